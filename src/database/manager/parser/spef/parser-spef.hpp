@@ -7,8 +7,11 @@
 #include <cstring>
 #include <experimental/filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <regex>
 #include <string_view>
@@ -18,6 +21,11 @@
 #include <utility>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "ThreadPool/ThreadPool.h"
 #include "pegtl/pegtl.hpp"
 
@@ -81,6 +89,51 @@ struct Net {
   void scale_resistance(float);
 };
 
+// MappedFile: the read only memory mapped file, the content is paged in by the
+// os on demand, so the huge SPEF need not be copied to a buffer.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::experimental::filesystem::path& p) {
+    _fd = ::open(p.c_str(), O_RDONLY);
+    if (_fd < 0) {
+      return;
+    }
+
+    struct stat st;
+    if (::fstat(_fd, &st) != 0 || st.st_size == 0) {
+      return;
+    }
+
+    void* addr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (addr == MAP_FAILED) {
+      return;
+    }
+    ::madvise(addr, st.st_size, MADV_SEQUENTIAL);
+    _data = static_cast<const char*>(addr);
+    _size = st.st_size;
+  }
+
+  ~MappedFile() {
+    if (_data) {
+      ::munmap(const_cast<char*>(_data), _size);
+    }
+    if (_fd >= 0) {
+      ::close(_fd);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool empty() const { return _data == nullptr; }
+  std::string_view view() const { return {_data, _size}; }
+
+ private:
+  int _fd{-1};
+  const char* _data{nullptr};
+  size_t _size{0};
+};
+
 // Spef: the data in a SPEF.
 // There are four parts: header, name map, ports, nets.
 struct Spef {
@@ -136,12 +189,24 @@ struct Spef {
 
   bool read(const std::experimental::filesystem::path&);
 
+  // The streaming read, read_header parses the header, name map and ports
+  // of the memory mapped file, and then read_nets splits the *D_NET
+  // section to chunks parsed by multiple threads. Each net is expanded and
+  // handed to the net_func, and then released, the nets are not kept.
+  bool read_header(const std::experimental::filesystem::path&);
+  bool read_nets(unsigned num_threads,
+                 const std::function<void(Net&)>& net_func);
+
   template <typename T>
   friend struct Action;
 
  private:
   Net* _current_net{nullptr};
   std::vector<std::string_view> _tokens;
+
+  std::function<void(Net&)> _net_func;  // the net consumer of streaming read.
+  std::shared_ptr<MappedFile> _mapped_file;
+  size_t _net_section_offset{0};
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -1083,7 +1148,14 @@ struct RuleNetEnd : pegtl::seq<TAO_PEGTL_STRING("*END")> {};
 template <>
 struct Action<RuleNetEnd> {
   template <typename Input>
-  static void apply(const Input& in, Spef& d) {}
+  static void apply(const Input& in, Spef& d) {
+    // streaming read, consume the net and release it.
+    if (d._net_func) {
+      d._net_func(*d._current_net);
+      d.nets.clear();
+      d._current_net = nullptr;
+    }
+  }
 };
 
 struct RuleInputEnd : pegtl::star<pegtl::any> {};
@@ -1101,6 +1173,18 @@ struct Action<RuleInputEnd> {
 // Spef Top Rule
 // ----------------------------------------------------------------------------------
 
+struct RuleNet
+    : pegtl::if_must<
+          RuleNetBeg, RuleDontCare,
+          pegtl::opt<pegtl::seq<RuleConnBeg, RuleDontCare>,
+                     pegtl::star<pegtl::seq<RuleConn, RuleDontCare>>>,
+          pegtl::opt<pegtl::seq<RuleCapBeg, RuleDontCare>,
+                     pegtl::star<pegtl::seq<
+                         pegtl::sor<RuleCapGround, RuleCapCouple>, RuleSpace>>>,
+          pegtl::opt<pegtl::seq<RuleResBeg, RuleDontCare>,
+                     pegtl::star<pegtl::seq<RuleRes, RuleSpace>>>,
+          RuleNetEnd, RuleDontCare> {};
+
 struct RuleSpef
     : pegtl::must<
           pegtl::star<pegtl::space>,  // strip leading space
@@ -1124,21 +1208,16 @@ struct RuleSpef
           pegtl::opt<RulePortBeg,
                      pegtl::star<pegtl::seq<RulePort, RuleDontCare>>>,
 
-          pegtl::star<pegtl::if_must<
-              RuleNetBeg, RuleDontCare,
-              pegtl::opt<pegtl::seq<RuleConnBeg, RuleDontCare>,
-                         pegtl::star<pegtl::seq<RuleConn, RuleDontCare>>>,
-              pegtl::opt<
-                  pegtl::seq<RuleCapBeg, RuleDontCare>,
-                  pegtl::star<pegtl::seq<
-                      pegtl::sor<RuleCapGround, RuleCapCouple>, RuleSpace>>>,
-              pegtl::opt<pegtl::seq<RuleResBeg, RuleDontCare>,
-                         pegtl::star<pegtl::seq<RuleRes, RuleSpace>>>,
-              RuleNetEnd, RuleDontCare>>,
+          pegtl::star<RuleNet>,
           pegtl::star<pegtl::space>,  // strip trailing spaces
           RuleInputEnd                // can't have anything more
           > {};
 
+// The *D_NET section chunk of streaming read.
+struct RuleSpefNetChunk
+    : pegtl::must<pegtl::star<pegtl::space>, pegtl::star<RuleNet>,
+                  pegtl::star<pegtl::space>, RuleInputEnd> {};
+
 // Error control
 // ----------------------------------------------------------------------------------
 
@@ -1177,15 +1256,8 @@ inline std::string file_to_memory(
   return buffer;
 }
 
-// Function: read
-inline bool Spef::read(const std::experimental::filesystem::path& p) {
-  auto buffer{file_to_memory(p)};
-
-  if (buffer.empty()) {
-    return false;
-  }
-
-  // Remove comments
+// Procedure: remove the comments before the first *D_NET
+inline void remove_comments(std::string& buffer) {
   for (size_t i = 0; i < buffer.size(); i++) {
     if (buffer[i] == 'D' && i + 1 < buffer.size() && buffer[i + 1] == '_' &&
         (i + 5) < buffer.size()) {
@@ -1206,6 +1278,17 @@ inline bool Spef::read(const std::experimental::filesystem::path& p) {
       }
     }
   }
+}
+
+// Function: read
+inline bool Spef::read(const std::experimental::filesystem::path& p) {
+  auto buffer{file_to_memory(p)};
+
+  if (buffer.empty()) {
+    return false;
+  }
+
+  remove_comments(buffer);
 
   // Use Lazy mode to avoid performance hit!!! (very important...)
   tao::pegtl::memory_input<pegtl::tracking_mode::LAZY> in(buffer, "");
@@ -1220,6 +1303,116 @@ inline bool Spef::read(const std::experimental::filesystem::path& p) {
   }
 }
 
+// Function: read_header
+inline bool Spef::read_header(const std::experimental::filesystem::path& p) {
+  _mapped_file = std::make_shared<MappedFile>(p);
+  if (_mapped_file->empty()) {
+    _mapped_file.reset();
+    return false;
+  }
+
+  auto content = _mapped_file->view();
+
+  // The net section start from the first *D_NET at the line begin.
+  size_t net_pos = content.rfind("*D_NET", 0) == 0 ? 0 : std::string_view::npos;
+  if (net_pos == std::string_view::npos) {
+    net_pos = content.find("\n*D_NET");
+    net_pos = (net_pos == std::string_view::npos) ? content.size() : net_pos + 1;
+  }
+  _net_section_offset = net_pos;
+
+  std::string header{content.substr(0, net_pos)};
+  remove_comments(header);
+
+  tao::pegtl::memory_input<pegtl::tracking_mode::LAZY> in(header, "");
+
+  try {
+    tao::pegtl::parse<spef::RuleSpef, spef::Action, spef::Control>(in, *this);
+  } catch (const tao::pegtl::parse_error& e) {
+    const auto& pos = e.positions.front();
+    error = Error{in.line_as_string(pos), pos.line, pos.byte_in_line};
+    return false;
+  }
+
+  for (auto& port : ports) {
+    expand_name(port);
+  }
+
+  return true;
+}
+
+// Function: read_nets
+inline bool Spef::read_nets(unsigned num_threads,
+                            const std::function<void(Net&)>& net_func) {
+  if (!_mapped_file) {
+    return false;
+  }
+
+  auto content = _mapped_file->view().substr(_net_section_offset);
+
+  // Split the net section to chunks at the *D_NET boundary.
+  num_threads = std::max(num_threads, 1u);
+  const size_t min_chunk_size = 4 * 1024 * 1024;
+  size_t chunk_size =
+      std::max(min_chunk_size, content.size() / (num_threads * 4) + 1);
+
+  std::vector<std::string_view> chunks;
+  size_t chunk_begin = 0;
+  while (chunk_begin < content.size()) {
+    size_t chunk_end = content.size();
+    if (chunk_begin + chunk_size < content.size()) {
+      chunk_end = content.find("\n*D_NET", chunk_begin + chunk_size);
+      chunk_end =
+          (chunk_end == std::string_view::npos) ? content.size() : chunk_end + 1;
+    }
+    chunks.emplace_back(content.substr(chunk_begin, chunk_end - chunk_begin));
+    chunk_begin = chunk_end;
+  }
+
+  // The name map is read only when parsing, shared by the threads.
+  auto expand_and_consume = [this, &net_func](Net& net) {
+    expand_name(net);
+    net_func(net);
+  };
+
+  std::vector<std::optional<Error>> chunk_errors(chunks.size());
+  auto parse_chunk = [&chunks, &chunk_errors,
+                      &expand_and_consume](size_t index) {
+    Spef chunk_spef;
+    chunk_spef._net_func = expand_and_consume;
+
+    tao::pegtl::memory_input<pegtl::tracking_mode::LAZY> in(
+        chunks[index].data(), chunks[index].data() + chunks[index].size(), "");
+    try {
+      tao::pegtl::parse<spef::RuleSpefNetChunk, spef::Action, spef::Control>(
+          in, chunk_spef);
+    } catch (const tao::pegtl::parse_error& e) {
+      const auto& pos = e.positions.front();
+      chunk_errors[index] =
+          Error{in.line_as_string(pos), pos.line, pos.byte_in_line};
+    }
+  };
+
+  {
+    ThreadPool pool(num_threads);
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      pool.enqueue(parse_chunk, i);
+    }
+  }
+
+  _mapped_file.reset();
+  name_map.clear();
+
+  for (auto& chunk_error : chunk_errors) {
+    if (chunk_error) {
+      error = chunk_error;
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // Procedure: replace the keys in str by the values in the mapping
 inline void expand_string(
     std::string& str, const std::unordered_map<size_t, std::string>& mapping) {
@@ -1239,11 +1432,9 @@ inline void expand_string(
       }
       endptr = (&str.data()[end]);
       key = ::strtoul(&str.data()[beg + 1], &(endptr), 10);
-      if (mapping.find(key) != mapping.end()) {
-        std::string raw_name = mapping.at(key);
-        std::regex re(R"(\\)");
-        std::string str_name = std::regex_replace(raw_name, re, "");
-        str.replace(beg, end - beg, str_name);
+      // the escape of name map is stripped when parsing.
+      if (auto it = mapping.find(key); it != mapping.end()) {
+        str.replace(beg, end - beg, it->second);
       }
     } else {
       break;
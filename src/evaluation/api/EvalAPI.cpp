@@ -125,20 +125,31 @@ vector<float> EvalAPI::evalInstDens(CongGrid* grid, const vector<CongInst*>& ins
 vector<float> EvalAPI::evalNetCong(const string& rudy_type)
 {
   _congestion_eval_inst->checkRUDYType(rudy_type);
-  _congestion_eval_inst->mapNet2Bin();
   return _congestion_eval_inst->getNetCong(rudy_type);
 }
 
+std::map<string, vector<float>> EvalAPI::evalNetCong(const vector<string>& rudy_type_list)
+{
+  return _congestion_eval_inst->evalNetCong(rudy_type_list);
+}
+
 vector<float> EvalAPI::evalNetCong(CongGrid* grid, const vector<CongNet*>& net_list, const string& rudy_type)
 {
   CongestionEval congestion_eval;
   congestion_eval.checkRUDYType(rudy_type);
   congestion_eval.set_cong_grid(grid);
   congestion_eval.set_cong_net_list(net_list);
-  congestion_eval.mapNet2Bin();
   return congestion_eval.getNetCong(rudy_type);
 }
 
+std::map<string, vector<float>> EvalAPI::evalNetCong(CongGrid* grid, const vector<CongNet*>& net_list, const vector<string>& rudy_type_list)
+{
+  CongestionEval congestion_eval;
+  congestion_eval.set_cong_grid(grid);
+  congestion_eval.set_cong_net_list(net_list);
+  return congestion_eval.evalNetCong(rudy_type_list);
+}
+
 vector<float> EvalAPI::evalGRCong()
 {
   // call router to get tilegrid info
@@ -151,6 +162,37 @@ vector<float> EvalAPI::evalGRCong()
   return _congestion_eval_inst->evalRouteCong();
 }
 
+/**
+ * @brief build the early global router once from idb, pin_coord_map records the pin coordinates of the current db
+ */
+vector<float> EvalAPI::initGRCongSession(std::map<std::string, std::pair<int, int>>& pin_coord_map)
+{
+  irt::RTAPI& rt_api = irt::RTAPI::getInst();
+  std::map<std::string, std::any> config_map;
+  rt_api.initCongestionSession(config_map);
+  return updateGRCongSession(pin_coord_map, 0);
+}
+
+/**
+ * @brief move the pins of the session without writing back to idb, only the nets with pins moved beyond move_threshold are rerouted
+ */
+vector<float> EvalAPI::updateGRCongSession(std::map<std::string, std::pair<int, int>>& pin_coord_map, const int& move_threshold)
+{
+  irt::RTAPI& rt_api = irt::RTAPI::getInst();
+  TileGrid* tile_grid = rt_api.updateCongestionSession(pin_coord_map, move_threshold);
+
+  delete _congestion_eval_inst->get_tile_grid();
+  _congestion_eval_inst->set_tile_grid(tile_grid);
+  return _congestion_eval_inst->evalRouteCong();
+}
+
+void EvalAPI::destroyGRCongSession()
+{
+  irt::RTAPI& rt_api = irt::RTAPI::getInst();
+  rt_api.destroyCongestionSession();
+  rt_api.destroyInst();
+}
+
 vector<float> EvalAPI::getUseCapRatioList()
 {
   return _congestion_eval_inst->getUseCapRatioList();
@@ -206,7 +248,6 @@ void EvalAPI::plotNetCong(const string& plot_path, const string& output_file_nam
   congestion_eval.checkRUDYType(rudy_type);
   congestion_eval.set_cong_grid(grid);
   congestion_eval.set_cong_net_list(net_list);
-  congestion_eval.mapNet2Bin();
   congestion_eval.evalNetCong(rudy_type);
   congestion_eval.plotNetCong(plot_path, output_file_name, rudy_type);
 }
@@ -219,7 +260,6 @@ void EvalAPI::reportCongestion(const string& plot_path, const string& output_fil
   congestion_eval.set_cong_inst_list(inst_list);
   congestion_eval.set_cong_net_list(net_list);
   congestion_eval.mapInst2Bin();
-  congestion_eval.mapNet2Bin();
   congestion_eval.reportCongestion(plot_path, output_file_name);
 }
 /******************************Congestion Eval: END******************************/
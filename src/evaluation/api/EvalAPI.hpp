@@ -1,6 +1,7 @@
 #ifndef SRC_EVALUATION_API_EVALAPI_HPP_
 #define SRC_EVALUATION_API_EVALAPI_HPP_
 
+#include <map>
 #include <string>
 #include <vector>
 
@@ -39,7 +40,13 @@ class EvalAPI
   vector<float> evalInstDens(CongGrid* grid, const vector<CongInst*>& inst_list);
   vector<float> evalNetCong(const string& rudy_type);
   vector<float> evalNetCong(CongGrid* grid, const vector<CongNet*>& net_list, const string& rudy_type);
+  // all types of rudy_type_list are computed in one pass of nets
+  std::map<string, vector<float>> evalNetCong(const vector<string>& rudy_type_list);
+  std::map<string, vector<float>> evalNetCong(CongGrid* grid, const vector<CongNet*>& net_list, const vector<string>& rudy_type_list);
   vector<float> evalGRCong();
+  vector<float> initGRCongSession(std::map<std::string, std::pair<int, int>>& pin_coord_map);
+  vector<float> updateGRCongSession(std::map<std::string, std::pair<int, int>>& pin_coord_map, const int& move_threshold);
+  void destroyGRCongSession();
   vector<float> getUseCapRatioList();
   vector<int> getTileGridCoordSizeCntXY();
   void plotPinDens(const string& plot_path, const string& output_file_name, CongGrid* grid, const vector<CongInst*>& inst_list);
@@ -13,7 +13,7 @@ class CongNet
 
   // getter
   std::string get_name() const { return _name; }
-  std::vector<CongPin*> get_pin_list() const { return _pin_list; }
+  const std::vector<CongPin*>& get_pin_list() const { return _pin_list; }
   int64_t get_lx();
   int64_t get_ly();
   int64_t get_ux();
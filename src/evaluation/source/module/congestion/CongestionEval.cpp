@@ -4,9 +4,11 @@
 #include <cfloat>
 #include <cmath>
 #include <fstream>
+#include <set>
 
 #include "../manager.hpp"
 #include "EvalLog.hpp"
+#include "omp.h"
 
 namespace eval {
 
@@ -25,7 +27,6 @@ void CongestionEval::reportCongestion(const std::string& plot_path, const std::s
   reportInstDens();
   plotInstDens(plot_path, output_file_name);
   LOG_INFO << " Evaluating Net Congestion for Each Bin ... ... ";
-  mapNet2Bin();
   evalNetCong("RUDY");
   reportNetCong();
   plotNetCong(plot_path, output_file_name, "RUDY");
@@ -301,38 +302,275 @@ void CongestionEval::evalNetCong(const std::string& rudy_type)
   for (auto& bin : _cong_grid->get_bin_list()) {
     bin->reset();
   }
+  std::vector<float> net_cong = evalNetCong(std::vector<std::string>{rudy_type})[rudy_type];
+  auto& bin_list = _cong_grid->get_bin_list();
+  for (size_t i = 0; i < bin_list.size(); ++i) {
+    bin_list[i]->set_net_cong(net_cong[i]);
+  }
+}
 
-  std::map<std::string, int64_t> netname_steinerwl_map;
-  std::map<std::string, int64_t> netname_truewl_map;
-  if (rudy_type == "SteinerRUDY" || rudy_type == "PinSteinerRUDY") {
-    auto length_evaluator = Manager::getInst().getWirelengthEval();
-    netname_steinerwl_map = length_evaluator->getName2WLmap("SteinerRUDY");
+// the accumulated terms of all RUDY types, a term is the sum of (overlap area * net value) in each bin
+enum RudyTerm
+{
+  kInvHeight,     // 1 / h
+  kInvWidth,      // 1 / w
+  kLine,          // 1, the net with zero width or height
+  kSteiner,       // steiner wl / (h * w)
+  kTrue,          // true wl / (h * w)
+  kPin,           // (1 / h + 1 / w) for each pin in the bin
+  kPinSteiner,    // steiner wl / (h * w) for each pin in the bin
+  kRudyTermNum
+};
+
+// add value to the bins [lx, ux] x [ly, uy] of the 2D difference array
+static inline void addDiffRect(double* diff, const int& stride, const int& lx, const int& ly, const int& ux, const int& uy, const double& value)
+{
+  diff[ly * stride + lx] += value;
+  diff[ly * stride + ux + 1] -= value;
+  diff[(uy + 1) * stride + lx] -= value;
+  diff[(uy + 1) * stride + ux + 1] += value;
+}
+
+/**
+ * all RUDY maps are computed in one pass of nets. the overlap area of a net and a bin is the product of the
+ * overlap length in x and y, so the overlap of a net bbox is split into at most 9 rectangles with constant value
+ * (inner, 4 boundary rows/columns, 4 corners) and added to the 2D difference array of each thread in O(1).
+ */
+std::map<std::string, std::vector<float>> CongestionEval::evalNetCong(const std::vector<std::string>& rudy_type_list)
+{
+  std::set<std::string> rudy_type_set(rudy_type_list.begin(), rudy_type_list.end());
+  for (auto& rudy_type : rudy_type_set) {
+    checkRUDYType(rudy_type);
+  }
+
+  std::vector<bool> is_term_used(kRudyTermNum, false);
+  for (auto& rudy_type : rudy_type_set) {
+    if (rudy_type == "RUDY" || rudy_type == "RUDYDev") {
+      is_term_used[kInvHeight] = is_term_used[kInvWidth] = is_term_used[kLine] = true;
+    } else if (rudy_type == "SteinerRUDY") {
+      is_term_used[kSteiner] = is_term_used[kLine] = true;
+    } else if (rudy_type == "TrueRUDY") {
+      is_term_used[kTrue] = is_term_used[kLine] = true;
+    } else if (rudy_type == "PinRUDY") {
+      is_term_used[kPin] = true;
+    } else if (rudy_type == "PinSteinerRUDY") {
+      is_term_used[kPinSteiner] = true;
+    }
   }
-  if (rudy_type == "TrueRUDY") {
+  std::vector<int> term_slot(kRudyTermNum, -1);
+  int slot_num = 0;
+  for (int term = 0; term < kRudyTermNum; ++term) {
+    if (is_term_used[term]) {
+      term_slot[term] = slot_num++;
+    }
+  }
+
+  // wirelength indexed by net id
+  int net_num = _cong_net_list.size();
+  std::vector<int64_t> steiner_wl_list(net_num, 0);
+  std::vector<int64_t> true_wl_list(net_num, 0);
+  if (is_term_used[kSteiner] || is_term_used[kPinSteiner] || is_term_used[kTrue]) {
     auto length_evaluator = Manager::getInst().getWirelengthEval();
-    netname_truewl_map = length_evaluator->getName2WLmap("TrueRUDY");
+    for (int net_id = 0; net_id < net_num; ++net_id) {
+      WLNet* wl_net = length_evaluator->find_net(_cong_net_list[net_id]->get_name());
+      if (wl_net == nullptr) {
+        continue;
+      }
+      if (is_term_used[kSteiner] || is_term_used[kPinSteiner]) {
+        steiner_wl_list[net_id] = wl_net->FluteWL();
+      }
+      if (is_term_used[kTrue]) {
+        true_wl_list[net_id] = wl_net->detailRouteWL();
+      }
+    }
   }
-  for (auto& bin : _cong_grid->get_bin_list()) {
-    int32_t overlap_area = 0;
-    double congestion = 0.0;
-    for (auto& net : bin->get_net_list()) {
-      overlap_area = getOverlapArea(bin, net);
-      if (rudy_type == "RUDY") {
-        congestion += overlap_area * getRudy(bin, net);
-      } else if (rudy_type == "RUDYDev") {
-        congestion += overlap_area * getRudyDev(bin, net);
-      } else if (rudy_type == "PinRUDY") {
-        congestion += overlap_area * getPinRudy(bin, net);
-      } else if (rudy_type == "PinSteinerRUDY") {
-        congestion += overlap_area * getPinSteinerRudy(bin, net, netname_steinerwl_map);
-      } else if (rudy_type == "SteinerRUDY") {
-        congestion += overlap_area * getSteinerRudy(bin, net, netname_steinerwl_map);
-      } else if (rudy_type == "TrueRUDY") {
-        congestion += overlap_area * getTrueRudy(bin, net, netname_truewl_map);
+
+  int grid_lx = _cong_grid->get_lx();
+  int grid_ly = _cong_grid->get_ly();
+  int bin_cnt_x = _cong_grid->get_bin_cnt_x();
+  int bin_cnt_y = _cong_grid->get_bin_cnt_y();
+  int bin_size_x = _cong_grid->get_bin_size_x();
+  int bin_size_y = _cong_grid->get_bin_size_y();
+  int stride = bin_cnt_x + 1;
+  size_t diff_size = static_cast<size_t>(bin_cnt_x + 1) * (bin_cnt_y + 1);
+
+  // the partial grids of all threads are limited to 1 << 27 doubles (1 GiB)
+  size_t thread_grid_size = std::max<size_t>(1, diff_size * slot_num);
+  int thread_num = std::max(1, std::min(omp_get_max_threads(), static_cast<int>((size_t(1) << 27) / thread_grid_size)));
+  std::vector<std::vector<double>> thread_diff_list(thread_num, std::vector<double>(diff_size * slot_num, 0.0));
+
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 256)
+  for (int net_id = 0; net_id < net_num; ++net_id) {
+    CongNet* net = _cong_net_list[net_id];
+    const std::vector<CongPin*>& pin_list = net->get_pin_list();
+    if (pin_list.size() < 2) {
+      continue;
+    }
+    int64_t net_lx = net->get_lx();
+    int64_t net_ly = net->get_ly();
+    int64_t net_ux = net->get_ux();
+    int64_t net_uy = net->get_uy();
+    int64_t net_width = net_ux - net_lx;
+    int64_t net_height = net_uy - net_ly;
+    if (net_width == 0 && net_height == 0) {
+      continue;
+    }
+    int lx = (net_lx - grid_lx) / bin_size_x;
+    int ly = (net_ly - grid_ly) / bin_size_y;
+    int ux = (net_ux - grid_lx) / bin_size_x;
+    int uy = (net_uy - grid_ly) / bin_size_y;
+    if (lx >= bin_cnt_x || ly >= bin_cnt_y || ux < 0 || uy < 0) {
+      continue;
+    }
+    lx = std::max(lx, 0);
+    ly = std::max(ly, 0);
+    ux = std::min(ux, bin_cnt_x - 1);
+    uy = std::min(uy, bin_cnt_y - 1);
+
+    // overlap length with the bin column / row, the zero width(height) net takes 1 as in a line
+    auto overlap_x = [&](int i) -> double {
+      if (net_width == 0) {
+        return 1.0;
+      }
+      int64_t bin_lx = grid_lx + static_cast<int64_t>(i) * bin_size_x;
+      return std::max<int64_t>(0, std::min(bin_lx + bin_size_x, net_ux) - std::max(bin_lx, net_lx));
+    };
+    auto overlap_y = [&](int j) -> double {
+      if (net_height == 0) {
+        return 1.0;
+      }
+      int64_t bin_ly = grid_ly + static_cast<int64_t>(j) * bin_size_y;
+      return std::max<int64_t>(0, std::min(bin_ly + bin_size_y, net_uy) - std::max(bin_ly, net_ly));
+    };
+    double full_x = (net_width == 0) ? 1.0 : bin_size_x;
+    double full_y = (net_height == 0) ? 1.0 : bin_size_y;
+    double lx_delta = overlap_x(lx) - full_x;
+    double ux_delta = (ux == lx) ? 0.0 : overlap_x(ux) - full_x;
+    double ly_delta = overlap_y(ly) - full_y;
+    double uy_delta = (uy == ly) ? 0.0 : overlap_y(uy) - full_y;
+
+    double* diff = thread_diff_list[omp_get_thread_num()].data();
+    auto add_bbox = [&](const int& term, const double& value) {
+      if (term_slot[term] < 0 || value == 0.0) {
+        return;
+      }
+      double* term_diff = diff + term_slot[term] * diff_size;
+      addDiffRect(term_diff, stride, lx, ly, ux, uy, value * full_x * full_y);
+      addDiffRect(term_diff, stride, lx, ly, ux, ly, value * full_x * ly_delta);
+      addDiffRect(term_diff, stride, lx, uy, ux, uy, value * full_x * uy_delta);
+      addDiffRect(term_diff, stride, lx, ly, lx, uy, value * lx_delta * full_y);
+      addDiffRect(term_diff, stride, ux, ly, ux, uy, value * ux_delta * full_y);
+      addDiffRect(term_diff, stride, lx, ly, lx, ly, value * lx_delta * ly_delta);
+      addDiffRect(term_diff, stride, lx, uy, lx, uy, value * lx_delta * uy_delta);
+      addDiffRect(term_diff, stride, ux, ly, ux, ly, value * ux_delta * ly_delta);
+      addDiffRect(term_diff, stride, ux, uy, ux, uy, value * ux_delta * uy_delta);
+    };
+    if (net_width == 0 || net_height == 0) {
+      add_bbox(kLine, 1.0);
+    } else {
+      add_bbox(kInvHeight, 1.0 / net_height);
+      add_bbox(kInvWidth, 1.0 / net_width);
+      add_bbox(kSteiner, steiner_wl_list[net_id] / static_cast<double>(net_height) / net_width);
+      add_bbox(kTrue, true_wl_list[net_id] / static_cast<double>(net_height) / net_width);
+    }
+
+    // the pin on the bin boundary is not in any bin
+    if (term_slot[kPin] < 0 && term_slot[kPinSteiner] < 0) {
+      continue;
+    }
+    double pin_value = (net_height == 0 ? 0.0 : 1.0 / net_height) + (net_width == 0 ? 0.0 : 1.0 / net_width);
+    double pin_steiner_value
+        = (net_height == 0 || net_width == 0) ? 0.0 : steiner_wl_list[net_id] / static_cast<double>(net_height) / net_width;
+    for (auto* pin : pin_list) {
+      int64_t offset_x = pin->get_x() - grid_lx;
+      int64_t offset_y = pin->get_y() - grid_ly;
+      if (offset_x <= 0 || offset_y <= 0 || offset_x % bin_size_x == 0 || offset_y % bin_size_y == 0) {
+        continue;
+      }
+      int i = offset_x / bin_size_x;
+      int j = offset_y / bin_size_y;
+      if (i < lx || i > ux || j < ly || j > uy) {
+        continue;
+      }
+      double overlap_area = overlap_x(i) * overlap_y(j);
+      if (term_slot[kPin] >= 0) {
+        addDiffRect(diff + term_slot[kPin] * diff_size, stride, i, j, i, j, overlap_area * pin_value);
+      }
+      if (term_slot[kPinSteiner] >= 0) {
+        addDiffRect(diff + term_slot[kPinSteiner] * diff_size, stride, i, j, i, j, overlap_area * pin_steiner_value);
+      }
+    }
+  }
+
+  // reduce the partial grids to the first one, then prefix sum by rows and columns
+  std::vector<double>& term_diff_list = thread_diff_list[0];
+  int64_t total_size = static_cast<int64_t>(diff_size) * slot_num;
+#pragma omp parallel for schedule(static)
+  for (int64_t k = 0; k < total_size; ++k) {
+    for (int t = 1; t < thread_num; ++t) {
+      term_diff_list[k] += thread_diff_list[t][k];
+    }
+  }
+#pragma omp parallel for collapse(2) schedule(static)
+  for (int slot = 0; slot < slot_num; ++slot) {
+    for (int j = 0; j < bin_cnt_y; ++j) {
+      double* row = term_diff_list.data() + slot * diff_size + static_cast<size_t>(j) * stride;
+      for (int i = 1; i < bin_cnt_x; ++i) {
+        row[i] += row[i - 1];
+      }
+    }
+  }
+#pragma omp parallel for collapse(2) schedule(static)
+  for (int slot = 0; slot < slot_num; ++slot) {
+    for (int i = 0; i < bin_cnt_x; ++i) {
+      double* column = term_diff_list.data() + slot * diff_size + i;
+      for (int j = 1; j < bin_cnt_y; ++j) {
+        column[static_cast<size_t>(j) * stride] += column[static_cast<size_t>(j - 1) * stride];
+      }
+    }
+  }
+  auto get_term = [&](const int& term, const int& i, const int& j) -> double {
+    return term_diff_list[term_slot[term] * diff_size + static_cast<size_t>(j) * stride + i];
+  };
+
+  std::map<std::string, std::vector<float>> net_cong_map;
+  auto& bin_list = _cong_grid->get_bin_list();
+  for (auto& rudy_type : rudy_type_set) {
+    bool is_rudy = rudy_type == "RUDY";
+    bool is_rudy_dev = rudy_type == "RUDYDev";
+    bool is_steiner_rudy = rudy_type == "SteinerRUDY";
+    bool is_true_rudy = rudy_type == "TrueRUDY";
+    bool is_pin_rudy = rudy_type == "PinRUDY";
+    std::vector<float>& net_cong = net_cong_map[rudy_type];
+    net_cong.resize(bin_list.size(), 0.0f);
+#pragma omp parallel for schedule(static)
+    for (int j = 0; j < bin_cnt_y; ++j) {
+      for (int i = 0; i < bin_cnt_x; ++i) {
+        CongBin* bin = bin_list[j * bin_cnt_x + i];
+        double congestion = 0.0;
+        if (is_rudy) {
+          double wire_width = bin->get_average_wire_width();
+          congestion = wire_width * (get_term(kInvHeight, i, j) + get_term(kInvWidth, i, j)) + get_term(kLine, i, j);
+        } else if (is_rudy_dev) {
+          int capacity_hor = bin->get_horizontal_capacity();
+          int capacity_ver = bin->get_vertical_capacity();
+          double coef_hor = capacity_hor == 0 ? 0.0 : bin_size_y / capacity_hor;
+          double coef_ver = capacity_ver == 0 ? 0.0 : bin_size_x / capacity_ver;
+          congestion = coef_hor * get_term(kInvHeight, i, j) + coef_ver * get_term(kInvWidth, i, j) + get_term(kLine, i, j);
+        } else if (is_steiner_rudy) {
+          congestion = bin->get_average_wire_width() * get_term(kSteiner, i, j) + get_term(kLine, i, j);
+        } else if (is_true_rudy) {
+          congestion = bin->get_average_wire_width() * get_term(kTrue, i, j) + get_term(kLine, i, j);
+        } else if (is_pin_rudy) {
+          congestion = get_term(kPin, i, j);
+        } else {
+          congestion = get_term(kPinSteiner, i, j);
+        }
+        net_cong[j * bin_cnt_x + i] = congestion;
       }
     }
-    bin->set_net_cong(congestion);
   }
+  return net_cong_map;
 }
 
 std::vector<float> CongestionEval::getNetCong(const std::string& rudy_type)
@@ -888,169 +1126,6 @@ int32_t CongestionEval::getOverlapArea(CongBin* bin, CongInst* inst)
   }
 }
 
-int32_t CongestionEval::getOverlapArea(CongBin* bin, CongNet* net)
-{
-  int32_t rect_lx = std::max((int64_t) bin->get_lx(), net->get_lx());
-  int32_t rect_ly = std::max((int64_t) bin->get_ly(), net->get_ly());
-  int32_t rect_ux = std::min((int64_t) bin->get_ux(), net->get_ux());
-  int32_t rect_uy = std::min((int64_t) bin->get_uy(), net->get_uy());
-
-  if (rect_lx > rect_ux || rect_ly > rect_uy) {
-    return 0;
-  } else if (rect_lx == rect_ux) {
-    return rect_uy - rect_ly;
-  } else if (rect_ly == rect_uy) {
-    return rect_ux - rect_lx;
-  } else {
-    return (rect_ux - rect_lx) * (rect_uy - rect_ly);
-  }
-}
-
-// this idea is from the paper "Fast and Accurate Routing Demand Estimation for Efficient Routability-driven Placement"
-double CongestionEval::getRudy(CongBin* bin, CongNet* net)
-{
-  double item_1 = 0.0;
-  double item_2 = 0.0;
-
-  if (net->get_height() == 0 || net->get_width() == 0) {
-    return 1;
-  }
-
-  if (net->get_height() != 0) {
-    item_1 = bin->get_average_wire_width() / static_cast<double>(net->get_height());
-  }
-  if (net->get_width() != 0) {
-    item_2 = bin->get_average_wire_width() / static_cast<double>(net->get_width());
-  }
-
-  return item_1 + item_2;
-}
-
-// this idea is from the paper "Routability-Driven Analytical Placement by Net Overlapping Removal for
-// Large-Scale Mixed-Size Designs"
-double CongestionEval::getRudyDev(CongBin* bin, CongNet* net)
-{
-  double item_1 = 0.0;
-  double item_2 = 0.0;
-  int64_t net_height = net->get_height();
-  int64_t net_width = net->get_width();
-
-  if (net_height == 0 || net_width == 0) {
-    return 1;
-  }
-
-  if (net_height != 0) {
-    int bin_size_y = _cong_grid->get_bin_size_y();
-    int capacity_hor = bin->get_horizontal_capacity();
-    item_1 = bin_size_y / capacity_hor / static_cast<double>(net_height);
-  }
-
-  if (net->get_width() != 0) {
-    int bin_size_x = _cong_grid->get_bin_size_x();
-    int capacity_ver = bin->get_vertical_capacity();
-    item_2 = bin_size_x / capacity_ver / static_cast<double>(net_width);
-  }
-
-  return item_1 + item_2;
-}
-
-// this idea is from the paper "Global Placement with Deep Learning-Enabled Explicit Routability Optimization"
-double CongestionEval::getPinRudy(CongBin* bin, CongNet* net)
-{
-  double item_1 = 0.0;
-  double item_2 = 0.0;
-  int64_t net_height = net->get_height();
-  int64_t net_width = net->get_width();
-
-  for (auto& pin : net->get_pin_list()) {
-    auto pin_x = pin->get_x();
-    auto pin_y = pin->get_y();
-    if (pin_x > bin->get_lx() && pin_x < bin->get_ux() && pin_y > bin->get_ly() && pin_y < bin->get_uy()) {
-      if (net_height != 0) {
-        item_1 += 1 / static_cast<double>(net_height);
-      }
-      if (net_width != 0) {
-        item_2 += 1 / static_cast<double>(net_width);
-      }
-    }
-  }
-
-  return item_1 + item_2;
-}
-
-double CongestionEval::getPinSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map)
-{
-  double result = 0.0;
-  int64_t net_height = net->get_height();
-  int64_t net_width = net->get_width();
-
-  int64_t flute_wl = 0;
-  auto net_pair = map.find(net->get_name());
-  if (net_pair != map.end()) {
-    flute_wl = net_pair->second;
-  } else {
-    flute_wl = 0;
-  }
-
-  for (auto& pin : net->get_pin_list()) {
-    auto pin_x = pin->get_x();
-    auto pin_y = pin->get_y();
-    if (pin_x > bin->get_lx() && pin_x < bin->get_ux() && pin_y > bin->get_ly() && pin_y < bin->get_uy()) {
-      if (net_height != 0 && net_width != 0) {
-        result += flute_wl / static_cast<double>(net_height) / net_width;
-      }
-    }
-  }
-
-  return result;
-}
-
-double CongestionEval::getSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map)
-{
-  double result = 0.0;
-  int64_t net_height = net->get_height();
-  int64_t net_width = net->get_width();
-
-  int64_t flute_wl = 0;
-  auto net_pair = map.find(net->get_name());
-  if (net_pair != map.end()) {
-    flute_wl = net_pair->second;
-  } else {
-    flute_wl = 0;
-  }
-
-  if (net_height == 0 || net_width == 0) {
-    result = 1;
-  } else {
-    result = flute_wl / static_cast<double>(net_height) / net_width * bin->get_average_wire_width();
-  }
-  std::cout << "steiner rudy :" << result << std::endl;
-  return result;
-}
-
-double CongestionEval::getTrueRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map)
-{
-  double result = 0.0;
-  int64_t net_height = net->get_height();
-  int64_t net_width = net->get_width();
-
-  int64_t true_wl = 0;
-  auto net_pair = map.find(net->get_name());
-  if (net_pair != map.end()) {
-    true_wl = net_pair->second;
-  } else {
-    true_wl = 0;
-  }
-
-  if (net_height == 0 || net_width == 0) {
-    result = 1;
-  } else {
-    result = true_wl / static_cast<double>(net_height) / net_width * bin->get_average_wire_width();
-  }
-  std::cout << "ture rudy :" << result << std::endl;
-  return result;
-}
-
 float CongestionEval::getUsageCapacityRatio(Tile* tile)
 {
   unsigned int cap_N = 0, cap_S = 0, cap_E = 0, cap_W = 0;
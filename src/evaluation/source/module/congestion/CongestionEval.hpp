@@ -36,6 +36,7 @@ class CongestionEval
   /*----evaluate net congestion----*/
   void mapNet2Bin();
   void evalNetCong(const std::string& rudy_type);
+  std::map<std::string, std::vector<float>> evalNetCong(const std::vector<std::string>& rudy_type_list);
   void reportNetCong();
   void plotNetCong(const std::string& plot_path, const std::string& output_file_name, const std::string& type);
   double getBinNetCong(const int& index_x, const int& index_y, const std::string& rudy_type);
@@ -88,14 +89,6 @@ class CongestionEval
   std::vector<CongNet*> _cong_net_list;
 
   int32_t getOverlapArea(CongBin* bin, CongInst* inst);
-  int32_t getOverlapArea(CongBin* bin, CongNet* net);
-
-  double getRudy(CongBin* bin, CongNet* net);
-  double getRudyDev(CongBin* bin, CongNet* net);
-  double getPinRudy(CongBin* bin, CongNet* net);
-  double getPinSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
-  double getSteinerRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
-  double getTrueRudy(CongBin* bin, CongNet* net, const std::map<std::string, int64_t>& map);
 
   float getUsageCapacityRatio(Tile* tile);
 };
@@ -13,6 +13,7 @@ TimingEval::TimingEval(idb::IdbBuilder* idb_builder, const char* sta_workspace_p
 {
   _timing_engine = ista::TimingEngine::getOrCreateTimingEngine();
   _timing_engine->set_num_threads(40);
+  _timing_engine->set_is_level_propagation(true);
   _timing_engine->set_design_work_space(sta_workspace_path);
   _timing_engine->readLiberty(lib_file_path_list);
   auto db_adapter = std::make_unique<ista::TimingIDBAdapter>(_timing_engine->get_ista());
@@ -59,6 +60,7 @@ void TimingEval::estimateDelay(idb::IdbBuilder* idb_builder, const char* sta_wor
   // start TimingEngine
   _timing_engine = ista::TimingEngine::getOrCreateTimingEngine();
   _timing_engine->set_num_threads(40);
+  _timing_engine->set_is_level_propagation(true);
   _timing_engine->set_design_work_space(sta_workspace_path);
   _timing_engine->readLiberty(lib_file_path_list);
   auto db_adapter = std::make_unique<ista::TimingIDBAdapter>(_timing_engine->get_ista());
@@ -309,6 +311,7 @@ void TimingEval::initTimingEngine(idb::IdbBuilder* idb_builder, const char* sta_
 {
   _timing_engine = ista::TimingEngine::getOrCreateTimingEngine();
   _timing_engine->set_num_threads(8);
+  _timing_engine->set_is_level_propagation(true);
   _timing_engine->set_design_work_space(sta_workspace_path);
   _timing_engine->readLiberty(lib_file_path_list);
   auto db_adapter = std::make_unique<ista::TimingIDBAdapter>(_timing_engine->get_ista());
@@ -29,7 +29,11 @@ unsigned TclDrcCheckDef::exec()
   std::cout << "init DRC check module ......" << std::endl;
   DrcInst.initCheckModule();
   std::cout << "run DRC check module ......" << std::endl;
-  DrcInst.run();
+  int thread_number = 1;
+  if (config_map.find("-thread_number") != config_map.end()) {
+    thread_number = std::any_cast<int>(config_map["-thread_number"]);
+  }
+  DrcInst.run(thread_number);
   std::cout << "report check result ......" << std::endl;
   DrcInst.report();
   return 1;
@@ -45,6 +49,7 @@ unsigned TclDrcCheckDef::exec()
 void TclDrcCheckDef::addOptionForTCL()
 {
   TclUtil::addOption(this, "-def_path", ValueType::kString);
+  TclUtil::addOption(this, "-thread_number", ValueType::kInt);
 }
 
 // bool TclDrcCheckDef::initConfigMapByJSON(std::map<std::string, std::any>& config_map)
@@ -76,6 +81,10 @@ bool TclDrcCheckDef::initConfigMapByTCL(std::map<std::string, std::any>& config_
   if (config_value.has_value()) {
     config_map.insert(std::make_pair("-def_path", config_value));
   }
+  config_value = TclUtil::getValue(this, "-thread_number", ValueType::kInt);
+  if (config_value.has_value()) {
+    config_map.insert(std::make_pair("-thread_number", config_value));
+  }
 
   return true;
 }
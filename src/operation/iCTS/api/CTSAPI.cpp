@@ -130,10 +130,16 @@ void CTSAPI::init(const std::string& config_file)
   _balancer = new Balancer();
   _model_factory = new ModelFactory();
   _mpl_helper = new MplHelper();
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   auto external_models = _config->get_external_models();
   for (auto [net_name, model_path] : external_models) {
-    auto* model = _model_factory->pyLoad(model_path);
+    auto* model = _model_factory->load(model_path);
+#ifdef PY_MODEL
+    if (model == nullptr) {
+      model = _model_factory->pyLoad(model_path);
+    }
+#endif
+    LOG_FATAL_IF(model == nullptr) << "can't load external model: " << model_path;
     _libs->insertModel(net_name, model);
   }
 #endif
@@ -544,9 +550,10 @@ icts::CtsCellLib* CTSAPI::getCellLib(const std::string& cell_master, const std::
   lib->set_slew_coef(_model_factory->cppLinearModel(x_slew, y_slew));
 
 #ifdef PY_MODEL
-  auto* delay_lib_model = _model_factory->pyFit(x_delay, y_delay, icts::FitType::kCATBOOST);
+  // the fits are predicted natively, so the nets can still be built in parallel
+  auto* delay_lib_model = _model_factory->pyFitCatBoost(x_delay, y_delay);
   lib->set_delay_lib_model(delay_lib_model);
-  auto* slew_lib_model = _model_factory->pyFit(x_slew, y_slew, icts::FitType::kCATBOOST);
+  auto* slew_lib_model = _model_factory->pyFitCatBoost(x_slew, y_slew);
   lib->set_slew_lib_model(slew_lib_model);
 #endif
   _libs->insertLib(cell_master, lib);
@@ -1035,16 +1042,21 @@ void CTSAPI::toPyArray(const icts::CtsPolygon<int64_t>& polygon, const std::stri
   CTSAPIInst.saveToLog(message);
 }
 
-// python API
-#ifdef PY_MODEL
-
 #ifdef USE_EXTERNAL_MODEL
 icts::ModelBase* CTSAPI::findExternalModel(const std::string& net_name)
 {
   return _libs->findModel(net_name);
 }
+
+bool CTSAPI::hasPyExternalModel() const
+{
+  return _libs->hasPyModel();
+}
 #endif
 
+// python API
+#ifdef PY_MODEL
+
 /**
  * @brief Python interface for plot
  *
@@ -145,13 +145,14 @@ class CTSAPI
   void toPyArray(const icts::Polygon& polygon, const std::string& label);
   void toPyArray(const icts::CtsPolygon<int64_t>& polygon, const std::string& label);
 
-// python API
-#ifdef PY_MODEL
-
 #ifdef USE_EXTERNAL_MODEL
   icts::ModelBase* findExternalModel(const std::string& net_name);
+  bool hasPyExternalModel() const;
 #endif
 
+// python API
+#ifdef PY_MODEL
+
   icts::ModelBase* fitPyModel(const std::vector<std::vector<double>>& X, const std::vector<double>& y, const icts::FitType& fit_type);
   void saveFig(const std::string& file_name);
   void plot(const icts::Point& point, const std::string& label);
@@ -25,6 +25,7 @@ class CtsConfig {
   const string &get_delay_type() const { return _delay_type; }
   const string &get_cluster_type() const { return _cluster_type; }
   int get_cluster_size() const { return _cluster_size; }
+  int get_thread_num() const { return _thread_num; }
   const string &get_sta_workspace() const { return _sta_workspace; }
   const string &get_output_def_path() const { return _output_def_path; }
   const string &get_log_file() const { return _log_file; }
@@ -58,6 +59,7 @@ class CtsConfig {
     _cluster_type = cluster_type;
   }
   void set_cluster_size(int size) { _cluster_size = size; }
+  void set_thread_num(int thread_num) { _thread_num = thread_num; }
   void set_sta_workspace(const string &sta_workspace) {
     _sta_workspace = sta_workspace;
   }
@@ -95,6 +97,7 @@ class CtsConfig {
   double _max_length = 300;
   string _cluster_type = "kmeans";
   int _cluster_size = 32;
+  int _thread_num = 1;
   // file
   string _sta_workspace = "./result/cts";
   string _output_def_path = "./result/cts";
@@ -87,6 +87,9 @@ void JsonParser::parse(const string &json_file, CtsConfig *config) const {
     if (COMUtil::getData(json, {"cluster_size"}) != nullptr) {
       config->set_cluster_size(COMUtil::getData(json, {"cluster_size"}));
     }
+    if (COMUtil::getData(json, {"thread_number"}) != nullptr) {
+      config->set_thread_num(COMUtil::getData(json, {"thread_number"}));
+    }
     if (COMUtil::getData(json, {"buffer_type"}) != nullptr) {
       config->set_buffer_types(COMUtil::getData(json, {"buffer_type"}));
     }
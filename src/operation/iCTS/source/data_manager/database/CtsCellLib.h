@@ -171,7 +171,7 @@ class CtsLibs {
     }
     return _lib_maps[cell_master];
   }
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   void insertModel(const std::string& net_name, ModelBase* model) {
     _model_maps[net_name] = model;
   }
@@ -182,10 +182,15 @@ class CtsLibs {
     }
     return _model_maps[net_name];
   }
+
+  bool hasPyModel() const {
+    return std::any_of(_model_maps.begin(), _model_maps.end(),
+                       [](const auto& item) { return item.second->isPyModel(); });
+  }
 #endif
  private:
   std::map<std::string, CtsCellLib*> _lib_maps;
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   std::map<std::string, ModelBase*> _model_maps;
 #endif
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -34,7 +35,8 @@ class CtsDesign
     return false;
   }
 
-  int nextId() { return _id++; }
+  // the timing nodes of different nets are built by the threads at the same time
+  int nextId() { return std::atomic_ref<int>(_id).fetch_add(1); }
   vector<CtsClock*>& get_clocks() { return _clocks; }
   vector<ClockTopo>& get_clock_topos() { return _clock_topos; }
   vector<pair<string, string>>& get_clock_net_names() { return _clock_net_names; }
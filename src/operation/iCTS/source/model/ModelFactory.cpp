@@ -2,13 +2,68 @@
 
 #include <Eigen/Dense>
 #include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <unsupported/Eigen/Polynomials>
 
+#include "json/json.hpp"
+#include "log/Log.hh"
+
 #ifdef PY_MODEL
 #include "PyModel.h"
 #endif
 namespace icts {
 
+std::vector<double> ModelBase::predict(
+    const std::vector<std::vector<double>>& X) const {
+  std::vector<double> result(X.size());
+  for (size_t i = 0; i < X.size(); ++i) {
+    result[i] = predict(X[i]);
+  }
+  return result;
+}
+
+double LinearModel::predict(const std::vector<double>& x) const {
+  double result = _coef[0];
+  for (size_t i = 0; i < x.size() && i + 1 < _coef.size(); ++i) {
+    result += _coef[i + 1] * x[i];
+  }
+  return result;
+}
+
+double TreeEnsembleModel::findLeafValue(const int& root,
+                                        const std::vector<double>& x) const {
+  int node_id = root;
+  while (_node_list[node_id].feature >= 0) {
+    const auto& node = _node_list[node_id];
+    node_id = x[node.feature] < node.threshold ? node.left : node.right;
+  }
+  return _node_list[node_id].value;
+}
+
+double TreeEnsembleModel::predict(const std::vector<double>& x) const {
+  double result = _base_score;
+  for (int root : _tree_root_list) {
+    result += findLeafValue(root, x);
+  }
+  return result;
+}
+
+std::vector<double> TreeEnsembleModel::predict(
+    const std::vector<std::vector<double>>& X) const {
+  // tree by tree, the nodes of one tree stay in cache for all samples
+  std::vector<double> result(X.size(), _base_score);
+  for (int root : _tree_root_list) {
+    for (size_t i = 0; i < X.size(); ++i) {
+      result[i] += findLeafValue(root, X[i]);
+    }
+  }
+  return result;
+}
+
 std::vector<double> ModelFactory::solvePolynomialRealRoots(
     const std::vector<double>& coeffs) const {
   int poly_order = coeffs.size() - 1;
@@ -49,15 +104,163 @@ std::vector<double> ModelFactory::cppLinearModel(
 
   return result;
 }
+/**
+ * @brief native model format, whitespace separated
+ *
+ *   icts_model linear
+ *   feature_num n
+ *   coef c_0 c_1 ... c_n
+ *
+ *   icts_model tree_ensemble
+ *   feature_num n
+ *   base_score b
+ *   tree_num t
+ *   (for each tree)
+ *   node_num k
+ *   (k lines) feature threshold left right value
+ *
+ * the child id is local in the tree, the leaf node has feature -1
+ */
+ModelBase* ModelFactory::load(const std::string& model_path) const {
+  std::ifstream ifs(model_path);
+  if (!ifs.is_open()) {
+    LOG_ERROR << "can't open model file: " << model_path;
+    return nullptr;
+  }
+  std::string key;
+  std::string model_type;
+  int feature_num = 0;
+  if (!(ifs >> key >> model_type) || key != "icts_model") {
+    // not a native model, e.g. the joblib dump
+    return nullptr;
+  }
+  auto malformed = [&](const std::string& reason) -> ModelBase* {
+    LOG_ERROR << "malformed native model " << model_path << ": " << reason;
+    return nullptr;
+  };
+  if (!(ifs >> key >> feature_num) || key != "feature_num" ||
+      feature_num <= 0) {
+    return malformed("bad feature_num");
+  }
+  if (model_type == "linear") {
+    std::vector<double> coef(feature_num + 1);
+    if (!(ifs >> key) || key != "coef") {
+      return malformed("missing coef");
+    }
+    for (auto& c : coef) {
+      if (!(ifs >> c)) {
+        return malformed("coef size is less than feature_num + 1");
+      }
+    }
+    return new LinearModel(coef);
+  }
+  if (model_type != "tree_ensemble") {
+    return malformed("unknown model type " + model_type);
+  }
+  double base_score = 0.0;
+  int tree_num = 0;
+  if (!(ifs >> key >> base_score) || key != "base_score") {
+    return malformed("bad base_score");
+  }
+  if (!(ifs >> key >> tree_num) || key != "tree_num" || tree_num < 0) {
+    return malformed("bad tree_num");
+  }
+  std::vector<int> tree_root_list;
+  std::vector<RegressionTreeNode> node_list;
+  tree_root_list.reserve(tree_num);
+  for (int i = 0; i < tree_num; ++i) {
+    int node_num = 0;
+    if (!(ifs >> key >> node_num) || key != "node_num" || node_num <= 0) {
+      return malformed("bad node_num of tree " + std::to_string(i));
+    }
+    int offset = node_list.size();
+    tree_root_list.emplace_back(offset);
+    for (int j = 0; j < node_num; ++j) {
+      RegressionTreeNode node;
+      if (!(ifs >> node.feature >> node.threshold >> node.left >> node.right >>
+            node.value)) {
+        return malformed("bad node " + std::to_string(j) + " of tree " +
+                         std::to_string(i));
+      }
+      if (node.feature >= 0) {
+        // the children must be in the same tree, and no cycle
+        if (node.feature >= feature_num || node.left <= j ||
+            node.left >= node_num || node.right <= j ||
+            node.right >= node_num) {
+          return malformed("bad split node " + std::to_string(j) +
+                           " of tree " + std::to_string(i));
+        }
+        node.left += offset;
+        node.right += offset;
+      }
+      node_list.emplace_back(node);
+    }
+  }
+  return new TreeEnsembleModel(base_score, tree_root_list, node_list);
+}
+
+/**
+ * @brief the oblivious tree of catboost checks the same split on one level,
+ * the bit of level d of the leaf index is set when x > border. It is expanded
+ * to the full binary tree, x > border goes to the right child.
+ */
+ModelBase* ModelFactory::loadCatBoostJson(const std::string& json_path) const {
+  std::ifstream ifs(json_path);
+  if (!ifs.is_open()) {
+    LOG_ERROR << "can't open model file: " << json_path;
+    return nullptr;
+  }
+  auto data = nlohmann::json::parse(ifs, nullptr, false);
+  if (data.is_discarded() || !data.contains("oblivious_trees")) {
+    LOG_ERROR << "not a catboost json model: " << json_path;
+    return nullptr;
+  }
+  double scale = 1.0;
+  double bias = 0.0;
+  if (data.contains("scale_and_bias")) {
+    const auto& scale_and_bias = data["scale_and_bias"];
+    scale = scale_and_bias[0].get<double>();
+    // the bias is a vector in the newer catboost
+    const auto& bias_value = scale_and_bias[1];
+    bias = bias_value.is_array() ? bias_value[0].get<double>()
+                                 : bias_value.get<double>();
+  }
+  std::vector<int> tree_root_list;
+  std::vector<RegressionTreeNode> node_list;
+  for (const auto& tree : data["oblivious_trees"]) {
+    const auto& splits = tree["splits"];
+    const auto& leaf_values = tree["leaf_values"];
+    std::function<int(size_t, size_t)> build = [&](size_t level,
+                                                   size_t leaf_index) -> int {
+      int node_id = node_list.size();
+      node_list.emplace_back();
+      if (level == splits.size()) {
+        node_list[node_id].value = scale * leaf_values[leaf_index].get<double>();
+        return node_id;
+      }
+      const auto& split = splits[level];
+      int left = build(level + 1, leaf_index);
+      int right = build(level + 1, leaf_index | (size_t{1} << level));
+      auto& node = node_list[node_id];
+      node.feature = split["float_feature_index"].get<int>();
+      node.threshold = std::nextafter(split["border"].get<double>(),
+                                      std::numeric_limits<double>::infinity());
+      node.left = left;
+      node.right = right;
+      return node_id;
+    };
+    tree_root_list.emplace_back(build(0, 0));
+  }
+  return new TreeEnsembleModel(bias, tree_root_list, node_list);
+}
+
 #ifdef PY_MODEL
 /**
  * @brief Python interface for timing model
  *
- * @param x (m x n)
- * @param y (n)
+ * @param x (n)
  */
-
-double ModelBase::predict(const std::vector<double>& x) const {
+double PythonModel::predict(const std::vector<double>& x) const {
   return pyPredict(x, _model);
 }
 
@@ -79,12 +282,34 @@ ModelBase* ModelFactory::pyFit(const std::vector<std::vector<double>>& x,
       model = pyLinearModel(x, y);
       break;
   }
-  return new ModelBase(model);
+  return new PythonModel(model);
+}
+
+ModelBase* ModelFactory::pyFitCatBoost(
+    const std::vector<std::vector<double>>& x,
+    const std::vector<double>& y) const {
+  auto* model = pyCatBoostModel(x, y);
+  auto json_path =
+      (std::filesystem::temp_directory_path() /
+       ("icts_catboost_" +
+        std::to_string(reinterpret_cast<std::uintptr_t>(model)) + ".json"))
+          .string();
+  auto* result =
+      PyObject_CallMethod(model, "save_model", "ss", json_path.c_str(), "json");
+  if (result == nullptr) {
+    PyErr_Print();
+    LOG_FATAL << "can't save the catboost model to " << json_path;
+  }
+  Py_DECREF(result);
+  Py_DECREF(model);
+  auto* native_model = loadCatBoostJson(json_path);
+  std::filesystem::remove(json_path);
+  return native_model;
 }
 
 ModelBase* ModelFactory::pyLoad(const std::string& model_path) const {
   auto* model = pyLoadModel(model_path);
-  return new ModelBase(model);
+  return new PythonModel(model);
 }
 #endif
 }  // namespace icts
\ No newline at end of file
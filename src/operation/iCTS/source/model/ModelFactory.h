@@ -11,30 +11,106 @@ namespace icts {
 
 enum class FitType { kLINEAR, kCATBOOST, kXGBOOST };
 
-class ModelBase : public PyToolBase {
+class ModelBase {
  public:
-#ifdef PY_MODEL
-  ModelBase(PyObject* model) {
-    PyToolBase();
-    _model = model;
-  }
+  ModelBase() = default;
+  virtual ~ModelBase() = default;
 
   /**
-   * @brief Python interface for timing model
+   * @brief predict one sample
    *
-   * @param X (m x n)
-   * @param y (n)
+   * @param x (n)
    */
-  double predict(const std::vector<double>& X) const;
+  virtual double predict(const std::vector<double>& x) const = 0;
 
-#endif
+  /**
+   * @brief predict a batch of samples
+   *
+   * @param X (m x n), one sample per row
+   * @return (m)
+   */
+  virtual std::vector<double> predict(
+      const std::vector<std::vector<double>>& X) const;
+
+  /**
+   * @brief the python model holds the GIL, so it can't be called by
+   * multiple threads
+   */
+  virtual bool isPyModel() const { return false; }
+};
+
+/**
+ * @brief native linear model, y = coef[0] + sum(coef[i + 1] * x[i])
+ */
+class LinearModel : public ModelBase {
+ public:
+  explicit LinearModel(const std::vector<double>& coef) : _coef(coef) {}
+  ~LinearModel() override = default;
+
+  using ModelBase::predict;
+  double predict(const std::vector<double>& x) const override;
+
+ private:
+  std::vector<double> _coef;
+};
+
+/**
+ * @brief node of the regression tree, the leaf node has no feature (-1)
+ *        x[feature] < threshold goes to left, otherwise goes to right
+ */
+struct RegressionTreeNode {
+  int feature = -1;
+  double threshold = 0.0;
+  int left = -1;
+  int right = -1;
+  double value = 0.0;
+};
+
+/**
+ * @brief native gradient boosted trees, y = base_score + sum(leaf value of
+ * each tree), the nodes of all trees are kept in one list
+ */
+class TreeEnsembleModel : public ModelBase {
+ public:
+  TreeEnsembleModel(const double& base_score,
+                    const std::vector<int>& tree_root_list,
+                    const std::vector<RegressionTreeNode>& node_list)
+      : _base_score(base_score),
+        _tree_root_list(tree_root_list),
+        _node_list(node_list) {}
+  ~TreeEnsembleModel() override = default;
+
+  double predict(const std::vector<double>& x) const override;
+  std::vector<double> predict(
+      const std::vector<std::vector<double>>& X) const override;
 
  private:
+  double findLeafValue(const int& root, const std::vector<double>& x) const;
+
+  double _base_score = 0.0;
+  std::vector<int> _tree_root_list;
+  std::vector<RegressionTreeNode> _node_list;
+};
+
 #ifdef PY_MODEL
+class PythonModel : public ModelBase, public PyToolBase {
+ public:
+  PythonModel(PyObject* model) : _model(model) {}
+  ~PythonModel() override = default;
+
+  using ModelBase::predict;
+  bool isPyModel() const override { return true; }
+  /**
+   * @brief Python interface for timing model
+   *
+   * @param x (n)
+   */
+  double predict(const std::vector<double>& x) const override;
 
+ private:
   PyObject* _model = NULL;
-#endif
 };
+#endif
 
 class ModelFactory : public PyToolBase {
  public:
@@ -43,6 +119,25 @@ class ModelFactory : public PyToolBase {
 
   std::vector<double> cppLinearModel(const std::vector<std::vector<double>>& x,
                                      const std::vector<double>& y) const;
+
+  /**
+   * @brief load the native model, which is exported by
+   * "python/exportModel.py"
+   *
+   * @param model_path
+   * @return nullptr if the file is not a native model, a native model which
+   * is malformed is reported as an error and also returns nullptr
+   */
+  ModelBase* load(const std::string& model_path) const;
+
+  /**
+   * @brief load the catboost model saved in json format to the native tree
+   * ensemble
+   *
+   * @param json_path
+   * @return nullptr if the file is not a catboost json model
+   */
+  ModelBase* loadCatBoostJson(const std::string& json_path) const;
 #ifdef PY_MODEL
   /**
    * @brief Python interface for timing model
@@ -53,7 +148,17 @@ class ModelFactory : public PyToolBase {
   ModelBase* pyFit(const std::vector<std::vector<double>>& X,
                    const std::vector<double>& y, const FitType& fit_type) const;
 
+  /**
+   * @brief fit the catboost model by python, and predict it by the native
+   * tree ensemble, which can be called by multiple threads
+   *
+   * @param X (m x n)
+   * @param y (n)
+   */
+  ModelBase* pyFitCatBoost(const std::vector<std::vector<double>>& X,
+                           const std::vector<double>& y) const;
+
   ModelBase* pyLoad(const std::string& model_path) const;
 #endif
 };
-}  // namespace icts
\ No newline at end of file
+}  // namespace icts
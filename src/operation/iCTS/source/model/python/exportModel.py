@@ -0,0 +1,127 @@
+# export the joblib model to the native format of icts::ModelFactory::load
+# usage: python exportModel.py <model.joblib.dat> <model.txt>
+import json
+import sys
+import tempfile
+
+import joblib
+import numpy as np
+
+
+def writeLinear(model, path):
+    coef = np.ravel(model.coef_)
+    intercept = float(np.ravel(model.intercept_)[0])
+    with open(path, 'w') as f:
+        f.write('icts_model linear\n')
+        f.write('feature_num {}\n'.format(len(coef)))
+        f.write('coef ' + ' '.join(repr(float(c))
+                for c in [intercept, *coef]) + '\n')
+
+
+def writeTrees(path, feature_num, base_score, trees):
+    # trees: list of node list, node: (feature, threshold, left, right, value)
+    with open(path, 'w') as f:
+        f.write('icts_model tree_ensemble\n')
+        f.write('feature_num {}\n'.format(feature_num))
+        f.write('base_score {}\n'.format(repr(float(base_score))))
+        f.write('tree_num {}\n'.format(len(trees)))
+        for nodes in trees:
+            f.write('node_num {}\n'.format(len(nodes)))
+            for feature, threshold, left, right, value in nodes:
+                f.write('{} {} {} {} {}\n'.format(feature, repr(float(threshold)),
+                                                  left, right, repr(float(value))))
+
+
+def parseBaseScore(base_score):
+    # newer xgboost saves the base score as a vector string, e.g. "[5E-1]"
+    return float(str(base_score).strip().strip('[]').split(',')[0])
+
+
+def parseFeature(split, feature_names):
+    # the split is "f<index>" by default, or the feature name when the model is
+    # trained with named features (e.g. a pandas DataFrame)
+    if feature_names is not None and split in feature_names:
+        return feature_names.index(split)
+    return int(str(split).lstrip('f'))
+
+
+def xgboostTrees(model):
+    booster = model.get_booster()
+    config = json.loads(booster.save_config())
+    base_score = parseBaseScore(config['learner']['learner_model_param']['base_score'])
+    feature_names = list(booster.feature_names) if booster.feature_names else None
+    trees = []
+    for dump in booster.get_dump(dump_format='json'):
+        root = json.loads(dump)
+        # breadth first, the children are always after the parent
+        order = [root]
+        index = 0
+        while index < len(order):
+            node = order[index]
+            index += 1
+            if 'children' in node:
+                children = {child['nodeid']: child for child in node['children']}
+                order.append(children[node['yes']])
+                order.append(children[node['no']])
+        local_id = {node['nodeid']: i for i, node in enumerate(order)}
+        nodes = []
+        for node in order:
+            if 'leaf' in node:
+                nodes.append((-1, 0.0, -1, -1, node['leaf']))
+            else:
+                feature = parseFeature(node['split'], feature_names)
+                nodes.append((feature, node['split_condition'], local_id[node['yes']],
+                              local_id[node['no']], 0.0))
+        trees.append(nodes)
+    return model.n_features_in_, base_score, trees
+
+
+def catboostTrees(model):
+    with tempfile.NamedTemporaryFile(suffix='.json') as tmp:
+        model.save_model(tmp.name, format='json')
+        with open(tmp.name) as f:
+            data = json.load(f)
+    scale, bias = data.get('scale_and_bias', [1.0, [0.0]])
+    bias = float(np.ravel(bias)[0])
+    trees = []
+    for tree in data['oblivious_trees']:
+        splits = tree['splits']
+        leaf_values = tree['leaf_values']
+        depth = len(splits)
+        # the oblivious tree is expanded to the full binary tree, the bit of
+        # level d is set when x > border, which goes to the right child
+        nodes = []
+
+        def build(level, leaf_index):
+            node_id = len(nodes)
+            nodes.append(None)
+            if level == depth:
+                nodes[node_id] = (-1, 0.0, -1, -1, scale * leaf_values[leaf_index])
+                return node_id
+            split = splits[level]
+            left = build(level + 1, leaf_index)
+            right = build(level + 1, leaf_index | (1 << level))
+            threshold = np.nextafter(split['border'], np.inf)
+            nodes[node_id] = (split['float_feature_index'], threshold, left, right, 0.0)
+            return node_id
+
+        build(0, 0)
+        trees.append(nodes)
+    return len(model.feature_names_), bias, trees
+
+
+def exportModel(model_path, out_path):
+    model = joblib.load(model_path)
+    name = type(model).__name__
+    if name == 'LinearRegression':
+        writeLinear(model, out_path)
+    elif name == 'XGBRegressor':
+        writeTrees(out_path, *xgboostTrees(model))
+    elif name == 'CatBoostRegressor':
+        writeTrees(out_path, *catboostTrees(model))
+    else:
+        raise TypeError('unsupported model type: ' + name)
+
+
+if __name__ == '__main__':
+    exportModel(sys.argv[1], sys.argv[2])
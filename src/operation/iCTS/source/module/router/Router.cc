@@ -31,8 +31,11 @@ void Router::normalBuild()
 void Router::slewAwareBuild()
 {
   auto* config = CTSAPIInst.get_config();
+  // the buffer libs are cached when the first timer is built, so build it before the parallel part
   auto* timer = new TimingCalculator();
 
+  std::vector<CtsNet*> clk_nets;
+  std::vector<SlewAware*> slew_awares;
   for (auto* clock : _clocks) {
     auto& clock_nets = clock->get_clock_nets();
     for (auto* clk_net : clock_nets) {
@@ -41,43 +44,74 @@ void Router::slewAwareBuild()
         continue;
       }
       clk_net->setClockRouted();
-      slewAwareRouting(clk_net);
-      // find root node
-      auto root_topo = _clk_topos.back();
-      auto* root_node = CTSAPIInst.findTimingNode(root_topo.get_driver()->get_name());
-
-      auto* clk_inst = clk_net->get_driver_inst();
-      auto* clk_node = new TimingNode(clk_inst);
-      CTSAPIInst.addTimingNode(clk_node);
-      auto slew_constraint = config->get_max_buf_tran();
-      clk_node->set_slew_constraint(slew_constraint);
-      clk_node->set_left(root_node);
-      root_node->set_parent(clk_node);
+      auto* slew_aware = new SlewAware(clk_net->get_net_name(), insts);
+      slew_aware->initSinkCap();
+      clk_nets.emplace_back(clk_net);
+      slew_awares.emplace_back(slew_aware);
+    }
+  }
+  // build the nets at the same time, each net only touch its own timing nodes
+  int thread_num = std::max(config->get_thread_num(), 1);
+#ifdef USE_EXTERNAL_MODEL
+  // the python models hold the GIL, the native models can be shared by the threads
+  if (CTSAPIInst.hasPyExternalModel()) {
+    thread_num = 1;
+  }
+#endif
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 1)
+  for (size_t i = 0; i < slew_awares.size(); ++i) {
+    slewAwareRouting(slew_awares[i]);
+  }
+  // place the buffers and merge the topos in the net order
+  for (size_t i = 0; i < slew_awares.size(); ++i) {
+    auto* clk_net = clk_nets[i];
+    auto* slew_aware = slew_awares[i];
+    slew_aware->commit();
+#ifdef TIMING_LOG
+    slew_aware->timingLog();
+#endif
+#ifdef SAVE_TRAINING_DATA
+    slew_aware->saveTrainingData();
+#endif
+    auto clk_topos = slew_aware->get_clk_topos();
+    for (auto& clk_topo : clk_topos) {
+      _clk_topos.emplace_back(clk_topo);
+    }
+    // find root node
+    auto root_topo = _clk_topos.back();
+    auto* root_node = CTSAPIInst.findTimingNode(root_topo.get_driver()->get_name());
+
+    auto* clk_inst = clk_net->get_driver_inst();
+    auto* clk_node = new TimingNode(clk_inst);
+    CTSAPIInst.addTimingNode(clk_node);
+    auto slew_constraint = config->get_max_buf_tran();
+    clk_node->set_slew_constraint(slew_constraint);
+    clk_node->set_left(root_node);
+    root_node->set_parent(clk_node);
+    root_node->set_left(nullptr);
+    root_node->set_right(nullptr);
+    if (timer->calcShortestLength(clk_node, root_node) > config->get_max_length()) {
+      timer->breakLongWire(clk_node, root_node);
+      timer->updateCap(clk_node);
+      timer->timingPropagate(clk_node);
+      auto net_name = clk_node->get_name() + "_break";
+      auto* slew_aware = new SlewAware(net_name, {});
+      // top down
+      slew_aware->topDown(clk_node);
+      // make topo
+      slew_aware->buildClockTopo(clk_node->get_left(), net_name);
+      auto break_topos = slew_aware->get_clk_topos();
+      for (auto topo : break_topos) {
+        _clk_topos.emplace_back(topo);
+      }
+      root_node = clk_node->get_left();
       root_node->set_left(nullptr);
       root_node->set_right(nullptr);
-      if (timer->calcShortestLength(clk_node, root_node) > config->get_max_length()) {
-        timer->breakLongWire(clk_node, root_node);
-        timer->updateCap(clk_node);
-        timer->timingPropagate(clk_node);
-        auto net_name = clk_node->get_name() + "_break";
-        auto* slew_aware = new SlewAware(net_name, {});
-        // top down
-        slew_aware->topDown(clk_node);
-        // make topo
-        slew_aware->buildClockTopo(clk_node->get_left(), net_name);
-        auto break_topos = slew_aware->get_clk_topos();
-        for (auto topo : break_topos) {
-          _clk_topos.emplace_back(topo);
-        }
-        root_node = clk_node->get_left();
-        root_node->set_left(nullptr);
-        root_node->set_right(nullptr);
-      }
-      timer->updateTiming(clk_node);
-      ClockTopo root_clk_topo = create_clock_topo(clk_net);
-      root_clk_topo.connect_load(root_node->get_inst());
-      _clk_topos.emplace_back(root_clk_topo);
     }
+    timer->updateTiming(clk_node);
+    ClockTopo root_clk_topo = create_clock_topo(clk_net);
+    root_clk_topo.connect_load(root_node->get_inst());
+    _clk_topos.emplace_back(root_clk_topo);
   }
 }
 
@@ -169,26 +203,10 @@ void Router::comfortRouting(CtsNet* clk_net)
   _clk_topos.emplace_back(root_clk_topo);
 }
 
-void Router::slewAwareRouting(CtsNet* clk_net)
+void Router::slewAwareRouting(SlewAware* slew_aware)
 {
-  std::string net_name = clk_net->get_net_name();
-  std::vector<CtsInstance*> insts = get_clustering_insts(clk_net);
-  if (insts.size() <= 1) {
-    return;
-  }
   // total topology
-  auto* slew_aware = new SlewAware(net_name, insts);
-  insts.size() > 3000 ? slew_aware->slewAwareByKmeans() : slew_aware->slewAware();
-#ifdef TIMING_LOG
-  slew_aware->timingLog();
-#endif
-#ifdef SAVE_TRAINING_DATA
-  slew_aware->saveTrainingData();
-#endif
-  auto clk_topos = slew_aware->get_clk_topos();
-  for (auto& clk_topo : clk_topos) {
-    _clk_topos.emplace_back(clk_topo);
-  }
+  slew_aware->_instances.size() > 3000 ? slew_aware->buildSlewAwareByKmeans() : slew_aware->buildSlewAware();
 }
 
 std::vector<CtsInstance*> Router::get_clustering_insts(CtsNet* clk_net)
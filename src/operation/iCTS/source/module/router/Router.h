@@ -182,7 +182,7 @@ class Router {
 
   void routing(CtsNet* clock_net);
   void comfortRouting(CtsNet* clock_net);
-  void slewAwareRouting(CtsNet* clock_net);
+  void slewAwareRouting(SlewAware* slew_aware);
   void clustering(vector<vector<CtsInstance*>>& clusters,
                   const vector<CtsInstance*>& insts) const;
   int calFeasibleFanout(const double& avg_wirelength) const;
@@ -1,55 +1,235 @@
 #pragma once
 
+#include <algorithm>
 #include <climits>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
 #include <vector>
 
 #include "Traits.h"
+#include "omp.h"
 #include "pgl.h"
 
 namespace icts {
 using std::pair;
 using std::vector;
-class ClusterCenter {
+
+/**
+ * @brief k-means by manhattan distance, the points and centers are kept in SoA
+ *
+ * the centers are bucketed into a uniform grid, the nearest center of a point is
+ * searched ring by ring from its cell, the result is the same as the brute force
+ * search (the smaller index wins the tie), the assignment is parallel by openmp.
+ */
+class ManhattanKmeans {
  public:
-  ClusterCenter() = default;
-  ClusterCenter(const Point& location, int count = 0)
-      : _location(location), _count(count) {}
-  ~ClusterCenter() = default;
+  ManhattanKmeans() = default;
+  ~ManhattanKmeans() = default;
 
   // getter
-  Point get_location() const { return _location; }
-  int get_count() const { return _count; }
+  int get_point_num() const { return _xs.size(); }
+  int get_center_num() const { return _center_xs.size(); }
+  const vector<int>& get_assignments() const { return _assignments; }
+  const vector<int>& get_counts() const { return _counts; }
 
   // setter
-  void set_location(const Point& location) { _location = location; }
-  void set_count(int count) { _count = count; }
+  void add_point(const int64_t& x, const int64_t& y)
+  {
+    _xs.push_back(x);
+    _ys.push_back(y);
+  }
 
-  // operator
-  void increase_count(int addend) { _count += addend; }
+  /**
+   * @brief k-means++ seeding, the weight of a point is the square of the distance to the nearest chosen center
+   */
+  void seedPlusPlus(const int& k, std::mt19937& gen)
+  {
+    int point_num = get_point_num();
+    _center_xs.clear();
+    _center_ys.clear();
+    if (point_num == 0 || k <= 0) {
+      return;
+    }
+    std::uniform_int_distribution<> dis(0, point_num - 1);
+    int first = dis(gen);
+    _center_xs.push_back(_xs[first]);
+    _center_ys.push_back(_ys[first]);
+
+    vector<double> min_dists(point_num, std::numeric_limits<double>::max());
+    vector<double> weights(point_num);
+    while (get_center_num() < k) {
+      // only the last center is new
+      int64_t cx = _center_xs.back();
+      int64_t cy = _center_ys.back();
+      double total_weight = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : total_weight) if (point_num > kParallelPointNum)
+      for (int i = 0; i < point_num; ++i) {
+        double dist = std::abs(_xs[i] - cx) + std::abs(_ys[i] - cy);
+        min_dists[i] = std::min(min_dists[i], dist);
+        weights[i] = min_dists[i] * min_dists[i];
+        total_weight += weights[i];
+      }
+      int selected = 0;
+      if (total_weight > 0.0) {
+        std::discrete_distribution<> distribution(weights.begin(), weights.end());
+        selected = distribution(gen);
+      } else {
+        selected = dis(gen);
+      }
+      _center_xs.push_back(_xs[selected]);
+      _center_ys.push_back(_ys[selected]);
+    }
+  }
 
- private:
-  Point _location;
-  int _count;
-};
+  /**
+   * @brief assign every point to the nearest center
+   */
+  void assign()
+  {
+    int point_num = get_point_num();
+    int center_num = get_center_num();
+    _assignments.assign(point_num, -1);
+    _counts.assign(center_num, 0);
+    if (center_num == 0) {
+      return;
+    }
+    buildGrid();
+#pragma omp parallel for schedule(static) if (point_num > kParallelPointNum)
+    for (int i = 0; i < point_num; ++i) {
+      _assignments[i] = findNearest(_xs[i], _ys[i]);
+    }
+    for (int i = 0; i < point_num; ++i) {
+      ++_counts[_assignments[i]];
+    }
+  }
 
-template <typename Value>
-class ClusterPoint {
- public:
-  ClusterPoint() = default;
-  ClusterPoint(Value value, int index = 0) : _value(value), _index(index) {}
-  ~ClusterPoint() = default;
+  /**
+   * @brief move every center to the rounded mean of its points, the empty center stay
+   *
+   * @return whether any center is moved
+   */
+  bool updateCenters()
+  {
+    int point_num = get_point_num();
+    int center_num = get_center_num();
+    vector<int64_t> sum_xs(center_num, 0);
+    vector<int64_t> sum_ys(center_num, 0);
+    for (int i = 0; i < point_num; ++i) {
+      sum_xs[_assignments[i]] += _xs[i];
+      sum_ys[_assignments[i]] += _ys[i];
+    }
+    bool is_update = false;
+    for (int c = 0; c < center_num; ++c) {
+      if (_counts[c] == 0) {
+        continue;
+      }
+      auto x = static_cast<int64_t>(static_cast<double>(sum_xs[c]) / _counts[c] + 0.5);
+      auto y = static_cast<int64_t>(static_cast<double>(sum_ys[c]) / _counts[c] + 0.5);
+      if (x != _center_xs[c] || y != _center_ys[c]) {
+        is_update = true;
+      }
+      _center_xs[c] = x;
+      _center_ys[c] = y;
+    }
+    return is_update;
+  }
 
-  // getter
-  Value get_value() const { return _value; }
-  int get_index() const { return _index; }
+ private:
+  static constexpr int kParallelPointNum = 4096;
+
+  void buildGrid()
+  {
+    int center_num = get_center_num();
+    auto [min_x, max_x] = std::minmax_element(_center_xs.begin(), _center_xs.end());
+    auto [min_y, max_y] = std::minmax_element(_center_ys.begin(), _center_ys.end());
+    _grid_lx = *min_x;
+    _grid_ly = *min_y;
+    _grid_nx = _grid_ny = std::max(1, static_cast<int>(std::sqrt(center_num)));
+    _cell_w = (*max_x - *min_x) / _grid_nx + 1;
+    _cell_h = (*max_y - *min_y) / _grid_ny + 1;
+    // the centers of cell i are _cell_centers[_cell_starts[i], _cell_starts[i + 1]), in index order
+    _cell_starts.assign(_grid_nx * _grid_ny + 1, 0);
+    vector<int> center_cells(center_num);
+    for (int c = 0; c < center_num; ++c) {
+      center_cells[c] = cellId(_center_xs[c], _center_ys[c]);
+      ++_cell_starts[center_cells[c] + 1];
+    }
+    for (size_t i = 1; i < _cell_starts.size(); ++i) {
+      _cell_starts[i] += _cell_starts[i - 1];
+    }
+    _cell_centers.resize(center_num);
+    vector<int> fill_pos(_cell_starts.begin(), _cell_starts.end() - 1);
+    for (int c = 0; c < center_num; ++c) {
+      _cell_centers[fill_pos[center_cells[c]]++] = c;
+    }
+  }
 
-  // setter
-  void set_value(Value value) { _value = value; }
-  void set_index(int index) { _index = index; }
+  int cellX(const int64_t& x) const { return std::clamp(static_cast<int>((x - _grid_lx) / _cell_w), 0, _grid_nx - 1); }
+  int cellY(const int64_t& y) const { return std::clamp(static_cast<int>((y - _grid_ly) / _cell_h), 0, _grid_ny - 1); }
+  int cellId(const int64_t& x, const int64_t& y) const { return cellX(x) * _grid_ny + cellY(y); }
+
+  int findNearest(const int64_t& x, const int64_t& y) const
+  {
+    int cx = cellX(x);
+    int cy = cellY(y);
+    int64_t min_cell = std::min(_cell_w, _cell_h);
+    int max_ring = std::max(_grid_nx, _grid_ny);
+    int64_t best_dist = std::numeric_limits<int64_t>::max();
+    int best_center = -1;
+    auto visit_cell = [&](int ix, int iy) {
+      if (ix < 0 || ix >= _grid_nx || iy < 0 || iy >= _grid_ny) {
+        return;
+      }
+      int cell = ix * _grid_ny + iy;
+      for (int i = _cell_starts[cell]; i < _cell_starts[cell + 1]; ++i) {
+        int c = _cell_centers[i];
+        int64_t dist = std::abs(_center_xs[c] - x) + std::abs(_center_ys[c] - y);
+        if (dist < best_dist || (dist == best_dist && c < best_center)) {
+          best_dist = dist;
+          best_center = c;
+        }
+      }
+    };
+    for (int ring = 0; ring < max_ring; ++ring) {
+      if (ring == 0) {
+        visit_cell(cx, cy);
+      } else {
+        for (int d = -ring; d <= ring; ++d) {
+          visit_cell(cx + d, cy - ring);
+          visit_cell(cx + d, cy + ring);
+        }
+        for (int d = -ring + 1; d <= ring - 1; ++d) {
+          visit_cell(cx - ring, cy + d);
+          visit_cell(cx + ring, cy + d);
+        }
+      }
+      // the centers out of this ring are at least ring * min_cell away
+      if (best_center >= 0 && best_dist < ring * min_cell) {
+        break;
+      }
+    }
+    return best_center;
+  }
 
- private:
-  Value _value;
-  int _index;
+  // points
+  vector<int64_t> _xs;
+  vector<int64_t> _ys;
+  vector<int> _assignments;
+  // centers
+  vector<int64_t> _center_xs;
+  vector<int64_t> _center_ys;
+  vector<int> _counts;
+  // grid of centers
+  int64_t _grid_lx = 0;
+  int64_t _grid_ly = 0;
+  int64_t _cell_w = 1;
+  int64_t _cell_h = 1;
+  int _grid_nx = 1;
+  int _grid_ny = 1;
+  vector<int> _cell_starts;
+  vector<int> _cell_centers;
 };
 
 template <typename Value>
@@ -66,24 +246,14 @@ class Kmeans {
  private:
   vector<vector<Value>> kmeans(const vector<Value>& points, int cluster_size,
                                int cluster_num = 0);
-  void init(const std::vector<Value>& points, int cluster_size,
-            int cluster_num = 0);
-  void partition_point();
-  void compute_center_coords(vector<pair<double, double>>& center_coords);
-  bool update_center_coords(
-      std::vector<std::pair<double, double>>& center_coords);
-  void adjust_index(ClusterPoint<Value>& cluster_point);
 
   Point get_location(const Value& val) const {
     return DataTraits<Value>::getPoint(val);
   }
 
  private:
-  vector<ClusterPoint<Value>> _cluster_points;
-  vector<ClusterCenter> _cluster_centers;
-  int _cluster_num;
-  int _cluster_size;
-  int _size_upper_bound;
+  int _size_upper_bound = 0;
+  int _max_iterations = 300;
 };
 
 template <typename Value>
@@ -108,22 +278,30 @@ vector<vector<Value>> Kmeans<Value>::operator()(const vector<Value>& points,
 template <typename Value>
 vector<vector<Value>> Kmeans<Value>::kmeans(const vector<Value>& points,
                                             int cluster_size, int cluster_num) {
-  init(points, cluster_size, cluster_num);
-  bool stop_flag = true;
-  while (stop_flag) {
-    partition_point();
-
-    vector<pair<double, double>> center_coords(_cluster_num);
-    compute_center_coords(center_coords);
+  int points_num = points.size();
+  int center_num = cluster_num == 0
+                       ? (points_num + cluster_size - 1) / cluster_size
+                       : cluster_num;
+  _size_upper_bound = cluster_size * 3;
 
-    stop_flag = update_center_coords(center_coords);
+  ManhattanKmeans solver;
+  for (auto& point : points) {
+    auto location = get_location(point);
+    solver.add_point(location.x(), location.y());
+  }
+  std::mt19937 gen(0);
+  solver.seedPlusPlus(center_num, gen);
+  for (int i = 0; i < _max_iterations; ++i) {
+    solver.assign();
+    if (!solver.updateCenters()) {
+      break;
+    }
   }
 
-  vector<vector<Value>> clusters(_cluster_num);
-  for (auto& cluster_point : _cluster_points) {
-    auto index = cluster_point.get_index();
-    auto value = cluster_point.get_value();
-    clusters[index].push_back(value);
+  vector<vector<Value>> clusters(solver.get_center_num());
+  auto& assignments = solver.get_assignments();
+  for (int i = 0; i < points_num; ++i) {
+    clusters[assignments[i]].push_back(points[i]);
   }
 
   auto remove_rule = [](auto& cluster) { return cluster.size() == 0; };
@@ -133,109 +311,4 @@ vector<vector<Value>> Kmeans<Value>::kmeans(const vector<Value>& points,
   return clusters;
 }
 
-template <typename Value>
-void Kmeans<Value>::init(const std::vector<Value>& points, int cluster_size,
-                         int cluster_num) {
-  _cluster_centers.clear();
-  _cluster_points.clear();
-
-  int points_num = points.size();
-  _cluster_num = cluster_num == 0
-                     ? (points_num + cluster_size - 1) / cluster_size
-                     : cluster_num;
-  _cluster_size = cluster_size;
-  _size_upper_bound = cluster_size * 3;
-  // auto setp = points_num / _cluster_num;
-  // set initial center point according to input data
-  for (int i = 0; i < _cluster_num; ++i) {
-    auto point = points[i * cluster_size];
-    auto center = get_location(point);
-    _cluster_centers.emplace_back(ClusterCenter(center));
-  }
-
-  for (auto point : points) {
-    _cluster_points.emplace_back(ClusterPoint<Value>(point));
-  }
-}
-
-template <typename Value>
-void Kmeans<Value>::partition_point() {
-  // clear cluster
-  for (auto& cluster : _cluster_centers) {
-    cluster.set_count(0);
-  }
-
-  // partiotion
-  // #pragma omp parallel for
-  for (auto& cluster_point : _cluster_points) {
-    auto cur_loc = get_location(cluster_point.get_value());
-
-    auto itr = std::min_element(
-        _cluster_centers.begin(), _cluster_centers.end(),
-        [&cur_loc](const auto& center_point1, const auto& conter_point2) {
-          return pgl::manhattan_distance(center_point1.get_location(),
-                                         cur_loc) <
-                 pgl::manhattan_distance(conter_point2.get_location(), cur_loc);
-        });
-    auto center_index = itr - _cluster_centers.begin();
-    cluster_point.set_index(center_index);
-
-    // #pragma omp critical
-    _cluster_centers[center_index].increase_count(1);
-  }
-}
-
-template <typename Value>
-void Kmeans<Value>::compute_center_coords(
-    vector<pair<double, double>>& center_coords) {
-  for (auto& cluster_point : _cluster_points) {
-    auto index = cluster_point.get_index();
-    auto location = get_location(cluster_point.get_value());
-    double coord_x = location.x();
-    double coord_y = location.y();
-
-    auto count = _cluster_centers[index].get_count();
-    center_coords[index].first += coord_x / count;
-    center_coords[index].second += coord_y / count;
-  }
-}
-
-template <typename Value>
-bool Kmeans<Value>::update_center_coords(
-    vector<pair<double, double>>& center_coords) {
-  bool is_update = false;
-  for (int idx = 0; idx < _cluster_num; ++idx) {
-    int coord_x = static_cast<int>(center_coords[idx].first + 0.5);
-    int coord_y = static_cast<int>(center_coords[idx].second + 0.5);
-
-    auto& cluster_center = _cluster_centers[idx];
-    auto center_location = cluster_center.get_location();
-
-    if (coord_x != center_location.x() || coord_y != center_location.y()) {
-      is_update = true;
-    }
-    _cluster_centers[idx].set_location(Point(coord_x, coord_y));
-  }
-  return is_update;
-}
-
-template <typename Value>
-void Kmeans<Value>::adjust_index(ClusterPoint<Value>& cluster_point) {
-  auto index = cluster_point.get_index();
-  auto cur_location = get_location(cluster_point.get_value());
-
-  double min_dist = INT_MAX;
-  for (int i = 0; i < _cluster_size; ++i) {
-    if (i == index) {
-      continue;
-    }
-    auto center_location = _cluster_centers[i].get_location();
-    auto dist = manhattan_distance(cur_location, center_location);
-    if (dist < min_dist) {
-      min_dist = dist;
-      cluster_point.set_index(i);
-    }
-  }
-}
-
-}  // namespace icts
\ No newline at end of file
+}  // namespace icts
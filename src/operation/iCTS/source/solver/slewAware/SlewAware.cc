@@ -91,12 +91,28 @@ TimingNode* SlewAware::slewAwareBase(std::vector<TimingNode*>& timing_nodes, Tim
 
 void SlewAware::slewAware()
 {
+  buildSlewAware();
+  commit();
+}
+
+void SlewAware::slewAwareByKmeans()
+{
+  buildSlewAwareByKmeans();
+  commit();
+}
+
+void SlewAware::slewAwareByBiCluster()
+{
+  buildSlewAwareByBiCluster();
+  commit();
+}
+
+void SlewAware::buildSlewAware()
+{
+  _log_title = "[Slew Aware]";
   LOG_INFO << "#################### [Slew Aware] ####################";
   LOG_INFO << "[Slew Aware] build net: " << _net_name;
   LOG_INFO << "[Slew Aware] Flip-Flops num: " << _instances.size();
-  CTSAPIInst.saveToLog("#################### [Slew Aware] ####################");
-  CTSAPIInst.saveToLog("[Slew Aware] build net: ", _net_name);
-  CTSAPIInst.saveToLog("[Slew Aware] Flip-Flops num: ", _instances.size());
   auto* config = CTSAPIInst.get_config();
   // init timing nodes
   auto max_sink_tran = config->get_max_sink_tran();
@@ -104,7 +120,7 @@ void SlewAware::slewAware()
   for (auto* inst : _instances) {
     auto* node = new TimingNode(inst);
     node->set_slew_constraint(max_sink_tran);
-    node->set_cap_out(CTSAPIInst.getSinkCap(inst));
+    node->set_cap_out(getSinkCap(inst));
     node->set_type(TimingNodeType::kSink);
     timing_nodes.emplace_back(node);
   }
@@ -123,25 +139,15 @@ void SlewAware::slewAware()
   LOG_INFO << "[Slew Aware] Root Max delay: " << root->get_delay_max();
   LOG_INFO << "[Slew Aware] Root Min delay: " << root->get_delay_min();
   LOG_INFO << "[Slew Aware] Root skew: " << root->get_delay_max() - root->get_delay_min();
-  CTSAPIInst.saveToLog("[Slew Aware] Root Max delay: ", root->get_delay_max());
-  CTSAPIInst.saveToLog("[Slew Aware] Root Min delay: ", root->get_delay_min());
-  CTSAPIInst.saveToLog("[Slew Aware] Root skew: ", root->get_delay_max() - root->get_delay_min());
-  // top-down set instance
-  topDown(root);
-  // build cts topo
-  buildClockTopo(root, _net_name);
-  LOG_INFO << "[Slew Aware] Insert Buffer num: " << _clock_topos.size();
-  CTSAPIInst.saveToLog("[Slew Aware] Insert Buffer num: ", _clock_topos.size());
+  _root = root;
 }
 
-void SlewAware::slewAwareByKmeans()
+void SlewAware::buildSlewAwareByKmeans()
 {
+  _log_title = "[Slew Aware By Kmeans]";
   LOG_INFO << "############### [Slew Aware By Kmeans] ###############";
   LOG_INFO << "[Slew Aware By Kmeans] build net: " << _net_name;
   LOG_INFO << "[Slew Aware By Kmeans] Flip-Flops num: " << _instances.size();
-  CTSAPIInst.saveToLog("############### [Slew Aware By Kmeans] ###############");
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] build net: ", _net_name);
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] Flip-Flops num: ", _instances.size());
   auto* config = CTSAPIInst.get_config();
   // init timing nodes
   auto max_sink_tran = config->get_max_sink_tran();
@@ -157,7 +163,7 @@ void SlewAware::slewAwareByKmeans()
     for (auto* inst : sinks) {
       auto* node = new TimingNode(inst);
       node->set_slew_constraint(max_sink_tran);
-      node->set_cap_out(CTSAPIInst.getSinkCap(inst));
+      node->set_cap_out(getSinkCap(inst));
       node->set_type(TimingNodeType::kSink);
       timing_nodes.emplace_back(node);
     }
@@ -193,25 +199,15 @@ void SlewAware::slewAwareByKmeans()
   LOG_INFO << "[Slew Aware By Kmeans] Root Max delay: " << root->get_delay_max();
   LOG_INFO << "[Slew Aware By Kmeans] Root Min delay: " << root->get_delay_min();
   LOG_INFO << "[Slew Aware By Kmeans] Root skew: " << root->get_delay_max() - root->get_delay_min();
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] Root Max delay: ", root->get_delay_max());
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] Root Min delay: ", root->get_delay_min());
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] Root skew: ", root->get_delay_max() - root->get_delay_min());
-  // top-down set instance
-  topDown(root);
-  // build cts topo
-  buildClockTopo(root, _net_name);
-  LOG_INFO << "[Slew Aware By Kmeans] Insert Buffer num: " << _clock_topos.size();
-  CTSAPIInst.saveToLog("[Slew Aware By Kmeans] Insert Buffer num: ", _clock_topos.size());
+  _root = root;
 }
 
-void SlewAware::slewAwareByBiCluster()
+void SlewAware::buildSlewAwareByBiCluster()
 {
+  _log_title = "[Slew Aware By Bi-Cluster]";
   LOG_INFO << "############# [Slew Aware By Bi-Cluster] #############";
   LOG_INFO << "[Slew Aware By Bi-Cluster] build net: " << _net_name;
   LOG_INFO << "[Slew Aware By Bi-Cluster] Flip-Flops num: " << _instances.size();
-  CTSAPIInst.saveToLog("############# [Slew Aware By Bi-Cluster] #############");
-  CTSAPIInst.saveToLog("[Slew Aware By Bi-Cluster] build net: ", _net_name);
-  CTSAPIInst.saveToLog("[Slew Aware By Bi-Cluster] Flip-Flops num: ", _instances.size());
 
   auto* config = CTSAPIInst.get_config();
   auto* timer = genTimer();
@@ -226,12 +222,45 @@ void SlewAware::slewAwareByBiCluster()
     timer->updateTiming(root);
     timer->fixTiming(root);
   }
+  _root = root;
+}
+
+void SlewAware::commit()
+{
+  if (_root == nullptr) {
+    return;
+  }
+  auto banner = std::string((52 - _log_title.size()) / 2, '#');
+  CTSAPIInst.saveToLog(banner, " ", _log_title, " ", banner);
+  CTSAPIInst.saveToLog(_log_title, " build net: ", _net_name);
+  CTSAPIInst.saveToLog(_log_title, " Flip-Flops num: ", _instances.size());
+  CTSAPIInst.saveToLog(_log_title, " Root Max delay: ", _root->get_delay_max());
+  CTSAPIInst.saveToLog(_log_title, " Root Min delay: ", _root->get_delay_min());
+  CTSAPIInst.saveToLog(_log_title, " Root skew: ", _root->get_delay_max() - _root->get_delay_min());
+  // renumber the nodes in the net order, same as the serial build
+  renumber(_root);
   // top-down set instance
-  topDown(root);
+  topDown(_root);
   // build cts topo
-  buildClockTopo(root, _net_name);
-  LOG_INFO << "[Slew Aware By Bi-Cluster] Insert Buffer num: " << _clock_topos.size();
-  CTSAPIInst.saveToLog("[Slew Aware By Bi-Cluster] Insert Buffer num: ", _clock_topos.size());
+  buildClockTopo(_root, _net_name);
+  LOG_INFO << _log_title << " Insert Buffer num: " << _clock_topos.size();
+  CTSAPIInst.saveToLog(_log_title, " Insert Buffer num: ", _clock_topos.size());
+}
+
+void SlewAware::initSinkCap()
+{
+  for (auto* inst : _instances) {
+    _sink_cap_map[inst] = CTSAPIInst.getSinkCap(inst);
+  }
+}
+
+double SlewAware::getSinkCap(CtsInstance* inst) const
+{
+  auto itr = _sink_cap_map.find(inst);
+  if (itr != _sink_cap_map.end()) {
+    return itr->second;
+  }
+  return CTSAPIInst.getSinkCap(inst);
 }
 
 void SlewAware::recursiveMerge(TimingNode* root, TimingCalculator* timer)
@@ -290,6 +319,16 @@ void SlewAware::topDown(TimingNode* root)
   topDown(right);
 }
 
+void SlewAware::renumber(TimingNode* root)
+{
+  if (root == nullptr) {
+    return;
+  }
+  root->set_id(CTSAPIInst.genId());
+  renumber(root->get_left());
+  renumber(root->get_right());
+}
+
 void SlewAware::buildClockTopo(TimingNode* root, const std::string& net_name)
 {
   // step1: find all drivers
@@ -417,7 +456,7 @@ TimingNode* SlewAware::biCluster(const std::vector<CtsInstance*>& insts)
     auto* node = new TimingNode(insts[0]);
     auto* config = CTSAPIInst.get_config();
     auto max_sink_tran = config->get_max_sink_tran();
-    auto sink_cap = CTSAPIInst.getSinkCap(insts[0]);
+    auto sink_cap = getSinkCap(insts[0]);
     node->set_type(TimingNodeType::kSink);
     node->set_slew_constraint(max_sink_tran);
     node->set_cap_out(sink_cap);
@@ -436,57 +475,28 @@ TimingNode* SlewAware::biCluster(const std::vector<CtsInstance*>& insts)
 
 vector<vector<CtsInstance*>> SlewAware::manhattanKmeans(const vector<CtsInstance*>& instances, const int& k, const int& max_iterations)
 {
-  std::vector<CtsPoint<int64_t>> centers;
   int num_instances = instances.size();
-  std::vector<int> assignments(num_instances);
-
-  // Randomly choose first center from instances
-  // std::random_device rd;
-  // std::mt19937 gen(rd());
+  ManhattanKmeans solver;
+  for (auto* inst : instances) {
+    auto location = inst->get_location();
+    solver.add_point(location.x(), location.y());
+  }
+  // Choose k centers using kmeans++ algorithm
   std::mt19937::result_type seed = 0;
   std::mt19937 gen(seed);
-  std::uniform_int_distribution<> dis(0, num_instances - 1);
-  centers.push_back(instances[dis(gen)]->get_location());
-  // Choose k-1 remaining centers using kmeans++ algorithm
-  while (static_cast<int>(centers.size()) < k) {
-    std::vector<double> distances(num_instances, std::numeric_limits<double>::max());
-    for (int i = 0; i < num_instances; i++) {
-      CtsPoint<int64_t> instance_location = instances[i]->get_location();
-      double min_distance = std::numeric_limits<double>::max();
-      for (size_t j = 0; j < centers.size(); j++) {
-        double distance = pgl::manhattan_distance(instance_location, centers[j]);
-        min_distance = std::min(min_distance, distance);
-      }
-      distances[i] = min_distance * min_distance;  // square distance
-    }
-
-    std::discrete_distribution<> distribution(distances.begin(), distances.end());
-    int selected_index = distribution(gen);
-    centers.emplace_back(instances[selected_index]->get_location());
-  }
+  solver.seedPlusPlus(k, gen);
 
   int num_iterations = 0;
   double prev_cap_variance = std::numeric_limits<double>::max();
   while (num_iterations++ < max_iterations) {
     // Assignment step
-    for (int i = 0; i < num_instances; i++) {
-      CtsPoint<int64_t> instance_location = instances[i]->get_location();
-      double min_distance = std::numeric_limits<double>::max();
-      int min_center_index = -1;
-      for (size_t j = 0; j < centers.size(); j++) {
-        double distance = pgl::manhattan_distance(instance_location, centers[j]);
-        if (distance < min_distance) {
-          min_distance = distance;
-          min_center_index = j;
-        }
-      }
-      assignments[i] = min_center_index;
-    }
+    solver.assign();
+    auto& assignments = solver.get_assignments();
     // Check cap variance
     std::vector<double> cluster_cap(k, 0);
     for (int i = 0; i < num_instances; i++) {
       int center_index = assignments[i];
-      cluster_cap[center_index] += CTSAPIInst.getSinkCap(instances[i]);
+      cluster_cap[center_index] += getSinkCap(instances[i]);
     }
     double sum = std::accumulate(std::begin(cluster_cap), std::end(cluster_cap), 0.0);
     double mean = sum / cluster_cap.size();
@@ -499,23 +509,11 @@ vector<vector<CtsInstance*>> SlewAware::manhattanKmeans(const vector<CtsInstance
     }
     prev_cap_variance = std::min(prev_cap_variance, cap_variance);
     // Update step
-    std::vector<CtsPoint<int64_t>> new_centers(k, CtsPoint<int64_t>(0, 0));
-    std::vector<int> center_counts(k, 0);
-    for (int i = 0; i < num_instances; i++) {
-      Point instance_location = instances[i]->get_location();
-      int center_index = assignments[i];
-      new_centers[center_index] += instance_location;
-      center_counts[center_index]++;
-    }
-    for (int i = 0; i < k; i++) {
-      if (center_counts[i] > 0) {
-        new_centers[i] /= center_counts[i];
-      }
-    }
-    centers = new_centers;
+    solver.updateCenters();
   }
   // Collect results
   std::vector<std::vector<CtsInstance*>> clusters(k);
+  auto& assignments = solver.get_assignments();
   for (int i = 0; i < num_instances; i++) {
     int center_index = assignments[i];
     clusters[center_index].push_back(instances[i]);
@@ -536,7 +534,7 @@ TimingNode* SlewAware::findTimingNode(const std::string& buffer_name)
 TimingCalculator* SlewAware::genTimer() const
 {
   auto* timer = new TimingCalculator();
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   timer->set_external_model(CTSAPIInst.findExternalModel(_net_name));
 #endif
   return timer;
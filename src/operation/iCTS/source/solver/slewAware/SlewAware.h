@@ -3,6 +3,7 @@
  * @author Dawn Li (dawnli619215645@gmail.com)
  */
 #pragma once
+#include <map>
 #include <span>
 #include <vector>
 
@@ -31,8 +32,24 @@ class SlewAware {
 
   void slewAwareByBiCluster();
 
+  // bottom-up build only touch the nodes of this net, so different nets can be
+  // built at the same time, the shared design is updated by commit in order
+  void buildSlewAware();
+
+  void buildSlewAwareByKmeans();
+
+  void buildSlewAwareByBiCluster();
+
+  void commit();
+
+  void initSinkCap();
+
+  double getSinkCap(CtsInstance *inst) const;
+
   std::vector<ClockTopo> get_clk_topos() const { return _clock_topos; }
 
+  TimingNode *get_root() const { return _root; }
+
   TimingNode *findTimingNode(const std::string &buffer_name);
 
   TimingCalculator *genTimer() const;
@@ -52,6 +69,9 @@ class SlewAware {
 
   void topDown(TimingNode *root);
 
+  // the ids drawn by the threads depend on the schedule, renumber in commit
+  void renumber(TimingNode *root);
+
   void buildClockTopo(TimingNode *root, const std::string &net_name);
 
   ClockTopo makeTopo(TimingNode *root, const std::string &net_name);
@@ -71,6 +91,9 @@ class SlewAware {
   std::vector<CtsInstance *> _instances;
   std::vector<ClockTopo> _clock_topos;
   std::map<std::string, TimingNode *> _timing_node_map;
+  std::map<CtsInstance *, double> _sink_cap_map;
+  TimingNode *_root = nullptr;
+  std::string _log_title;
 };
 template <>
 struct DataTraits<CtsInstance *> {
@@ -1188,7 +1188,7 @@ void TimingCalculator::breakLongWire(TimingNode* s, TimingNode* t) const
 
 double TimingCalculator::predictSlewIn(TimingNode* k) const
 {
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   // predict slew in and find lib to set insertion delay
   if (_external_model) {
     std::vector<double> x_type;
@@ -1228,7 +1228,7 @@ double TimingCalculator::predictSlewIn(TimingNode* k) const
 
 double TimingCalculator::predictInsertDelay(TimingNode* k, CtsCellLib* lib) const
 {
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   // predict slew in and find lib to set insertion delay
   if (_external_model && k->get_level() < 10) {
     auto slew_in = predictSlewIn(k);
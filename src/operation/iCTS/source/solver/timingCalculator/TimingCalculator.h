@@ -197,7 +197,7 @@ class TimingCalculator
   ~TimingCalculator() = default;
 
   void set_skew_bound(const double& skew_bound) { _skew_bound = skew_bound; }
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   void set_external_model(ModelBase* external_model) { _external_model = external_model; }
 #endif
 
@@ -355,7 +355,7 @@ class TimingCalculator
   double _max_length = 0;
   double _min_insert_delay = 0.0;
   std::vector<icts::CtsCellLib*> _delay_libs;
-#if (defined PY_MODEL) && (defined USE_EXTERNAL_MODEL)
+#ifdef USE_EXTERNAL_MODEL
   ModelBase* _external_model = nullptr;
 #endif
 };
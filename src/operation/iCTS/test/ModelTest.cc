@@ -0,0 +1,158 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "log/Log.hh"
+#include "model/ModelFactory.h"
+
+using ieda::Log;
+
+namespace {
+
+class ModelTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+
+ protected:
+  std::string writeModel(const std::string& name, const std::string& content) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::ofstream ofs(path);
+    ofs << content;
+    return path.string();
+  }
+};
+
+TEST_F(ModelTest, LoadLinearModel) {
+  LOG_INFO << "build ModelTest for load native linear model";
+  auto* model_factory = new icts::ModelFactory();
+
+  auto path = writeModel("icts_linear_model.txt",
+                         "icts_model linear\n"
+                         "feature_num 2\n"
+                         "coef 0.5 1.0 2.0\n");
+  auto* linear_model = model_factory->load(path);
+  ASSERT_NE(linear_model, nullptr);
+  EXPECT_DOUBLE_EQ(linear_model->predict({1, 2}), 5.5);
+  EXPECT_FALSE(linear_model->isPyModel());
+
+  delete linear_model;
+  delete model_factory;
+}
+
+TEST_F(ModelTest, LoadTreeEnsembleModel) {
+  LOG_INFO << "build ModelTest for load native tree ensemble model";
+  auto* model_factory = new icts::ModelFactory();
+
+  // the format written by python/exportModel.py: one split tree and one leaf
+  auto path = writeModel("icts_tree_model.txt",
+                         "icts_model tree_ensemble\n"
+                         "feature_num 2\n"
+                         "base_score 0.5\n"
+                         "tree_num 2\n"
+                         "node_num 3\n"
+                         "1 0.5 1 2 0.0\n"
+                         "-1 0.0 -1 -1 1.0\n"
+                         "-1 0.0 -1 -1 2.0\n"
+                         "node_num 1\n"
+                         "-1 0.0 -1 -1 0.25\n");
+  auto* tree_model = model_factory->load(path);
+  ASSERT_NE(tree_model, nullptr);
+  EXPECT_DOUBLE_EQ(tree_model->predict({3, 0.2}), 1.75);
+  EXPECT_DOUBLE_EQ(tree_model->predict({3, 0.5}), 2.75);
+  EXPECT_DOUBLE_EQ(tree_model->predict({3, 0.8}), 2.75);
+
+  delete tree_model;
+  delete model_factory;
+}
+
+TEST_F(ModelTest, LoadCatBoostJsonModel) {
+  LOG_INFO << "build ModelTest for load catboost json model";
+  auto* model_factory = new icts::ModelFactory();
+
+  // one oblivious tree of depth 1 and one tree of depth 0, x > border goes
+  // to the right child
+  auto path = writeModel("icts_catboost_model.json",
+                         R"({"oblivious_trees": [)"
+                         R"({"splits": [{"border": 0.5, "float_feature_index": 1,)"
+                         R"( "split_type": "FloatFeature"}],)"
+                         R"( "leaf_values": [1.0, 2.0]},)"
+                         R"({"splits": [], "leaf_values": [0.25]}],)"
+                         R"( "scale_and_bias": [1.0, [0.5]]})");
+  auto* catboost_model = model_factory->load(path);
+  EXPECT_EQ(catboost_model, nullptr);
+  catboost_model = model_factory->loadCatBoostJson(path);
+  ASSERT_NE(catboost_model, nullptr);
+  EXPECT_DOUBLE_EQ(catboost_model->predict({3, 0.2}), 1.75);
+  EXPECT_DOUBLE_EQ(catboost_model->predict({3, 0.5}), 1.75);
+  EXPECT_DOUBLE_EQ(catboost_model->predict({3, 0.8}), 2.75);
+
+  auto other_path = writeModel("icts_other_model.json", "{}");
+  EXPECT_EQ(model_factory->loadCatBoostJson(other_path), nullptr);
+
+  delete catboost_model;
+  delete model_factory;
+}
+
+TEST_F(ModelTest, BatchPredict) {
+  LOG_INFO << "build ModelTest for batch predict of native models";
+  auto* model_factory = new icts::ModelFactory();
+
+  auto linear_path = writeModel("icts_batch_linear_model.txt",
+                                "icts_model linear\n"
+                                "feature_num 2\n"
+                                "coef 0.5 1.0 2.0\n");
+  auto tree_path = writeModel("icts_batch_tree_model.txt",
+                              "icts_model tree_ensemble\n"
+                              "feature_num 2\n"
+                              "base_score 0.5\n"
+                              "tree_num 2\n"
+                              "node_num 3\n"
+                              "1 0.5 1 2 0.0\n"
+                              "-1 0.0 -1 -1 1.0\n"
+                              "-1 0.0 -1 -1 2.0\n"
+                              "node_num 1\n"
+                              "-1 0.0 -1 -1 0.25\n");
+  std::vector<std::vector<double>> X = {{1, 2}, {3, 0.2}, {3, 0.8}};
+  for (const auto& path : {linear_path, tree_path}) {
+    auto* model = model_factory->load(path);
+    ASSERT_NE(model, nullptr);
+    // the batch result is the same as predicting the samples one by one
+    auto batch_result = model->predict(X);
+    ASSERT_EQ(batch_result.size(), X.size());
+    for (size_t i = 0; i < X.size(); ++i) {
+      EXPECT_DOUBLE_EQ(batch_result[i], model->predict(X[i]));
+    }
+    delete model;
+  }
+  delete model_factory;
+}
+
+TEST_F(ModelTest, LoadInvalidModel) {
+  LOG_INFO << "build ModelTest for load invalid model";
+  auto* model_factory = new icts::ModelFactory();
+
+  // not a native model, e.g. the joblib dump
+  auto other_path = writeModel("icts_other_model.txt", "joblib\n");
+  EXPECT_EQ(model_factory->load(other_path), nullptr);
+
+  // the child of the split node is out of the tree
+  auto bad_path = writeModel("icts_bad_model.txt",
+                             "icts_model tree_ensemble\n"
+                             "feature_num 1\n"
+                             "base_score 0.0\n"
+                             "tree_num 1\n"
+                             "node_num 2\n"
+                             "0 0.5 1 2 0.0\n"
+                             "-1 0.0 -1 -1 1.0\n");
+  EXPECT_EQ(model_factory->load(bad_path), nullptr);
+
+  delete model_factory;
+}
+
+}  // namespace
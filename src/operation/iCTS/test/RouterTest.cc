@@ -0,0 +1,61 @@
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "CTSAPI.hpp"
+#include "Router.h"
+#include "gtest/gtest.h"
+#include "idm.h"
+#include "log/Log.hh"
+
+using ieda::Log;
+
+namespace {
+
+class RouterTest : public testing::Test {
+  void SetUp() {
+    char config[] = "test";
+    char* argv[] = {config};
+    Log::init(argv);
+    // Read Def, Lef
+    std::string idb_json_file = "<local_path>/db_default_config.json";
+    dmInst->init(idb_json_file);
+  }
+  void TearDown() { Log::end(); }
+
+ protected:
+  using NodeInfo = std::tuple<std::string, int, int, int, double, double>;
+
+  std::vector<NodeInfo> slewAwareBuild(int thread_num) {
+    std::string cts_json_file = "<local_path>/cts_default_config.json";
+    CTSAPIInst.init(cts_json_file);
+    CTSAPIInst.get_config()->set_thread_num(thread_num);
+    CTSAPIInst.readData();
+
+    icts::Router router;
+    router.init();
+    router.slewAwareBuild();
+
+    std::vector<NodeInfo> node_infos;
+    for (auto* node : CTSAPIInst.get_design()->get_timing_nodes()) {
+      auto loc = node->get_location();
+      node_infos.emplace_back(node->get_name(), node->get_id(), loc.x(),
+                              loc.y(), node->get_delay_min(),
+                              node->get_delay_max());
+    }
+    return node_infos;
+  }
+};
+
+TEST_F(RouterTest, ParallelSlewAwareBuild) {
+  LOG_INFO << "build RouterTest for parallel slew aware build";
+  auto serial_infos = slewAwareBuild(1);
+  auto parallel_infos = slewAwareBuild(8);
+
+  ASSERT_EQ(serial_infos.size(), parallel_infos.size());
+  for (size_t i = 0; i < serial_infos.size(); ++i) {
+    EXPECT_EQ(serial_infos[i], parallel_infos[i]);
+  }
+}
+
+}  // namespace
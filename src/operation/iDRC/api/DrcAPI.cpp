@@ -119,6 +119,9 @@ void DrcAPI::add(std::vector<ids::DRCTask> task_list)
     region_query->getIntersectPoly(intersect_poly_set, drc_rect_list);
     // 删除与这组rect相交的所有polygon
     region_query->deleteIntersectPoly(intersect_poly_set);
+    for (DrcPoly* poly : intersect_poly_set) {
+      region_query->eraseObjectViolationBuffer(poly);
+    }
 
     DrcPoly* new_poly = region_query->rebuildPoly_add(intersect_poly_set, drc_rect_list);
     if (new_poly) {
@@ -175,57 +178,75 @@ bool DrcAPI::checkSpacing(RegionQuery* region_query, DrcRect* check_rect)
   std::vector<std::pair<RTreeSegment, DrcEdge*>> edge_query_result;
   int layer_id = check_rect->get_layer_id();
 
-  region_query->queryEdgeInRoutingLayer(layer_id, DRCUtil::getRTreeBox(check_rect), edge_query_result);
-  region_query->queryInRoutingLayer(layer_id, DRCUtil::getRTreeBox(check_rect), rect_query_result);
-  std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>> max_scope_query_result;
-  region_query->queryInMaxScope(layer_id, DRCUtil::getRTreeBox(check_rect), max_scope_query_result);
-  std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>> min_scope_query_result;
-  region_query->queryInMinScope(layer_id, DRCUtil::getRTreeBox(check_rect), min_scope_query_result);
+  RTreeBox check_box = DRCUtil::getRTreeBox(check_rect);
+
+  region_query->queryEdgeInRoutingLayer(layer_id, check_box, edge_query_result);
+  region_query->queryInRoutingLayer(layer_id, check_box, rect_query_result);
 
-  // 排除与poly相交，rect直接query 出edge和rect，移除掉同一net的，不同net的直接报短路违例，再把这些edge、rect从min和max中移除
+  // 排除与poly相交，rect直接query 出edge和rect，不同net的直接报短路违例，同一net的edge、rect作为scope owner在min和max中排除
+  std::set<void*> exclude_owner_set;
   for (auto [rtree_seg, edge] : edge_query_result) {
-    min_scope_query_result.erase(edge);
-    max_scope_query_result.erase(edge);
     if (edge->get_owner_polygon()->getNetId() != check_rect->get_net_id()) {
       return false;
     }
+    exclude_owner_set.insert(edge);
   }
   for (auto [rtree_box, rect] : rect_query_result) {
-    min_scope_query_result.erase(rect);
-    max_scope_query_result.erase(rect);
     if (rect->get_net_id() != check_rect->get_net_id()) {
       return false;
     }
+    exclude_owner_set.insert(rect);
   }
-  bool intersect_with_min_scope = !min_scope_query_result.empty();
-  bool intersect_with_max_scope = !max_scope_query_result.empty();
+  // min scope只需判断是否存在，遇到第一个即停止
+  bool intersect_with_min_scope = false;
+  region_query->visitInMinScope(layer_id, check_box, [&](DrcRect* scope) {
+    if (exclude_owner_set.contains(scope->get_scope_owner())) {
+      return true;
+    }
+    intersect_with_min_scope = true;
+    return false;
+  });
   if (intersect_with_min_scope) {
     return false;
-  } else if (intersect_with_max_scope) {
-    for (auto [target, scope_type_set] : max_scope_query_result) {
-      if (scope_type_set.contains(ScopeType::EOL)) {
-        EOLSpacingCheck* eol_spacing_check = new EOLSpacingCheck(_tech, region_query);
-        if (!eol_spacing_check->check(target, check_rect)) {
-          delete eol_spacing_check;
-          return false;
-        }
+  }
+  std::vector<std::pair<void*, ScopeType>> max_scope_list;
+  region_query->visitInMaxScope(layer_id, check_box, [&](DrcRect* scope) {
+    if (!exclude_owner_set.contains(scope->get_scope_owner())) {
+      max_scope_list.emplace_back(scope->get_scope_owner(), scope->getScopeType());
+    }
+    return true;
+  });
+  if (max_scope_list.empty()) {
+    // 以rect为主体查，融合为poly，过程同读def的检查流程
+    return checkSpacing_rect(check_rect, region_query);
+  }
+  std::sort(max_scope_list.begin(), max_scope_list.end());
+  max_scope_list.erase(std::unique(max_scope_list.begin(), max_scope_list.end()), max_scope_list.end());
+  for (size_t i = 0; i < max_scope_list.size();) {
+    void* target = max_scope_list[i].first;
+    std::set<ScopeType> scope_type_set;
+    for (; i < max_scope_list.size() && max_scope_list[i].first == target; ++i) {
+      scope_type_set.insert(max_scope_list[i].second);
+    }
+    if (scope_type_set.contains(ScopeType::EOL)) {
+      EOLSpacingCheck* eol_spacing_check = new EOLSpacingCheck(_tech, region_query);
+      if (!eol_spacing_check->check(target, check_rect)) {
         delete eol_spacing_check;
-      }
-      if (scope_type_set.contains(ScopeType::CornerFill)) {
         return false;
       }
-      if (scope_type_set.contains(ScopeType::Common)) {
-        RoutingSpacingCheck* routing_spacing_check = new RoutingSpacingCheck(_tech, region_query);
-        if (!routing_spacing_check->check(target, check_rect)) {
-          delete routing_spacing_check;
-          return false;
-        }
+      delete eol_spacing_check;
+    }
+    if (scope_type_set.contains(ScopeType::CornerFill)) {
+      return false;
+    }
+    if (scope_type_set.contains(ScopeType::Common)) {
+      RoutingSpacingCheck* routing_spacing_check = new RoutingSpacingCheck(_tech, region_query);
+      if (!routing_spacing_check->check(target, check_rect)) {
         delete routing_spacing_check;
+        return false;
       }
+      delete routing_spacing_check;
     }
-  } else {
-    // 以rect为主体查，融合为poly，过程同读def的检查流程
-    return checkSpacing_rect(check_rect, region_query);
   }
   return true;
 }
@@ -290,16 +311,340 @@ void DrcAPI::del(std::vector<ids::DRCTask> task_list)
     std::set<DrcPoly*> intersect_poly_set;
     region_query->getIntersectPoly(intersect_poly_set, drc_rect_list);
     region_query->deleteIntersectPoly(intersect_poly_set);
+    for (DrcPoly* poly : intersect_poly_set) {
+      region_query->eraseObjectViolationBuffer(poly);
+    }
     auto new_poly_list = region_query->rebuildPoly_del(intersect_poly_set, drc_rect_list);
     if (!new_poly_list.empty()) {
       region_query->addPolyList(new_poly_list);
     }
     for (auto& drc_rect : drc_rect_list) {
+      region_query->eraseObjectViolationBuffer(drc_rect);
       region_query->removeDrcRect(drc_rect);
     }
   }
 }
 
+/**
+ * @brief 对region_query中已有的全部矩形与多边形做一次检查，违规按对象分别记录，作为增量检查的基准
+ *
+ * @param region_query 增量检查会话
+ */
+void DrcAPI::initIncrementalCheck(RegionQuery* region_query)
+{
+  region_query->clearObjectViolationBuffer();
+  DrcCheckModuleGroup check_module_group = createCheckModuleGroup(region_query);
+  for (DrcRect* routing_rect : region_query->getRoutingRectSet()) {
+    region_query->setObjectViolationBuffer(region_query->getObjectKey(routing_rect),
+                                           checkIncrementalObject(region_query, check_module_group, routing_rect));
+  }
+  for (DrcRect* cut_rect : region_query->getCutRectSet()) {
+    region_query->setObjectViolationBuffer(region_query->getObjectKey(cut_rect),
+                                           checkIncrementalObject(region_query, check_module_group, cut_rect));
+  }
+  for (auto& [net_id, layer_to_polys_map] : region_query->getRegionPolysMap()) {
+    for (auto& [layer_id, poly_set] : layer_to_polys_map) {
+      for (DrcPoly* poly : poly_set) {
+        region_query->setObjectViolationBuffer(region_query->getObjectKey(poly),
+                                               checkIncrementalObject(region_query, check_module_group, poly));
+      }
+    }
+  }
+  deleteCheckModuleGroup(check_module_group);
+}
+
+/**
+ * @brief 增删一批矩形，只重新检查规则影响范围与变化矩形相交的对象，返回这些对象违规的增减
+ *
+ * @param add_task_list 新增的矩形
+ * @param del_task_list 删除的矩形
+ * @return DrcViolationDiff
+ */
+DrcViolationDiff DrcAPI::updateIncrementalCheck(std::vector<ids::DRCTask> add_task_list, std::vector<ids::DRCTask> del_task_list)
+{
+  std::map<RegionQuery*, std::vector<std::pair<DrcRect*, RTreeBox>>> check_box_map;
+  for (std::vector<ids::DRCTask>* task_list : {&add_task_list, &del_task_list}) {
+    for (auto& [region_query, drc_rect_list] : *task_list) {
+      for (DrcRect* drc_rect : drc_rect_list) {
+        check_box_map[region_query].emplace_back(drc_rect, getIncrementalCheckBox(drc_rect));
+      }
+    }
+  }
+  // 变化前，取出受影响对象的违规；矩形对违规会同时记录在两个对象中，在整个更新范围内去重后计数
+  std::map<std::tuple<ViolationType, int, int, int, int, int>, DrcViolationSpot> old_spot_map;
+  std::map<ViolationType, int> old_count_map;
+  std::map<ViolationType, std::set<std::pair<DrcRect*, DrcRect*>>> old_rect_pair_map;
+  for (auto& [region_query, check_box_list] : check_box_map) {
+    std::set<DrcRect*> routing_rect_set;
+    std::set<DrcRect*> cut_rect_set;
+    std::set<DrcPoly*> poly_set;
+    getIncrementalCheckObject(region_query, check_box_list, routing_rect_set, cut_rect_set, poly_set);
+    std::vector<std::pair<int, int>> object_key_list;
+    for (std::set<DrcRect*>* rect_set : {&routing_rect_set, &cut_rect_set}) {
+      for (DrcRect* drc_rect : *rect_set) {
+        object_key_list.push_back(region_query->getObjectKey(drc_rect));
+      }
+    }
+    for (DrcPoly* poly : poly_set) {
+      object_key_list.push_back(region_query->getObjectKey(poly));
+    }
+    for (std::pair<int, int>& object_key : object_key_list) {
+      DrcViolationBuffer* buffer = region_query->popObjectViolationBuffer(object_key);
+      if (buffer == nullptr) {
+        continue;
+      }
+      getViolationSpotMap(buffer, old_spot_map);
+      getViolationCountMap(buffer, old_count_map, old_rect_pair_map);
+      region_query->deleteViolationBuffer(buffer);
+    }
+  }
+  del(del_task_list);
+  add(add_task_list);
+  // 变化后，重新检查受影响的对象
+  std::map<std::tuple<ViolationType, int, int, int, int, int>, DrcViolationSpot> new_spot_map;
+  std::map<ViolationType, int> new_count_map;
+  std::map<ViolationType, std::set<std::pair<DrcRect*, DrcRect*>>> new_rect_pair_map;
+  for (auto& [region_query, check_box_list] : check_box_map) {
+    std::set<DrcRect*> routing_rect_set;
+    std::set<DrcRect*> cut_rect_set;
+    std::set<DrcPoly*> poly_set;
+    getIncrementalCheckObject(region_query, check_box_list, routing_rect_set, cut_rect_set, poly_set);
+    DrcCheckModuleGroup check_module_group = createCheckModuleGroup(region_query);
+    std::vector<std::pair<std::pair<int, int>, DrcViolationBuffer*>> object_buffer_list;
+    for (std::set<DrcRect*>* rect_set : {&routing_rect_set, &cut_rect_set}) {
+      for (DrcRect* drc_rect : *rect_set) {
+        object_buffer_list.emplace_back(region_query->getObjectKey(drc_rect),
+                                        checkIncrementalObject(region_query, check_module_group, drc_rect));
+      }
+    }
+    for (DrcPoly* poly : poly_set) {
+      object_buffer_list.emplace_back(region_query->getObjectKey(poly), checkIncrementalObject(region_query, check_module_group, poly));
+    }
+    deleteCheckModuleGroup(check_module_group);
+    for (auto& [object_key, buffer] : object_buffer_list) {
+      getViolationSpotMap(buffer, new_spot_map);
+      getViolationCountMap(buffer, new_count_map, new_rect_pair_map);
+      region_query->setObjectViolationBuffer(object_key, buffer);
+    }
+  }
+
+  DrcViolationDiff violation_diff;
+  for (auto& [spot_key, spot] : new_spot_map) {
+    if (!old_spot_map.contains(spot_key)) {
+      violation_diff.added_spot_list.push_back(spot);
+    }
+  }
+  for (auto& [spot_key, spot] : old_spot_map) {
+    if (!new_spot_map.contains(spot_key)) {
+      violation_diff.removed_spot_list.push_back(spot);
+    }
+  }
+  for (auto& [vio_type, count] : new_count_map) {
+    violation_diff.count_diff_map[vio_type] += count;
+  }
+  for (auto& [vio_type, rect_pair_set] : new_rect_pair_map) {
+    violation_diff.count_diff_map[vio_type] += static_cast<int>(rect_pair_set.size());
+  }
+  for (auto& [vio_type, count] : old_count_map) {
+    violation_diff.count_diff_map[vio_type] -= count;
+  }
+  for (auto& [vio_type, rect_pair_set] : old_rect_pair_map) {
+    violation_diff.count_diff_map[vio_type] -= static_cast<int>(rect_pair_set.size());
+  }
+  return violation_diff;
+}
+
+void DrcAPI::clearIncrementalCheck(RegionQuery* region_query)
+{
+  region_query->clearObjectViolationBuffer();
+}
+
+DrcCheckModuleGroup DrcAPI::createCheckModuleGroup(RegionQuery* region_query)
+{
+  DrcCheckModuleGroup check_module_group;
+  check_module_group.notch_spacing_check = new NotchSpacingCheck(_tech, region_query);
+  check_module_group.min_step_check = new MinStepCheck(_tech, region_query);
+  check_module_group.corner_fill_spacing_check = new CornerFillSpacingCheck(_tech, region_query);
+  check_module_group.cut_eol_spacing_check = new CutEolSpacingCheck(_tech, region_query);
+  check_module_group.routing_sapcing_check = new RoutingSpacingCheck(_tech, region_query);
+  check_module_group.eol_spacing_check = new EOLSpacingCheck(_tech, region_query);
+  check_module_group.routing_area_check = new RoutingAreaCheck(_tech, region_query);
+  check_module_group.routing_width_check = new RoutingWidthCheck(_tech, region_query);
+  check_module_group.cut_spacing_check = new CutSpacingCheck(_tech, region_query);
+  check_module_group.enclosure_check = new EnclosureCheck(_tech, region_query);
+  return check_module_group;
+}
+
+void DrcAPI::deleteCheckModuleGroup(DrcCheckModuleGroup& check_module_group)
+{
+  delete check_module_group.notch_spacing_check;
+  delete check_module_group.min_step_check;
+  delete check_module_group.corner_fill_spacing_check;
+  delete check_module_group.cut_eol_spacing_check;
+  delete check_module_group.routing_sapcing_check;
+  delete check_module_group.eol_spacing_check;
+  delete check_module_group.routing_area_check;
+  delete check_module_group.routing_width_check;
+  delete check_module_group.cut_spacing_check;
+  delete check_module_group.enclosure_check;
+  check_module_group = DrcCheckModuleGroup();
+}
+
+/**
+ * @brief 矩形外扩其所在层的最大规则距离，范围内的对象可能受该矩形影响
+ *
+ * @param drc_rect
+ * @return RTreeBox
+ */
+RTreeBox DrcAPI::getIncrementalCheckBox(DrcRect* drc_rect)
+{
+  int layer_id = drc_rect->get_layer_id();
+  int spacing = 0;
+  if (drc_rect->get_owner_type() == RectOwnerType::kViaCut) {
+    spacing = std::max(_tech->getCutSpacing(layer_id), 0);
+  } else {
+    spacing = std::max(_tech->getRoutingMaxRequireSpacing(layer_id, drc_rect), 0);
+  }
+  RTreePoint left_bottom(drc_rect->get_left() - spacing, drc_rect->get_bottom() - spacing);
+  RTreePoint right_top(drc_rect->get_right() + spacing, drc_rect->get_top() + spacing);
+  return RTreeBox(left_bottom, right_top);
+}
+
+/**
+ * @brief 得到需要重新检查的对象
+ * 金属矩形影响同层的金属矩形与多边形，以及上下两层cut(cut层Id与其上层金属相同)的enclosure；cut矩形影响本层与相邻cut层
+ *
+ */
+void DrcAPI::getIncrementalCheckObject(RegionQuery* region_query, std::vector<std::pair<DrcRect*, RTreeBox>>& check_box_list,
+                                       std::set<DrcRect*>& routing_rect_set, std::set<DrcRect*>& cut_rect_set,
+                                       std::set<DrcPoly*>& poly_set)
+{
+  std::vector<std::pair<RTreeBox, DrcRect*>> cut_query_result;
+  for (auto& [drc_rect, check_box] : check_box_list) {
+    int layer_id = drc_rect->get_layer_id();
+    if (drc_rect->get_owner_type() == RectOwnerType::kViaCut) {
+      for (int cut_layer_id = layer_id - 1; cut_layer_id <= layer_id + 1; ++cut_layer_id) {
+        region_query->queryInCutLayer(cut_layer_id, check_box, cut_query_result);
+      }
+      continue;
+    }
+    std::vector<std::pair<RTreeBox, DrcRect*>> rect_query_result;
+    region_query->queryInRoutingLayer(layer_id, check_box, rect_query_result);
+    for (auto& [rtree_box, result_rect] : rect_query_result) {
+      // pin与blockage不作为检查对象
+      if (region_query->getRoutingRectSet().contains(result_rect)) {
+        routing_rect_set.insert(result_rect);
+      }
+    }
+    std::vector<std::pair<RTreeSegment, DrcEdge*>> edge_query_result;
+    region_query->queryEdgeInRoutingLayer(layer_id, check_box, edge_query_result);
+    for (auto& [rtree_seg, edge] : edge_query_result) {
+      poly_set.insert(edge->get_owner_polygon());
+    }
+    region_query->queryInCutLayer(layer_id, check_box, cut_query_result);
+    region_query->queryInCutLayer(layer_id + 1, check_box, cut_query_result);
+  }
+  for (auto& [rtree_box, result_rect] : cut_query_result) {
+    cut_rect_set.insert(result_rect);
+  }
+}
+
+DrcViolationBuffer* DrcAPI::checkIncrementalObject(RegionQuery* region_query, DrcCheckModuleGroup& check_module_group, DrcRect* drc_rect)
+{
+  DrcViolationBuffer* buffer = new DrcViolationBuffer();
+  region_query->bindCaptureBuffer(buffer);
+  if (drc_rect->get_owner_type() == RectOwnerType::kViaCut) {
+    check_module_group.cut_eol_spacing_check->check(drc_rect);
+    check_module_group.cut_spacing_check->check(drc_rect);
+    check_module_group.enclosure_check->check(drc_rect);
+  } else {
+    check_module_group.routing_sapcing_check->check(drc_rect);
+    check_module_group.routing_width_check->check(drc_rect);
+  }
+  region_query->bindCaptureBuffer(nullptr);
+  return buffer;
+}
+
+DrcViolationBuffer* DrcAPI::checkIncrementalObject(RegionQuery* region_query, DrcCheckModuleGroup& check_module_group, DrcPoly* poly)
+{
+  DrcViolationBuffer* buffer = new DrcViolationBuffer();
+  region_query->bindCaptureBuffer(buffer);
+  check_module_group.eol_spacing_check->check(poly);
+  check_module_group.notch_spacing_check->check(poly);
+  check_module_group.min_step_check->check(poly);
+  check_module_group.routing_area_check->check(poly);
+  check_module_group.corner_fill_spacing_check->check(poly);
+  region_query->bindCaptureBuffer(nullptr);
+  return buffer;
+}
+
+/**
+ * @brief 把buffer中的违规转为Spot，以违规类型、层与违规区域为键去重
+ *
+ */
+void DrcAPI::getViolationSpotMap(DrcViolationBuffer* buffer,
+                                 std::map<std::tuple<ViolationType, int, int, int, int, int>, DrcViolationSpot>& spot_map)
+{
+  auto add_spot = [&](DrcViolationSpot& spot) {
+    spot_map.emplace(std::make_tuple(spot.get_violation_type(), spot.get_layer_id(), spot.get_min_x(), spot.get_min_y(), spot.get_max_x(),
+                                     spot.get_max_y()),
+                     spot);
+  };
+  auto add_span_box = [&](ViolationType vio_type, int layer_id, const RTreeBox& span_box) {
+    DrcViolationSpot spot;
+    spot.set_vio_type(vio_type);
+    spot.set_layer_id(layer_id);
+    if (isCutViolation(vio_type)) {
+      spot.set_layer_name(_tech->getCutLayerNameById(layer_id));
+    } else {
+      spot.set_layer_name(_tech->getRoutingLayerNameById(layer_id));
+    }
+    spot.setCoordinate(span_box.min_corner().x(), span_box.min_corner().y(), span_box.max_corner().x(), span_box.max_corner().y());
+    add_spot(spot);
+  };
+  for (auto& [vio_type, rect_pair_violation_list] : buffer->rect_pair_violation_map) {
+    for (DrcViolationBuffer::RectPairViolation& rect_pair_violation : rect_pair_violation_list) {
+      if (rect_pair_violation.spot != nullptr) {
+        add_spot(*rect_pair_violation.spot);
+      }
+      if (rect_pair_violation.has_span_box) {
+        add_span_box(vio_type, rect_pair_violation.layer_id, rect_pair_violation.span_box);
+      }
+    }
+  }
+  for (auto& [vio_type, span_box_list] : buffer->span_box_violation_map) {
+    for (auto& [layer_id, span_box] : span_box_list) {
+      add_span_box(vio_type, layer_id, span_box);
+    }
+  }
+  for (DrcViolationSpot* spot : buffer->spot_list) {
+    add_spot(*spot);
+  }
+}
+
+bool DrcAPI::isCutViolation(ViolationType vio_type)
+{
+  return vio_type == ViolationType::kCutSpacing || vio_type == ViolationType::kCutEOLSpacing
+         || vio_type == ViolationType::kCutDiffLayerSpacing || vio_type == ViolationType::kCutShort;
+}
+
+/**
+ * @brief 统计buffer中的违规计数，矩形对违规收集到rect_pair_map中，由调用方在整个更新范围内去重后计数
+ *
+ */
+void DrcAPI::getViolationCountMap(DrcViolationBuffer* buffer, std::map<ViolationType, int>& count_map,
+                                  std::map<ViolationType, std::set<std::pair<DrcRect*, DrcRect*>>>& rect_pair_map)
+{
+  for (auto& [vio_type, count] : buffer->violation_count_map) {
+    count_map[vio_type] += count;
+  }
+  for (auto& [vio_type, rect_pair_violation_list] : buffer->rect_pair_violation_map) {
+    for (DrcViolationBuffer::RectPairViolation& rect_pair_violation : rect_pair_violation_list) {
+      rect_pair_map[vio_type].insert(rect_pair_violation.rect_pair);
+    }
+  }
+}
+
 // RegionQuery* DrcAPI::createRTree(ids::DRCEnv env)
 // {
 //   RegionQuery* region_query = new RegionQuery();
@@ -505,6 +850,7 @@ RTreeBox DrcAPI::getRTreeBox(DrcRect* rect)
 
 void DrcAPI::initRegionQuery(std::vector<DrcRect*> origin_rect_list, RegionQuery* region_query)
 {
+  region_query->startBulkLoad();
   for (auto& drc_rect : origin_rect_list) {
     int layer_id = drc_rect->get_layer_id();
     if (drc_rect->get_owner_type() == RectOwnerType::kViaCut) {
@@ -513,6 +859,7 @@ void DrcAPI::initRegionQuery(std::vector<DrcRect*> origin_rect_list, RegionQuery
       region_query->add_routing_rect_to_rtree(layer_id, drc_rect);
     }
   }
+  region_query->finishBulkLoad();
 }
 
 void DrcAPI::initPolyEdges(DrcNet* net, RegionQuery* region_query)
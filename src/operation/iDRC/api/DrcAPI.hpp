@@ -1,10 +1,15 @@
 #pragma once
 
+#include <map>
+#include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "../../../database/interaction/ids.hpp"
 #include "DRC.h"
 #include "DrcEnum.h"
+#include "DrcViolationSpot.h"
 
 namespace idrc {
 
@@ -29,6 +34,19 @@ class SpotParser;
 class MultiPatterning;
 class DrcConflictGraph;
 class EOLSpacingCheck;
+struct DrcViolationBuffer;
+
+/**
+ * @brief 增量检查中变化区域内违规的增减
+ *
+ */
+struct DrcViolationDiff
+{
+  std::vector<DrcViolationSpot> added_spot_list;
+  std::vector<DrcViolationSpot> removed_spot_list;
+  // 各违规类型计数的变化，包含不生成Spot的违规类型
+  std::map<ViolationType, int> count_diff_map;
+};
 
 #define DrcAPIInst DrcAPI::getInst()
 class DrcAPI
@@ -50,6 +68,10 @@ class DrcAPI
   void add(std::vector<ids::DRCTask> task_list);
   void del(std::vector<ids::DRCTask> task_list);
   std::map<std::string, int> getCheckResult(RegionQuery* region_query);
+  // 增量检查：region_query作为持久的检查会话，init时检查全部对象，update时只重新检查变化区域附近的对象
+  void initIncrementalCheck(RegionQuery* region_query);
+  DrcViolationDiff updateIncrementalCheck(std::vector<ids::DRCTask> add_task_list, std::vector<ids::DRCTask> del_task_list);
+  void clearIncrementalCheck(RegionQuery* region_query);
 
   std::map<std::string, int> getCheckResult();
   std::map<std::string, std::vector<DrcViolationSpot*>> getDetailCheckResult();
@@ -103,6 +125,20 @@ class DrcAPI
   void queryInMaxScope(DrcRect* check_rect, std::map<void*, std::set<ScopeType>>& max_scope_query_result);
   bool checkSpacing_rect(DrcRect* check_rect, RegionQuery* region_query);
   void mergeRectToPoly(DrcRect* check_rect, RegionQuery* region_query, DrcPoly* poly);
+
+  // incremental check
+  DrcCheckModuleGroup createCheckModuleGroup(RegionQuery* region_query);
+  void deleteCheckModuleGroup(DrcCheckModuleGroup& check_module_group);
+  RTreeBox getIncrementalCheckBox(DrcRect* drc_rect);
+  void getIncrementalCheckObject(RegionQuery* region_query, std::vector<std::pair<DrcRect*, RTreeBox>>& check_box_list,
+                                 std::set<DrcRect*>& routing_rect_set, std::set<DrcRect*>& cut_rect_set, std::set<DrcPoly*>& poly_set);
+  DrcViolationBuffer* checkIncrementalObject(RegionQuery* region_query, DrcCheckModuleGroup& check_module_group, DrcRect* drc_rect);
+  DrcViolationBuffer* checkIncrementalObject(RegionQuery* region_query, DrcCheckModuleGroup& check_module_group, DrcPoly* poly);
+  void getViolationSpotMap(DrcViolationBuffer* buffer,
+                           std::map<std::tuple<ViolationType, int, int, int, int, int>, DrcViolationSpot>& spot_map);
+  void getViolationCountMap(DrcViolationBuffer* buffer, std::map<ViolationType, int>& count_map,
+                            std::map<ViolationType, std::set<std::pair<DrcRect*, DrcRect*>>>& rect_pair_map);
+  bool isCutViolation(ViolationType vio_type);
 };
 
 }  // namespace idrc
@@ -25,6 +25,7 @@
 #include "SpotParser.h"
 #include "Tech.h"
 #include "idm.h"
+#include "omp.h"
 
 namespace idrc {
 DRC* DRC::_drc_instance = nullptr;
@@ -266,9 +267,28 @@ void DRC::update()
 /**
  * @brief 遍历每一条Net运行各个设计规则检查模块对每一条Net进行设计规则检查
  *
+ * @param thread_num 线程数目，大于1时并行检查
  */
-void DRC::run()
+void DRC::run(int thread_num)
 {
+  if (thread_num > 1) {
+    runParallel(thread_num);
+    return;
+  }
+  DrcCheckModuleGroup check_module_group;
+  check_module_group.jog_spacing_check = _jog_spacing_check;
+  check_module_group.notch_spacing_check = _notch_spacing_check;
+  check_module_group.min_step_check = _min_step_check;
+  check_module_group.corner_fill_spacing_check = _corner_fill_spacing_check;
+  check_module_group.cut_eol_spacing_check = _cut_eol_spacing_check;
+  check_module_group.routing_sapcing_check = _routing_sapcing_check;
+  check_module_group.eol_spacing_check = _eol_spacing_check;
+  check_module_group.routing_area_check = _routing_area_check;
+  check_module_group.routing_width_check = _routing_width_check;
+  check_module_group.cut_spacing_check = _cut_spacing_check;
+  check_module_group.enclosed_area_check = _enclosed_area_check;
+  check_module_group.enclosure_check = _enclosure_check;
+
   int index = 0;
   for (auto& drc_net : _drc_design->get_drc_net_list()) {
     if (index++ % 1000 == 0) {
@@ -277,29 +297,7 @@ void DRC::run()
     if (index++ % 100000 == 0) {
       std::cout << std::endl;
     }
-    _routing_sapcing_check->checkRoutingSpacing(drc_net);
-
-    _routing_width_check->checkRoutingWidth(drc_net);
-
-    _routing_area_check->checkArea(drc_net);
-
-    _enclosed_area_check->checkEnclosedArea(drc_net);
-
-    _cut_spacing_check->checkCutSpacing(drc_net);
-
-    _enclosure_check->checkEnclosure(drc_net);
-
-    _eol_spacing_check->checkEOLSpacing(drc_net);
-
-    _notch_spacing_check->checkNotchSpacing(drc_net);
-
-    _min_step_check->checkMinStep(drc_net);
-
-    _corner_fill_spacing_check->checkCornerFillSpacing(drc_net);
-
-    _cut_eol_spacing_check->checkCutEolSpacing(drc_net);
-    // cout << "CutEol" << timeEnd - timeStart << std::endl;
-    _jog_spacing_check->checkJogSpacing(drc_net);
+    checkDrcNet(drc_net, check_module_group);
   }
   // if (_conflict_graph != nullptr) {
   // }
@@ -381,6 +379,128 @@ void DRC::clearRoutingShapesInDrcNetList()
   }
 }
 
+/**
+ * @brief 按Net分片并行检查，每个线程使用独立的检查模块，违规先写入每条Net的buffer，
+ *        检查结束后按Net顺序合并去重，结果与串行检查一致
+ *
+ * @param thread_num 线程数目
+ */
+void DRC::runParallel(int thread_num)
+{
+  std::vector<DrcNet*>& drc_net_list = _drc_design->get_drc_net_list();
+  int net_num = static_cast<int>(drc_net_list.size());
+
+  std::vector<DrcCheckModuleGroup> check_module_group_list;
+  for (int i = 0; i < thread_num; i++) {
+    check_module_group_list.push_back(createCheckModuleGroup());
+  }
+  _region_query->initViolationBuffer(net_num, thread_num);
+
+  int checked_net_num = 0;
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 16)
+  for (int i = 0; i < net_num; i++) {
+    _region_query->bindViolationBuffer(i);
+    checkDrcNet(drc_net_list[i], check_module_group_list[omp_get_thread_num()]);
+#pragma omp critical(drc_progress)
+    {
+      if (++checked_net_num % 1000 == 0) {
+        std::cout << "-" << std::flush;
+      }
+    }
+  }
+  std::cout << std::endl;
+
+  _region_query->mergeViolationBuffer();
+  for (DrcCheckModuleGroup& check_module_group : check_module_group_list) {
+    mergeCheckModuleSpot(check_module_group);
+    deleteCheckModuleGroup(check_module_group);
+  }
+}
+
+/**
+ * @brief 把线程检查模块中记录的宽度与面积Spot并入共享的检查模块，计数与去重已在RegionQuery的合并中完成
+ *
+ * @param check_module_group 线程的检查模块
+ */
+void DRC::mergeCheckModuleSpot(DrcCheckModuleGroup& check_module_group)
+{
+  auto merge_spots_map = [](std::map<int, std::vector<DrcSpot>>& from_map, std::map<int, std::vector<DrcSpot>>& to_map) {
+    for (auto& [layer_id, spot_list] : from_map) {
+      std::vector<DrcSpot>& to_spot_list = to_map[layer_id];
+      to_spot_list.insert(to_spot_list.end(), spot_list.begin(), spot_list.end());
+    }
+    from_map.clear();
+  };
+  merge_spots_map(check_module_group.routing_width_check->get_routing_layer_to_spots_map(),
+                  _routing_width_check->get_routing_layer_to_spots_map());
+  merge_spots_map(check_module_group.routing_area_check->get_routing_layer_to_spots_map(),
+                  _routing_area_check->get_routing_layer_to_spots_map());
+  merge_spots_map(check_module_group.enclosed_area_check->get_routing_layer_to_spots_map(),
+                  _enclosed_area_check->get_routing_layer_to_spots_map());
+}
+
+DrcCheckModuleGroup DRC::createCheckModuleGroup()
+{
+  DrcCheckModuleGroup check_module_group;
+  check_module_group.jog_spacing_check = new JogSpacingCheck(_tech, _region_query);
+  check_module_group.notch_spacing_check = new NotchSpacingCheck(_tech, _region_query);
+  check_module_group.min_step_check = new MinStepCheck(_tech, _region_query);
+  check_module_group.corner_fill_spacing_check = new CornerFillSpacingCheck(_tech, _region_query);
+  check_module_group.cut_eol_spacing_check = new CutEolSpacingCheck(_tech, _region_query);
+  check_module_group.routing_sapcing_check = new RoutingSpacingCheck(_tech, _region_query);
+  check_module_group.eol_spacing_check = new EOLSpacingCheck(_tech, _region_query);
+  check_module_group.routing_area_check = new RoutingAreaCheck(_tech, _region_query);
+  check_module_group.routing_width_check = new RoutingWidthCheck(_tech, _region_query);
+  check_module_group.enclosed_area_check = new EnclosedAreaCheck(_tech, _region_query);
+  check_module_group.cut_spacing_check = new CutSpacingCheck(_tech, _region_query);
+  check_module_group.enclosure_check = new EnclosureCheck(_tech, _region_query);
+  return check_module_group;
+}
+
+void DRC::deleteCheckModuleGroup(DrcCheckModuleGroup& check_module_group)
+{
+  delete check_module_group.jog_spacing_check;
+  delete check_module_group.notch_spacing_check;
+  delete check_module_group.min_step_check;
+  delete check_module_group.corner_fill_spacing_check;
+  delete check_module_group.cut_eol_spacing_check;
+  delete check_module_group.routing_sapcing_check;
+  delete check_module_group.eol_spacing_check;
+  delete check_module_group.routing_area_check;
+  delete check_module_group.routing_width_check;
+  delete check_module_group.enclosed_area_check;
+  delete check_module_group.cut_spacing_check;
+  delete check_module_group.enclosure_check;
+  check_module_group = DrcCheckModuleGroup();
+}
+
+void DRC::checkDrcNet(DrcNet* drc_net, DrcCheckModuleGroup& check_module_group)
+{
+  check_module_group.routing_sapcing_check->checkRoutingSpacing(drc_net);
+
+  check_module_group.routing_width_check->checkRoutingWidth(drc_net);
+
+  check_module_group.routing_area_check->checkArea(drc_net);
+
+  check_module_group.enclosed_area_check->checkEnclosedArea(drc_net);
+
+  check_module_group.cut_spacing_check->checkCutSpacing(drc_net);
+
+  check_module_group.enclosure_check->checkEnclosure(drc_net);
+
+  check_module_group.eol_spacing_check->checkEOLSpacing(drc_net);
+
+  check_module_group.notch_spacing_check->checkNotchSpacing(drc_net);
+
+  check_module_group.min_step_check->checkMinStep(drc_net);
+
+  check_module_group.corner_fill_spacing_check->checkCornerFillSpacing(drc_net);
+
+  check_module_group.cut_eol_spacing_check->checkCutEolSpacing(drc_net);
+
+  check_module_group.jog_spacing_check->checkJogSpacing(drc_net);
+}
+
 // void DRC::checkMultipatterning(int check_colorable_num)
 // {
 //   _multi_patterning->set_conflict_graph(_conflict_graph);
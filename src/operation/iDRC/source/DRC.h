@@ -41,6 +41,23 @@ class DrcViolationSpot;
 
 #define DrcInst (idrc::DRC::getInst())
 
+// 一组设计规则检查模块，并行检查时每个线程各用一组
+struct DrcCheckModuleGroup
+{
+  JogSpacingCheck* jog_spacing_check = nullptr;
+  NotchSpacingCheck* notch_spacing_check = nullptr;
+  MinStepCheck* min_step_check = nullptr;
+  CornerFillSpacingCheck* corner_fill_spacing_check = nullptr;
+  CutEolSpacingCheck* cut_eol_spacing_check = nullptr;
+  RoutingSpacingCheck* routing_sapcing_check = nullptr;
+  EOLSpacingCheck* eol_spacing_check = nullptr;
+  RoutingAreaCheck* routing_area_check = nullptr;
+  RoutingWidthCheck* routing_width_check = nullptr;
+  CutSpacingCheck* cut_spacing_check = nullptr;
+  EnclosedAreaCheck* enclosed_area_check = nullptr;
+  EnclosureCheck* enclosure_check = nullptr;
+};
+
 class DRC
 {
  public:
@@ -68,8 +85,8 @@ class DRC
   void update();
   //初始化各个设计规则检查模块
   void initCheckModule();
-  //运行各个设计规则检查模块
-  void run();
+  //运行各个设计规则检查模块，thread_num大于1时按Net分片并行检查
+  void run(int thread_num = 1);
   //以文件的形式报告设计规则违规
   void report();
   std::map<std::string, int> getDrcResult();
@@ -144,6 +161,11 @@ class DRC
   // function
 
   void clearRoutingShapesInDrcNetList();
+  void runParallel(int thread_num);
+  DrcCheckModuleGroup createCheckModuleGroup();
+  void deleteCheckModuleGroup(DrcCheckModuleGroup& check_module_group);
+  void mergeCheckModuleSpot(DrcCheckModuleGroup& check_module_group);
+  void checkDrcNet(DrcNet* drc_net, DrcCheckModuleGroup& check_module_group);
 
   // void addSegmentToDrcPolygon(const BoostSegment& segment, DrcPolygon* polygon);
   // void initNetMergePolyEdgeOuter(DrcPolygon* polygon, std::set<int>& x_value_list, std::set<int>& y_value_list);
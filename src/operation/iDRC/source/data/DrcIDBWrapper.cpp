@@ -50,9 +50,12 @@ void DrcIDBWrapper::initIDB(idb::IdbBuilder* db_builder)
 
 void DrcIDBWrapper::wrapDesign()
 {
+  // wrap过程中只插入不查询，矩形先缓存再批量构建R树
+  _region_query->startBulkLoad();
   wrapNetList();
   wrapBlockageList();
   wrapNetPolyList();
+  _region_query->finishBulkLoad();
 }
 
 void DrcIDBWrapper::wrap()
@@ -61,9 +64,11 @@ void DrcIDBWrapper::wrap()
   wrapRoutingLayerList();
   wrapCutLayerList();
   wrapViaLib();
+  _region_query->startBulkLoad();
   wrapNetList();
   wrapBlockageList();
   wrapNetPolyList();
+  _region_query->finishBulkLoad();
   std::cout << "[IDBWrapper Info] build drc db success ...??" << std::endl;
 }
 
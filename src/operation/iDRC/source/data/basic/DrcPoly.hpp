@@ -39,12 +39,14 @@ class DrcPoly
   DrcPolygon* getPolygon() const { return _polygon; }
   DrcNet* getNet() const { return _net; }
   int getNetId() const { return _net_id; }
+  int get_object_id() const { return _object_id; }
   std::set<DrcRect*>& getScopes() { return _scope_set; }
 
   std::vector<std::vector<std::unique_ptr<DrcEdge>>>& getEdges() { return _edges; }
 
   void setNet(DrcNet* in) { _net = in; }
   void setNetId(int net_id) { _net_id = net_id; }
+  void set_object_id(int object_id) { _object_id = object_id; }
   void setPolygon(DrcPolygon* in) { _polygon = in; }
 
   void set_layer_id(int in) { _layer_id = in; }
@@ -56,6 +58,7 @@ class DrcPoly
  private:
   int _layer_id;
   int _net_id;
+  int _object_id = -1;
   DrcPolygon* _polygon;
   DrcNet* _net;
   std::vector<std::vector<std::unique_ptr<DrcEdge>>> _edges;
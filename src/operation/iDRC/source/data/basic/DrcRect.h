@@ -116,6 +116,7 @@ class DrcRect
   void set_max_scope(DrcRect* in) { _max_scope = in; }
   void set_is_max_scope(bool in) { _is_max_scope = in; }
   void setScopeType(ScopeType in) { _scope_type = in; }
+  void set_object_id(int object_id) { _object_id = object_id; }
 
   // getter
   int get_layer_id() const { return _layer_id; }
@@ -131,6 +132,7 @@ class DrcRect
   DrcRect* get_max_scope() { return _max_scope; }
   ScopeType getScopeType() { return _scope_type; }
   bool is_scope_max() { return _is_max_scope; }
+  int get_object_id() const { return _object_id; }
 
   bool isSegmentRect() const { return _owner_type == RectOwnerType::kSegment; }
   bool isPinRect() const { return _owner_type == RectOwnerType::kPin; }
@@ -153,6 +155,8 @@ class DrcRect
  private:
   int _layer_id = -1;
   int _net_id = -1;
+  // 增量检查会话中分配的对象序号，拷贝时不保留
+  int _object_id = -1;
   bool _is_fixed = false;
   bool _is_cut = false;
   bool _is_max_scope = false;
@@ -3,6 +3,7 @@
 #include "CornerFillSpacingCheck.hpp"
 #include "DrcConfig.h"
 #include "EOLSpacingCheck.hpp"
+#include "omp.h"
 
 namespace idrc {
 void RegionQuery::init(DrcConfig* config, DrcDesign* design)
@@ -16,18 +17,18 @@ void RegionQuery::queryIntersectsInRoutingLayer(int routingLayerId, RTreeBox que
                                                 std::vector<std::pair<RTreeBox, DrcRect*>>& query_result)
 {
   // _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(query_result));
-  _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::contains(query_box), std::back_inserter(query_result));
-  _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::overlaps(query_box), std::back_inserter(query_result));
-  _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::covers(query_box), std::back_inserter(query_result));
-  _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::covered_by(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, routingLayerId, bgi::contains(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, routingLayerId, bgi::overlaps(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, routingLayerId, bgi::covers(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, routingLayerId, bgi::covered_by(query_box), std::back_inserter(query_result));
   // _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(query_result));
   // _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::disjoint(query_box), std::back_inserter(query_result));
   // _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::within(query_box), std::back_inserter(query_result));
   // _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(query_result));
-  _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::contains(query_box), std::back_inserter(query_result));
-  _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::overlaps(query_box), std::back_inserter(query_result));
-  _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::covers(query_box), std::back_inserter(query_result));
-  _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::covered_by(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, routingLayerId, bgi::contains(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, routingLayerId, bgi::overlaps(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, routingLayerId, bgi::covers(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, routingLayerId, bgi::covered_by(query_box), std::back_inserter(query_result));
   // _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(query_result));
   // _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::disjoint(query_box), std::back_inserter(query_result));
   // _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::within(query_box), std::back_inserter(query_result));
@@ -55,8 +56,8 @@ void RegionQuery::queryInRoutingLayer(int routingLayerId, RTreeBox query_box, st
  */
 void RegionQuery::queryEnclosureInRoutingLayer(int LayerId, RTreeBox query_box, std::vector<std::pair<RTreeBox, DrcRect*>>& query_result)
 {
-  _layer_to_routing_rects_tree_map[LayerId].query(bgi::covers(query_box), std::back_inserter(query_result));
-  _layer_to_fixed_rects_tree_map[LayerId].query(bgi::intersects(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, LayerId, bgi::covers(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, LayerId, bgi::intersects(query_box), std::back_inserter(query_result));
 }
 
 /**
@@ -68,7 +69,7 @@ void RegionQuery::queryEnclosureInRoutingLayer(int LayerId, RTreeBox query_box,
  */
 void RegionQuery::searchRoutingRect(int routingLayerId, RTreeBox query_box, std::vector<std::pair<RTreeBox, DrcRect*>>& query_result)
 {
-  _layer_to_routing_rects_tree_map[routingLayerId].query(bgi::overlaps(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_routing_rects_tree_map, routingLayerId, bgi::overlaps(query_box), std::back_inserter(query_result));
 }
 
 /**
@@ -80,7 +81,7 @@ void RegionQuery::searchRoutingRect(int routingLayerId, RTreeBox query_box, std:
  */
 void RegionQuery::searchFixedRect(int routingLayerId, RTreeBox query_box, std::vector<std::pair<RTreeBox, DrcRect*>>& query_result)
 {
-  _layer_to_fixed_rects_tree_map[routingLayerId].query(bgi::overlaps(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_fixed_rects_tree_map, routingLayerId, bgi::overlaps(query_box), std::back_inserter(query_result));
 }
 
 // 下面的目前没用到
@@ -91,27 +92,25 @@ void RegionQuery::queryInCutLayer(int cutLayerId, RTreeBox query_box, std::vecto
 
 void RegionQuery::searchCutRect(int cutLayerId, RTreeBox query_box, std::vector<std::pair<RTreeBox, DrcRect*>>& query_result)
 {
-  _layer_to_cut_rects_tree_map[cutLayerId].query(bgi::overlaps(query_box), std::back_inserter(query_result));
+  queryInLayer(_layer_to_cut_rects_tree_map, cutLayerId, bgi::overlaps(query_box), std::back_inserter(query_result));
 }
 
 void RegionQuery::queryInMaxScope(int layer_id, RTreeBox check_rect,
                                   std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>>& query_result)
 {
-  std::vector<std::pair<RTreeBox, DrcRect*>> origin_result;
-  _layer_to_routing_max_region_tree_map[layer_id].query(bgi::overlaps(check_rect), std::back_inserter(origin_result));
-  for (auto [rtree_box, drc_rect] : origin_result) {
+  visitInMaxScope(layer_id, check_rect, [&](DrcRect* drc_rect) {
     query_result[drc_rect->get_scope_owner()][drc_rect->getScopeType()].push_back(drc_rect);
-  }
+    return true;
+  });
 }
 
 void RegionQuery::queryInMinScope(int layer_id, RTreeBox check_rect,
                                   std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>>& query_result)
 {
-  std::vector<std::pair<RTreeBox, DrcRect*>> origin_result;
-  _layer_to_routing_min_region_tree_map[layer_id].query(bgi::overlaps(check_rect), std::back_inserter(origin_result));
-  for (auto [rtree_box, drc_rect] : origin_result) {
+  visitInMinScope(layer_id, check_rect, [&](DrcRect* drc_rect) {
     query_result[drc_rect->get_scope_owner()][drc_rect->getScopeType()].push_back(drc_rect);
-  }
+    return true;
+  });
 }
 
 /**
@@ -136,6 +135,10 @@ RTreeBox RegionQuery::getRTreeBox(DrcRect* rect)
 void RegionQuery::add_routing_rect_to_rtree(int routingLayerId, DrcRect* rect)
 {
   RTreeBox rTreeBox = getRTreeBox(rect);
+  if (_is_bulk_loading) {
+    addToBulkList(_bulk_routing_rect_list, routingLayerId, rTreeBox, rect);
+    return;
+  }
   _layer_to_routing_rects_tree_map[routingLayerId].insert(std::make_pair(rTreeBox, rect));
 }
 
@@ -155,15 +158,57 @@ void RegionQuery::add_routing_rect_to_rtree(int routingLayerId, DrcRect* rect)
 void RegionQuery::add_fixed_rect_to_rtree(int routingLayerId, DrcRect* rect)
 {
   RTreeBox rTreeBox = getRTreeBox(rect);
+  if (_is_bulk_loading) {
+    addToBulkList(_bulk_fixed_rect_list, routingLayerId, rTreeBox, rect);
+    return;
+  }
   _layer_to_fixed_rects_tree_map[routingLayerId].insert(std::make_pair(rTreeBox, rect));
 }
 
 void RegionQuery::add_cut_rect_to_rtree(int cutLayerId, DrcRect* rect)
 {
   RTreeBox rTreeBox = getRTreeBox(rect);
+  if (_is_bulk_loading) {
+    addToBulkList(_bulk_cut_rect_list, cutLayerId, rTreeBox, rect);
+    return;
+  }
   _layer_to_cut_rects_tree_map[cutLayerId].insert(std::make_pair(rTreeBox, rect));
 }
 
+void RegionQuery::addToBulkList(std::vector<std::vector<std::pair<RTreeBox, DrcRect*>>>& bulk_rect_list, int layer_id,
+                                const RTreeBox& rtree_box, DrcRect* rect)
+{
+  if (layer_id < 0) {
+    std::cout << "[RegionQuery Error] : Layer id " << layer_id << " is invalid!" << std::endl;
+    exit(1);
+  }
+  if (layer_id >= static_cast<int>(bulk_rect_list.size())) {
+    bulk_rect_list.resize(layer_id + 1);
+  }
+  bulk_rect_list[layer_id].emplace_back(rtree_box, rect);
+}
+
+/**
+ * @brief 结束批量构建，将缓存的矩形按层用packing算法构建R树
+ *
+ */
+void RegionQuery::finishBulkLoad()
+{
+  _is_bulk_loading = false;
+  for (int layer_id = 0; layer_id < static_cast<int>(_bulk_routing_rect_list.size()); ++layer_id) {
+    _layer_to_routing_rects_tree_map.pack(layer_id, _bulk_routing_rect_list[layer_id]);
+  }
+  for (int layer_id = 0; layer_id < static_cast<int>(_bulk_fixed_rect_list.size()); ++layer_id) {
+    _layer_to_fixed_rects_tree_map.pack(layer_id, _bulk_fixed_rect_list[layer_id]);
+  }
+  for (int layer_id = 0; layer_id < static_cast<int>(_bulk_cut_rect_list.size()); ++layer_id) {
+    _layer_to_cut_rects_tree_map.pack(layer_id, _bulk_cut_rect_list[layer_id]);
+  }
+  _bulk_routing_rect_list.clear();
+  _bulk_fixed_rect_list.clear();
+  _bulk_cut_rect_list.clear();
+}
+
 // // check
 // bool RegionQuery::isExistingRectangleInRoutingRTree(int layerId, const DrcRectangle<int>& rectangle)
 // {
@@ -188,7 +233,8 @@ void RegionQuery::add_cut_rect_to_rtree(int cutLayerId, DrcRect* rect)
 void RegionQuery::printRoutingRectsRTree()
 {
   std::cout << "[PRINT routing rtree rect ]:::::::::::::::::::::::::" << std::endl;
-  for (auto& [layerId, rtree] : _layer_to_routing_rects_tree_map) {
+  for (int layerId = 0; layerId < _layer_to_routing_rects_tree_map.size(); ++layerId) {
+    auto& rtree = _layer_to_routing_rects_tree_map[layerId];
     std::cout << "[routing rtree rect on layer] : " << layerId << std::endl;
     for (auto it = rtree.begin(); it != rtree.end(); ++it) {
       DrcRect* drc_rect = it->second;
@@ -203,7 +249,8 @@ void RegionQuery::printRoutingRectsRTree()
 void RegionQuery::printFixedRectsRTree()
 {
   std::cout << "[PRINT fixed rtree rect ]:::::::::::::::::::::::::" << std::endl;
-  for (auto& [layerId, rtree] : _layer_to_fixed_rects_tree_map) {
+  for (int layerId = 0; layerId < _layer_to_fixed_rects_tree_map.size(); ++layerId) {
+    auto& rtree = _layer_to_fixed_rects_tree_map[layerId];
     std::cout << "[fixed rtree rect on layer] : " << layerId << std::endl;
     for (auto it = rtree.begin(); it != rtree.end(); ++it) {
       DrcRect* drc_rect = it->second;
@@ -216,24 +263,20 @@ void RegionQuery::printFixedRectsRTree()
   std::cout << "-----------------------------------" << std::endl;
 }
 
-bool RegionQuery::addCutSpacingViolation(DrcRect* target_rect, DrcRect* result_rect)
+bool RegionQuery::addCutSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot)
 {
-  if (target_rect > result_rect) {
-    return _cut_spacing_vio_set.insert(std::make_pair(target_rect, result_rect)).second;
-  } else {
-    return _cut_spacing_vio_set.insert(std::make_pair(result_rect, target_rect)).second;
-  }
-  return false;
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  rect_pair_violation.spot = spot;
+  return addRectPairViolation(ViolationType::kCutSpacing, rect_pair_violation);
 }
 
-bool RegionQuery::addCutDiffLayerSpacingViolation(DrcRect* target_rect, DrcRect* result_rect)
+bool RegionQuery::addCutDiffLayerSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot)
 {
-  if (target_rect > result_rect) {
-    return _cut_diff_layer_spacing_vio_set.insert(std::make_pair(target_rect, result_rect)).second;
-  } else {
-    return _cut_diff_layer_spacing_vio_set.insert(std::make_pair(result_rect, target_rect)).second;
-  }
-  return false;
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  rect_pair_violation.spot = spot;
+  return addRectPairViolation(ViolationType::kCutDiffLayerSpacing, rect_pair_violation);
 }
 
 void RegionQuery::initPrlVioSpot()
@@ -285,98 +328,54 @@ void RegionQuery::initShortVioSpot()
   }
 }
 
-bool RegionQuery::addCutEOLSpacingViolation(DrcRect* target_rect, DrcRect* result_rect)
+bool RegionQuery::addCutEOLSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot)
 {
-  if (target_rect > result_rect) {
-    return _cut_eol_spacing_vio_set.insert(std::make_pair(target_rect, result_rect)).second;
-  } else {
-    return _cut_eol_spacing_vio_set.insert(std::make_pair(result_rect, target_rect)).second;
-  }
-  return false;
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  rect_pair_violation.spot = spot;
+  return addRectPairViolation(ViolationType::kCutEOLSpacing, rect_pair_violation);
 }
 
 void RegionQuery::addPRLRunLengthSpacingViolation(int layer_id, RTreeBox span_box)
 {
-  std::vector<RTreeBox> query_result;
-  _layer_to_prl_vio_box_tree[layer_id].query(bgi::intersects(span_box), std::back_inserter(query_result));
-  for (auto& box : query_result) {
-    // if (DRCUtil::isPenetratedIntersected(box, span_box)) {
-    int lb_x = std::min(box.min_corner().get<0>(), span_box.min_corner().get<0>());
-    int lb_y = std::min(box.min_corner().get<1>(), span_box.min_corner().get<1>());
-    int rt_x = std::max(box.max_corner().get<0>(), span_box.max_corner().get<0>());
-    int rt_y = std::max(box.max_corner().get<1>(), span_box.max_corner().get<1>());
-    span_box.min_corner().set<0>(lb_x);
-    span_box.min_corner().set<1>(lb_y);
-    span_box.max_corner().set<0>(rt_x);
-    span_box.max_corner().set<1>(rt_y);
-    _layer_to_prl_vio_box_tree[layer_id].remove(box);
-    // }
-  }
-  _layer_to_prl_vio_box_tree[layer_id].insert(span_box);
+  addSpanBoxViolation(ViolationType::kRoutingSpacing, layer_id, span_box);
 }
 
 bool RegionQuery::addPRLRunLengthSpacingViolation(DrcRect* target_rect, DrcRect* result_rect)
 {
-  if (target_rect > result_rect) {
-    return _prl_spacing_vio_set.insert(std::make_pair(target_rect, result_rect)).second;
-  } else {
-    return _prl_spacing_vio_set.insert(std::make_pair(result_rect, target_rect)).second;
-  }
-  return false;
+  return addRectPairViolation(ViolationType::kRoutingSpacing, target_rect, result_rect);
 }
 
 void RegionQuery::addMetalEOLSpacingViolation(int layer_id, RTreeBox span_box)
 {
-  std::vector<RTreeBox> query_result;
-  _layer_to_metal_EOL_vio_box_tree[layer_id].query(bgi::intersects(span_box), std::back_inserter(query_result));
-  for (auto& box : query_result) {
-    // if (DRCUtil::isPenetratedIntersected(box, span_box)) {
-    int lb_x = std::min(box.min_corner().get<0>(), span_box.min_corner().get<0>());
-    int lb_y = std::min(box.min_corner().get<1>(), span_box.min_corner().get<1>());
-    int rt_x = std::max(box.max_corner().get<0>(), span_box.max_corner().get<0>());
-    int rt_y = std::max(box.max_corner().get<1>(), span_box.max_corner().get<1>());
-    span_box.min_corner().set<0>(lb_x);
-    span_box.min_corner().set<1>(lb_y);
-    span_box.max_corner().set<0>(rt_x);
-    span_box.max_corner().set<1>(rt_y);
-    _layer_to_metal_EOL_vio_box_tree[layer_id].remove(box);
-    // }
-  }
-  _layer_to_metal_EOL_vio_box_tree[layer_id].insert(span_box);
+  addSpanBoxViolation(ViolationType::kEOLSpacing, layer_id, span_box);
 }
 
-void RegionQuery::addShortViolation(int layer_id, RTreeBox span_box)
+bool RegionQuery::addShortViolation(int layer_id, DrcRect* target_rect, DrcRect* result_rect, RTreeBox span_box)
 {
-  std::vector<RTreeBox> query_result;
-  _layer_to_short_vio_box_tree[layer_id].query(bgi::intersects(span_box), std::back_inserter(query_result));
-  for (auto& box : query_result) {
-    // if (DRCUtil::isPenetratedIntersected(box, span_box)) {
-    int lb_x = std::min(box.min_corner().get<0>(), span_box.min_corner().get<0>());
-    int lb_y = std::min(box.min_corner().get<1>(), span_box.min_corner().get<1>());
-    int rt_x = std::max(box.max_corner().get<0>(), span_box.max_corner().get<0>());
-    int rt_y = std::max(box.max_corner().get<1>(), span_box.max_corner().get<1>());
-    span_box.min_corner().set<0>(lb_x);
-    span_box.min_corner().set<1>(lb_y);
-    span_box.max_corner().set<0>(rt_x);
-    span_box.max_corner().set<1>(rt_y);
-    _layer_to_short_vio_box_tree[layer_id].remove(box);
-    // }
-  }
-  _layer_to_short_vio_box_tree[layer_id].insert(span_box);
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  rect_pair_violation.has_span_box = true;
+  rect_pair_violation.layer_id = layer_id;
+  rect_pair_violation.span_box = span_box;
+  return addRectPairViolation(ViolationType::kShort, rect_pair_violation);
 }
 
-bool RegionQuery::addShortViolation(DrcRect* target_rect, DrcRect* result_rect)
+bool RegionQuery::addRoutingWidthViolation(DrcRect* target_rect, DrcRect* result_rect)
 {
-  if (target_rect > result_rect) {
-    return _short_vio_set.insert(std::make_pair(target_rect, result_rect)).second;
-  } else {
-    return _short_vio_set.insert(std::make_pair(result_rect, target_rect)).second;
-  }
-  return false;
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  rect_pair_violation.is_counted = true;
+  return addRectPairViolation(ViolationType::kRoutingWidth, rect_pair_violation);
 }
 
 void RegionQuery::addViolation(ViolationType vio_type)
 {
+  DrcViolationBuffer* buffer = getViolationBuffer();
+  if (buffer != nullptr) {
+    buffer->violation_count_map[vio_type]++;
+    return;
+  }
   switch (vio_type) {
     case ViolationType::kCutShort:
       break;
@@ -435,6 +434,328 @@ void RegionQuery::addViolation(ViolationType vio_type)
   }
 }
 
+bool RegionQuery::addRectPairViolation(ViolationType vio_type, DrcRect* target_rect, DrcRect* result_rect)
+{
+  DrcViolationBuffer::RectPairViolation rect_pair_violation;
+  rect_pair_violation.rect_pair = std::make_pair(target_rect, result_rect);
+  return addRectPairViolation(vio_type, rect_pair_violation);
+}
+
+/**
+ * @brief 记录矩形对违规及其Spot与违规区域，同一矩形对只记录一次，重复出现时释放Spot
+ * 并行检查时先在Net的buffer内去重，合并时再与之前的Net去重
+ *
+ * @param vio_type 违规类型
+ * @param rect_pair_violation
+ * @return true 矩形对第一次出现
+ */
+bool RegionQuery::addRectPairViolation(ViolationType vio_type, DrcViolationBuffer::RectPairViolation& rect_pair_violation)
+{
+  auto& [target_rect, result_rect] = rect_pair_violation.rect_pair;
+  if (target_rect < result_rect) {
+    std::swap(target_rect, result_rect);
+  }
+  DrcViolationBuffer* buffer = getViolationBuffer();
+  std::set<std::pair<DrcRect*, DrcRect*>>& rect_pair_set
+      = buffer == nullptr ? getRectPairViolationSet(vio_type) : buffer->rect_pair_set_map[vio_type];
+  if (!rect_pair_set.insert(rect_pair_violation.rect_pair).second) {
+    delete rect_pair_violation.spot;
+    rect_pair_violation.spot = nullptr;
+    return false;
+  }
+  if (buffer != nullptr) {
+    buffer->rect_pair_violation_map[vio_type].push_back(rect_pair_violation);
+    return true;
+  }
+  if (rect_pair_violation.spot != nullptr) {
+    addViolationSpot(rect_pair_violation.spot);
+  }
+  if (rect_pair_violation.has_span_box) {
+    addSpanBoxViolation(vio_type, rect_pair_violation.layer_id, rect_pair_violation.span_box);
+  }
+  if (rect_pair_violation.is_counted) {
+    addViolation(vio_type);
+  }
+  return true;
+}
+
+/**
+ * @brief 记录违规区域，与已有的相交违规区域合并为一个
+ *
+ * @param vio_type 违规类型
+ * @param layer_id 层Id
+ * @param span_box 违规区域
+ */
+void RegionQuery::addSpanBoxViolation(ViolationType vio_type, int layer_id, RTreeBox span_box)
+{
+  DrcViolationBuffer* buffer = getViolationBuffer();
+  if (buffer != nullptr) {
+    buffer->span_box_violation_map[vio_type].emplace_back(layer_id, span_box);
+    return;
+  }
+  bgi::rtree<RTreeBox, bgi::quadratic<16>>& box_tree = getViolationBoxTreeMap(vio_type)[layer_id];
+  std::vector<RTreeBox> query_result;
+  box_tree.query(bgi::intersects(span_box), std::back_inserter(query_result));
+  for (auto& box : query_result) {
+    int lb_x = std::min(box.min_corner().get<0>(), span_box.min_corner().get<0>());
+    int lb_y = std::min(box.min_corner().get<1>(), span_box.min_corner().get<1>());
+    int rt_x = std::max(box.max_corner().get<0>(), span_box.max_corner().get<0>());
+    int rt_y = std::max(box.max_corner().get<1>(), span_box.max_corner().get<1>());
+    span_box.min_corner().set<0>(lb_x);
+    span_box.min_corner().set<1>(lb_y);
+    span_box.max_corner().set<0>(rt_x);
+    span_box.max_corner().set<1>(rt_y);
+    box_tree.remove(box);
+  }
+  box_tree.insert(span_box);
+}
+
+/**
+ * @brief 按违规类型把Spot存入对应的列表
+ *
+ * @param spot
+ */
+void RegionQuery::addViolationSpot(DrcViolationSpot* spot)
+{
+  DrcViolationBuffer* buffer = getViolationBuffer();
+  if (buffer == nullptr) {
+    getViolationSpotList(spot->get_violation_type()).emplace_back(spot);
+    return;
+  }
+  buffer->spot_list.push_back(spot);
+}
+
+std::set<std::pair<DrcRect*, DrcRect*>>& RegionQuery::getRectPairViolationSet(ViolationType vio_type)
+{
+  switch (vio_type) {
+    case ViolationType::kRoutingSpacing:
+      return _prl_spacing_vio_set;
+    case ViolationType::kRoutingWidth:
+      return _routing_width_vio_set;
+    case ViolationType::kShort:
+      return _short_vio_set;
+    case ViolationType::kCutSpacing:
+      return _cut_spacing_vio_set;
+    case ViolationType::kCutDiffLayerSpacing:
+      return _cut_diff_layer_spacing_vio_set;
+    case ViolationType::kCutEOLSpacing:
+      return _cut_eol_spacing_vio_set;
+    default:
+      std::cout << "[RegionQuery Error] : no rect pair violation set of this type!" << std::endl;
+      exit(1);
+  }
+}
+
+std::vector<DrcViolationSpot*>& RegionQuery::getViolationSpotList(ViolationType vio_type)
+{
+  switch (vio_type) {
+    case ViolationType::kShort:
+      return _short_vio_spot_list;
+    case ViolationType::kRoutingSpacing:
+      return _prl_run_length_spacing_spot_list;
+    case ViolationType::kEOLSpacing:
+      return _metal_eol_spacing_spot_list;
+    case ViolationType::kNotchSpacing:
+      return _metal_notch_spacing_spot_list;
+    case ViolationType::kRoutingArea:
+      return _min_area_spot_list;
+    case ViolationType::kMinStep:
+      return _min_step_spot_list;
+    case ViolationType::kCutSpacing:
+      return _cut_spacing_spot_list;
+    case ViolationType::kCutEOLSpacing:
+      return _cut_eol_spacing_spot_list;
+    case ViolationType::kCutDiffLayerSpacing:
+      return _cut_diff_layer_spacing_spot_list;
+    case ViolationType::kEnclosure:
+      return _cut_enclosure_spot_list;
+    case ViolationType::kEnclosureEdge:
+      return _cut_enclosure_edge_spot_list;
+    default:
+      std::cout << "[RegionQuery Error] : no spot list of this type!" << std::endl;
+      exit(1);
+  }
+}
+
+std::map<int, bgi::rtree<RTreeBox, bgi::quadratic<16>>>& RegionQuery::getViolationBoxTreeMap(ViolationType vio_type)
+{
+  switch (vio_type) {
+    case ViolationType::kRoutingSpacing:
+      return _layer_to_prl_vio_box_tree;
+    case ViolationType::kShort:
+      return _layer_to_short_vio_box_tree;
+    case ViolationType::kEOLSpacing:
+      return _layer_to_metal_EOL_vio_box_tree;
+    default:
+      std::cout << "[RegionQuery Error] : no violation box tree of this type!" << std::endl;
+      exit(1);
+  }
+}
+
+/**
+ * @brief 进入并行检查模式，之后每个线程检查Net前需要绑定该Net的buffer
+ *
+ * @param net_num Net数目
+ * @param thread_num 线程数目
+ */
+void RegionQuery::initViolationBuffer(int net_num, int thread_num)
+{
+  _net_violation_buffer_list.assign(net_num, nullptr);
+  _thread_net_idx_list.assign(thread_num, -1);
+}
+
+void RegionQuery::bindViolationBuffer(int net_idx)
+{
+  _thread_net_idx_list[omp_get_thread_num()] = net_idx;
+}
+
+DrcViolationBuffer* RegionQuery::getViolationBuffer()
+{
+  if (_capture_buffer != nullptr) {
+    return _capture_buffer;
+  }
+  if (_thread_net_idx_list.empty()) {
+    return nullptr;
+  }
+  // 大部分Net没有违规，buffer在第一次记录违规时才创建
+  DrcViolationBuffer*& buffer = _net_violation_buffer_list[_thread_net_idx_list[omp_get_thread_num()]];
+  if (buffer == nullptr) {
+    buffer = new DrcViolationBuffer();
+  }
+  return buffer;
+}
+
+/**
+ * @brief 退出并行检查模式，按Net顺序把各buffer中的违规合并到RegionQuery中
+ *
+ */
+void RegionQuery::mergeViolationBuffer()
+{
+  _thread_net_idx_list.clear();
+  for (DrcViolationBuffer* buffer : _net_violation_buffer_list) {
+    if (buffer == nullptr) {
+      continue;
+    }
+    mergeViolationBuffer(buffer);
+    delete buffer;
+  }
+  _net_violation_buffer_list.clear();
+}
+
+void RegionQuery::mergeViolationBuffer(DrcViolationBuffer* buffer)
+{
+  for (auto& [vio_type, rect_pair_violation_list] : buffer->rect_pair_violation_map) {
+    for (DrcViolationBuffer::RectPairViolation& rect_pair_violation : rect_pair_violation_list) {
+      // 已由之前的Net记录的矩形对在此去重
+      addRectPairViolation(vio_type, rect_pair_violation);
+    }
+  }
+  for (auto& [vio_type, span_box_list] : buffer->span_box_violation_map) {
+    for (auto& [layer_id, span_box] : span_box_list) {
+      addSpanBoxViolation(vio_type, layer_id, span_box);
+    }
+  }
+  for (DrcViolationSpot* spot : buffer->spot_list) {
+    addViolationSpot(spot);
+  }
+  for (auto& [vio_type, count] : buffer->violation_count_map) {
+    for (int i = 0; i < count; i++) {
+      addViolation(vio_type);
+    }
+  }
+}
+
+/**
+ * @brief 得到对象的键，对象第一次使用时分配序号
+ *
+ * @param drc_rect
+ * @return std::pair<int, int> (net_id, 对象序号)
+ */
+std::pair<int, int> RegionQuery::getObjectKey(DrcRect* drc_rect)
+{
+  if (drc_rect->get_object_id() < 0) {
+    drc_rect->set_object_id(_object_id_count++);
+  }
+  return std::make_pair(drc_rect->get_net_id(), drc_rect->get_object_id());
+}
+
+std::pair<int, int> RegionQuery::getObjectKey(DrcPoly* poly)
+{
+  if (poly->get_object_id() < 0) {
+    poly->set_object_id(_object_id_count++);
+  }
+  return std::make_pair(poly->getNetId(), poly->get_object_id());
+}
+
+DrcViolationBuffer* RegionQuery::popObjectViolationBuffer(const std::pair<int, int>& object_key)
+{
+  auto iter = _object_violation_buffer_map.find(object_key);
+  if (iter == _object_violation_buffer_map.end()) {
+    return nullptr;
+  }
+  DrcViolationBuffer* buffer = iter->second;
+  _object_violation_buffer_map.erase(iter);
+  return buffer;
+}
+
+void RegionQuery::setObjectViolationBuffer(const std::pair<int, int>& object_key, DrcViolationBuffer* buffer)
+{
+  DrcViolationBuffer*& object_buffer = _object_violation_buffer_map[object_key];
+  if (object_buffer != nullptr && object_buffer != buffer) {
+    deleteViolationBuffer(object_buffer);
+  }
+  object_buffer = buffer;
+}
+
+/**
+ * @brief 对象被删除时释放其buffer，未分配序号的对象没有buffer
+ *
+ */
+void RegionQuery::eraseObjectViolationBuffer(DrcRect* drc_rect)
+{
+  if (drc_rect->get_object_id() < 0) {
+    return;
+  }
+  deleteViolationBuffer(popObjectViolationBuffer(getObjectKey(drc_rect)));
+}
+
+void RegionQuery::eraseObjectViolationBuffer(DrcPoly* poly)
+{
+  if (poly->get_object_id() < 0) {
+    return;
+  }
+  deleteViolationBuffer(popObjectViolationBuffer(getObjectKey(poly)));
+}
+
+void RegionQuery::clearObjectViolationBuffer()
+{
+  for (auto& [object_key, buffer] : _object_violation_buffer_map) {
+    deleteViolationBuffer(buffer);
+  }
+  _object_violation_buffer_map.clear();
+}
+
+/**
+ * @brief 删除未合并的buffer及其中的Spot
+ *
+ * @param buffer
+ */
+void RegionQuery::deleteViolationBuffer(DrcViolationBuffer* buffer)
+{
+  if (buffer == nullptr) {
+    return;
+  }
+  for (auto& [vio_type, rect_pair_violation_list] : buffer->rect_pair_violation_map) {
+    for (DrcViolationBuffer::RectPairViolation& rect_pair_violation : rect_pair_violation_list) {
+      delete rect_pair_violation.spot;
+    }
+  }
+  for (DrcViolationSpot* spot : buffer->spot_list) {
+    delete spot;
+  }
+  delete buffer;
+}
+
 void RegionQuery::getRegionDetailReport(std::map<std::string, std::vector<DrcViolationSpot*>>& vio_map)
 {
   vio_map.insert(std::make_pair("Cut EOL Spacing", _cut_eol_spacing_spot_list));
@@ -661,12 +982,12 @@ void RegionQuery::queryEdgeInRoutingLayer(int routingLayerId, RTreeBox query_box
 
 void RegionQuery::searchRoutingEdge(int routingLayerId, RTreeBox query_box, std::vector<std::pair<RTreeSegment, DrcEdge*>>& result)
 {
-  _layer_to_routing_edges[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(result));
+  queryInLayer(_layer_to_routing_edges, routingLayerId, bgi::intersects(query_box), std::back_inserter(result));
 }
 
 void RegionQuery::searchBlockEdge(int routingLayerId, RTreeBox query_box, std::vector<std::pair<RTreeSegment, DrcEdge*>>& result)
 {
-  _layer_to_block_edges[routingLayerId].query(bgi::intersects(query_box), std::back_inserter(result));
+  queryInLayer(_layer_to_block_edges, routingLayerId, bgi::intersects(query_box), std::back_inserter(result));
 }
 
 void RegionQuery::addDrcRect(DrcRect* drc_rect, Tech* tech)
@@ -2,8 +2,10 @@
 #define IDRC_SRC_MODULE_REGION_QUERY_H_
 
 #include <algorithm>
+#include <iostream>
 #include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "BoostType.h"
@@ -15,6 +17,88 @@ namespace idrc {
 
 class DrcConfig;
 
+/**
+ * @brief 并行检查时一条Net产生的违规，检查结束后按Net顺序合并到RegionQuery中
+ *
+ */
+struct DrcViolationBuffer
+{
+  struct RectPairViolation
+  {
+    std::pair<DrcRect*, DrcRect*> rect_pair;
+    // 矩形对第一次出现时才保留的Spot与违规区域，与矩形对一起记录
+    DrcViolationSpot* spot = nullptr;
+    bool has_span_box = false;
+    int layer_id = -1;
+    RTreeBox span_box;
+    // 矩形对第一次出现时计数
+    bool is_counted = false;
+  };
+
+  std::map<ViolationType, int> violation_count_map;
+  std::map<ViolationType, std::set<std::pair<DrcRect*, DrcRect*>>> rect_pair_set_map;
+  std::map<ViolationType, std::vector<RectPairViolation>> rect_pair_violation_map;
+  std::map<ViolationType, std::vector<std::pair<int, RTreeBox>>> span_box_violation_map;
+  std::vector<DrcViolationSpot*> spot_list;
+};
+
+/**
+ * @brief 以层号为下标的R树列表，层号由Tech给出且连续，查询时按下标直接取到对应的R树
+ *
+ * @tparam Value R树中保存的元素
+ */
+template <typename Value>
+class DrcLayerRTreeList
+{
+ public:
+  using RTree = bgi::rtree<Value, bgi::quadratic<16>>;
+
+  RTree& operator[](int layer_id)
+  {
+    if (layer_id < 0) {
+      std::cout << "[DrcLayerRTreeList Error] : Layer id " << layer_id << " is invalid!" << std::endl;
+      exit(1);
+    }
+    if (layer_id >= static_cast<int>(_rtree_list.size())) {
+      _rtree_list.resize(layer_id + 1);
+    }
+    return _rtree_list[layer_id];
+  }
+  // 不存在的层返回nullptr，不会扩展列表，多个线程可以同时查询
+  RTree* find(int layer_id)
+  {
+    if (layer_id < 0 || layer_id >= static_cast<int>(_rtree_list.size())) {
+      return nullptr;
+    }
+    return &_rtree_list[layer_id];
+  }
+  int size() const { return static_cast<int>(_rtree_list.size()); }
+  void clear() { _rtree_list.clear(); }
+  /**
+   * @brief 用packing算法批量构建一层的R树，已在R树中的元素一并重建
+   *
+   * @param layer_id 层号
+   * @param value_list 待加入的元素，构建后清空
+   */
+  void pack(int layer_id, std::vector<Value>& value_list)
+  {
+    if (value_list.empty()) {
+      return;
+    }
+    RTree& rtree = (*this)[layer_id];
+    value_list.insert(value_list.end(), rtree.begin(), rtree.end());
+    RTree packed_rtree(value_list.begin(), value_list.end());
+    rtree = std::move(packed_rtree);
+    std::vector<Value>().swap(value_list);
+  }
+
+ private:
+  std::vector<RTree> _rtree_list;
+};
+
+using DrcRectRTreeList = DrcLayerRTreeList<std::pair<RTreeBox, DrcRect*>>;
+using DrcEdgeRTreeList = DrcLayerRTreeList<std::pair<RTreeSegment, DrcEdge*>>;
+
 class RegionQuery
 {
  public:
@@ -60,27 +144,39 @@ class RegionQuery
   void addViolation(ViolationType vio_type);
   bool addPRLRunLengthSpacingViolation(DrcRect* target_rect, DrcRect* result_rect);
   void addPRLRunLengthSpacingViolation(int layer_id, RTreeBox span_box);
-  bool addShortViolation(DrcRect* target_rect, DrcRect* result_rect);
-  void addShortViolation(int layer_id, RTreeBox span_box);
+  bool addShortViolation(int layer_id, DrcRect* target_rect, DrcRect* result_rect, RTreeBox span_box);
   void addMetalEOLSpacingViolation(int layer_id, RTreeBox span_box);
-
-  bool addCutSpacingViolation(DrcRect* target_rect, DrcRect* result_rect);
-  bool addCutDiffLayerSpacingViolation(DrcRect* target_rect, DrcRect* result_rect);
-  bool addCutEOLSpacingViolation(DrcRect* target_rect, DrcRect* result_rect);
+  bool addRoutingWidthViolation(DrcRect* target_rect, DrcRect* result_rect);
+
+  // 矩形对已被记录时释放spot
+  bool addCutSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot);
+  bool addCutDiffLayerSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot);
+  bool addCutEOLSpacingViolation(DrcRect* target_rect, DrcRect* result_rect, DrcViolationSpot* spot);
+  void addViolationSpot(DrcViolationSpot* spot);
+
+  // 并行检查时违规先写入每条Net的buffer，合并时按Net顺序回放，结果与串行检查一致
+  void initViolationBuffer(int net_num, int thread_num);
+  void bindViolationBuffer(int net_idx);
+  void mergeViolationBuffer();
+  // 增量检查时每个矩形或多边形的违规单独记录在其buffer中，重新检查时整体替换
+  void bindCaptureBuffer(DrcViolationBuffer* buffer) { _capture_buffer = buffer; }
+  // 对象以(net_id, 对象序号)为键，对象被删除或地址被复用都不会取到过期的buffer
+  std::pair<int, int> getObjectKey(DrcRect* drc_rect);
+  std::pair<int, int> getObjectKey(DrcPoly* poly);
+  DrcViolationBuffer* popObjectViolationBuffer(const std::pair<int, int>& object_key);
+  void setObjectViolationBuffer(const std::pair<int, int>& object_key, DrcViolationBuffer* buffer);
+  void eraseObjectViolationBuffer(DrcRect* drc_rect);
+  void eraseObjectViolationBuffer(DrcPoly* poly);
+  void clearObjectViolationBuffer();
+  void deleteViolationBuffer(DrcViolationBuffer* buffer);
 
   // setter
   // getter
   std::set<DrcRect*>& getCutRectSet() { return _cut_rect_set; }
   std::set<DrcRect*>& getRoutingRectSet() { return _routing_rect_set; }
   std::map<int, std::map<int, std::set<DrcPoly*>>>& getRegionPolysMap() { return _region_polys_map; }
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>>& get_layer_to_routing_rects_tree_map()
-  {
-    return _layer_to_routing_rects_tree_map;
-  }
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>>& get_layer_to_fixed_rects_tree_map()
-  {
-    return _layer_to_fixed_rects_tree_map;
-  }
+  DrcRectRTreeList& get_layer_to_routing_rects_tree_map() { return _layer_to_routing_rects_tree_map; }
+  DrcRectRTreeList& get_layer_to_fixed_rects_tree_map() { return _layer_to_fixed_rects_tree_map; }
   std::map<int, DrcNet>& get_nets_map() { return _nets_map; }
   // function
   /**********目前用到的接口**************/
@@ -92,7 +188,14 @@ class RegionQuery
     _layer_to_cut_rects_tree_map.clear();
     _layer_to_block_edges.clear();
     _layer_to_routing_edges.clear();
+    _is_bulk_loading = false;
+    _bulk_routing_rect_list.clear();
+    _bulk_fixed_rect_list.clear();
+    _bulk_cut_rect_list.clear();
   }
+  // 批量构建：start之后加入的矩形先缓存，finish时按层用packing算法一次性构建R树
+  void startBulkLoad() { _is_bulk_loading = true; }
+  void finishBulkLoad();
   // 获得搜索区域内的矩形
   void queryInRoutingLayer(int routingLayerId, RTreeBox query_box, std::vector<std::pair<RTreeBox, DrcRect*>>& query_result);
   // find cut rect enclosure
@@ -136,6 +239,17 @@ class RegionQuery
 
   void queryInMaxScope(int layer_id, RTreeBox check_rect, std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>>& query_result);
   void queryInMinScope(int layer_id, RTreeBox check_rect, std::map<void*, std::map<ScopeType, std::vector<DrcRect*>>>& query_result);
+  // 不构造结果容器的scope查询，visitor(DrcRect* scope)返回false时停止遍历
+  template <typename Visitor>
+  void visitInMaxScope(int layer_id, const RTreeBox& check_rect, Visitor&& visitor)
+  {
+    visitInLayer(_layer_to_routing_max_region_tree_map, layer_id, check_rect, std::forward<Visitor>(visitor));
+  }
+  template <typename Visitor>
+  void visitInMinScope(int layer_id, const RTreeBox& check_rect, Visitor&& visitor)
+  {
+    visitInLayer(_layer_to_routing_min_region_tree_map, layer_id, check_rect, std::forward<Visitor>(visitor));
+  }
   std::vector<DrcViolationSpot*> _short_vio_spot_list;
   std::vector<DrcViolationSpot*> _cut_spacing_spot_list;
   std::vector<DrcViolationSpot*> _cut_eol_spacing_spot_list;
@@ -172,6 +286,7 @@ class RegionQuery
   int _min_hole_count;
 
   std::set<std::pair<DrcRect*, DrcRect*>> _prl_spacing_vio_set;
+  std::set<std::pair<DrcRect*, DrcRect*>> _routing_width_vio_set;
   std::set<std::pair<DrcRect*, DrcRect*>> _short_vio_set;
   std::set<std::pair<DrcRect*, DrcRect*>> _cut_spacing_vio_set;
 
@@ -179,6 +294,14 @@ class RegionQuery
 
   std::set<std::pair<DrcRect*, DrcRect*>> _cut_eol_spacing_vio_set;
 
+  // 并行检查
+  std::vector<DrcViolationBuffer*> _net_violation_buffer_list;
+  std::vector<int> _thread_net_idx_list;
+  // 增量检查
+  DrcViolationBuffer* _capture_buffer = nullptr;
+  int _object_id_count = 0;
+  std::map<std::pair<int, int>, DrcViolationBuffer*> _object_violation_buffer_map;
+
   DrcConfig* _config;
   DrcDesign* _drc_design;
   Tech* _tech;
@@ -187,20 +310,27 @@ class RegionQuery
   std::map<int, DrcNet> _nets_map;
   std::map<int, std::map<int, std::set<DrcPoly*>>> _region_polys_map;  // Use net_id and layer_id to store poly in order
   // routing layer
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>> _layer_to_routing_rects_tree_map;  // via and segment
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>> _layer_to_fixed_rects_tree_map;    // pin and block
+  DrcRectRTreeList _layer_to_routing_rects_tree_map;  // via and segment
+  DrcRectRTreeList _layer_to_fixed_rects_tree_map;    // pin and block
 
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>> _layer_to_routing_min_region_tree_map;
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>> _layer_to_routing_max_region_tree_map;
+  DrcRectRTreeList _layer_to_routing_min_region_tree_map;
+  DrcRectRTreeList _layer_to_routing_max_region_tree_map;
 
   ////////////////////////////////
   ///////下面的没用到
   // cut layer
-  std::map<int, bgi::rtree<std::pair<RTreeBox, DrcRect*>, bgi::quadratic<16>>> _layer_to_cut_rects_tree_map;
+  DrcRectRTreeList _layer_to_cut_rects_tree_map;
   // drc edge
-  std::map<int, bgi::rtree<std::pair<RTreeSegment, DrcEdge*>, bgi::quadratic<16>>> _layer_to_block_edges;  // block edges
-  std::map<int, bgi::rtree<std::pair<RTreeSegment, DrcEdge*>, bgi::quadratic<16>>>
-      _layer_to_routing_edges;  // pin and segment via merge edges
+  DrcEdgeRTreeList _layer_to_block_edges;    // block edges
+  DrcEdgeRTreeList _layer_to_routing_edges;  // pin and segment via merge edges
+
+  // 批量构建时缓存的矩形，下标为层号
+  bool _is_bulk_loading = false;
+  std::vector<std::vector<std::pair<RTreeBox, DrcRect*>>> _bulk_routing_rect_list;
+  std::vector<std::vector<std::pair<RTreeBox, DrcRect*>>> _bulk_fixed_rect_list;
+  std::vector<std::vector<std::pair<RTreeBox, DrcRect*>>> _bulk_cut_rect_list;
+  void addToBulkList(std::vector<std::vector<std::pair<RTreeBox, DrcRect*>>>& bulk_rect_list, int layer_id, const RTreeBox& rtree_box,
+                     DrcRect* rect);
 
   // add rect to rtree
   // void add_routing_rect_to_rtree(int routingLayerId, DrcRect* drcRect);
@@ -238,6 +368,49 @@ class RegionQuery
   void getEOLSpacingScope(DrcPoly* new_poly, bool is_max);
   void getCornerFillSpacingScope(DrcPoly* new_poly);
 
+  // 查询时不插入新的层，多个线程可以同时查询
+  template <typename Value, typename Predicates, typename OutIter>
+  void queryInLayer(DrcLayerRTreeList<Value>& layer_rtree_list, int layer_id, const Predicates& predicates, OutIter out_iter)
+  {
+    auto* rtree = layer_rtree_list.find(layer_id);
+    if (rtree != nullptr) {
+      rtree->query(predicates, out_iter);
+    }
+  }
+  template <typename Predicates, typename OutIter>
+  void queryInLayer(std::map<int, bgi::rtree<RTreeBox, bgi::quadratic<16>>>& layer_to_rtree_map, int layer_id, const Predicates& predicates,
+                    OutIter out_iter)
+  {
+    auto iter = layer_to_rtree_map.find(layer_id);
+    if (iter != layer_to_rtree_map.end()) {
+      iter->second.query(predicates, out_iter);
+    }
+  }
+  // 对与check_rect重叠的scope依次调用visitor(DrcRect* scope)，visitor返回false时停止遍历
+  template <typename Visitor>
+  void visitInLayer(DrcRectRTreeList& layer_rtree_list, int layer_id, const RTreeBox& check_rect, Visitor&& visitor)
+  {
+    auto* rtree = layer_rtree_list.find(layer_id);
+    if (rtree == nullptr) {
+      return;
+    }
+    for (auto iter = rtree->qbegin(bgi::overlaps(check_rect)); iter != rtree->qend(); ++iter) {
+      if (!visitor(iter->second)) {
+        return;
+      }
+    }
+  }
+
+  // violation
+  DrcViolationBuffer* getViolationBuffer();
+  std::set<std::pair<DrcRect*, DrcRect*>>& getRectPairViolationSet(ViolationType vio_type);
+  std::vector<DrcViolationSpot*>& getViolationSpotList(ViolationType vio_type);
+  std::map<int, bgi::rtree<RTreeBox, bgi::quadratic<16>>>& getViolationBoxTreeMap(ViolationType vio_type);
+  bool addRectPairViolation(ViolationType vio_type, DrcRect* target_rect, DrcRect* result_rect);
+  bool addRectPairViolation(ViolationType vio_type, DrcViolationBuffer::RectPairViolation& rect_pair_violation);
+  void addSpanBoxViolation(ViolationType vio_type, int layer_id, RTreeBox span_box);
+  void mergeViolationBuffer(DrcViolationBuffer* buffer);
+
   RTreeSegment getRTreeSegment(DrcEdge* drcEdge);
   RTreeBox getRTreeBox(DrcRect* drcRect);
 };
@@ -146,8 +146,7 @@ void RoutingWidthCheck::checkDiagonalLengthOfOverlapRect(int layerId, DrcRect* t
       if (!isOverlapBoxCoveredByExistedRect(target_rect, result_rect, overlap_rect, query_result)) {
         if (_interact_with_op) {
           _check_result = false;
-        } else {
-          _region_query->addViolation(ViolationType::kRoutingWidth);
+        } else if (_region_query->addRoutingWidthViolation(target_rect, result_rect)) {
           add_spot(layerId, target_rect, result_rect);
         }
       }
@@ -324,14 +324,10 @@ void CutSpacingCheck::checkMaxXYSpacing(DrcRect* target_rect, DrcRect* result_re
     _check_result = false;
     // std::cout << "spacing2 vio" << std::endl;
     if (target_rect->get_layer_id() == result_rect->get_layer_id()) {
-      if (_region_query->addCutSpacingViolation(target_rect, result_rect)) {
-        addCutSpacingSpot(target_rect, result_rect);
-      }
+      addCutSpacingSpot(target_rect, result_rect);
 
     } else {
-      if (_region_query->addCutDiffLayerSpacingViolation(target_rect, result_rect)) {
-        addDiffLayerSpot(target_rect, result_rect);
-      }
+      addDiffLayerSpot(target_rect, result_rect);
     }
     // _region_query->addViolation(ViolationType::kCutSpacing);
   }
@@ -347,7 +343,7 @@ void CutSpacingCheck::addCutSpacingSpot(DrcRect* target_rect, DrcRect* result_re
   spot->set_net_id(target_rect->get_net_id());
   spot->set_vio_type(ViolationType::kCutSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_cut_spacing_spot_list.emplace_back(spot);
+  _region_query->addCutSpacingViolation(target_rect, result_rect, spot);
 }
 
 void CutSpacingCheck::addDiffLayerSpot(DrcRect* target_rect, DrcRect* result_rect)
@@ -360,7 +356,7 @@ void CutSpacingCheck::addDiffLayerSpot(DrcRect* target_rect, DrcRect* result_rec
   spot->set_net_id(target_rect->get_net_id());
   spot->set_vio_type(ViolationType::kCutDiffLayerSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_cut_diff_layer_spacing_spot_list.emplace_back(spot);
+  _region_query->addCutDiffLayerSpacingViolation(target_rect, result_rect, spot);
 }
 
 void CutSpacingCheck::checkSpacing_TwoRect_PrlPos(DrcRect* target_rect, DrcRect* result_rect)
@@ -445,13 +441,9 @@ void CutSpacingCheck::checkCornerSpacing(DrcRect* result_rect, DrcRect* target_r
     // std::cout << "spacing1 vio" << std::endl;
     // _region_query->addViolation(ViolationType::kCutSpacing);
     if (target_rect->get_layer_id() == result_rect->get_layer_id()) {
-      if (_region_query->addCutSpacingViolation(target_rect, result_rect)) {
-        addCutSpacingSpot(target_rect, result_rect);
-      }
+      addCutSpacingSpot(target_rect, result_rect);
     } else {
-      if (_region_query->addCutDiffLayerSpacingViolation(target_rect, result_rect)) {
-        addDiffLayerSpot(target_rect, result_rect);
-      }
+      addDiffLayerSpot(target_rect, result_rect);
     }
   }
 }
@@ -500,9 +492,7 @@ void CutSpacingCheck::checkSpacing2_PrlNeg(DrcRect* target_rect)
         _check_result = false;
         // std::cout << "spacing2 vio" << std::endl;
         // _region_query->addViolation(ViolationType::kCutSpacing);
-        if (_region_query->addCutSpacingViolation(target_rect, cut_rect)) {
-          addCutSpacingSpot(target_rect, cut_rect);
-        }
+        addCutSpacingSpot(target_rect, cut_rect);
       }
     }
   }
@@ -262,9 +262,7 @@ void CutEolSpacingCheck::checkCornerSpacing(DrcRect* result_rect, DrcRect* targe
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -288,9 +286,7 @@ void CutEolSpacingCheck::checkCornerSpacing(DrcRect* result_rect, DrcRect* targe
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -314,9 +310,7 @@ void CutEolSpacingCheck::checkCornerSpacing(DrcRect* result_rect, DrcRect* targe
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -340,9 +334,7 @@ void CutEolSpacingCheck::checkCornerSpacing(DrcRect* result_rect, DrcRect* targe
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -407,9 +399,7 @@ void CutEolSpacingCheck::checkEdgeSpacing(DrcRect* target_rect, DrcRect* result_
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -421,9 +411,7 @@ void CutEolSpacingCheck::checkEdgeSpacing(DrcRect* target_rect, DrcRect* result_
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -435,9 +423,7 @@ void CutEolSpacingCheck::checkEdgeSpacing(DrcRect* target_rect, DrcRect* result_
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -449,9 +435,7 @@ void CutEolSpacingCheck::checkEdgeSpacing(DrcRect* target_rect, DrcRect* result_
       _check_result = false;
       // std::cout << "spacing1 vio" << std::endl;
       // _region_query->addViolation(ViolationType::kCutEOLSpacing);
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
 
       return;
     }
@@ -468,7 +452,7 @@ void CutEolSpacingCheck::addSpot(DrcRect* target_rect, DrcRect* result_rect)
   spot->set_net_id(target_rect->get_net_id());
   spot->set_vio_type(ViolationType::kCutEOLSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_cut_eol_spacing_spot_list.emplace_back(spot);
+  _region_query->addCutEOLSpacingViolation(target_rect, result_rect, spot);
 }
 
 void CutEolSpacingCheck::checkSpacing1_TwoRect_PrlNeg(DrcRect* target_rect, DrcRect* result_rect, EdgeDirection edge_dir)
@@ -531,9 +515,7 @@ void CutEolSpacingCheck::checkSpacing2_PrlNeg(DrcRect* target_rect, EdgeDirectio
     _check_result = false;
     // _region_query->addViolation(ViolationType::kCutEOLSpacing);
     for (auto& [rt_box, result_rect] : query_result) {
-      if (_region_query->addCutEOLSpacingViolation(target_rect, result_rect)) {
-        addSpot(target_rect, result_rect);
-      }
+      addSpot(target_rect, result_rect);
     }
     // std::cout << "spacing2 vio!!!" << std::endl;
   }
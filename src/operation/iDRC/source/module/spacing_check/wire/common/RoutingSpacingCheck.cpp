@@ -407,10 +407,8 @@ void RoutingSpacingCheck::checkSpacingFromQueryResult(int routingLayerId, DrcRec
     RTreeBox span_box = DRCUtil::getSpanBoxBetweenTwoRects(target_rect, result_rect);
 
     if (checkShort(target_rect, result_rect)) {
-      if (_region_query->addShortViolation(target_rect, result_rect)) {
-        // addShortSpot(target_rect, result_rect);
-        _region_query->addShortViolation(routingLayerId, span_box);
-      }
+      // addShortSpot(target_rect, result_rect);
+      _region_query->addShortViolation(routingLayerId, target_rect, result_rect, span_box);
       // _region_query->addViolation(ViolationType::kShort);
       // storeViolationResult(routingLayerId, target_rect, result_rect, ViolationType::kShort);
       continue;
@@ -706,7 +704,7 @@ void RoutingSpacingCheck::addShortSpot(DrcRect* target_rect, DrcRect* result_rec
   spot->set_net_id(target_rect->get_net_id());
   spot->set_vio_type(ViolationType::kShort);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_short_vio_spot_list.emplace_back(spot);
+  _region_query->addViolationSpot(spot);
 }
 
 void RoutingSpacingCheck::addSpacingSpot(DrcRect* target_rect, DrcRect* result_rect)
@@ -719,7 +717,7 @@ void RoutingSpacingCheck::addSpacingSpot(DrcRect* target_rect, DrcRect* result_r
   spot->set_net_id(target_rect->get_net_id());
   spot->set_vio_type(ViolationType::kRoutingSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_prl_run_length_spacing_spot_list.emplace_back(spot);
+  _region_query->addViolationSpot(spot);
 }
 
 }  // namespace idrc
\ No newline at end of file
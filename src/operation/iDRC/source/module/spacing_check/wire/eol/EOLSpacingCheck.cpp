@@ -224,7 +224,7 @@ void EOLSpacingCheck::addE2ESpot(DrcEdge* edge, DrcEdge* result_edge)
   spot->set_layer_name(_tech->getRoutingLayerNameById(layer_id));
   spot->set_vio_type(ViolationType::kEOLSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_metal_eol_spacing_spot_list.emplace_back(spot);
+  _region_query->addViolationSpot(spot);
 }
 
 void EOLSpacingCheck::storeEnd2EndViolationResult(DrcEdge* result_edge, DrcEdge* edge)
@@ -885,7 +885,7 @@ void EOLSpacingCheck::addSpot(DrcEdge* target_edge, DrcRect* result_rect)
   spot->set_layer_name(_tech->getRoutingLayerNameById(layer_id));
   spot->set_vio_type(ViolationType::kEOLSpacing);
   spot->setCoordinate(box.min_corner().x(), box.min_corner().y(), box.max_corner().x(), box.max_corner().y());
-  _region_query->_metal_eol_spacing_spot_list.emplace_back(spot);
+  _region_query->addViolationSpot(spot);
 }
 
 bool EOLSpacingCheck::isSameMetalMet(RTreeBox result_rect, DrcEdge* edge)
@@ -294,7 +294,7 @@ void NotchSpacingCheck::addSpot(DrcEdge* edge)
   spot->set_layer_name(_tech->getRoutingLayerNameById(layer_id));
   spot->set_vio_type(ViolationType::kNotchSpacing);
   spot->setCoordinate(lb_x, lb_y, rt_x, rt_y);
-  _region_query->_metal_notch_spacing_spot_list.emplace_back(spot);
+  _region_query->addViolationSpot(spot);
 }
 
 void NotchSpacingCheck::checkNotchSpacing(DrcEdge* edge)
@@ -0,0 +1,90 @@
+#include <map>
+#include <string>
+
+#include "DrcAPI.hpp"
+#include "idm.h"
+#include "ids.hpp"
+
+using namespace idrc;
+
+/**
+ * @brief 增量检查的结果与对最终图形做一次完整检查的结果比较
+ * 完整检查：空会话中一次性加入最终图形，得到的计数变化即为全部违规
+ *
+ */
+std::vector<ids::DRCTask> getTaskList(RegionQuery* region_query, std::vector<DrcRect*> drc_rect_list)
+{
+  // 每个矩形单独作为一个task，保证task内矩形可以合并为一个多边形
+  std::vector<ids::DRCTask> task_list;
+  for (DrcRect* drc_rect : drc_rect_list) {
+    ids::DRCTask task;
+    task.region_query = region_query;
+    task.drc_rect_list.push_back(drc_rect);
+    task_list.push_back(task);
+  }
+  return task_list;
+}
+
+void addCountDiff(std::map<ViolationType, int>& count_map, DrcViolationDiff& violation_diff)
+{
+  for (auto& [vio_type, count] : violation_diff.count_diff_map) {
+    count_map[vio_type] += count;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  std::string path = "<local_path>/tech.lef";
+  dmInst->get_config().set_tech_lef_path(path);
+  vector<string> path_list;
+  path_list.push_back(path);
+  dmInst->readLef(path_list);
+
+  DrcAPIInst.initDRC();
+
+  // 增量检查：先加入初始图形，再删除一个矩形并加入一个与其它Net短路的矩形
+  RegionQuery* incremental_region_query = DrcAPIInst.init();
+  DrcAPIInst.initIncrementalCheck(incremental_region_query);
+  DrcRect* rect1 = DrcAPIInst.getDrcRect(1, 1000, 1000, 1100, 2000, "M1");
+  DrcRect* rect2 = DrcAPIInst.getDrcRect(2, 1150, 1000, 1250, 2000, "M1");
+  DrcRect* rect3 = DrcAPIInst.getDrcRect(3, 1300, 1000, 1400, 1500, "M1");
+  DrcRect* rect4 = DrcAPIInst.getDrcRect(4, 1350, 1400, 1450, 2000, "M1");
+  std::map<ViolationType, int> incremental_count_map;
+  DrcViolationDiff init_diff = DrcAPIInst.updateIncrementalCheck(getTaskList(incremental_region_query, {rect1, rect2, rect3}), {});
+  addCountDiff(incremental_count_map, init_diff);
+  DrcViolationDiff update_diff
+      = DrcAPIInst.updateIncrementalCheck(getTaskList(incremental_region_query, {rect4}), getTaskList(incremental_region_query, {rect2}));
+  addCountDiff(incremental_count_map, update_diff);
+
+  // 完整检查：最终图形为rect1、rect3与rect4
+  RegionQuery* full_region_query = DrcAPIInst.init();
+  DrcAPIInst.initIncrementalCheck(full_region_query);
+  std::vector<DrcRect*> final_rect_list = {DrcAPIInst.getDrcRect(1, 1000, 1000, 1100, 2000, "M1"),
+                                           DrcAPIInst.getDrcRect(3, 1300, 1000, 1400, 1500, "M1"),
+                                           DrcAPIInst.getDrcRect(4, 1350, 1400, 1450, 2000, "M1")};
+  std::map<ViolationType, int> full_count_map;
+  DrcViolationDiff full_diff = DrcAPIInst.updateIncrementalCheck(getTaskList(full_region_query, final_rect_list), {});
+  addCountDiff(full_count_map, full_diff);
+
+  bool is_same = true;
+  for (auto& count_map : {incremental_count_map, full_count_map}) {
+    for (auto& [vio_type, count] : count_map) {
+      int incremental_count = incremental_count_map.contains(vio_type) ? incremental_count_map[vio_type] : 0;
+      int full_count = full_count_map.contains(vio_type) ? full_count_map[vio_type] : 0;
+      if (incremental_count != full_count) {
+        std::cout << "violation type " << static_cast<int>(vio_type) << " : " << incremental_count << " / " << full_count << std::endl;
+        is_same = false;
+      }
+    }
+  }
+  size_t incremental_spot_num = init_diff.added_spot_list.size() + update_diff.added_spot_list.size() - update_diff.removed_spot_list.size();
+  if (incremental_spot_num != full_diff.added_spot_list.size()) {
+    std::cout << "spot num : " << incremental_spot_num << " / " << full_diff.added_spot_list.size() << std::endl;
+    is_same = false;
+  }
+  std::cout << (is_same ? "true" : "false") << std::endl;
+
+  DrcAPIInst.clearIncrementalCheck(incremental_region_query);
+  DrcAPIInst.clearIncrementalCheck(full_region_query);
+  return is_same ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#include <map>
+#include <string>
+
+#include "DRC.h"
+
+using namespace idrc;
+
+/**
+ * @brief 同一设计分别串行与并行检查，比较各类违规的数目
+ *
+ */
+std::map<std::string, int> runDrc(std::string& drc_config_path, int thread_num)
+{
+  DRC* drc = new DRC();
+  drc->initDRC(drc_config_path);
+  drc->initCheckModule();
+  drc->run(thread_num);
+  return drc->getDrcResult();
+}
+
+int main(int argc, char* argv[])
+{
+  std::string drc_config_path = "<local_path>/drc_config.json";
+  int thread_num = 8;
+  if (argc >= 2) {
+    drc_config_path = argv[1];
+  }
+  if (argc >= 3) {
+    thread_num = std::stoi(argv[2]);
+  }
+
+  std::map<std::string, int> serial_result = runDrc(drc_config_path, 1);
+  std::map<std::string, int> parallel_result = runDrc(drc_config_path, thread_num);
+
+  bool is_same = true;
+  for (auto& [vio_type, num] : serial_result) {
+    int parallel_num = parallel_result.contains(vio_type) ? parallel_result[vio_type] : 0;
+    std::cout << vio_type << " : " << num << " / " << parallel_num << std::endl;
+    if (num != parallel_num) {
+      is_same = false;
+    }
+  }
+  if (serial_result.size() != parallel_result.size()) {
+    is_same = false;
+  }
+  std::cout << (is_same ? "true" : "false") << std::endl;
+  return is_same ? 0 : 1;
+}
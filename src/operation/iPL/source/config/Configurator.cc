@@ -53,6 +53,7 @@ void Config::initConfigByJson(nlohmann::json json)
   float target_density = getDataByJson(json, {"PL", "GP", "Density", "target_density"});
   int32_t bin_cnt_x = getDataByJson(json, {"PL", "GP", "Density", "bin_cnt_x"});
   int32_t bin_cnt_y = getDataByJson(json, {"PL", "GP", "Density", "bin_cnt_y"});
+  std::string density_solver = getDataByJson(json, {"PL", "GP", "Density", "density_solver"});
 
   int32_t max_iter = getDataByJson(json, {"PL", "GP", "Nesterov", "max_iter"});
   int32_t max_backtrack = getDataByJson(json, {"PL", "GP", "Nesterov", "max_backtrack"});
@@ -73,10 +74,12 @@ void Config::initConfigByJson(nlohmann::json json)
   // Legalizer
   int32_t lg_max_displacement = getDataByJson(json, {"PL", "LG", "max_displacement"});
   int32_t lg_global_padding = getDataByJson(json, {"PL", "LG", "global_right_padding"});
+  int32_t lg_band_row_num = getDataByJson(json, {"PL", "LG", "band_row_num"});
 
   // Detail Placer
   int32_t dp_max_displacement = getDataByJson(json, {"PL", "DP", "max_displacement"});
   int32_t dp_global_padding = getDataByJson(json, {"PL", "DP", "global_right_padding"});
+  int32_t dp_enable_window_reorder = getDataByJson(json, {"PL", "DP", "enable_window_reorder"});
 
   // Filler
   std::vector<std::vector<std::string>> filler_group_list;
@@ -116,6 +119,7 @@ void Config::initConfigByJson(nlohmann::json json)
   std::string solution_type = getDataByJson(json, {"PL", "MP", "solution_type"});
   int32_t perturb_per_step = getDataByJson(json, {"PL", "MP", "SimulateAnneal", "perturb_per_step"});
   float cool_rate = getDataByJson(json, {"PL", "MP", "SimulateAnneal", "cool_rate"});
+  int32_t num_replica = getDataByJson(json, {"PL", "MP", "SimulateAnneal", "num_replica"});
   int32_t parts = getDataByJson(json, {"PL", "MP", "Partition", "parts"});
   int32_t ufactor = getDataByJson(json, {"PL", "MP", "Partition", "ufactor"});
   float new_macro_density = getDataByJson(json, {"PL", "MP", "Partition", "new_macro_density"});
@@ -133,6 +137,7 @@ void Config::initConfigByJson(nlohmann::json json)
   _nes_config.set_target_density(target_density);
   _nes_config.set_bin_cnt_x(bin_cnt_x);
   _nes_config.set_bin_cnt_y(bin_cnt_y);
+  _nes_config.set_density_solver(density_solver);
   _nes_config.set_max_iter(max_iter);
   _nes_config.set_max_back_track(max_backtrack);
   _nes_config.set_init_density_penalty(init_density_penalty);
@@ -162,11 +167,13 @@ void Config::initConfigByJson(nlohmann::json json)
   _lg_config.set_thread_num(num_threads);
   _lg_config.set_max_displacement(lg_max_displacement);
   _lg_config.set_global_padding(lg_global_padding);
+  _lg_config.set_band_row_num(lg_band_row_num);
 
   // DetailPlacer
   _dp_config.set_thread_num(num_threads);
   _dp_config.set_max_displacement(dp_max_displacement);
   _dp_config.set_global_padding(dp_global_padding);
+  _dp_config.set_is_window_reorder(dp_enable_window_reorder == 1);
 
   // Filler
   _filler_config.set_thread_num(num_threads);
@@ -182,6 +189,7 @@ void Config::initConfigByJson(nlohmann::json json)
   _mp_config.set_solution_type(solution_type);
   _mp_config.set_perturb_per_step(perturb_per_step);
   _mp_config.set_cool_rate(cool_rate);
+  _mp_config.set_num_replica(num_replica);
   _mp_config.set_parts(parts);
   _mp_config.set_ufactor(ufactor);
   _mp_config.set_new_macro_density(new_macro_density);
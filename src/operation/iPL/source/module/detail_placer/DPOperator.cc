@@ -1,7 +1,5 @@
 #include "DPOperator.hh"
 
-#include "module/evaluator/wirelength/HPWirelength.hh"
-
 namespace ipl {
 
 DPOperator::DPOperator()
@@ -14,11 +12,13 @@ DPOperator::~DPOperator()
   delete _grid_manager;
 }
 
-void DPOperator::initDPOperator(DPDatabase* database)
+void DPOperator::initDPOperator(DPDatabase* database, DPConfig* config)
 {
   _database = database;
+  _config = config;
   initTopoManager();
   initGridManager();
+  initNetHPWL();
 }
 
 std::pair<int32_t, int32_t> DPOperator::obtainOptimalXCoordiLine(DPInstance* inst)
@@ -483,10 +483,70 @@ void DPOperator::cutOutShape(Rectangle<int32_t>& shape)
   shape.set_rectangle(llx, lly, urx, ury);
 }
 
+void DPOperator::initNetHPWL()
+{
+  const std::vector<DPInstance*> inst_list = _database->get_design()->get_inst_list();
+  const std::vector<DPNet*> net_list = _database->get_design()->get_net_list();
+  int32_t thread_num = _config->get_thread_num();
+
+  _inst_coordi_list.resize(inst_list.size());
+  for (size_t i = 0; i < inst_list.size(); i++) {
+    _inst_coordi_list[i] = inst_list[i]->get_coordi();
+  }
+
+  int64_t total_hpwl = 0;
+  _net_hpwl_list.resize(net_list.size());
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 256) reduction(+ : total_hpwl)
+  for (size_t i = 0; i < net_list.size(); i++) {
+    _net_hpwl_list[i] = net_list[i]->calCurrentHPWL();
+    total_hpwl += _net_hpwl_list[i];
+  }
+  _total_hpwl = total_hpwl;
+}
+
 int64_t DPOperator::calTotalHPWL()
 {
-  HPWirelength hpwl_eval(_topo_manager);
-  return hpwl_eval.obtainTotalWirelength() + _database->get_outside_wl();
+  const std::vector<DPInstance*> inst_list = _database->get_design()->get_inst_list();
+  const std::vector<DPNet*> net_list = _database->get_design()->get_net_list();
+  int32_t thread_num = _config->get_thread_num();
+
+  // pick the instances moved since last call
+  std::vector<uint8_t> moved_flag_list(inst_list.size(), 0);
+#pragma omp parallel for num_threads(thread_num) schedule(static)
+  for (size_t i = 0; i < inst_list.size(); i++) {
+    Point<int32_t> coordi = inst_list[i]->get_coordi();
+    if (!(coordi == _inst_coordi_list[i])) {
+      _inst_coordi_list[i] = coordi;
+      moved_flag_list[i] = 1;
+    }
+  }
+
+  std::vector<uint8_t> net_flag_list(net_list.size(), 0);
+  std::vector<int32_t> dirty_net_list;
+  for (size_t i = 0; i < inst_list.size(); i++) {
+    if (!moved_flag_list[i]) {
+      continue;
+    }
+    for (auto* pin : inst_list[i]->get_pin_list()) {
+      int32_t net_id = pin->get_net()->get_net_id();
+      if (!net_flag_list[net_id]) {
+        net_flag_list[net_id] = 1;
+        dirty_net_list.push_back(net_id);
+      }
+    }
+  }
+
+  int64_t delta_hpwl = 0;
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 256) reduction(+ : delta_hpwl)
+  for (size_t i = 0; i < dirty_net_list.size(); i++) {
+    int32_t net_id = dirty_net_list[i];
+    int64_t net_hpwl = net_list[net_id]->calCurrentHPWL();
+    delta_hpwl += net_hpwl - _net_hpwl_list[net_id];
+    _net_hpwl_list[net_id] = net_hpwl;
+  }
+  _total_hpwl += delta_hpwl;
+
+  return _total_hpwl + _database->get_outside_wl();
 }
 
 }  // namespace ipl
\ No newline at end of file
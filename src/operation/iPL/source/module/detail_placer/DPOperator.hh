@@ -4,7 +4,9 @@
 #include <string>
 
 #include "GridManager.hh"
+#include "config/DetailPlacerConfig.hh"
 #include "TopologyManager.hh"
+#include "data/Point.hh"
 #include "data/Rectangle.hh"
 #include "database/DPDatabase.hh"
 
@@ -25,7 +27,7 @@ class DPOperator
   TopologyManager* get_topo_manager() const { return _topo_manager; }
   GridManager* get_grid_manager() const { return _grid_manager; }
 
-  void initDPOperator(DPDatabase* database);
+  void initDPOperator(DPDatabase* database, DPConfig* config);
   void updateTopoManager();
   void updateGridManager();
 
@@ -51,9 +53,16 @@ class DPOperator
 
  private:
   DPDatabase* _database;
+  DPConfig* _config;
   TopologyManager* _topo_manager;
   GridManager* _grid_manager;
 
+  // incremental hpwl, only the nets of the moved instances are recomputed
+  std::vector<Point<int32_t>> _inst_coordi_list;
+  std::vector<int64_t> _net_hpwl_list;
+  int64_t _total_hpwl = 0;
+
+  void initNetHPWL();
   void initTopoManager();
   void initGridManager();
   void initGridManagerFixedArea();
@@ -1,7 +1,6 @@
 #include "DetailPlacer.hh"
 
 #include "module/evaluator/density/Density.hh"
-#include "module/evaluator/wirelength/HPWirelength.hh"
 #include "operation/BinOpt.hh"
 #include "operation/InstanceSwap.hh"
 #include "operation/LocalReorder.hh"
@@ -15,7 +14,7 @@ DetailPlacer::DetailPlacer(Config* pl_config, PlacerDB* placer_db)
 {
   initDPConfig(pl_config);
   initDPDatabase(placer_db);
-  _operator.initDPOperator(&_database);
+  _operator.initDPOperator(&_database, &_config);
 }
 
 DetailPlacer::~DetailPlacer()
@@ -200,8 +199,10 @@ void DetailPlacer::wrapNetList()
 {
   auto* pl_design = _database._placer_db->get_design();
   auto* dp_design = _database._design;
+  int32_t net_id = 0;
   for (auto* pl_net : pl_design->get_net_list()) {
     DPNet* dp_net = wrapNet(pl_net);
+    dp_net->set_net_id(net_id++);
     dp_design->add_net(dp_net);
   }
 }
@@ -458,7 +459,6 @@ void DetailPlacer::runDetailPlace()
   LOG_INFO << "Execution Origin Instance Shift: ";
   RowOpt row_opt(&_config, &_database, &_operator);
   row_opt.runRowOpt();
-  _operator.updateTopoManager();
   LOG_INFO << "After RowOpt HPWL: " << calTotalHPWL();
   // _operator.updateGridManager();
   // LOG_INFO << "After Origin Peak Bin Density: " << calPeakBinDensity();
@@ -474,25 +474,22 @@ void DetailPlacer::runDetailPlace()
 
     InstanceSwap swap_opt(&_config, &_database, &_operator);
     swap_opt.runGlobalSwap();
-    _operator.updateTopoManager();
     LOG_INFO << "---After Global Swap HPWL: " << calTotalHPWL();
     // _operator.updateGridManager();
     // LOG_INFO << "---After Global Swap Peak Density: " << calPeakBinDensity();
 
     swap_opt.runVerticalSwap();
-    _operator.updateTopoManager();
     LOG_INFO << "---After Vertical Swap HPWL: " << calTotalHPWL();
     // _operator.updateGridManager();
     // LOG_INFO << "---After Vertical Swap Peak Density: " << calPeakBinDensity();
 
     LocalReorder reorder_opt(&_config, &_database, &_operator);
-    reorder_opt.runLocalReorder();
-    _operator.updateTopoManager();
-    LOG_INFO << "---After Local Reorder HPWL: " << calTotalHPWL();
+    reorder_opt.runLocalReorder(swap_iter);
+    update_hpwl = calTotalHPWL();
+    LOG_INFO << "---After Local Reorder HPWL: " << update_hpwl;
     // _operator.updateGridManager();
     // LOG_INFO << "---After Local Reorder Peak Density: " << calPeakBinDensity();
 
-    update_hpwl = calTotalHPWL();
     improve_ratio = static_cast<double>(front_hpwl - update_hpwl) / front_hpwl;
 
     // BinOpt bin_opt(&_config, &_database, &_operator);
@@ -504,12 +501,11 @@ void DetailPlacer::runDetailPlace()
 
     RowOpt row_opt_test(&_config, &_database, &_operator);
     row_opt_test.runRowOpt();
-    _operator.updateTopoManager();
-    LOG_INFO << "---After Row Opt HPWL: " << calTotalHPWL();
+    update_hpwl = calTotalHPWL();
+    LOG_INFO << "---After Row Opt HPWL: " << update_hpwl;
     // _operator.updateGridManager();
     // LOG_INFO << "After Row Opt Peak Density: " << calPeakBinDensity();
 
-    update_hpwl = calTotalHPWL();
     front_hpwl = update_hpwl;
     ++swap_iter;
   } while (improve_ratio > threshold && swap_iter < 10);
@@ -520,7 +516,6 @@ void DetailPlacer::runDetailPlace()
 
     RowOpt row_opt2(&_config, &_database, &_operator);
     row_opt2.runRowOpt();
-    _operator.updateTopoManager();
 
     update_hpwl = calTotalHPWL();
     improve_ratio = static_cast<double>(front_hpwl - update_hpwl) / front_hpwl;
@@ -543,8 +538,7 @@ void DetailPlacer::runDetailPlace()
 
 int64_t DetailPlacer::calTotalHPWL()
 {
-  HPWirelength hpwl_eval(_operator.get_topo_manager());
-  return hpwl_eval.obtainTotalWirelength() + _database._outside_wl;
+  return _operator.calTotalHPWL();
 }
 
 float DetailPlacer::calPeakBinDensity()
@@ -29,16 +29,19 @@ public:
     int32_t get_thread_num() const { return _thread_num;}
     int32_t get_max_displacement() const { return _max_displacement;}
     int32_t get_global_padding() const { return _global_padding;}
+    bool isWindowReorder() const { return _is_window_reorder;}
 
     // setter
     void set_thread_num(int32_t num_thread) { _thread_num = num_thread;}
     void set_max_displacement(int32_t max_displacement) { _max_displacement = max_displacement;}
     void set_global_padding(int32_t padding) { _global_padding = padding;}
+    void set_is_window_reorder(bool flag) { _is_window_reorder = flag;}
 
 private:
     int32_t _thread_num;
     int32_t _max_displacement;
     int32_t _global_padding;
+    bool _is_window_reorder = false;
 };
 
 }
@@ -12,7 +12,7 @@
 
 namespace ipl{
 
-DPNet::DPNet(std::string name): _name(name),_netweight(1.0f),_driver_pin(nullptr)
+DPNet::DPNet(std::string name): _name(name),_net_id(-1),_netweight(1.0f),_driver_pin(nullptr)
 {
 
 }
@@ -45,6 +45,7 @@ public:
 
     // getter
     std::string get_name() const { return _name;}
+    int32_t get_net_id() const { return _net_id;}
     DPNET_TYPE get_net_type() const { return _type;}
     DPNET_STATE get_net_state() const { return _state;}
     float get_netwight() const { return _netweight;}
@@ -52,6 +53,7 @@ public:
     const std::vector<DPPin*>& get_pins() const { return _pins;}
 
     // setter
+    void set_net_id(int32_t net_id) { _net_id = net_id;}
     void set_driver_pin(DPPin* pin) { _driver_pin = pin;}
     void add_pin(DPPin* pin) { _pins.push_back(pin);}
     void set_netweight(float weight) { _netweight = weight; }
@@ -65,6 +67,7 @@ public:
 
 private:
     std::string _name;
+    int32_t _net_id;
     DPNET_TYPE _type;
     DPNET_STATE _state;
     float _netweight;
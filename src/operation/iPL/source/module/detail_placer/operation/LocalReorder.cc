@@ -1,5 +1,8 @@
 #include "LocalReorder.hh"
 
+#include <algorithm>
+#include <set>
+
 #include "module/logger/Log.hh"
 
 namespace ipl{
@@ -15,61 +18,209 @@ LocalReorder::~LocalReorder()
 {
 }
 
-void LocalReorder::runLocalReorder(){
+void LocalReorder::runLocalReorder(int32_t pass_idx){
     bool is_clusted = _operator->checkIfClustered();
     if(!is_clusted){
         _operator->updateInstClustering();
     }
 
+    if(_config->isWindowReorder() && _config->get_thread_num() > 1){
+        runWindowReorder(pass_idx);
+    }else{
+        runSerialReorder();
+    }
+}
+
+void LocalReorder::runSerialReorder(){
     int64_t total_benefit = 0;
     auto& interval_2d_list = _database->get_layout()->get_interval_2d_list();
 
-    // Debug
-    int32_t row_index = 0;
-
     for(auto& interval_list : interval_2d_list){
         for(auto* interval : interval_list){
+            auto* cur_cluster = interval->get_cluster_root();
+            while(cur_cluster){
+                total_benefit += reorderCluster(cur_cluster, -1);
+                cur_cluster = cur_cluster->get_back_cluster();
+            }
+        }
+    }
+
+    // LOG_INFO << "Expected HPWL Benefit: " << total_benefit;
+}
 
+void LocalReorder::runWindowReorder(int32_t pass_idx){
+    initWindowInfo(pass_idx);
+    int32_t thread_num = _config->get_thread_num();
+
+    // the cluster is owned by the window of its left end
+    std::vector<std::vector<DPCluster*>> window_cluster_list(_window_x_num * _window_y_num);
+    for(auto& interval_list : _database->get_layout()->get_interval_2d_list()){
+        for(auto* interval : interval_list){
             auto* cur_cluster = interval->get_cluster_root();
             while(cur_cluster){
-                auto inst_list = cur_cluster->get_inst_list();
-                for(size_t i=0,j=i+1; i< inst_list.size() && j < inst_list.size(); i++,j++){
-                    auto* inst_1 = inst_list[i];
-                    auto* inst_2 = inst_list[j];
-                    int64_t origin_hpwl = _operator->calInstPairAffectiveHPWL(inst_1, inst_2);
-
-                    int32_t coordi_x = inst_1->get_coordi().get_x();
-                    int32_t coordi_y = inst_1->get_coordi().get_y();
-
-                    inst_2->updateCoordi(coordi_x, coordi_y);
-                    inst_1->updateCoordi(coordi_x + inst_2->get_shape().get_width(), coordi_y);
-                    int64_t modify_hpwl = _operator->calInstPairAffectiveHPWL(inst_1, inst_2);
-
-                    if(origin_hpwl > modify_hpwl){
-                        int32_t inst1_internal_id = inst_1->get_internal_id();
-                        int32_t inst2_internal_id = inst_2->get_internal_id();
-                        inst_1->set_internal_id(inst2_internal_id);
-                        inst_2->set_internal_id(inst1_internal_id);
-                        cur_cluster->replaceInstance(inst_2, inst1_internal_id);
-                        cur_cluster->replaceInstance(inst_1, inst2_internal_id);
-                        inst_list[i] = inst_2;
-                        inst_list[j] = inst_1;
-                        
-                        total_benefit += (origin_hpwl - modify_hpwl);
-                    }else{
-                        inst_1->updateCoordi(coordi_x, coordi_y);
-                        inst_2->updateCoordi(coordi_x + inst_1->get_shape().get_width(), coordi_y);
-                    }
-                }
+                window_cluster_list[obtainWindowIdx(cur_cluster)].push_back(cur_cluster);
                 cur_cluster = cur_cluster->get_back_cluster();
             }
+        }
+    }
+
+    // the windows of one phase are not adjacent and reordered in parallel,
+    // the pins out of the window are read from the snapshot taken at the phase start
+    int64_t total_benefit = 0;
+    for(int32_t phase = 0; phase < 4; phase++){
+        std::vector<int32_t> phase_window_list;
+        for(int32_t window_idx = 0; window_idx < _window_x_num * _window_y_num; window_idx++){
+            int32_t window_x = window_idx % _window_x_num;
+            int32_t window_y = window_idx / _window_x_num;
+            if((window_x % 2) + (window_y % 2) * 2 == phase && !window_cluster_list[window_idx].empty()){
+                phase_window_list.push_back(window_idx);
+            }
+        }
+        if(phase_window_list.empty()){
+            continue;
+        }
 
+        updatePinCoordiSnapshot();
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 1) reduction(+ : total_benefit)
+        for(size_t i = 0; i < phase_window_list.size(); i++){
+            int32_t window_idx = phase_window_list[i];
+            for(auto* cluster : window_cluster_list[window_idx]){
+                total_benefit += reorderCluster(cluster, window_idx);
+            }
         }
-        row_index += 1;
     }
 
     // LOG_INFO << "Expected HPWL Benefit: " << total_benefit;
 }
 
+void LocalReorder::initWindowInfo(int32_t pass_idx){
+    auto* layout = _database->get_layout();
+    _window_height = _window_row_num * layout->get_row_height();
+    _window_width = _window_height;
+
+    // shift half a window on the odd pass, so the window boundary is not fixed
+    _window_offset_x = (pass_idx % 2) * (_window_width / 2);
+    _window_offset_y = (pass_idx % 2) * (_window_height / 2);
+    _window_x_num = (layout->get_max_x() + _window_offset_x) / _window_width + 1;
+    _window_y_num = (layout->get_max_y() + _window_offset_y) / _window_height + 1;
+}
+
+int32_t LocalReorder::obtainWindowIdx(DPCluster* cluster){
+    int32_t row_y = cluster->get_belong_interval()->get_belong_row()->get_coordinate().get_y();
+    int32_t window_x = (cluster->get_min_x() + _window_offset_x) / _window_width;
+    int32_t window_y = (row_y + _window_offset_y) / _window_height;
+    window_x = std::clamp(window_x, 0, _window_x_num - 1);
+    window_y = std::clamp(window_y, 0, _window_y_num - 1);
+
+    return window_y * _window_x_num + window_x;
+}
+
+void LocalReorder::updatePinCoordiSnapshot(){
+    const std::vector<DPNet*> net_list = _database->get_design()->get_net_list();
+    int32_t thread_num = _config->get_thread_num();
+
+    if(_net_pin_offset_list.empty()){
+        _net_pin_offset_list.resize(net_list.size() + 1, 0);
+        for(auto* net : net_list){
+            _net_pin_offset_list[net->get_net_id() + 1] = net->get_pins().size();
+        }
+        for(size_t i = 1; i < _net_pin_offset_list.size(); i++){
+            _net_pin_offset_list[i] += _net_pin_offset_list[i - 1];
+        }
+        _pin_coordi_snapshot.resize(_net_pin_offset_list.back());
+    }
+
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 256)
+    for(size_t i = 0; i < net_list.size(); i++){
+        const auto& pin_list = net_list[i]->get_pins();
+        int64_t offset = _net_pin_offset_list[net_list[i]->get_net_id()];
+        for(size_t j = 0; j < pin_list.size(); j++){
+            _pin_coordi_snapshot[offset + j] = Point<int32_t>(pin_list[j]->get_x_coordi(), pin_list[j]->get_y_coordi());
+        }
+    }
+}
+
+int64_t LocalReorder::reorderCluster(DPCluster* cluster, int32_t window_idx){
+    int64_t benefit = 0;
+    auto inst_list = cluster->get_inst_list();
+    for(size_t i=0,j=i+1; i< inst_list.size() && j < inst_list.size(); i++,j++){
+        auto* inst_1 = inst_list[i];
+        auto* inst_2 = inst_list[j];
+        int64_t origin_hpwl = window_idx < 0 ? _operator->calInstPairAffectiveHPWL(inst_1, inst_2)
+                                             : calInstPairWindowHPWL(inst_1, inst_2, window_idx);
+
+        int32_t coordi_x = inst_1->get_coordi().get_x();
+        int32_t coordi_y = inst_1->get_coordi().get_y();
+
+        inst_2->updateCoordi(coordi_x, coordi_y);
+        inst_1->updateCoordi(coordi_x + inst_2->get_shape().get_width(), coordi_y);
+        int64_t modify_hpwl = window_idx < 0 ? _operator->calInstPairAffectiveHPWL(inst_1, inst_2)
+                                             : calInstPairWindowHPWL(inst_1, inst_2, window_idx);
+
+        if(origin_hpwl > modify_hpwl){
+            int32_t inst1_internal_id = inst_1->get_internal_id();
+            int32_t inst2_internal_id = inst_2->get_internal_id();
+            inst_1->set_internal_id(inst2_internal_id);
+            inst_2->set_internal_id(inst1_internal_id);
+            cluster->replaceInstance(inst_2, inst1_internal_id);
+            cluster->replaceInstance(inst_1, inst2_internal_id);
+            inst_list[i] = inst_2;
+            inst_list[j] = inst_1;
+
+            benefit += (origin_hpwl - modify_hpwl);
+        }else{
+            inst_1->updateCoordi(coordi_x, coordi_y);
+            inst_2->updateCoordi(coordi_x + inst_1->get_shape().get_width(), coordi_y);
+        }
+    }
+    return benefit;
+}
+
+int64_t LocalReorder::calInstPairWindowHPWL(DPInstance* inst_1, DPInstance* inst_2, int32_t window_idx){
+    int64_t affective_hpwl = 0;
+    std::set<DPNet*> net_set;
+    for(auto* pin : inst_1->get_pin_list()){
+        net_set.emplace(pin->get_net());
+    }
+    for(auto* pin : inst_2->get_pin_list()){
+        net_set.emplace(pin->get_net());
+    }
+    for(auto* net : net_set){
+        affective_hpwl += calNetWindowHPWL(net, window_idx);
+    }
+    return affective_hpwl;
+}
+
+int64_t LocalReorder::calNetWindowHPWL(DPNet* net, int32_t window_idx){
+    const auto& pin_list = net->get_pins();
+    if(pin_list.empty()){
+        return 0;
+    }
+
+    int32_t lower_x = INT32_MAX;
+    int32_t lower_y = INT32_MAX;
+    int32_t upper_x = INT32_MIN;
+    int32_t upper_y = INT32_MIN;
+
+    int64_t offset = _net_pin_offset_list[net->get_net_id()];
+    for(size_t i = 0; i < pin_list.size(); i++){
+        auto* pin_inst = pin_list[i]->get_instance();
+        auto* pin_cluster = pin_inst ? pin_inst->get_belong_cluster() : nullptr;
+
+        int32_t pin_x = _pin_coordi_snapshot[offset + i].get_x();
+        int32_t pin_y = _pin_coordi_snapshot[offset + i].get_y();
+        if(pin_cluster && obtainWindowIdx(pin_cluster) == window_idx){
+            pin_x = pin_list[i]->get_x_coordi();
+            pin_y = pin_list[i]->get_y_coordi();
+        }
+
+        lower_x = std::min(lower_x, pin_x);
+        lower_y = std::min(lower_y, pin_y);
+        upper_x = std::max(upper_x, pin_x);
+        upper_y = std::max(upper_y, pin_y);
+    }
+
+    return (upper_x - lower_x) + (upper_y - lower_y);
+}
 
 }
\ No newline at end of file
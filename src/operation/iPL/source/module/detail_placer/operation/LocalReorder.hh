@@ -12,6 +12,7 @@
 #define IPL_LOCALREORDER_H
 
 #include <string>
+#include <vector>
 
 #include "config/DetailPlacerConfig.hh"
 #include "database/DPDatabase.hh"
@@ -30,12 +31,33 @@ public:
     LocalReorder& operator=(const LocalReorder&) = delete;
     LocalReorder& operator=(LocalReorder&&) = delete;
 
-    void runLocalReorder();
+    void runLocalReorder(int32_t pass_idx = 0);
 
 private:
     DPConfig* _config;
     DPDatabase* _database;
     DPOperator* _operator;
+
+    // window of the parallel mode, the window offset is alternated between passes
+    int32_t _window_row_num = 8;
+    int32_t _window_width;
+    int32_t _window_height;
+    int32_t _window_offset_x;
+    int32_t _window_offset_y;
+    int32_t _window_x_num;
+    int32_t _window_y_num;
+    // pin coordinates at the start of a phase, indexed by net pin offset
+    std::vector<int64_t> _net_pin_offset_list;
+    std::vector<Point<int32_t>> _pin_coordi_snapshot;
+
+    void runSerialReorder();
+    void runWindowReorder(int32_t pass_idx);
+    void initWindowInfo(int32_t pass_idx);
+    int32_t obtainWindowIdx(DPCluster* cluster);
+    void updatePinCoordiSnapshot();
+    int64_t reorderCluster(DPCluster* cluster, int32_t window_idx);
+    int64_t calInstPairWindowHPWL(DPInstance* inst_1, DPInstance* inst_2, int32_t window_idx);
+    int64_t calNetWindowHPWL(DPNet* net, int32_t window_idx);
 };
 }
 #endif
\ No newline at end of file
@@ -37,6 +37,7 @@ void ElectricFieldGradient::updateDensityForce(int32_t thread_num)
   }
 
   // do FFT
+  _fft->set_thread_num(thread_num);
   _fft->doFFT();
 
 // update electro phi and electro force
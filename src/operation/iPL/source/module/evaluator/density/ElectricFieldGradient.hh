@@ -15,7 +15,7 @@
 #include <unordered_map>
 
 #include "DensityGradient.hh"
-#include "fft/fft.h"
+#include "fft/density_solver.h"
 
 namespace ipl {
 
@@ -59,10 +59,10 @@ class ElectricFieldGradient : public DensityGradient
 {
  public:
   ElectricFieldGradient() = delete;
-  explicit ElectricFieldGradient(GridManager* grid_manager);
+  explicit ElectricFieldGradient(GridManager* grid_manager, DENSITY_SOLVER_TYPE solver_type = DENSITY_SOLVER_TYPE::kOoura);
   ElectricFieldGradient(const ElectricFieldGradient&) = delete;
   ElectricFieldGradient(ElectricFieldGradient&&)      = delete;
-  ~ElectricFieldGradient() override                   = default;
+  ~ElectricFieldGradient() override { delete _fft; }
 
   ElectricFieldGradient& operator=(const ElectricFieldGradient&) = delete;
   ElectricFieldGradient& operator=(ElectricFieldGradient&&) = delete;
@@ -73,18 +73,19 @@ class ElectricFieldGradient : public DensityGradient
   void reset();
 
  private:
-  float _sum_phi;
-  FFT*  _fft;
+  float               _sum_phi;
+  DensityFieldSolver* _fft;
 
   std::unordered_map<Grid*, ElectroInfo> _electro_map;
   void                                   initElectroMap();
 };
-inline ElectricFieldGradient::ElectricFieldGradient(GridManager* grid_manager) : DensityGradient(grid_manager), _sum_phi(0.0F)
+inline ElectricFieldGradient::ElectricFieldGradient(GridManager* grid_manager, DENSITY_SOLVER_TYPE solver_type)
+    : DensityGradient(grid_manager), _sum_phi(0.0F)
 {
   int32_t grid_size_x = grid_manager->get_grid_size_x();
   int32_t grid_size_y = grid_manager->get_grid_size_y();
 
-  _fft = new FFT(_grid_manager->obtainGridCntX(), _grid_manager->obtainRowCntY(), grid_size_x, grid_size_y);
+  _fft = createDensityFieldSolver(solver_type, _grid_manager->obtainGridCntX(), _grid_manager->obtainRowCntY(), grid_size_x, grid_size_y);
 
   initElectroMap();
 }
@@ -0,0 +1,20 @@
+#include "density_solver.h"
+
+#include "fft.h"
+#include "spectral_solver.h"
+
+namespace ipl {
+
+DensityFieldSolver* createDensityFieldSolver(DENSITY_SOLVER_TYPE type, int binCnt_x, int binCnt_y, int binSize_x, int binSize_y)
+{
+  switch (type) {
+    case DENSITY_SOLVER_TYPE::kOoura:
+      return new FFT(binCnt_x, binCnt_y, binSize_x, binSize_y);
+    case DENSITY_SOLVER_TYPE::kSpectralDouble:
+      return new SpectralSolver<double>(binCnt_x, binCnt_y, binSize_x, binSize_y);
+    default:
+      return new SpectralSolver<float>(binCnt_x, binCnt_y, binSize_x, binSize_y);
+  }
+}
+
+}  // namespace ipl
@@ -0,0 +1,54 @@
+/*
+ * @Description: The solver interface of the electrostatic density field in placer
+ * @FilePath: /iEDA/src/iPL/src/evaluator/density/fft/density_solver.h
+ */
+
+#ifndef IPL_DENSITY_SOLVER_H
+#define IPL_DENSITY_SOLVER_H
+
+#include <cstdint>
+#include <utility>
+
+namespace ipl {
+
+enum class DENSITY_SOLVER_TYPE
+{
+  kNone,
+  kOoura,           // the legacy float** ooura 2d transform.
+  kSpectralFloat,   // the row/column batched transform on contiguous buffers.
+  kSpectralDouble,  // the same as kSpectralFloat with double precision.
+};
+
+/**
+ * Solve the poisson equation of the bin density, the bin grid is binCnt_x * binCnt_y,
+ * both of the count should be a power of 2.
+ */
+class DensityFieldSolver
+{
+ public:
+  DensityFieldSolver() = default;
+  DensityFieldSolver(const DensityFieldSolver&) = delete;
+  DensityFieldSolver(DensityFieldSolver&&) = delete;
+  virtual ~DensityFieldSolver() = default;
+
+  DensityFieldSolver& operator=(const DensityFieldSolver&) = delete;
+  DensityFieldSolver& operator=(DensityFieldSolver&&) = delete;
+
+  void set_thread_num(int32_t thread_num) { _thread_num = thread_num > 0 ? thread_num : 1; }
+
+  virtual void updateDensity(int x, int y, float density) = 0;
+  virtual void doFFT() = 0;
+
+  // return func
+  virtual std::pair<float, float> get_electro_force(int x, int y) = 0;
+  virtual float get_electro_phi(int x, int y) = 0;
+
+ protected:
+  int32_t _thread_num = 8;
+};
+
+DensityFieldSolver* createDensityFieldSolver(DENSITY_SOLVER_TYPE type, int binCnt_x, int binCnt_y, int binSize_x, int binSize_y);
+
+}  // namespace ipl
+
+#endif  // IPL_DENSITY_SOLVER_H
@@ -87,24 +87,24 @@ void FFT::doFFT() {
   ddct2d(_binCnt_x, _binCnt_y, -1, _bin_density, NULL, (int*)&_work_area[0],
          (float*)&_cs_table[0]);
 
-  #pragma omp parallel for num_threads(8)
+  #pragma omp parallel for num_threads(_thread_num)
   for (int i = 0; i < _binCnt_x; i++) {
     _bin_density[i][0] *= 0.5;
   }
 
-  #pragma omp parallel for num_threads(8)
+  #pragma omp parallel for num_threads(_thread_num)
   for (int i = 0; i < _binCnt_y; i++) {
     _bin_density[0][i] *= 0.5;
   }
 
-  #pragma omp parallel for num_threads(8)
+  #pragma omp parallel for num_threads(_thread_num)
   for (int i = 0; i < _binCnt_x; i++) {
     for (int j = 0; j < _binCnt_y; j++) {
       _bin_density[i][j] *= 4.0 / _binCnt_x / _binCnt_y;
     }
   }
 
-  #pragma omp parallel for num_threads(8)
+  #pragma omp parallel for num_threads(_thread_num)
   for (int i = 0; i < _binCnt_x; i++) {
     float wx = _wx[i];
     float wx2 = _wx_square[i];
@@ -13,22 +13,24 @@
 
 #include <vector>
 
-class FFT
+#include "density_solver.h"
+
+class FFT : public ipl::DensityFieldSolver
 {
  public:
   FFT();
   FFT(int binCnt_x, int binCnt_y, int binSize_x, int binSize_y);
-  ~FFT();
+  ~FFT() override;
 
   void init();
 
-  void updateDensity(int x, int y, float density);
+  void updateDensity(int x, int y, float density) override;
 
-  void doFFT();
+  void doFFT() override;
 
   // return func
-  std::pair<float, float> get_electro_force(int x, int y);
-  float                   get_electro_phi(int x, int y);
+  std::pair<float, float> get_electro_force(int x, int y) override;
+  float                   get_electro_phi(int x, int y) override;
 
  private:
   // 2D array; width: binCntX_, height: binCntY_
@@ -0,0 +1,321 @@
+#include "spectral_solver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "omp.h"
+
+#define SPECTRAL_PI 3.141592653589793238462L
+
+namespace ipl {
+
+namespace {
+
+// the column count of one tile, a tile is transposed to make the column transform contiguous.
+constexpr int kColumnBlock = 8;
+
+template <typename T>
+inline std::complex<T> complexMul(const std::complex<T>& a, const std::complex<T>& b)
+{
+  return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+// unnormalized radix-2 fft, the twiddle of each stage is contiguous, the inverse one use the conjugate twiddle.
+template <typename T>
+void complexFFT(const SpectralPlan<T>& plan, std::complex<T>* a, bool is_inverse)
+{
+  const int n = plan.n;
+  for (int i = 0; i < n; i++) {
+    int j = plan.bit_reverse[i];
+    if (i < j) {
+      std::swap(a[i], a[j]);
+    }
+  }
+
+  // the first stage need no multiplication.
+  for (int i = 0; i + 1 < n; i += 2) {
+    std::complex<T> u = a[i];
+    std::complex<T> v = a[i + 1];
+    a[i] = u + v;
+    a[i + 1] = u - v;
+  }
+
+  const std::vector<std::complex<T>>& twiddle = is_inverse ? plan.inverse_twiddle : plan.twiddle;
+  for (int half = 2; half < n; half <<= 1) {
+    const std::complex<T>* w = &twiddle[half];
+    for (int i = 0; i < n; i += 2 * half) {
+      std::complex<T>* lo = a + i;
+      std::complex<T>* hi = a + i + half;
+      for (int k = 0; k < half; k++) {
+        std::complex<T> u = lo[k];
+        std::complex<T> v = complexMul(hi[k], w[k]);
+        lo[k] = u + v;
+        hi[k] = u - v;
+      }
+    }
+  }
+}
+
+// C[k] = sum_j=0^n-1 a[j]*cos(pi*(j+1/2)*k/n), two sequences share one complex fft.
+template <typename T>
+void dctPair(const SpectralPlan<T>& plan, T* a, T* b, std::complex<T>* work)
+{
+  const int n = plan.n;
+  // the transform of length 1 is identity.
+  if (n == 1) {
+    return;
+  }
+  for (int m = 0; m < n / 2; m++) {
+    work[m] = std::complex<T>(a[2 * m], b[2 * m]);
+    work[n - 1 - m] = std::complex<T>(a[2 * m + 1], b[2 * m + 1]);
+  }
+
+  complexFFT(plan, work, false);
+
+  for (int k = 0; k < n; k++) {
+    std::complex<T> z = work[k];
+    std::complex<T> z_conj = std::conj(work[(n - k) & (n - 1)]);
+    std::complex<T> sum = z + z_conj;
+    std::complex<T> diff = z - z_conj;
+    // split the spectrum of a and b.
+    std::complex<T> spec_a(sum.real() / 2, sum.imag() / 2);
+    std::complex<T> spec_b(diff.imag() / 2, -diff.real() / 2);
+
+    const std::complex<T>& s = plan.shift[k];
+    a[k] = s.real() * spec_a.real() - s.imag() * spec_a.imag();
+    b[k] = s.real() * spec_b.real() - s.imag() * spec_b.imag();
+  }
+}
+
+// C[k] = sum_j=0^n-1 a[j]*cos(pi*j*(k+1/2)/n), the spectrum of each sequence is hermitian, so the
+// two real outputs are the real and imag part of one inverse fft.
+template <typename T>
+void idctPair(const SpectralPlan<T>& plan, T* a, T* b, std::complex<T>* work)
+{
+  const int n = plan.n;
+  if (n == 1) {
+    return;
+  }
+  work[0] = std::complex<T>(a[0], b[0]);
+  for (int j = 1; j < n; j++) {
+    std::complex<T> rotate = std::conj(plan.shift[j]);
+    std::complex<T> z_a = complexMul(std::complex<T>(a[j] / 2, -a[n - j] / 2), rotate);
+    std::complex<T> z_b = complexMul(std::complex<T>(b[j] / 2, -b[n - j] / 2), rotate);
+    work[j] = std::complex<T>(z_a.real() - z_b.imag(), z_a.imag() + z_b.real());
+  }
+
+  complexFFT(plan, work, true);
+
+  for (int m = 0; m < n / 2; m++) {
+    a[2 * m] = work[m].real();
+    a[2 * m + 1] = work[n - 1 - m].real();
+    b[2 * m] = work[m].imag();
+    b[2 * m + 1] = work[n - 1 - m].imag();
+  }
+}
+
+// S[k] = sum_j=1^n A[j]*sin(pi*j*(k+1/2)/n), A[n] is stored in a[0].
+// the sine sum is the cosine sum of the reversed input with the odd output negated.
+template <typename T>
+void idstPair(const SpectralPlan<T>& plan, T* a, T* b, std::complex<T>* work)
+{
+  const int n = plan.n;
+  std::reverse(a + 1, a + n);
+  std::reverse(b + 1, b + n);
+
+  idctPair(plan, a, b, work);
+
+  for (int k = 1; k < n; k += 2) {
+    a[k] = -a[k];
+    b[k] = -b[k];
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void SpectralPlan<T>::init(int length)
+{
+  n = length;
+
+  bit_reverse.resize(n);
+  int bits = 0;
+  while ((1 << bits) < n) {
+    bits++;
+  }
+  for (int i = 0; i < n; i++) {
+    int reverse = 0;
+    for (int b = 0; b < bits; b++) {
+      reverse |= ((i >> b) & 1) << (bits - 1 - b);
+    }
+    bit_reverse[i] = reverse;
+  }
+
+  // the twiddle of the stage with half length h is at [h, 2h).
+  twiddle.resize(std::max(n, 1));
+  inverse_twiddle.resize(std::max(n, 1));
+  for (int half = 1; half < n; half <<= 1) {
+    for (int k = 0; k < half; k++) {
+      long double theta = -SPECTRAL_PI * k / half;
+      twiddle[half + k] = std::complex<T>(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+      inverse_twiddle[half + k] = std::conj(twiddle[half + k]);
+    }
+  }
+
+  shift.resize(n);
+  for (int k = 0; k < n; k++) {
+    long double theta = -SPECTRAL_PI * k / (2.0L * n);
+    shift[k] = std::complex<T>(static_cast<T>(std::cos(theta)), static_cast<T>(std::sin(theta)));
+  }
+}
+
+template <typename T>
+SpectralSolver<T>::SpectralSolver(int binCnt_x, int binCnt_y, int binSize_x, int binSize_y)
+    : _binCnt_x(binCnt_x), _binCnt_y(binCnt_y), _binSize_x(binSize_x), _binSize_y(binSize_y)
+{
+  size_t bin_cnt = static_cast<size_t>(_binCnt_x) * _binCnt_y;
+  _bin_density.resize(bin_cnt, 0);
+  _electro_phi.resize(bin_cnt, 0);
+  _electroForce_x.resize(bin_cnt, 0);
+  _electroForce_y.resize(bin_cnt, 0);
+
+  _wx.resize(_binCnt_x, 0);
+  for (int i = 0; i < _binCnt_x; i++) {
+    _wx[i] = SPECTRAL_PI * static_cast<T>(i) / static_cast<T>(_binCnt_x);
+  }
+  _wy.resize(_binCnt_y, 0);
+  for (int i = 0; i < _binCnt_y; i++) {
+    _wy[i] = SPECTRAL_PI * static_cast<T>(i) / static_cast<T>(_binCnt_y) * static_cast<T>(_binSize_y) / static_cast<T>(_binSize_x);
+  }
+
+  _plan_x.init(_binCnt_x);
+  _plan_y.init(_binCnt_y);
+}
+
+template <typename T>
+void SpectralSolver<T>::doFFT()
+{
+  transformRows(_bin_density, TRANSFORM_TYPE::kDCT);
+  transformColumns(_bin_density, TRANSFORM_TYPE::kDCT);
+
+  solvePoisson();
+
+  // Inverse DCT
+  transformRows(_electro_phi, TRANSFORM_TYPE::kIDCT);
+  transformColumns(_electro_phi, TRANSFORM_TYPE::kIDCT);
+  // Inverse DST on x, inverse DCT on y
+  transformRows(_electroForce_x, TRANSFORM_TYPE::kIDCT);
+  transformColumns(_electroForce_x, TRANSFORM_TYPE::kIDST);
+  // Inverse DCT on x, inverse DST on y
+  transformRows(_electroForce_y, TRANSFORM_TYPE::kIDST);
+  transformColumns(_electroForce_y, TRANSFORM_TYPE::kIDCT);
+}
+
+template <typename T>
+void SpectralSolver<T>::transformRows(std::vector<T>& data, TRANSFORM_TYPE type)
+{
+#pragma omp parallel num_threads(_thread_num)
+  {
+    std::vector<std::complex<T>> work(_binCnt_y);
+    std::vector<T> dummy_row;
+
+#pragma omp for schedule(static)
+    for (int x = 0; x < _binCnt_x; x += 2) {
+      T* row_a = &data[index(x, 0)];
+      T* row_b = nullptr;
+      if (x + 1 < _binCnt_x) {
+        row_b = &data[index(x + 1, 0)];
+      } else {
+        // the last row of an odd count is paired with a zero row.
+        dummy_row.assign(_binCnt_y, 0);
+        row_b = dummy_row.data();
+      }
+      if (type == TRANSFORM_TYPE::kDCT) {
+        dctPair(_plan_y, row_a, row_b, work.data());
+      } else if (type == TRANSFORM_TYPE::kIDCT) {
+        idctPair(_plan_y, row_a, row_b, work.data());
+      } else {
+        idstPair(_plan_y, row_a, row_b, work.data());
+      }
+    }
+  }
+}
+
+template <typename T>
+void SpectralSolver<T>::transformColumns(std::vector<T>& data, TRANSFORM_TYPE type)
+{
+  const int block = std::min(_binCnt_y, kColumnBlock);
+
+#pragma omp parallel num_threads(_thread_num)
+  {
+    // one more column for the zero column paired with the last column of an odd count.
+    std::vector<T> tile(static_cast<size_t>(block + 1) * _binCnt_x);
+    std::vector<std::complex<T>> work(_binCnt_x);
+
+#pragma omp for schedule(static)
+    for (int y = 0; y < _binCnt_y; y += block) {
+      const int width = std::min(block, _binCnt_y - y);
+      for (int x = 0; x < _binCnt_x; x++) {
+        const T* src = &data[index(x, y)];
+        for (int c = 0; c < width; c++) {
+          tile[c * _binCnt_x + x] = src[c];
+        }
+      }
+      if (width % 2 == 1) {
+        std::fill(tile.begin() + static_cast<size_t>(width) * _binCnt_x, tile.begin() + static_cast<size_t>(width + 1) * _binCnt_x, 0);
+      }
+
+      for (int c = 0; c < width; c += 2) {
+        T* column_a = &tile[c * _binCnt_x];
+        T* column_b = &tile[(c + 1) * _binCnt_x];
+        if (type == TRANSFORM_TYPE::kDCT) {
+          dctPair(_plan_x, column_a, column_b, work.data());
+        } else if (type == TRANSFORM_TYPE::kIDCT) {
+          idctPair(_plan_x, column_a, column_b, work.data());
+        } else {
+          idstPair(_plan_x, column_a, column_b, work.data());
+        }
+      }
+
+      for (int x = 0; x < _binCnt_x; x++) {
+        T* dst = &data[index(x, y)];
+        for (int c = 0; c < width; c++) {
+          dst[c] = tile[c * _binCnt_x + x];
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void SpectralSolver<T>::solvePoisson()
+{
+  const T scale = static_cast<T>(4.0) / _binCnt_x / _binCnt_y;
+
+#pragma omp parallel for num_threads(_thread_num) schedule(static)
+  for (int i = 0; i < _binCnt_x; i++) {
+    T wx = _wx[i];
+    T wx2 = wx * wx;
+    T row_scale = (i == 0) ? scale * static_cast<T>(0.5) : scale;
+
+    for (int j = 0; j < _binCnt_y; j++) {
+      T wy = _wy[j];
+      T wy2 = wy * wy;
+
+      size_t idx = index(i, j);
+      T density = _bin_density[idx] * ((j == 0) ? row_scale * static_cast<T>(0.5) : row_scale);
+      T phi = (i == 0 && j == 0) ? static_cast<T>(0) : density / (wx2 + wy2);
+
+      _electro_phi[idx] = phi;
+      _electroForce_x[idx] = phi * wx;
+      _electroForce_y[idx] = phi * wy;
+    }
+  }
+}
+
+template struct SpectralPlan<float>;
+template struct SpectralPlan<double>;
+template class SpectralSolver<float>;
+template class SpectralSolver<double>;
+
+}  // namespace ipl
@@ -0,0 +1,86 @@
+/*
+ * @Description: The multithreaded spectral solver of the electrostatic density field in placer
+ * @FilePath: /iEDA/src/iPL/src/evaluator/density/fft/spectral_solver.h
+ */
+
+#ifndef IPL_SPECTRAL_SOLVER_H
+#define IPL_SPECTRAL_SOLVER_H
+
+#include <complex>
+#include <vector>
+
+#include "density_solver.h"
+
+namespace ipl {
+
+// the 1d transform tables of one axis, the length n is a power of 2.
+template <typename T>
+struct SpectralPlan
+{
+  void init(int length);
+
+  int n = 0;
+  std::vector<int> bit_reverse;
+  std::vector<std::complex<T>> twiddle;          // exp(-pi*i*k/h) of each stage, 0<=k<h
+  std::vector<std::complex<T>> inverse_twiddle;  // the conjugate of twiddle
+  std::vector<std::complex<T>> shift;            // exp(-pi*i*k/(2n)), 0<=k<n
+};
+
+/**
+ * The same equation and result layout as FFT, but the bin data is kept in contiguous buffers(x major),
+ * the rows are transformed in place and the columns are transformed by cache blocked tiles,
+ * all the 1d transforms are dispatched by openmp and two real sequences are packed into one complex fft.
+ */
+template <typename T>
+class SpectralSolver : public DensityFieldSolver
+{
+ public:
+  SpectralSolver() = delete;
+  SpectralSolver(int binCnt_x, int binCnt_y, int binSize_x, int binSize_y);
+  ~SpectralSolver() override = default;
+
+  void updateDensity(int x, int y, float density) override { _bin_density[index(x, y)] = density; }
+  void doFFT() override;
+
+  // return func
+  std::pair<float, float> get_electro_force(int x, int y) override
+  {
+    return std::make_pair(static_cast<float>(_electroForce_x[index(x, y)]), static_cast<float>(_electroForce_y[index(x, y)]));
+  }
+  float get_electro_phi(int x, int y) override { return static_cast<float>(_electro_phi[index(x, y)]); }
+
+ private:
+  enum class TRANSFORM_TYPE
+  {
+    kDCT,   // forward dct.
+    kIDCT,  // inverse dct (excluding scale).
+    kIDST   // inverse dst (excluding scale), a[0] is the highest frequency.
+  };
+
+  int _binCnt_x;
+  int _binCnt_y;
+  int _binSize_x;
+  int _binSize_y;
+
+  // length: binCnt_x * binCnt_y, the element (x, y) is at x * binCnt_y + y.
+  std::vector<T> _bin_density;
+  std::vector<T> _electro_phi;
+  std::vector<T> _electroForce_x;
+  std::vector<T> _electroForce_y;
+
+  std::vector<T> _wx;
+  std::vector<T> _wy;
+
+  SpectralPlan<T> _plan_x;
+  SpectralPlan<T> _plan_y;
+
+  size_t index(int x, int y) const { return static_cast<size_t>(x) * _binCnt_y + y; }
+
+  void transformRows(std::vector<T>& data, TRANSFORM_TYPE type);
+  void transformColumns(std::vector<T>& data, TRANSFORM_TYPE type);
+  void solvePoisson();
+};
+
+}  // namespace ipl
+
+#endif  // IPL_SPECTRAL_SOLVER_H
@@ -16,10 +16,28 @@
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <unordered_map>
 
 namespace ipl {
 
-static float fastExp(float a);
+//
+// https://codingforspeed.com/using-faster-exponential-approximation/
+#pragma omp declare simd
+static inline float fastExp(float a)
+{
+  a = 1.0 + a / 1024.0;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  a *= a;
+  return a;
+}
 
 WAWirelengthGradient::WAWirelengthGradient(TopologyManager* topology_manager) : WirelengthGradient(topology_manager)
 {
@@ -28,84 +46,165 @@ WAWirelengthGradient::WAWirelengthGradient(TopologyManager* topology_manager) :
 
 void WAWirelengthGradient::initWAInfo()
 {
-  for (auto* network : _topology_manager->get_network_list()) {
-    _wa_net_map.emplace(network, WANetInfo());
-
-    for (auto* node : network->get_node_list()) {
-      _wa_pin_map.emplace(node, WAPinInfo());
+  const auto& network_list = _topology_manager->get_network_list();
+  _net_list.assign(network_list.begin(), network_list.end());
+
+  _net_pin_start.clear();
+  _net_pin_start.reserve(_net_list.size() + 1);
+  _pin_list.clear();
+  _pin_net_index.clear();
+
+  std::unordered_map<Node*, int32_t> pin_index_map;
+  for (size_t i = 0; i < _net_list.size(); ++i) {
+    _net_pin_start.push_back(_pin_list.size());
+    for (auto* node : _net_list[i]->get_node_list()) {
+      pin_index_map.emplace(node, _pin_list.size());
+      _pin_list.push_back(node);
+      _pin_net_index.push_back(i);
+    }
+  }
+  _net_pin_start.push_back(_pin_list.size());
+  _net_weight.assign(_net_list.size(), 1.0F);
+
+  // the group pins not in any net have no gradient.
+  const auto& group_list = _topology_manager->get_group_list();
+  _group_pin_start.clear();
+  _group_pin_start.reserve(group_list.size() + 1);
+  _group_pin_index.clear();
+  for (auto* group : group_list) {
+    _group_pin_start.push_back(_group_pin_index.size());
+    for (auto* node : group->get_node_list()) {
+      auto it = pin_index_map.find(node);
+      if (it != pin_index_map.end()) {
+        _group_pin_index.push_back(it->second);
+      }
     }
   }
+  _group_pin_start.push_back(_group_pin_index.size());
+
+  size_t pin_num = _pin_list.size();
+  _pin_x.assign(pin_num, 0);
+  _pin_y.assign(pin_num, 0);
+  _pin_min_exp_x.assign(pin_num, 0.0F);
+  _pin_max_exp_x.assign(pin_num, 0.0F);
+  _pin_min_exp_y.assign(pin_num, 0.0F);
+  _pin_max_exp_y.assign(pin_num, 0.0F);
+  _pin_grad_x.assign(pin_num, 0.0F);
+  _pin_grad_y.assign(pin_num, 0.0F);
+
+  _wa_net_info_list.clear();
+  _wa_net_info_list.resize(_net_list.size());
 }
 
 void WAWirelengthGradient::updateWirelengthForce(float coeff_x, float coeff_y, float min_force_bar, int32_t thread_num)
 {
-  // reset all WA variables.
-  for (auto pair : _wa_pin_map) {
-    pair.second.reset();
-  }
-  for (auto pair : _wa_net_map) {
-    pair.second.reset();
+  // gather the pin coordinates to the contiguous arrays.
+  int32_t pin_num = _pin_list.size();
+#pragma omp parallel for num_threads(thread_num)
+  for (int32_t i = 0; i < pin_num; ++i) {
+    Point<int32_t> node_loc = _pin_list[i]->get_location();
+    _pin_x[i] = node_loc.get_x();
+    _pin_y[i] = node_loc.get_y();
   }
 
+  int32_t net_num = _net_list.size();
   // NOLINTNEXTLINE
-  int32_t net_chunk_size = std::max(int(_topology_manager->get_network_list().size() / thread_num / 16), 1);
+  int32_t net_chunk_size = std::max(int(net_num / thread_num / 16), 1);
 #pragma omp parallel for num_threads(thread_num) schedule(dynamic, net_chunk_size)
-  for (auto* network : _topology_manager->get_network_list()) {
-    if (network->isIgnoreNetwork()) {
+  for (int32_t i = 0; i < net_num; ++i) {
+    _net_weight[i] = _net_list[i]->get_net_weight();
+    if (_net_list[i]->isIgnoreNetwork()) {
+      _wa_net_info_list[i].reset();
+      for (int32_t j = _net_pin_start[i]; j < _net_pin_start[i + 1]; ++j) {
+        _pin_min_exp_x[j] = 0.0F;
+        _pin_max_exp_x[j] = 0.0F;
+        _pin_min_exp_y[j] = 0.0F;
+        _pin_max_exp_y[j] = 0.0F;
+      }
       continue;
     }
 
-    WANetInfo wa_net_info;
-
-    Rectangle<int32_t> network_shape = std::move(network->obtainNetWorkShape());
-    for (auto* node : network->get_node_list()) {
-      WAPinInfo wa_pin_info;
-
-      Point<int32_t> node_loc = std::move(node->get_location());
-      float exp_min_x = (network_shape.get_ll_x() - node_loc.get_x()) * coeff_x;
-      float exp_max_x = (node_loc.get_x() - network_shape.get_ur_x()) * coeff_x;
-      float exp_min_y = (network_shape.get_ll_y() - node_loc.get_y()) * coeff_y;
-      float exp_max_y = (node_loc.get_y() - network_shape.get_ur_y()) * coeff_y;
-
-      // min x.
-      if (exp_min_x > min_force_bar) {
-        wa_pin_info.min_ExpSum_x = fastExp(exp_min_x);
-        wa_pin_info.has_MinExpSum_x = 1;
-        wa_net_info.wa_ExpMinSum_x += wa_pin_info.min_ExpSum_x;
-        wa_net_info.wa_X_ExpMinSum_x += node_loc.get_x() * wa_pin_info.min_ExpSum_x;
-      }
-
-      // max x.
-      if (exp_max_x > min_force_bar) {
-        wa_pin_info.max_ExpSum_x = fastExp(exp_max_x);
-        wa_pin_info.has_MaxExpSum_x = 1;
-        wa_net_info.wa_ExpMaxSum_x += wa_pin_info.max_ExpSum_x;
-        wa_net_info.wa_X_ExpMaxSum_x += node_loc.get_x() * wa_pin_info.max_ExpSum_x;
-      }
-
-      // min y.
-      if (exp_min_y > min_force_bar) {
-        wa_pin_info.min_ExpSum_y = fastExp(exp_min_y);
-        wa_pin_info.has_MinExpSum_y = 1;
-        wa_net_info.wa_ExpMinSum_y += wa_pin_info.min_ExpSum_y;
-        wa_net_info.wa_Y_ExpMinSum_y += node_loc.get_y() * wa_pin_info.min_ExpSum_y;
-      }
+    updateNetWAInfo(i, coeff_x, coeff_y, min_force_bar);
+  }
 
-      // max y.
-      if (exp_max_y > min_force_bar) {
-        wa_pin_info.max_ExpSum_y = fastExp(exp_max_y);
-        wa_pin_info.has_MaxExpSum_y = 1;
-        wa_net_info.wa_ExpMaxSum_y += wa_pin_info.max_ExpSum_y;
-        wa_net_info.wa_Y_ExpMaxSum_y += node_loc.get_y() * wa_pin_info.max_ExpSum_y;
-      }
+  // pin gradient, which is summed by the group.
+#pragma omp parallel for num_threads(thread_num)
+  for (int32_t i = 0; i < pin_num; ++i) {
+    Point<float> pin_gradient_pair = obtainPinWirelengthGradient(i, coeff_x, coeff_y);
+    float net_weight = _net_weight[_pin_net_index[i]];
+    _pin_grad_x[i] = pin_gradient_pair.get_x() * net_weight;
+    _pin_grad_y[i] = pin_gradient_pair.get_y() * net_weight;
+  }
+}
 
-      auto& cur_node_info = _wa_pin_map.find(node)->second;
-      cur_node_info = std::move(wa_pin_info);
-    }
+void WAWirelengthGradient::updateNetWAInfo(int32_t net_index, float coeff_x, float coeff_y, float min_force_bar)
+{
+  const int32_t begin = _net_pin_start[net_index];
+  const int32_t end = _net_pin_start[net_index + 1];
+
+  const int32_t* pin_x = _pin_x.data();
+  const int32_t* pin_y = _pin_y.data();
+  float* pin_min_exp_x = _pin_min_exp_x.data();
+  float* pin_max_exp_x = _pin_max_exp_x.data();
+  float* pin_min_exp_y = _pin_min_exp_y.data();
+  float* pin_max_exp_y = _pin_max_exp_y.data();
+
+  // network shape.
+  int32_t lower_x = INT32_MAX;
+  int32_t lower_y = INT32_MAX;
+  int32_t upper_x = INT32_MIN;
+  int32_t upper_y = INT32_MIN;
+#pragma omp simd reduction(min : lower_x, lower_y) reduction(max : upper_x, upper_y)
+  for (int32_t i = begin; i < end; ++i) {
+    lower_x = std::min(lower_x, pin_x[i]);
+    lower_y = std::min(lower_y, pin_y[i]);
+    upper_x = std::max(upper_x, pin_x[i]);
+    upper_y = std::max(upper_y, pin_y[i]);
+  }
 
-    auto& cur_network_info = _wa_net_map.find(network)->second;
-    cur_network_info = std::move(wa_net_info);
+  float exp_min_sum_x = 0, x_exp_min_sum_x = 0;
+  float exp_max_sum_x = 0, x_exp_max_sum_x = 0;
+  float exp_min_sum_y = 0, y_exp_min_sum_y = 0;
+  float exp_max_sum_y = 0, y_exp_max_sum_y = 0;
+
+  // the branch is replaced by select, so the loop could be vectorized.
+#pragma omp simd reduction(+ : exp_min_sum_x, x_exp_min_sum_x, exp_max_sum_x, x_exp_max_sum_x, exp_min_sum_y, y_exp_min_sum_y, \
+                               exp_max_sum_y, y_exp_max_sum_y)
+  for (int32_t i = begin; i < end; ++i) {
+    float exp_min_x = (lower_x - pin_x[i]) * coeff_x;
+    float exp_max_x = (pin_x[i] - upper_x) * coeff_x;
+    float exp_min_y = (lower_y - pin_y[i]) * coeff_y;
+    float exp_max_y = (pin_y[i] - upper_y) * coeff_y;
+
+    float min_exp_x = exp_min_x > min_force_bar ? fastExp(exp_min_x) : 0.0F;
+    float max_exp_x = exp_max_x > min_force_bar ? fastExp(exp_max_x) : 0.0F;
+    float min_exp_y = exp_min_y > min_force_bar ? fastExp(exp_min_y) : 0.0F;
+    float max_exp_y = exp_max_y > min_force_bar ? fastExp(exp_max_y) : 0.0F;
+
+    pin_min_exp_x[i] = min_exp_x;
+    pin_max_exp_x[i] = max_exp_x;
+    pin_min_exp_y[i] = min_exp_y;
+    pin_max_exp_y[i] = max_exp_y;
+
+    exp_min_sum_x += min_exp_x;
+    x_exp_min_sum_x += pin_x[i] * min_exp_x;
+    exp_max_sum_x += max_exp_x;
+    x_exp_max_sum_x += pin_x[i] * max_exp_x;
+    exp_min_sum_y += min_exp_y;
+    y_exp_min_sum_y += pin_y[i] * min_exp_y;
+    exp_max_sum_y += max_exp_y;
+    y_exp_max_sum_y += pin_y[i] * max_exp_y;
   }
+
+  auto& wa_net_info = _wa_net_info_list[net_index];
+  wa_net_info.wa_ExpMinSum_x = exp_min_sum_x;
+  wa_net_info.wa_X_ExpMinSum_x = x_exp_min_sum_x;
+  wa_net_info.wa_ExpMaxSum_x = exp_max_sum_x;
+  wa_net_info.wa_X_ExpMaxSum_x = x_exp_max_sum_x;
+  wa_net_info.wa_ExpMinSum_y = exp_min_sum_y;
+  wa_net_info.wa_Y_ExpMinSum_y = y_exp_min_sum_y;
+  wa_net_info.wa_ExpMaxSum_y = exp_max_sum_y;
+  wa_net_info.wa_Y_ExpMaxSum_y = y_exp_max_sum_y;
 }
 
 void WAWirelengthGradient::waWLAnalyzeForDebug(float coeff_x, float coeff_y)
@@ -118,7 +217,8 @@ void WAWirelengthGradient::waWLAnalyzeForDebug(float coeff_x, float coeff_y)
   }
   std::stringstream feed;
 
-  for (auto* network : _topology_manager->get_network_list()) {
+  for (size_t i = 0; i < _net_list.size(); ++i) {
+    auto* network = _net_list[i];
     if (network->isIgnoreNetwork()) {
       continue;
     }
@@ -127,7 +227,7 @@ void WAWirelengthGradient::waWLAnalyzeForDebug(float coeff_x, float coeff_y)
       continue;
     }
 
-    auto& wa_net_info = _wa_net_map[network];
+    auto& wa_net_info = _wa_net_info_list[i];
     float func_x_value
         = wa_net_info.wa_X_ExpMaxSum_x / wa_net_info.wa_ExpMaxSum_x - wa_net_info.wa_X_ExpMinSum_x / wa_net_info.wa_ExpMinSum_x;
     float func_y_value
@@ -136,9 +236,9 @@ void WAWirelengthGradient::waWLAnalyzeForDebug(float coeff_x, float coeff_y)
     feed << func_x_value << "," << func_y_value << std::endl;
     feed << network->get_node_list().size() << std::endl;
 
-    for (auto* node : network->get_node_list()) {
-      Point<int32_t> pin_coordi = node->get_location();
-      Point<float> pin_gradient_pair = obtainPinWirelengthGradient(node, coeff_x, coeff_y);
+    for (int32_t j = _net_pin_start[i]; j < _net_pin_start[i + 1]; ++j) {
+      Point<int32_t> pin_coordi = _pin_list[j]->get_location();
+      Point<float> pin_gradient_pair = obtainPinWirelengthGradient(j, coeff_x, coeff_y);
 
       feed << pin_coordi.get_x() << "," << pin_coordi.get_y() << std::endl;
       feed << pin_gradient_pair.get_x() << "," << pin_gradient_pair.get_y() << std::endl;
@@ -152,95 +252,75 @@ void WAWirelengthGradient::waWLAnalyzeForDebug(float coeff_x, float coeff_y)
   std::cout << "append gradientAnalyze_4pins.txt to ./result/pl/" << std::endl;
 }
 
-Point<float> WAWirelengthGradient::obtainWirelengthGradient(std::string inst_name, float coeff_x, float coeff_y)
+Point<float> WAWirelengthGradient::obtainWirelengthGradient(int32_t group_id)
 {
   float gradient_x = 0.0F;
   float gradient_y = 0.0F;
 
-  auto* group = _topology_manager->findGroup(inst_name);
-  if (group) {
-    for (auto* node : group->get_node_list()) {
-      Point<float> pin_gradient_pair = obtainPinWirelengthGradient(node, coeff_x, coeff_y);
-
-      // add net weight.
-      float pin_gradient_x = pin_gradient_pair.get_x() * node->get_network()->get_net_weight();
-      float pin_gradient_y = pin_gradient_pair.get_y() * node->get_network()->get_net_weight();
+  // the filler is not in the topology.
+  if (group_id < 0 || group_id + 1 >= static_cast<int32_t>(_group_pin_start.size())) {
+    return Point<float>(gradient_x, gradient_y);
+  }
 
-      gradient_x += pin_gradient_x;
-      gradient_y += pin_gradient_y;
-    }
+  for (int32_t i = _group_pin_start[group_id]; i < _group_pin_start[group_id + 1]; ++i) {
+    gradient_x += _pin_grad_x[_group_pin_index[i]];
+    gradient_y += _pin_grad_y[_group_pin_index[i]];
   }
 
   return Point<float>(gradient_x, gradient_y);
 }
 
-Point<float> WAWirelengthGradient::obtainPinWirelengthGradient(Node* pin, float coeff_x, float coeff_y)
+Point<float> WAWirelengthGradient::obtainPinWirelengthGradient(int32_t pin_index, float coeff_x, float coeff_y)
 {
   float gradient_min_x = 0, gradient_min_y = 0;
   float gradient_max_x = 0, gradient_max_y = 0;
 
-  WAPinInfo pin_info = _wa_pin_map.find(pin)->second;
-  WANetInfo net_info = _wa_net_map.find(pin->get_network())->second;
+  const WANetInfo& net_info = _wa_net_info_list[_pin_net_index[pin_index]];
+
+  float pin_x = _pin_x[pin_index];
+  float pin_y = _pin_y[pin_index];
+  float min_exp_x = _pin_min_exp_x[pin_index];
+  float max_exp_x = _pin_max_exp_x[pin_index];
+  float min_exp_y = _pin_min_exp_y[pin_index];
+  float max_exp_y = _pin_max_exp_y[pin_index];
 
   // min x.
-  if (pin_info.has_MinExpSum_x == 1) {
+  if (min_exp_x != 0.0F) {
     float wa_exp_min_sum_x = net_info.wa_ExpMinSum_x;
     float wa_x_exp_min_sum_x = net_info.wa_X_ExpMinSum_x;
 
-    gradient_min_x = (wa_exp_min_sum_x * (pin_info.min_ExpSum_x * (1.0 - coeff_x * pin->get_location().get_x()))
-                      + coeff_x * pin_info.min_ExpSum_x * wa_x_exp_min_sum_x)
+    gradient_min_x = (wa_exp_min_sum_x * (min_exp_x * (1.0 - coeff_x * pin_x)) + coeff_x * min_exp_x * wa_x_exp_min_sum_x)
                      / (wa_exp_min_sum_x * wa_exp_min_sum_x);
   }
 
   // max x.
-  if (pin_info.has_MaxExpSum_x == 1) {
+  if (max_exp_x != 0.0F) {
     float wa_exp_max_sum_x = net_info.wa_ExpMaxSum_x;
     float wa_x_exp_max_sum_x = net_info.wa_X_ExpMaxSum_x;
 
-    gradient_max_x = (wa_exp_max_sum_x * (pin_info.max_ExpSum_x * (1.0 + coeff_x * pin->get_location().get_x()))
-                      - coeff_x * pin_info.max_ExpSum_x * wa_x_exp_max_sum_x)
+    gradient_max_x = (wa_exp_max_sum_x * (max_exp_x * (1.0 + coeff_x * pin_x)) - coeff_x * max_exp_x * wa_x_exp_max_sum_x)
                      / (wa_exp_max_sum_x * wa_exp_max_sum_x);
   }
 
   // min y.
-  if (pin_info.has_MinExpSum_y == 1) {
+  if (min_exp_y != 0.0F) {
     float wa_exp_min_sum_y = net_info.wa_ExpMinSum_y;
     float wa_y_exp_min_sum_y = net_info.wa_Y_ExpMinSum_y;
 
-    gradient_min_y = (wa_exp_min_sum_y * (pin_info.min_ExpSum_y * (1.0 - coeff_y * pin->get_location().get_y()))
-                      + coeff_y * pin_info.min_ExpSum_y * wa_y_exp_min_sum_y)
+    gradient_min_y = (wa_exp_min_sum_y * (min_exp_y * (1.0 - coeff_y * pin_y)) + coeff_y * min_exp_y * wa_y_exp_min_sum_y)
                      / (wa_exp_min_sum_y * wa_exp_min_sum_y);
   }
 
   // max y.
-  if (pin_info.has_MaxExpSum_y == 1) {
+  if (max_exp_y != 0.0F) {
     float wa_exp_max_sum_y = net_info.wa_ExpMaxSum_y;
     float wa_y_exp_max_sum_y = net_info.wa_Y_ExpMaxSum_y;
 
-    gradient_max_y = (wa_exp_max_sum_y * (pin_info.max_ExpSum_y * (1.0 + coeff_y * pin->get_location().get_y()))
-                      - coeff_y * pin_info.max_ExpSum_y * wa_y_exp_max_sum_y)
+    gradient_max_y = (wa_exp_max_sum_y * (max_exp_y * (1.0 + coeff_y * pin_y)) - coeff_y * max_exp_y * wa_y_exp_max_sum_y)
                      / (wa_exp_max_sum_y * wa_exp_max_sum_y);
   }
 
   return Point<float>(gradient_min_x - gradient_max_x, gradient_min_y - gradient_max_y);
 }
 
-//
-// https://codingforspeed.com/using-faster-exponential-approximation/
-static float fastExp(float a)
-{
-  a = 1.0 + a / 1024.0;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  a *= a;
-  return a;
-}
-
-}  // namespace ipl
\ No newline at end of file
+}  // namespace ipl
@@ -11,70 +11,13 @@
 #ifndef IPL_EVALUATOR_WA_WIRELENGTH_GRADIENT_H
 #define IPL_EVALUATOR_WA_WIRELENGTH_GRADIENT_H
 
-#include <map>
+#include <vector>
 
 #include "WirelengthGradient.hh"
 #include "data/Rectangle.hh"
 
 namespace ipl {
 
-struct WAPinInfo
-{
-  WAPinInfo();
-  WAPinInfo(const WAPinInfo&) = default;
-  WAPinInfo(WAPinInfo&&)      = default;
-
-  WAPinInfo& operator=(const WAPinInfo&) = delete;
-  WAPinInfo& operator                    =(WAPinInfo&& other)
-  {
-    max_ExpSum_x    = other.max_ExpSum_x;
-    max_ExpSum_y    = other.max_ExpSum_y;
-    min_ExpSum_x    = other.min_ExpSum_x;
-    min_ExpSum_y    = other.min_ExpSum_y;
-    has_MaxExpSum_x = other.has_MaxExpSum_x;
-    has_MaxExpSum_y = other.has_MaxExpSum_y;
-    has_MinExpSum_x = other.has_MinExpSum_x;
-    has_MinExpSum_y = other.has_MinExpSum_y;
-
-    return (*this);
-  }
-
-  void reset();
-
-  // maxExpSum_: holds exp(x_i/gamma)
-  // minExpSum_: holds exp(-x_i/gamma)
-  // the x_i is equal to cx_ variable.
-  //
-  float max_ExpSum_x = 0;
-  float max_ExpSum_y = 0;
-  float min_ExpSum_x = 0;
-  float min_ExpSum_y = 0;
-  // flag variables
-  // check whether
-  // this pin is considered in a WA models.
-  //
-  unsigned char has_MaxExpSum_x : 1;
-  unsigned char has_MaxExpSum_y : 1;
-
-  unsigned char has_MinExpSum_x : 1;
-  unsigned char has_MinExpSum_y : 1;
-};
-inline WAPinInfo::WAPinInfo() : has_MaxExpSum_x(0), has_MaxExpSum_y(0), has_MinExpSum_x(0), has_MinExpSum_y(0)
-{
-}
-
-inline void WAPinInfo::reset()
-{
-  max_ExpSum_x    = 0;
-  max_ExpSum_y    = 0;
-  min_ExpSum_x    = 0;
-  min_ExpSum_y    = 0;
-  has_MaxExpSum_x = 0;
-  has_MaxExpSum_y = 0;
-  has_MinExpSum_x = 0;
-  has_MinExpSum_y = 0;
-}
-
 struct WANetInfo
 {
   WANetInfo()                 = default;
@@ -146,21 +89,43 @@ class WAWirelengthGradient : public WirelengthGradient
 
   void updateWirelengthForce(float coeff_x, float coeff_y, float min_force_bar, int32_t thread_num) override;
 
-  Point<float> obtainWirelengthGradient(std::string inst_name, float coeff_x, float coeff_y) override;
-  Point<float> obtainPinWirelengthGradient(Node* pin, float coeff_x, float coeff_y);
+  Point<float> obtainWirelengthGradient(int32_t group_id) override;
 
   // Debug
   void waWLAnalyzeForDebug(float coeff_x, float coeff_y) override;
 
  private:
-  std::map<Node*, WAPinInfo>    _wa_pin_map;
-  std::map<NetWork*, WANetInfo> _wa_net_map;
+  // flattened net->pin layout(CSR), the pins of net i is in [_net_pin_start[i], _net_pin_start[i + 1]).
+  std::vector<NetWork*> _net_list;
+  std::vector<int32_t>  _net_pin_start;
+  std::vector<Node*>    _pin_list;
+  std::vector<int32_t>  _pin_net_index;
+  std::vector<float>    _net_weight;
+
+  // the pins of group i is _group_pin_index[_group_pin_start[i], _group_pin_start[i + 1]).
+  std::vector<int32_t> _group_pin_start;
+  std::vector<int32_t> _group_pin_index;
+
+  // pin coordinates, gathered before each evaluation.
+  std::vector<int32_t> _pin_x;
+  std::vector<int32_t> _pin_y;
+
+  // pin exp value, zero means the pin is not considered in the WA model.
+  // min_exp holds exp((ll - x)/gamma), max_exp holds exp((x - ur)/gamma).
+  std::vector<float> _pin_min_exp_x;
+  std::vector<float> _pin_max_exp_x;
+  std::vector<float> _pin_min_exp_y;
+  std::vector<float> _pin_max_exp_y;
+
+  std::vector<WANetInfo> _wa_net_info_list;
+
+  // pin gradient with the net weight.
+  std::vector<float> _pin_grad_x;
+  std::vector<float> _pin_grad_y;
 
   void initWAInfo();
-  void resetWAPinInfo() {}
-  void resetWANetInfo() {}
-
-
+  void updateNetWAInfo(int32_t net_index, float coeff_x, float coeff_y, float min_force_bar);
+  Point<float> obtainPinWirelengthGradient(int32_t pin_index, float coeff_x, float coeff_y);
 };
 
 }  // namespace ipl
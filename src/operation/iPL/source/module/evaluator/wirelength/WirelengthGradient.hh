@@ -29,7 +29,8 @@ class WirelengthGradient
   WirelengthGradient& operator=(WirelengthGradient&&) = delete;
 
   virtual void updateWirelengthForce(float coeff_x, float coeff_y, float min_force_bar, int32_t thread_num) = 0;
-  virtual Point<float> obtainWirelengthGradient(std::string inst_name, float coeff_x, float coeff_y) = 0;
+  // the gradient of the group(instance) computed by the last updateWirelengthForce.
+  virtual Point<float> obtainWirelengthGradient(int32_t group_id) = 0;
 
   // Debug
   virtual void waWLAnalyzeForDebug(float coeff_x, float coeff_y) = 0;
@@ -213,7 +213,16 @@ void NesterovPlace::initGridManager()
   _nes_database->_grid_manager = grid_manager;
   _nes_database->_bin_grid = new BinGrid(grid_manager);
   _nes_database->_density = new Density(grid_manager);
-  _nes_database->_density_gradient = new ElectricFieldGradient(grid_manager);  // TODO : be optional.
+  // the spectral solvers are optional, the ooura solver keeps the default result.
+  DENSITY_SOLVER_TYPE solver_type = DENSITY_SOLVER_TYPE::kOoura;
+  if (_nes_config.get_density_solver() == "SpectralFloat") {
+    solver_type = DENSITY_SOLVER_TYPE::kSpectralFloat;
+  } else if (_nes_config.get_density_solver() == "SpectralDouble") {
+    solver_type = DENSITY_SOLVER_TYPE::kSpectralDouble;
+  } else if (_nes_config.get_density_solver() != "Ooura") {
+    LOG_WARNING << "Unknown density solver : " << _nes_config.get_density_solver() << ", use Ooura instead.";
+  }
+  _nes_database->_density_gradient = new ElectricFieldGradient(grid_manager, solver_type);
 }
 
 void NesterovPlace::initTopologyManager()
@@ -249,6 +258,7 @@ void NesterovPlace::initTopologyManager()
 
   for (auto* n_inst : _nes_database->_nInstance_list) {
     Group* group = new Group(n_inst->get_name());
+    n_inst->set_group_id(topo_manager->get_group_list().size());
 
     for (auto* n_pin : n_inst->get_nPin_list()) {
       Node* node = topo_manager->findNode(n_pin->get_name());
@@ -790,8 +800,7 @@ void NesterovPlace::updatePenaltyGradientPre1(std::vector<NesInstance*>& nInst_l
   for (size_t i = 0; i < nInst_list.size(); i++) {
     auto& cur_n_inst = nInst_list[i];
 
-    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(
-        cur_n_inst->get_name(), _nes_database->_wirelength_coef, _nes_database->_wirelength_coef));
+    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(cur_n_inst->get_group_id()));
     density_grads[i] = std::move(
         _nes_database->_density_gradient->obtainDensityGradient(cur_n_inst->get_density_shape(), cur_n_inst->get_density_scale()));
 
@@ -862,8 +871,7 @@ void NesterovPlace::updatePenaltyGradientPre2(std::vector<NesInstance*>& nInst_l
   for (size_t i = 0; i < nInst_list.size(); i++) {
     auto& cur_n_inst = nInst_list[i];
 
-    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(
-        cur_n_inst->get_name(), _nes_database->_wirelength_coef, _nes_database->_wirelength_coef));
+    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(cur_n_inst->get_group_id()));
     density_grads[i] = std::move(
         _nes_database->_density_gradient->obtainDensityGradient(cur_n_inst->get_density_shape(), cur_n_inst->get_density_scale()));
 
@@ -914,8 +922,7 @@ void NesterovPlace::updatePenaltyGradient(std::vector<NesInstance*>& nInst_list,
   for (size_t i = 0; i < nInst_list.size(); i++) {
     auto& cur_n_inst = nInst_list[i];
 
-    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(
-        cur_n_inst->get_name(), _nes_database->_wirelength_coef, _nes_database->_wirelength_coef));
+    wirelength_grads[i] = std::move(_nes_database->_wirelength_gradient->obtainWirelengthGradient(cur_n_inst->get_group_id()));
     density_grads[i] = std::move(
         _nes_database->_density_gradient->obtainDensityGradient(cur_n_inst->get_density_shape(), cur_n_inst->get_density_scale()));
 
@@ -1401,12 +1408,21 @@ void NesterovPlace::NesterovRoutablitySolve(std::vector<NesInstance*>& inst_list
       num_call_routability++;
       LOG_INFO << "Routability-driven placement: num_call: " << num_call_routability;
 
-      // update placeDB && dmInst, get route congestion
+      // update placeDB, get route congestion. the router is built from dmInst at the first call,
+      // then the pins are moved in the router directly.
       writeBackPlacerDB();
-      PlacerDBInst.writeBackSourceDataBase();
       eval::EvalAPI& eval_api = eval::EvalAPI::initInst();
       eval_api.initCongestionEval();
-      std::vector<float> gr_congestion = eval_api.evalGRCong();
+      std::map<std::string, std::pair<int, int>> pin_coord_map = obtainPinCoordMap();
+      std::vector<float> gr_congestion;
+      if (num_call_routability == 1) {
+        PlacerDBInst.writeBackSourceDataBase();
+        gr_congestion = eval_api.initGRCongSession(pin_coord_map);
+      } else {
+        const std::vector<int>& grid_info = eval_api.getTileGridCoordSizeCntXY();
+        int move_threshold = std::min(grid_info[2], grid_info[3]) / 2;
+        gr_congestion = eval_api.updateGRCongSession(pin_coord_map, move_threshold);
+      }
       LOG_INFO << "Routability-driven placement: ACE: " << gr_congestion[0] << " TOF: " << gr_congestion[1] << " MOF: " << gr_congestion[2];
 
       // no need if ACE is lower than target_rc
@@ -1565,10 +1581,24 @@ void NesterovPlace::NesterovRoutablitySolve(std::vector<NesInstance*>& inst_list
     long_net_stream.close();
   }
 
+  if (num_call_routability > 0) {
+    eval::EvalAPI::getInst().destroyGRCongSession();
+  }
+
   // update PlacerDB.
   writeBackPlacerDB();
 }
 
+std::map<std::string, std::pair<int, int>> NesterovPlace::obtainPinCoordMap()
+{
+  std::map<std::string, std::pair<int, int>> pin_coord_map;
+  for (auto* pin : _nes_database->_placer_db->get_design()->get_pin_list()) {
+    Point<int32_t> pin_coordi = pin->get_center_coordi();
+    pin_coord_map.emplace(pin->get_name(), std::make_pair(pin_coordi.get_x(), pin_coordi.get_y()));
+  }
+  return pin_coord_map;
+}
+
 /*****************************Congestion-driven Placement: END*****************************/
 
 void NesterovPlace::writeBackPlacerDB()
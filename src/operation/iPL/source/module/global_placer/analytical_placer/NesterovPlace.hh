@@ -84,6 +84,7 @@ class NesterovPlace
   int64_t obtainTotalArea(std::vector<NesInstance*>& inst_list);
   float obtainPhiCoef(float scaled_diff_hpwl);
   int64_t obtainTotalFillerArea(std::vector<NesInstance*>& inst_list);
+  std::map<std::string, std::pair<int, int>> obtainPinCoordMap();
 
   void writeBackPlacerDB();
 
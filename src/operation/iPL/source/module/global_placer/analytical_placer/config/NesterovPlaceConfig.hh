@@ -34,6 +34,7 @@ class NesterovPlaceConfig
   float   get_target_density() const { return _target_density; }
   int32_t get_bin_cnt_x() const { return _bin_cnt_x; }
   int32_t get_bin_cnt_y() const { return _bin_cnt_y; }
+  std::string get_density_solver() const { return _density_solver; }
   float   get_min_phi_coef() const { return _min_phi_coef; }
   float   get_max_phi_coef() const { return _max_phi_coef; }
   int32_t get_max_iter() const { return _max_iter; }
@@ -54,6 +55,7 @@ class NesterovPlaceConfig
   void set_target_density(float target_density) { _target_density = target_density; }
   void set_bin_cnt_x(float bin_cnt_x) { _bin_cnt_x = bin_cnt_x; }
   void set_bin_cnt_y(float bin_cnt_y) { _bin_cnt_y = bin_cnt_y; }
+  void set_density_solver(std::string density_solver) { _density_solver = density_solver; }
   void set_min_phi_coef(float min_phi_coef) { _min_phi_coef = min_phi_coef; }
   void set_max_phi_coef(float max_phi_coef) { _max_phi_coef = max_phi_coef; }
   void set_max_iter(int32_t max_iter) { _max_iter = max_iter; }
@@ -78,6 +80,7 @@ class NesterovPlaceConfig
   float   _target_density;
   int32_t _bin_cnt_x;
   int32_t _bin_cnt_y;
+  std::string _density_solver;
 
   // about nesterov.
   int32_t _max_iter;
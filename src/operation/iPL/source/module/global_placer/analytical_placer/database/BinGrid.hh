@@ -11,7 +11,9 @@
 #ifndef IPL_OPERATOR_NESTEROV_PLACE_DATABASE_BIN_GRID_H
 #define IPL_OPERATOR_NESTEROV_PLACE_DATABASE_BIN_GRID_H
 
+#include <algorithm>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "GridManager.hh"
@@ -20,26 +22,6 @@
 
 namespace ipl {
 
-struct AreaInfo
-{
-  AreaInfo();
-
-  void reset();
-
-  int64_t macro_area;
-  int64_t stdcell_area;
-  int64_t filler_area;
-};
-inline AreaInfo::AreaInfo() : macro_area(int64_t(0)), stdcell_area(int64_t(0)), filler_area(int64_t(0))
-{
-}
-inline void AreaInfo::reset()
-{
-  macro_area = 0;
-  stdcell_area = 0;
-  filler_area = 0;
-}
-
 class BinGrid
 {
  public:
@@ -59,24 +41,40 @@ class BinGrid
   GridManager* _grid_manager;
 
   std::unordered_multimap<Grid*, NesInstance*> _bin_to_nInsts;
-  std::unordered_map<Grid*, AreaInfo> _bin_to_area;
-  void resetBinToArea();
+
+  // dense bin arrays, the bin (row_idx, grid_idx) is at row_idx * _grid_cnt_x + grid_idx.
+  int32_t _grid_cnt_x;
+  int32_t _grid_cnt_y;
+  std::vector<Grid*> _grid_list;
+  std::vector<int64_t> _bin_macro_area;
+  std::vector<int64_t> _bin_stdcell_area;
+  std::vector<int64_t> _bin_filler_area;
+
+  // the bin rows are splitted to bands, one band is scattered by one thread, so no atomic is needed.
+  int32_t _band_row_cnt;
+  std::vector<std::vector<NesInstance*>> _band_to_nInsts;
 
   void addBinnInstConnection(Grid* bin, NesInstance* nInst);
-  void addBinMacroAreaInfo(Grid* bin, int64_t macro_area);
-  void addBinStdcellAreaInfo(Grid* bin, int64_t stdcell_area);
-  void addBinFillerAreaInfo(Grid* bin, int64_t filler_area);
+  void initBandList(int32_t thread_num);
+  void scatterBand(int32_t band_idx);
+  std::pair<int32_t, int32_t> obtainOverlapIdxRange(int32_t border_lower, int32_t grid_size, int32_t grid_cnt, int32_t lower, int32_t upper);
 };
-inline BinGrid::BinGrid(GridManager* grid_manager) : _grid_manager(grid_manager)
+inline BinGrid::BinGrid(GridManager* grid_manager) : _grid_manager(grid_manager), _band_row_cnt(1)
 {
-}
+  auto& row_list = _grid_manager->get_row_list();
+  _grid_cnt_y = row_list.size();
+  _grid_cnt_x = _grid_cnt_y > 0 ? _grid_manager->obtainGridCntX() : 0;
 
-inline void BinGrid::resetBinToArea()
-{
-  for (auto& pair : _bin_to_area) {
-    auto& area_info = pair.second;
-    area_info.reset();
+  _grid_list.reserve(static_cast<size_t>(_grid_cnt_x) * _grid_cnt_y);
+  for (auto* row : row_list) {
+    for (auto* grid : row->get_grid_list()) {
+      _grid_list.push_back(grid);
+    }
   }
+
+  _bin_macro_area.resize(_grid_list.size(), 0);
+  _bin_stdcell_area.resize(_grid_list.size(), 0);
+  _bin_filler_area.resize(_grid_list.size(), 0);
 }
 
 inline void BinGrid::addBinnInstConnection(Grid* bin, NesInstance* nInst)
@@ -84,60 +82,137 @@ inline void BinGrid::addBinnInstConnection(Grid* bin, NesInstance* nInst)
   _bin_to_nInsts.emplace(bin, nInst);
 }
 
+inline std::pair<int32_t, int32_t> BinGrid::obtainOverlapIdxRange(int32_t border_lower, int32_t grid_size, int32_t grid_cnt, int32_t lower,
+                                                                  int32_t upper)
+{
+  int32_t lower_idx = (lower - border_lower) / grid_size;
+  int32_t upper_idx = (upper - border_lower + grid_size - 1) / grid_size;
+  return std::make_pair(std::max(lower_idx, 0), std::min(upper_idx, grid_cnt));
+}
+
+inline void BinGrid::initBandList(int32_t thread_num)
+{
+  int32_t band_cnt = std::max(1, std::min(thread_num * 4, _grid_cnt_y));
+  _band_row_cnt = (_grid_cnt_y + band_cnt - 1) / band_cnt;
+  band_cnt = (_grid_cnt_y + _band_row_cnt - 1) / _band_row_cnt;
+
+  _band_to_nInsts.resize(band_cnt);
+  for (auto& band_nInsts : _band_to_nInsts) {
+    band_nInsts.clear();  // keep the capacity for next update.
+  }
+}
+
+inline void BinGrid::scatterBand(int32_t band_idx)
+{
+  auto core_shape = _grid_manager->get_shape();
+  int32_t grid_size_x = _grid_manager->get_grid_size_x();
+  int32_t grid_size_y = _grid_manager->get_grid_size_y();
+
+  int32_t band_lower_row = band_idx * _band_row_cnt;
+  int32_t band_upper_row = std::min(band_lower_row + _band_row_cnt, _grid_cnt_y);
+
+  size_t band_lower_idx = static_cast<size_t>(band_lower_row) * _grid_cnt_x;
+  size_t band_upper_idx = static_cast<size_t>(band_upper_row) * _grid_cnt_x;
+  std::fill(_bin_macro_area.begin() + band_lower_idx, _bin_macro_area.begin() + band_upper_idx, 0);
+  std::fill(_bin_stdcell_area.begin() + band_lower_idx, _bin_stdcell_area.begin() + band_upper_idx, 0);
+  std::fill(_bin_filler_area.begin() + band_lower_idx, _bin_filler_area.begin() + band_upper_idx, 0);
+
+  for (auto* nInst : _band_to_nInsts[band_idx]) {
+    auto nInst_density_shape = nInst->get_density_shape();
+    auto [lower_col, upper_col] = obtainOverlapIdxRange(core_shape.get_ll_x(), grid_size_x, _grid_cnt_x, nInst_density_shape.get_ll_x(),
+                                                        nInst_density_shape.get_ur_x());
+    auto [lower_row, upper_row] = obtainOverlapIdxRange(core_shape.get_ll_y(), grid_size_y, _grid_cnt_y, nInst_density_shape.get_ll_y(),
+                                                        nInst_density_shape.get_ur_y());
+    lower_row = std::max(lower_row, band_lower_row);
+    upper_row = std::min(upper_row, band_upper_row);
+
+    for (int32_t row_idx = lower_row; row_idx < upper_row; ++row_idx) {
+      int64_t bin_ly = static_cast<int64_t>(core_shape.get_ll_y()) + static_cast<int64_t>(row_idx) * grid_size_y;
+      int64_t bin_uy = std::min(bin_ly + grid_size_y, static_cast<int64_t>(core_shape.get_ur_y()));
+      int64_t overlap_y = std::min(bin_uy, static_cast<int64_t>(nInst_density_shape.get_ur_y()))
+                          - std::max(bin_ly, static_cast<int64_t>(nInst_density_shape.get_ll_y()));
+      if (overlap_y <= 0) {
+        continue;
+      }
+
+      for (int32_t col_idx = lower_col; col_idx < upper_col; ++col_idx) {
+        int64_t bin_lx = static_cast<int64_t>(core_shape.get_ll_x()) + static_cast<int64_t>(col_idx) * grid_size_x;
+        int64_t bin_ux = std::min(bin_lx + grid_size_x, static_cast<int64_t>(core_shape.get_ur_x()));
+        int64_t overlap_x = std::min(bin_ux, static_cast<int64_t>(nInst_density_shape.get_ur_x()))
+                            - std::max(bin_lx, static_cast<int64_t>(nInst_density_shape.get_ll_x()));
+        if (overlap_x <= 0) {
+          continue;
+        }
+
+        int64_t overlap_area = overlap_x * overlap_y;
+        size_t bin_idx = static_cast<size_t>(row_idx) * _grid_cnt_x + col_idx;
+        if (nInst->isMacro()) {
+          _bin_macro_area[bin_idx]
+              += static_cast<int64_t>(overlap_area * nInst->get_density_scale() * _grid_list[bin_idx]->get_available_ratio());
+        } else if (nInst->isFiller()) {
+          _bin_filler_area[bin_idx] += static_cast<int64_t>(overlap_area * nInst->get_density_scale());
+        } else {
+          _bin_stdcell_area[bin_idx] += static_cast<int64_t>(overlap_area * nInst->get_density_scale());
+        }
+      }
+    }
+  }
+
+  // write back to the grid.
+  for (size_t bin_idx = band_lower_idx; bin_idx < band_upper_idx; ++bin_idx) {
+    auto* grid = _grid_list[bin_idx];
+    grid->clearOccupiedArea();
+    grid->add_area(_bin_macro_area[bin_idx] + _bin_stdcell_area[bin_idx] + _bin_filler_area[bin_idx]);
+  }
+}
+
 inline void BinGrid::updateBinGrid(std::vector<NesInstance*>& nInst_list, int32_t thread_num)
 {
-  _grid_manager->clearAllOccupiedArea();
-  // _bin_to_nInsts.clear();
-  resetBinToArea();
+  if (_grid_list.empty()) {
+    return;
+  }
+
+  initBandList(thread_num);
 
+  // bucket the instance to the bands it overlaps, most instances are in one band.
+  auto core_shape = _grid_manager->get_shape();
+  int32_t grid_size_y = _grid_manager->get_grid_size_y();
   for (auto* nInst : nInst_list) {
     if (nInst->isFixed()) {
       continue;
     }
 
-    auto nInst_density_shape = std::move(nInst->get_density_shape());
-
-    std::vector<Grid*> overlap_grid_list;
-    _grid_manager->obtainOverlapGridList(overlap_grid_list, nInst_density_shape);
-
-    for (auto* grid : overlap_grid_list) {
-      // addBinnInstConnection(grid, nInst);
-
-      int64_t overlap_area = _grid_manager->obtainOverlapArea(grid, nInst_density_shape);
-      if (nInst->isMacro()) {
-        int64_t macro_area = static_cast<int64_t>(overlap_area * nInst->get_density_scale() * grid->get_available_ratio());
-        _bin_to_area[grid].macro_area += macro_area;
-        grid->add_area(macro_area);
-      } else if (nInst->isFiller()) {
-        int64_t filler_area = static_cast<int64_t>(overlap_area * nInst->get_density_scale());
-        _bin_to_area[grid].filler_area += filler_area;
-        grid->add_area(filler_area);
-      } else {
-        int64_t stdcell_area = static_cast<int64_t>(overlap_area * nInst->get_density_scale());
-        _bin_to_area[grid].stdcell_area += stdcell_area;
-        grid->add_area(stdcell_area);
-      }
+    auto nInst_density_shape = nInst->get_density_shape();
+    auto [lower_row, upper_row]
+        = obtainOverlapIdxRange(core_shape.get_ll_y(), grid_size_y, _grid_cnt_y, nInst_density_shape.get_ll_y(), nInst_density_shape.get_ur_y());
+    if (lower_row >= upper_row) {
+      continue;
+    }
+
+    for (int32_t band_idx = lower_row / _band_row_cnt; band_idx <= (upper_row - 1) / _band_row_cnt; ++band_idx) {
+      _band_to_nInsts[band_idx].push_back(nInst);
     }
   }
+
+  int32_t band_cnt = _band_to_nInsts.size();
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic, 1)
+  for (int32_t band_idx = 0; band_idx < band_cnt; ++band_idx) {
+    scatterBand(band_idx);
+  }
 }
 
 inline int64_t BinGrid::obtainOverflowAreaWithoutFiller()
 {
   int64_t overflow_area = 0;
-  for (auto* row : _grid_manager->get_row_list()) {
-    for (auto* grid : row->get_grid_list()) {
-      auto occupy_it = _bin_to_area.find(grid);
-      if (occupy_it != _bin_to_area.end()) {
-        auto& area_info = occupy_it->second;
-        int64_t relative_area = area_info.macro_area + area_info.stdcell_area;
+  for (size_t bin_idx = 0; bin_idx < _grid_list.size(); ++bin_idx) {
+    auto* grid = _grid_list[bin_idx];
+    int64_t relative_area = _bin_macro_area[bin_idx] + _bin_stdcell_area[bin_idx];
 
-        // bin target area.
-        int64_t bin_area = static_cast<int64_t>(grid->get_width()) * static_cast<int64_t>(grid->get_height());
-        int64_t target_area = static_cast<int64_t>(bin_area * grid->get_available_ratio());
+    // bin target area.
+    int64_t bin_area = static_cast<int64_t>(grid->get_width()) * static_cast<int64_t>(grid->get_height());
+    int64_t target_area = static_cast<int64_t>(bin_area * grid->get_available_ratio());
 
-        overflow_area += std::max(int64_t(0), relative_area - target_area);
-      }
-    }
+    overflow_area += std::max(int64_t(0), relative_area - target_area);
   }
 
   return overflow_area;
@@ -34,6 +34,7 @@ class NesInstance
   // getter.
   std::string get_name() const { return _name; }
   float get_density_scale() const { return _density_scale; }
+  int32_t get_group_id() const { return _group_id; }
 
   Rectangle<int32_t> get_origin_shape() const { return _origin_shape; }
   Rectangle<int32_t> get_density_shape() const { return _density_shape; }
@@ -48,6 +49,7 @@ class NesInstance
 
   // setter.
   void set_density_scale(float scale) { _density_scale = scale; }
+  void set_group_id(int32_t group_id) { _group_id = group_id; }
 
   void set_origin_shape(Rectangle<int32_t> shape) { _origin_shape = std::move(shape); }
   void set_density_shape(Rectangle<int32_t> shape) { _density_shape = std::move(shape); }
@@ -66,6 +68,7 @@ class NesInstance
  private:
   std::string _name;
   float _density_scale;
+  int32_t _group_id;  // index of the topology group, -1 for filler.
 
   Rectangle<int32_t> _origin_shape;
   Rectangle<int32_t> _density_shape;
@@ -79,7 +82,8 @@ class NesInstance
 
   void updateNesPinListLocation();
 };
-inline NesInstance::NesInstance(std::string name) : _name(std::move(name)), _density_scale(1.0F), _is_fixed(0), _is_filler(0), _is_macro(0)
+inline NesInstance::NesInstance(std::string name)
+    : _name(std::move(name)), _density_scale(1.0F), _group_id(-1), _is_fixed(0), _is_filler(0), _is_macro(0)
 {
 }
 
@@ -1,5 +1,8 @@
 #include "AbacusLegalizer.hh"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Log.hh"
 #include "usage/usage.hh"
 #include "utility/Utility.hh"
@@ -18,6 +21,7 @@ void AbacusLegalizer::destoryInst()
 {
   if (_abacus_lg_instance) {
     delete _abacus_lg_instance;
+    _abacus_lg_instance = nullptr;
   }
 }
 
@@ -168,7 +172,7 @@ void AbacusLegalizer::updateInstanceList(std::vector<Instance*> inst_list)
   }
 
   // when changed_cnt reach a threshold, LG turn the default mode
-  int32_t changed_threshold = _database._lgInstance_list.size() * 0.1;
+  int32_t changed_threshold = _database._lgInstance_list.size() * 0.5;
   if (changed_cnt < changed_threshold) {
     _mode = LG_MODE::kIncremental;
   } else {
@@ -431,7 +435,7 @@ bool AbacusLegalizer::runIncrLegalize()
   } else if (_mode == LG_MODE::kIncremental) {
     is_succeed = this->runIncrementalMode();
     if (is_succeed) {
-      alignInstanceOrient(_target_inst_list);
+      alignInstanceOrient(_database._lgInstance_list);
       LOG_INFO << "Total Movement: " << calTotalMovement();
       writebackPlacerDB(_database._lgInstance_list);
       _target_inst_list.clear();
@@ -450,76 +454,242 @@ bool AbacusLegalizer::runIncrLegalize()
 
 bool AbacusLegalizer::runCompleteMode()
 {
+  _database.resetClusterInfo();
+
   // Sort all movable instances
   std::vector<LGInstance*> movable_inst_list;
   pickAndSortMovableInstList(movable_inst_list);
 
-  int32_t inst_id = 0;
-  for (auto* inst : movable_inst_list) {
-    int32_t best_row = INT32_MAX;
-    int32_t best_cost = INT32_MAX;
-    for (int32_t row_idx = 0; row_idx < _database._lg_layout->get_row_num(); row_idx++) {
-      int32_t cost = placeRow(inst, row_idx, true);
+  return placeInstList(movable_inst_list);
+}
 
-      if (cost < best_cost) {
-        best_cost = cost;
-        best_row = row_idx;
-      }
+bool AbacusLegalizer::runIncrementalMode()
+{
+  std::set<LGInstance*> target_inst_set;
+  for (auto* inst : _target_inst_list) {
+    if (inst->get_state() == LGINSTANCE_STATE::kFixed) {
+      continue;
     }
+    target_inst_set.insert(inst);
+  }
 
-    if (best_row == INT32_MAX) {
-      LOG_ERROR << "Instance: " << inst->get_name() << "Cannot find a row for placement";
-      return false;
-    }
+  // Keep the legal instances in their clusters, only the displaced instances are placed again
+  _database.resetClusterInfo();
+  std::vector<LGInstance*> displaced_inst_list;
+  rebuildClusterInfo(target_inst_set, displaced_inst_list);
+  LOG_INFO << "Incremental legalize " << displaced_inst_list.size() << " displaced instances";
 
-    placeRow(inst, best_row, false);
+  std::stable_sort(displaced_inst_list.begin(), displaced_inst_list.end(),
+                   [](LGInstance* l_inst, LGInstance* r_inst) { return (l_inst->get_coordi().get_x() < r_inst->get_coordi().get_x()); });
+
+  return placeInstList(displaced_inst_list);
+}
 
-    inst_id++;
-    if (inst_id % 100000 == 0) {
-      LOG_INFO << "Place Instance : " << inst_id;
+void AbacusLegalizer::pickAndSortMovableInstList(std::vector<LGInstance*>& movable_inst_list)
+{
+  for (auto* inst : _database._lgInstance_list) {
+    if (inst->get_state() == LGINSTANCE_STATE::kFixed) {
+      continue;
     }
+    movable_inst_list.push_back(inst);
   }
 
-  return true;
+  std::sort(movable_inst_list.begin(), movable_inst_list.end(),
+            [](LGInstance* l_inst, LGInstance* r_inst) { return (l_inst->get_coordi().get_x() < r_inst->get_coordi().get_x()); });
 }
 
-bool AbacusLegalizer::runIncrementalMode()
+void AbacusLegalizer::rebuildClusterInfo(std::set<LGInstance*>& target_inst_set, std::vector<LGInstance*>& displaced_inst_list)
 {
-  int32_t row_range_num = 5;
+  auto* lg_layout = _database._lg_layout;
+  auto& inst_list = _database._lgInstance_list;
+  int32_t row_num = lg_layout->get_row_num();
+
+  // Instances which are not on the site grid are displaced
+  std::vector<uint8_t> displaced_flag_list(inst_list.size(), 0);
+  std::vector<std::vector<int32_t>> row_inst_idx_list(row_num);
+  for (size_t i = 0; i < inst_list.size(); i++) {
+    auto* inst = inst_list[i];
+    if (inst->get_state() == LGINSTANCE_STATE::kFixed) {
+      continue;
+    }
+    int32_t inst_x = inst->get_coordi().get_x();
+    int32_t inst_y = inst->get_coordi().get_y();
+    if (target_inst_set.count(inst) || inst->get_state() == LGINSTANCE_STATE::kUnPlaced || inst_x < 0 || inst_y < 0
+        || inst_x % _site_width != 0 || inst_y % _row_height != 0 || inst_y / _row_height >= row_num) {
+      displaced_flag_list[i] = 1;
+      continue;
+    }
+    row_inst_idx_list[inst_y / _row_height].push_back(i);
+  }
 
-  for (auto* inst : _target_inst_list) {
-    int32_t row_height = _database._lg_layout->get_row_height();
-    int32_t row_idx = inst->get_coordi().get_y() / row_height;
-    int32_t max_row_idx
-        = (row_idx + row_range_num > _database._lg_layout->get_row_num()) ? _database._lg_layout->get_row_num() : row_idx + row_range_num;
-    int32_t min_row_idx = (row_idx - row_range_num < 0) ? 0 : row_idx - row_range_num;
-
-    int32_t best_row = INT32_MAX;
-    int32_t best_cost = INT32_MAX;
-    for (int32_t row_idx = min_row_idx; row_idx < max_row_idx; row_idx++) {
-      int32_t cost = placeRow(inst, row_idx, true);
-      if (cost < best_cost) {
-        best_cost = cost;
-        best_row = row_idx;
+  // Abutted instances in the same interval are merged into one cluster
+#pragma omp parallel for num_threads(std::max(1, _config.get_thread_num())) schedule(dynamic)
+  for (int32_t row_idx = 0; row_idx < row_num; row_idx++) {
+    auto& inst_idx_list = row_inst_idx_list[row_idx];
+    std::sort(inst_idx_list.begin(), inst_idx_list.end(), [&inst_list](int32_t l_idx, int32_t r_idx) {
+      int32_t l_x = inst_list[l_idx]->get_coordi().get_x();
+      int32_t r_x = inst_list[r_idx]->get_coordi().get_x();
+      return (l_x < r_x) || (l_x == r_x && l_idx < r_idx);
+    });
+
+    auto& interval_list = lg_layout->get_interval_2d_list()[row_idx];
+    LGInterval* last_interval = nullptr;
+    LGCluster* last_cluster = nullptr;
+    for (int32_t inst_idx : inst_idx_list) {
+      auto* inst = inst_list[inst_idx];
+      auto inst_shape = inst->get_shape();
+
+      auto iter = std::upper_bound(interval_list.begin(), interval_list.end(), inst_shape.get_ll_x(),
+                                   [](int32_t x, LGInterval* interval) { return x < interval->get_min_x(); });
+      if (iter == interval_list.begin() || inst_shape.get_ur_x() > (*std::prev(iter))->get_max_x()) {
+        displaced_flag_list[inst_idx] = 1;
+        continue;
+      }
+      auto* interval = *std::prev(iter);
+      if (interval != last_interval) {
+        last_interval = interval;
+        last_cluster = nullptr;
+      }
+      if (last_cluster && inst_shape.get_ll_x() < last_cluster->get_max_x()) {
+        displaced_flag_list[inst_idx] = 1;
+        continue;
       }
+
+      if (!last_cluster || inst_shape.get_ll_x() > last_cluster->get_max_x()) {
+        LGCluster* cluster = new LGCluster(inst->get_name());
+        cluster->set_belong_interval(interval);
+        cluster->set_min_x(inst_shape.get_ll_x());
+        cluster->set_front_cluster(last_cluster);
+        if (last_cluster) {
+          last_cluster->set_back_cluster(cluster);
+        } else {
+          interval->set_cluster_root(cluster);
+        }
+        _database.insertCluster(row_idx, cluster->get_name(), cluster);
+        last_cluster = cluster;
+      }
+      last_cluster->add_inst(inst);
+      last_cluster->updateAbacusInfo(inst);
+      inst->set_belong_cluster(last_cluster);
+      interval->updateRemainLength(-(inst_shape.get_width()));
     }
-    placeRow(inst, best_row, false);
+  }
+
+  for (size_t i = 0; i < inst_list.size(); i++) {
+    if (displaced_flag_list[i]) {
+      displaced_inst_list.push_back(inst_list[i]);
+    }
+  }
+}
+
+bool AbacusLegalizer::placeInstList(std::vector<LGInstance*>& inst_list)
+{
+  int32_t row_num = _database._lg_layout->get_row_num();
+  int32_t thread_num = std::max(1, _config.get_thread_num());
+
+  // Rows are cut into bands without shared interval, and the bands are legalized in parallel.
+  // The band size only comes from the config, so the result does not depend on the thread number.
+  int32_t band_row_num = _config.get_band_row_num();
+  int32_t band_num = (band_row_num > 0) ? (row_num + band_row_num - 1) / band_row_num : 1;
+
+  std::vector<LGInstance*> remain_inst_list;
+  if (band_num <= 1) {
+    remain_inst_list = inst_list;
+  } else {
+    std::vector<std::vector<LGInstance*>> band_inst_list(band_num);
+    std::vector<std::vector<LGInstance*>> band_remain_list(band_num);
+    for (auto* inst : inst_list) {
+      band_inst_list[obtainNearestRowIdx(inst, 0, row_num) / band_row_num].push_back(inst);
+    }
+
+#pragma omp parallel for num_threads(thread_num) schedule(dynamic)
+    for (int32_t band_idx = 0; band_idx < band_num; band_idx++) {
+      int32_t min_row_idx = band_idx * band_row_num;
+      int32_t max_row_idx = std::min(row_num, min_row_idx + band_row_num);
+      placeInstListInRows(band_inst_list[band_idx], min_row_idx, max_row_idx, band_remain_list[band_idx]);
+    }
+
+    for (auto& band_remain : band_remain_list) {
+      remain_inst_list.insert(remain_inst_list.end(), band_remain.begin(), band_remain.end());
+    }
+    std::stable_sort(remain_inst_list.begin(), remain_inst_list.end(),
+                     [](LGInstance* l_inst, LGInstance* r_inst) { return (l_inst->get_coordi().get_x() < r_inst->get_coordi().get_x()); });
+    LOG_INFO << "Legalize " << inst_list.size() << " instances in " << band_num << " row bands, " << remain_inst_list.size()
+             << " instances are left for all rows";
+  }
+
+  // Instances without room in their band search all rows
+  std::vector<LGInstance*> failed_inst_list;
+  placeInstListInRows(remain_inst_list, 0, row_num, failed_inst_list);
+  if (!failed_inst_list.empty()) {
+    LOG_ERROR << "Instance: " << failed_inst_list[0]->get_name() << " and other " << failed_inst_list.size() - 1
+              << " instances cannot find a row for placement";
+    return false;
   }
 
   return true;
 }
 
-void AbacusLegalizer::pickAndSortMovableInstList(std::vector<LGInstance*>& movable_inst_list)
+void AbacusLegalizer::placeInstListInRows(std::vector<LGInstance*>& inst_list, int32_t min_row_idx, int32_t max_row_idx,
+                                          std::vector<LGInstance*>& remain_inst_list)
 {
-  for (auto* inst : _database._lgInstance_list) {
-    if (inst->get_state() == LGINSTANCE_STATE::kFixed) {
+  for (auto* inst : inst_list) {
+    int32_t best_row = searchBestRow(inst, min_row_idx, max_row_idx);
+    if (best_row == INT32_MAX) {
+      remain_inst_list.push_back(inst);
       continue;
     }
-    movable_inst_list.push_back(inst);
+    placeRow(inst, best_row, false);
   }
+}
 
-  std::sort(movable_inst_list.begin(), movable_inst_list.end(),
-            [](LGInstance* l_inst, LGInstance* r_inst) { return (l_inst->get_coordi().get_x() < r_inst->get_coordi().get_x()); });
+int32_t AbacusLegalizer::obtainNearestRowIdx(LGInstance* inst, int32_t min_row_idx, int32_t max_row_idx)
+{
+  int32_t row_idx = std::round(static_cast<double>(inst->get_coordi().get_y()) / _row_height);
+  return std::clamp(row_idx, min_row_idx, max_row_idx - 1);
+}
+
+int32_t AbacusLegalizer::searchBestRow(LGInstance* inst, int32_t min_row_idx, int32_t max_row_idx)
+{
+  int32_t best_row = INT32_MAX;
+  int32_t best_cost = INT32_MAX;
+  if (min_row_idx >= max_row_idx) {
+    return best_row;
+  }
+
+  auto try_row = [&](int32_t row_idx) {
+    int32_t cost = placeRow(inst, row_idx, true);
+    if (cost < best_cost || (cost == best_cost && cost != INT32_MAX && row_idx < best_row)) {
+      best_cost = cost;
+      best_row = row_idx;
+    }
+  };
+
+  // The cost of a row is not less than the y movement, so rows are searched from near to far until the y movement exceeds the best cost
+  int32_t inst_y = inst->get_coordi().get_y();
+  int32_t nearest_row = obtainNearestRowIdx(inst, min_row_idx, max_row_idx);
+  try_row(nearest_row);
+  int32_t low_row = nearest_row - 1;
+  int32_t high_row = nearest_row + 1;
+  while (true) {
+    bool is_low_valid = (low_row >= min_row_idx) && (std::abs(low_row * _row_height - inst_y) <= best_cost);
+    bool is_high_valid = (high_row < max_row_idx) && (std::abs(high_row * _row_height - inst_y) <= best_cost);
+    if (!is_low_valid && !is_high_valid) {
+      break;
+    }
+    if (is_low_valid) {
+      try_row(low_row--);
+    } else {
+      low_row = min_row_idx - 1;
+    }
+    if (is_high_valid) {
+      try_row(high_row++);
+    } else {
+      high_row = max_row_idx;
+    }
+  }
+
+  return best_row;
 }
 
 int32_t AbacusLegalizer::placeRow(LGInstance* inst, int32_t row_idx, bool is_trial)
@@ -527,7 +697,7 @@ int32_t AbacusLegalizer::placeRow(LGInstance* inst, int32_t row_idx, bool is_tri
   Rectangle<int32_t> inst_shape = std::move(inst->get_shape());
 
   // Determine clusters and their optimal positions x_c(c):
-  std::vector<LGInterval*> interval_list = _database._lg_layout->get_interval_2d_list()[row_idx];
+  auto& interval_list = _database._lg_layout->get_interval_2d_list()[row_idx];
 
   // Select the nearest interval for the instance
   int32_t interval_idx = searchNearestIntervalIndex(interval_list, inst_shape);
@@ -757,8 +927,9 @@ void AbacusLegalizer::replaceClusterInfo(LGCluster& modify_cluster)
 {
   auto* origin_interval = modify_cluster.get_belong_interval();
   int32_t coordi_y = origin_interval->get_belong_row()->get_coordinate().get_y();
+  int32_t row_idx = coordi_y / _row_height;
 
-  auto* cluster_ptr = _database.findCluster(modify_cluster.get_name());
+  auto* cluster_ptr = _database.findCluster(row_idx, modify_cluster.get_name());
   if (!cluster_ptr) {
     LGCluster* new_cluster = new LGCluster(std::move(modify_cluster));
     auto inst_list = new_cluster->get_inst_list();
@@ -768,7 +939,7 @@ void AbacusLegalizer::replaceClusterInfo(LGCluster& modify_cluster)
     inst_list[0]->set_belong_cluster(new_cluster);
     inst_list[0]->updateCoordi(new_cluster->get_min_x(), coordi_y);
 
-    _database.insertCluster(new_cluster->get_name(), new_cluster);
+    _database.insertCluster(row_idx, new_cluster->get_name(), new_cluster);
 
     if (!origin_interval->get_cluster_root()) {
       origin_interval->set_cluster_root(new_cluster);
@@ -796,7 +967,7 @@ void AbacusLegalizer::replaceClusterInfo(LGCluster& modify_cluster)
     if (front_origin) {
       front_origin->set_back_cluster(&origin_cluster);
     }
-    _database.deleteCluster(delete_cluster);
+    _database.deleteCluster(row_idx, delete_cluster);
   }
   LGCluster* back_origin = origin_cluster.get_back_cluster();
   LGCluster* back_modify = modify_cluster.get_back_cluster();
@@ -807,7 +978,7 @@ void AbacusLegalizer::replaceClusterInfo(LGCluster& modify_cluster)
     if (back_origin) {
       back_origin->set_front_cluster(&origin_cluster);
     }
-    _database.deleteCluster(delete_cluster);
+    _database.deleteCluster(row_idx, delete_cluster);
   }
 
   // update all inst info
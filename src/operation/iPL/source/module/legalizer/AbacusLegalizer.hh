@@ -11,6 +11,8 @@
 #ifndef IPL_ABACUSLEGALIZER_H
 #define IPL_ABACUSLEGALIZER_H
 
+#include <set>
+
 #include "Config.hh"
 #include "config/LegalizerConfig.hh"
 #include "database/LGDatabase.hh"
@@ -50,7 +52,7 @@ class AbacusLegalizer
   int32_t _row_height;
   int32_t _site_width;
 
-  LG_MODE _mode;
+  LG_MODE _mode = LG_MODE::kNone;
   std::vector<LGInstance*> _target_inst_list;
 
   AbacusLegalizer() = default;
@@ -78,6 +80,12 @@ class AbacusLegalizer
   bool runIncrementalMode();
 
   void pickAndSortMovableInstList(std::vector<LGInstance*>& movable_inst_list);
+  void rebuildClusterInfo(std::set<LGInstance*>& target_inst_set, std::vector<LGInstance*>& displaced_inst_list);
+  bool placeInstList(std::vector<LGInstance*>& inst_list);
+  void placeInstListInRows(std::vector<LGInstance*>& inst_list, int32_t min_row_idx, int32_t max_row_idx,
+                           std::vector<LGInstance*>& remain_inst_list);
+  int32_t obtainNearestRowIdx(LGInstance* inst, int32_t min_row_idx, int32_t max_row_idx);
+  int32_t searchBestRow(LGInstance* inst, int32_t min_row_idx, int32_t max_row_idx);
   int32_t placeRow(LGInstance* inst, int32_t row_idx, bool is_trial);
   int32_t searchNearestIntervalIndex(std::vector<LGInterval*>& segment_list, Rectangle<int32_t>& inst_shape);
   int32_t searchRemainSpaceSegIndex(std::vector<LGInterval*>& segment_list, Rectangle<int32_t>& inst_shape, int32_t origin_index);
@@ -29,16 +29,20 @@ public:
     int32_t get_thread_num() const { return _thread_num;}
     int32_t get_global_padding() const { return _global_padding;}
     int32_t get_max_displacement() const { return _max_displacement;}
+    int32_t get_band_row_num() const { return _band_row_num;}
 
     // setter
     void set_thread_num(int32_t num_thread){ _thread_num = num_thread;}
     void set_global_padding(int32_t padding) { _global_padding = padding;}
     void set_max_displacement(int32_t max_displacement) { _max_displacement = max_displacement;}
+    void set_band_row_num(int32_t band_row_num) { _band_row_num = band_row_num;}
 
 private:
     int32_t _thread_num;
     int32_t _global_padding;
     int32_t _max_displacement;
+    // rows of one independent band, 0 means all rows are searched for every instance
+    int32_t _band_row_num = 0;
 };
 
 
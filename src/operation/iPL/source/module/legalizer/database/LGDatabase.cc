@@ -20,10 +20,12 @@ LGDatabase::~LGDatabase()
 {
   delete _lg_layout;
 
-  for (auto pair : _lgCluster_map) {
-    delete pair.second;
+  for (auto& cluster_map : _lgCluster_map_list) {
+    for (auto pair : cluster_map) {
+      delete pair.second;
+    }
   }
-  _lgCluster_map.clear();
+  _lgCluster_map_list.clear();
 
   for (auto* inst : _lgInstance_list) {
     delete inst;
@@ -33,31 +35,34 @@ LGDatabase::~LGDatabase()
   _instance_map.clear();
 }
 
-LGCluster* LGDatabase::findCluster(std::string name)
+LGCluster* LGDatabase::findCluster(int32_t row_idx, std::string name)
 {
   LGCluster* cluster = nullptr;
-  auto it = _lgCluster_map.find(name);
-  if (it != _lgCluster_map.end()) {
+  auto& cluster_map = _lgCluster_map_list[row_idx];
+  auto it = cluster_map.find(name);
+  if (it != cluster_map.end()) {
     cluster = it->second;
   }
 
   return cluster;
 }
 
-void LGDatabase::insertCluster(std::string name, LGCluster* cluster)
+void LGDatabase::insertCluster(int32_t row_idx, std::string name, LGCluster* cluster)
 {
-  auto it = _lgCluster_map.find(name);
-  if (it != _lgCluster_map.end()) {
+  auto& cluster_map = _lgCluster_map_list[row_idx];
+  auto it = cluster_map.find(name);
+  if (it != cluster_map.end()) {
     LOG_WARNING << "Cluster : " << name << " was added before";
   }
-  _lgCluster_map.emplace(name, cluster);
+  cluster_map.emplace(name, cluster);
 }
 
-void LGDatabase::deleteCluster(std::string name)
+void LGDatabase::deleteCluster(int32_t row_idx, std::string name)
 {
-  auto it = _lgCluster_map.find(name);
-  if (it != _lgCluster_map.end()) {
-    _lgCluster_map.erase(it);
+  auto& cluster_map = _lgCluster_map_list[row_idx];
+  auto it = cluster_map.find(name);
+  if (it != cluster_map.end()) {
+    cluster_map.erase(it);
   } else {
     LOG_WARNING << "Cluster: " << name << " has not been insert";
   }
@@ -78,10 +83,13 @@ void LGDatabase::resetClusterInfo()
   }
 
   // delete cluster list
-  for (auto pair : _lgCluster_map) {
-    delete pair.second;
+  for (auto& cluster_map : _lgCluster_map_list) {
+    for (auto pair : cluster_map) {
+      delete pair.second;
+    }
+    cluster_map.clear();
   }
-  _lgCluster_map.clear();
+  _lgCluster_map_list.resize(_lg_layout->get_row_num());
 }
 
 }  // namespace ipl
\ No newline at end of file
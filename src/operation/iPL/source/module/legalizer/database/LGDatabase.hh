@@ -32,9 +32,10 @@ public:
     LGDatabase& operator=(const LGDatabase&) = delete;
     LGDatabase& operator=(LGDatabase&&) = delete;
 
-    LGCluster* findCluster(std::string name);
-    void insertCluster(std::string name, LGCluster* cluster);
-    void deleteCluster(std::string name);
+    // the clusters are kept per row, so that the row bands can be legalized in parallel without lock
+    LGCluster* findCluster(int32_t row_idx, std::string name);
+    void insertCluster(int32_t row_idx, std::string name, LGCluster* cluster);
+    void deleteCluster(int32_t row_idx, std::string name);
 
     void resetClusterInfo();
 private:
@@ -45,7 +46,7 @@ private:
 
     LGLayout* _lg_layout;
     std::vector<LGInstance*> _lgInstance_list;
-    std::map<std::string, LGCluster*> _lgCluster_map;
+    std::vector<std::map<std::string, LGCluster*>> _lgCluster_map_list;
     std::map<LGInstance*, Instance*> _lgInstance_map;
     std::map<Instance*, LGInstance*> _instance_map;
 
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <ctime>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -48,8 +49,12 @@ void MacroPlacer::runMacroPlacer()
   SolutionFactory factory = SolutionFactory();
   MPSolution* mp_solution = factory.createSolution(_mdb->get_place_macro_list(), _set);
   MPEvaluation* mp_evaluation = new MPEvaluation(_mdb, _set, mp_solution);
-  SimulateAnneal* anneal = new SimulateAnneal(_set, mp_evaluation);
-  anneal->runAnneal();
+  if (_set->get_num_replica() > 1) {
+    runMultiStartAnneal(mp_evaluation);
+  } else {
+    SimulateAnneal* anneal = new SimulateAnneal(_set, mp_evaluation);
+    anneal->runAnneal();
+  }
 
   for (FPInst* macro : _mdb->get_place_macro_list()) {
     std::cout << macro->get_name() << " " << macro->get_x() << " " << macro->get_y() << " " << macro->get_width() << " "
@@ -88,6 +93,7 @@ void MacroPlacer::init()
   _set->set_perturb_per_step(_mp_config.get_perturb_per_step());
   _set->set_cool_rate(_mp_config.get_cool_rate());
   _set->set_init_temperature(1000);
+  _set->set_num_replica(std::max(1, _mp_config.get_num_replica()));
   // cost weight
   _set->set_weight_area(1);      // 1
   _set->set_weight_wl(12);       // 12
@@ -118,6 +124,77 @@ void MacroPlacer::init()
   initLocation();
 }
 
+void MacroPlacer::runMultiStartAnneal(MPEvaluation* mp_evaluation)
+{
+  // replica 0 is the primary solution, the others anneal their own copy of the place macros and nets,
+  // the copies are owned here and released after the best replica is written back
+  vector<FPInst*> place_macro_list = _mdb->get_place_macro_list();
+  vector<vector<FPInst*>> replica_macro_list{place_macro_list};
+  vector<Evaluation*> evaluation_list{mp_evaluation};
+  vector<std::unique_ptr<FPInst>> replica_macro_owner;
+  vector<std::unique_ptr<Coordinate>> replica_coordinate_owner;
+  vector<std::unique_ptr<FPNet>> replica_net_owner;
+  vector<std::unique_ptr<FPPin>> replica_pin_owner;
+  vector<std::unique_ptr<MPSolution>> replica_solution_owner;
+  vector<std::unique_ptr<MPEvaluation>> replica_evaluation_owner;
+  SolutionFactory factory = SolutionFactory();
+  for (int i = 1; i < _set->get_num_replica(); ++i) {
+    map<FPInst*, FPInst*> macro_map;
+    vector<FPInst*> macro_list;
+    for (FPInst* macro : place_macro_list) {
+      replica_macro_owner.emplace_back(std::make_unique<FPInst>(*macro));
+      replica_coordinate_owner.emplace_back(std::make_unique<Coordinate>(*macro->get_coordinate()));
+      FPInst* replica_macro = replica_macro_owner.back().get();
+      replica_macro->set_coordinate(replica_coordinate_owner.back().get());
+      macro_map.emplace(macro, replica_macro);
+      macro_list.emplace_back(replica_macro);
+    }
+
+    vector<FPNet*> net_list;
+    for (FPNet* net : _mdb->get_new_net_list()) {
+      replica_net_owner.emplace_back(std::make_unique<FPNet>());
+      FPNet* replica_net = replica_net_owner.back().get();
+      replica_net->set_name(net->get_name());
+      replica_net->set_weight(net->get_weight());
+      for (FPPin* pin : net->get_pin_list()) {
+        // the pin offset is shared, it is not changed by annealing
+        replica_pin_owner.emplace_back(std::make_unique<FPPin>(*pin));
+        FPPin* replica_pin = replica_pin_owner.back().get();
+        auto iter = macro_map.find(pin->get_instance());
+        if (iter != macro_map.end()) {
+          replica_pin->set_instance(iter->second);
+        }
+        replica_pin->set_net(replica_net);
+        replica_net->add_pin(replica_pin);
+      }
+      net_list.emplace_back(replica_net);
+    }
+
+    map<FPRect*, FPInst*> guidance_to_macro_map;
+    for (auto [guidance, macro] : _mdb->get_guidance_to_macro_map()) {
+      auto iter = macro_map.find(macro);
+      guidance_to_macro_map.emplace(guidance, iter != macro_map.end() ? iter->second : macro);
+    }
+
+    replica_solution_owner.emplace_back(factory.createSolution(macro_list, _set));
+    MPSolution* solution = replica_solution_owner.back().get();
+    solution->set_seed(i);
+    replica_evaluation_owner.emplace_back(
+        std::make_unique<MPEvaluation>(mp_evaluation, solution, macro_list, net_list, guidance_to_macro_map));
+    evaluation_list.emplace_back(replica_evaluation_owner.back().get());
+    replica_macro_list.emplace_back(macro_list);
+  }
+
+  size_t best_index = SimulateAnneal::runMultiStartAnneal(_set, evaluation_list);
+  std::cout << "best replica: " << best_index << " of " << evaluation_list.size() << std::endl;
+  for (size_t i = 0; i < place_macro_list.size(); ++i) {
+    FPInst* best_macro = replica_macro_list[best_index][i];
+    place_macro_list[i]->set_x(best_macro->get_x());
+    place_macro_list[i]->set_y(best_macro->get_y());
+    place_macro_list[i]->set_orient(best_macro->get_orient());
+  }
+}
+
 void MacroPlacer::updateDensity()
 {
   // update density
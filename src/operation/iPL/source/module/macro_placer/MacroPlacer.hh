@@ -41,6 +41,7 @@ class MacroPlacer
   void addGuidance();
   void writeSummary(double time);
   void initLocation();
+  void runMultiStartAnneal(MPEvaluation* mp_evaluation);
   // data
   MPDB* _mdb;
   Setting* _set;
@@ -46,6 +46,7 @@ class Setting : public SAParam
   void set_move_pro(float pro) { _move_pro = pro; }
   void set_output_path(std::string path) { _output_path = path; }
   void set_solution_type(SolutionTYPE type) { _type = type; }
+  void set_num_replica(int num) { _num_replica = num; }
 
   // get
   float get_core_density() const { return _core_density; }
@@ -66,6 +67,7 @@ class Setting : public SAParam
   float get_move_pro() const { return _move_pro; }
   std::string get_output_path() const { return _output_path; }
   SolutionTYPE get_solution_type() const { return _type; }
+  int get_num_replica() const { return _num_replica; }
 
  private:
   // macroplacer
@@ -87,6 +89,7 @@ class Setting : public SAParam
   float _weight_boundary = 1;
   float _weight_notch = 1;
   float _weight_guidance = 3;  // guidance
+  int _num_replica = 1;        // the number of annealing chains run in parallel
   // B* tree
   float _swap_pro = 0.5;  // the probability of swap
   float _move_pro = 0.5;  // the probability of move
@@ -31,6 +31,7 @@ class MacroPlacerConfig
   int32_t get_halo_x() { return _halo_x; }
   int32_t get_halo_y() { return _halo_y; }
   std::string get_output_path() { return _output_path; }
+  int32_t get_num_replica() { return _num_replica; }
 
   // setter.
   void set_fixed_macro(std::vector<std::string> fixed_macro) { _fixed_macro = fixed_macro; }
@@ -47,6 +48,7 @@ class MacroPlacerConfig
   void set_halo_x(int32_t x) { _halo_x = x; }
   void set_halo_y(int32_t y) { _halo_y = y; }
   void set_output_path(std::string path) { _output_path = path; }
+  void set_num_replica(int32_t num_replica) { _num_replica = num_replica; }
 
  private:
   // about fixed macro.
@@ -78,6 +80,8 @@ class MacroPlacerConfig
 
   // about output path
   std::string _output_path;
+  // about parallel
+  int32_t _num_replica = 1;
 };
 
 }  // namespace ipl::imp
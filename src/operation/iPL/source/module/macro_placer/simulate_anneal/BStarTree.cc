@@ -66,26 +66,26 @@ void BStarTree::update()
 
 void BStarTree::perturb()
 {
-  float rand_num = rand() / (RAND_MAX + 1.0);
+  float rand_num = uniformRandom();
   // swap node
   if (rand_num < _swap_pro) {
     _rotate = false;
-    int block_a = int(_num_macro * (rand() / (RAND_MAX + 1.0)));
-    int block_b = int((_num_macro - 1) * (rand() / (RAND_MAX + 1.0)));
+    int block_a = int(_num_macro * uniformRandom());
+    int block_b = int((_num_macro - 1) * uniformRandom());
     block_b = (block_b >= block_a) ? block_b + 1 : block_b;
     swap(block_a, block_b);
     // rotate node
   } else if (rand_num < 1 - _move_pro) {
     _rotate = true;
-    _rotate_macro_index = int(_num_macro * (rand() / (RAND_MAX + 1.0)));
+    _rotate_macro_index = int(_num_macro * uniformRandom());
     _old_orient = _macro_list[_rotate_macro_index]->get_orient();
     int new_orient = (_rotate_macro_index + 1) % 8;  // the total of orient is 8
     _macro_list[_rotate_macro_index]->set_orient(Orient(new_orient));
     // move node
   } else {
     _rotate = false;
-    int block = int(_num_macro * (rand() / (RAND_MAX + 1.0)));
-    int target_rand_num = int((2 * _num_macro - 1) * (rand() / (RAND_MAX + 1.0)));
+    int block = int(_num_macro * uniformRandom());
+    int target_rand_num = int((2 * _num_macro - 1) * uniformRandom());
     int target = target_rand_num / 2;
     target = (target == block) ? target - 1 : target;
     target = (target < 0) ? 1 : target;
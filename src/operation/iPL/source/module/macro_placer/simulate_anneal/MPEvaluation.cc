@@ -1,5 +1,7 @@
 #include "MPEvaluation.hh"
 
+#include <unordered_map>
+
 #include "iostream"
 #include "time.h"
 
@@ -9,7 +11,7 @@ namespace ipl::imp {
 float MPEvaluation::evaluate()
 {
   float cost = 0;
-  float hpwl = evalHPWL();
+  float hpwl = evalIncrHPWL();
   float e_area = evalEArea();
   float guidance_penalty = evalLocationPenalty();
   cost += _weight_wl * hpwl / _norm_wl;
@@ -61,6 +63,94 @@ float MPEvaluation::evalHPWL()
   return hpwl;
 }
 
+void MPEvaluation::initIncrHPWL()
+{
+  std::unordered_map<FPInst*, int> macro_index_map;
+  for (size_t i = 0; i < _macro_list.size(); ++i) {
+    macro_index_map.emplace(_macro_list[i], i);
+  }
+
+  _net_pin_list.resize(_net_list.size());
+  _macro_net_list.assign(_macro_list.size(), vector<int>());
+  for (size_t i = 0; i < _net_list.size(); ++i) {
+    _net_pin_list[i] = _net_list[i]->get_pin_list();
+    for (FPInst* inst : _net_list[i]->get_inst_set()) {
+      auto iter = macro_index_map.find(inst);
+      if (iter != macro_index_map.end()) {
+        _macro_net_list[iter->second].emplace_back(i);
+      }
+    }
+  }
+
+  _macro_coordinate_list.resize(_macro_list.size());
+  _macro_orient_list.resize(_macro_list.size());
+  for (size_t i = 0; i < _macro_list.size(); ++i) {
+    _macro_coordinate_list[i]._x = _macro_list[i]->get_x();
+    _macro_coordinate_list[i]._y = _macro_list[i]->get_y();
+    _macro_orient_list[i] = _macro_list[i]->get_orient();
+  }
+
+  _net_hpwl_list.resize(_net_list.size());
+  _net_dirty_list.assign(_net_list.size(), false);
+  _total_hpwl = 0;
+  for (size_t i = 0; i < _net_list.size(); ++i) {
+    _net_hpwl_list[i] = evalNetHPWL(i);
+    _total_hpwl += _net_hpwl_list[i];
+  }
+}
+
+float MPEvaluation::evalIncrHPWL()
+{
+  _evl_wl_count++;
+  clock_t start = clock();
+  for (size_t i = 0; i < _macro_list.size(); ++i) {
+    FPInst* macro = _macro_list[i];
+    if (macro->get_x() == _macro_coordinate_list[i]._x && macro->get_y() == _macro_coordinate_list[i]._y
+        && macro->get_orient() == _macro_orient_list[i]) {
+      continue;
+    }
+    _macro_coordinate_list[i]._x = macro->get_x();
+    _macro_coordinate_list[i]._y = macro->get_y();
+    _macro_orient_list[i] = macro->get_orient();
+    for (int net_index : _macro_net_list[i]) {
+      if (!_net_dirty_list[net_index]) {
+        _net_dirty_list[net_index] = true;
+        _dirty_net_list.emplace_back(net_index);
+      }
+    }
+  }
+
+  for (int net_index : _dirty_net_list) {
+    int64_t hpwl = evalNetHPWL(net_index);
+    _total_hpwl += hpwl - _net_hpwl_list[net_index];
+    _net_hpwl_list[net_index] = hpwl;
+    _net_dirty_list[net_index] = false;
+  }
+  _dirty_net_list.clear();
+  _evl_wl_time += double(clock() - start) / CLOCKS_PER_SEC;
+  return _total_hpwl;
+}
+
+int64_t MPEvaluation::evalNetHPWL(int net_index)
+{
+  if (_net_pin_list[net_index].empty()) {
+    return 0;
+  }
+  int32_t min_x = INT32_MAX;
+  int32_t min_y = INT32_MAX;
+  int32_t max_x = INT32_MIN;
+  int32_t max_y = INT32_MIN;
+  for (FPPin* pin : _net_pin_list[net_index]) {
+    int32_t pin_x = pin->get_x();
+    int32_t pin_y = pin->get_y();
+    min_x = min(pin_x, min_x);
+    min_y = min(pin_y, min_y);
+    max_x = max(pin_x, max_x);
+    max_y = max(pin_y, max_y);
+  }
+  return int64_t(max_x - min_x) + (max_y - min_y);
+}
+
 float MPEvaluation::evalEArea()
 {
   float e_area = 0;
@@ -31,6 +31,36 @@ class MPEvaluation : public Evaluation
     _macro_list = mdb->get_place_macro_list();
 
     init_norm(set);  // NOLINT
+    initIncrHPWL();
+  }
+  // replica of the primary evaluation on the copied macros and nets, the weights and norms are shared so that the costs are comparable
+  MPEvaluation(MPEvaluation* primary, MPSolution* solution, vector<FPInst*> macro_list, vector<FPNet*> net_list,
+               map<FPRect*, FPInst*> guidance_to_macro_map)
+  {
+    _solution = solution;
+    _core_width = primary->_core_width;
+    _core_height = primary->_core_height;
+    _net_list = net_list;
+
+    _weight_area = primary->_weight_area;
+    _weight_e_area = primary->_weight_e_area;
+    _weight_wl = primary->_weight_wl;
+    _weight_boundary = primary->_weight_boundary;
+    _weight_notch = primary->_weight_notch;
+    _weight_guidance = primary->_weight_guidance;
+
+    _norm_area = primary->_norm_area;
+    _norm_wl = primary->_norm_wl;
+    _norm_e_area = primary->_norm_e_area;
+    _norm_boundary = primary->_norm_boundary;
+    _norm_notch = primary->_norm_notch;
+    _norm_guidance = primary->_norm_guidance;
+
+    _blockage_list = primary->_blockage_list;
+    _guidance_to_macro_map = guidance_to_macro_map;
+    _macro_list = macro_list;
+
+    initIncrHPWL();
   }
   float get_weight_e_area() { return _weight_e_area; }
   void set_weight_e_area(float weight) { _weight_e_area = weight; }
@@ -43,6 +73,9 @@ class MPEvaluation : public Evaluation
 
  private:
   float evalHPWL();
+  void initIncrHPWL();
+  float evalIncrHPWL();
+  int64_t evalNetHPWL(int net_index);
   float evalEArea();
   float evalDREAMPlace();
   float evalBlockagePenalty();
@@ -75,6 +108,16 @@ class MPEvaluation : public Evaluation
   vector<FPRect*> _blockage_list;
   map<FPRect*, FPInst*> _guidance_to_macro_map;
   vector<FPInst*> _macro_list;
+  // incremental hpwl, only the nets of the macros moved since the last evaluation are recomputed
+  vector<vector<FPPin*>> _net_pin_list;
+  vector<vector<int>> _macro_net_list;
+  vector<Coordinate> _macro_coordinate_list;
+  vector<Orient> _macro_orient_list;
+  vector<int64_t> _net_hpwl_list;
+  vector<bool> _net_dirty_list;
+  vector<int> _dirty_net_list;
+  int64_t _total_hpwl = 0;
+
   int _evl_wl_count = 0;
   double _evl_wl_time = 0;
 
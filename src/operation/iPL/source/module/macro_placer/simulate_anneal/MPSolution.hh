@@ -1,4 +1,5 @@
 #pragma once
+#include <random>
 #include <string>
 #include <vector>
 
@@ -14,17 +15,24 @@ class MPSolution : public Solution
     _num_macro = macro_list.size();
     _macro_list = macro_list;
   }
+  virtual ~MPSolution() = default;
   uint32_t get_total_width() { return _total_width; }
   uint32_t get_total_height() { return _total_height; }
   float get_total_area() { return _total_area; }
+  void set_seed(uint32_t seed) { _generator.seed(seed); }
   virtual void printSolution(){};
 
  protected:
+  // uniform in [0, 1), every solution has its own generator so that the chains can run in parallel
+  double uniformRandom() { return _distribution(_generator); }
+
   int _num_macro = 0;
   vector<FPInst*> _macro_list;
   uint32_t _total_width = 0;
   uint32_t _total_height = 0;
   float _total_area = 0;
+  std::mt19937 _generator;
+  std::uniform_real_distribution<double> _distribution{0.0, 1.0};
 };
 
 }  // namespace ipl::imp
\ No newline at end of file
@@ -9,11 +9,11 @@ namespace ipl::imp {
 
 void SequencePair::perturb()
 {
-  float rand_num = rand() / (RAND_MAX + 1.0);
+  float rand_num = uniformRandom();
   if (rand_num < 1 - _rotate_pro) {
     _rotate = false;
-    int block_a = int(_num_macro * (rand() / (RAND_MAX + 1.0)));
-    int block_b = int((_num_macro - 1) * (rand() / (RAND_MAX + 1.0)));
+    int block_a = int(_num_macro * uniformRandom());
+    int block_b = int((_num_macro - 1) * uniformRandom());
     block_b = (block_b >= block_a) ? block_b + 1 : block_b;
     if (rand_num < _swap_pos_pro) {
       swap(_pos_seq[block_a], _pos_seq[block_b]);
@@ -24,11 +24,12 @@ void SequencePair::perturb()
     }
   } else {
     _rotate = true;
-    _rotate_macro_index = int(_num_macro * (rand() / (RAND_MAX + 1.0)));
+    _rotate_macro_index = int(_num_macro * uniformRandom());
     _old_orient = _macro_list[_rotate_macro_index]->get_orient();
     int new_orient = (_rotate_macro_index + 1) % 8;  // the total of orient is 8
     _macro_list[_rotate_macro_index]->set_orient(Orient(new_orient));
   }
+  pack();
 }
 
 void SequencePair::pack()
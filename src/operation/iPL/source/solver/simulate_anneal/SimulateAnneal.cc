@@ -2,6 +2,8 @@
 
 #include <math.h>
 
+#include <limits>
+
 namespace ipl {
 
 void SimulateAnneal::runAnneal()
@@ -14,6 +16,7 @@ void SimulateAnneal::runAnneal()
 
   float curr_cost = _evaluation->evaluate();
   float temp_cost, delta_cost, random;
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
 
   // fast sa
   uint32_t step = 1;
@@ -22,8 +25,7 @@ void SimulateAnneal::runAnneal()
       _solution->perturb();
       temp_cost = _evaluation->evaluate();
       delta_cost = temp_cost - curr_cost;
-      random = rand() % 10000;
-      random /= 10000;
+      random = distribution(_generator);
       if (delta_cost < 0 || exp(-delta_cost / temperature) > random) {
         _solution->update();
         curr_cost = temp_cost;
@@ -33,10 +35,35 @@ void SimulateAnneal::runAnneal()
     }
     step++;
     temperature *= cool_rate;
-    _evaluation->showMassage();
+    if (_show_message) {
+      _evaluation->showMassage();
+    }
   }
   _solution->pack();
-  _evaluation->showMassage();
+  if (_show_message) {
+    _evaluation->showMassage();
+  }
+}
+
+size_t SimulateAnneal::runMultiStartAnneal(SAParam* param, std::vector<Evaluation*>& evaluation_list)
+{
+  std::vector<float> cost_list(evaluation_list.size(), std::numeric_limits<float>::max());
+#pragma omp parallel for num_threads(evaluation_list.size()) schedule(dynamic, 1)
+  for (size_t i = 0; i < evaluation_list.size(); ++i) {
+    SimulateAnneal anneal(param, evaluation_list[i]);
+    anneal.set_seed(i);
+    anneal.set_show_message(i == 0);
+    anneal.runAnneal();
+    cost_list[i] = evaluation_list[i]->evaluate();
+  }
+
+  size_t best_index = 0;
+  for (size_t i = 1; i < cost_list.size(); ++i) {
+    if (cost_list[i] < cost_list[best_index]) {
+      best_index = i;
+    }
+  }
+  return best_index;
 }
 
 }  // namespace ipl
\ No newline at end of file
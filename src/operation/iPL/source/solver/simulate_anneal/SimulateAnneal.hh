@@ -1,6 +1,8 @@
-
 #pragma once
 
+#include <random>
+#include <vector>
+
 #include "Evaluation.hh"
 #include "SAParam.hh"
 #include "Solution.hh"
@@ -17,12 +19,24 @@ class SimulateAnneal
     _solution = _evaluation->get_solution();
   }
   ~SimulateAnneal(){};
+  void set_seed(uint32_t seed) { _generator.seed(seed); }
+  void set_show_message(bool show_message) { _show_message = show_message; }
   void runAnneal();
 
+  /**
+   * @brief run one chain for every evaluation in parallel, the chain i is seeded by i and only the chain 0 shows message.
+   * the evaluations must not share any data written by the solution.
+   *
+   * @return the index of the evaluation with the lowest final cost
+   */
+  static size_t runMultiStartAnneal(SAParam* param, std::vector<Evaluation*>& evaluation_list);
+
  private:
   SAParam* _param;
   Evaluation* _evaluation;
   Solution* _solution;
+  std::mt19937 _generator;
+  bool _show_message = true;
 };
 
 }  // namespace ipl
\ No newline at end of file
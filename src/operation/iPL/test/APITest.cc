@@ -8,8 +8,10 @@
  */
 
 #include <string>
+#include <vector>
 // #include <gperftools/profiler.h>
 
+#include "AbacusLegalizer.hh"
 #include "PlacerDB.hh"
 #include "TimingEval.hpp"
 #include "gtest/gtest.h"
@@ -73,6 +75,58 @@ TEST_F(APITestInterface, run_lg)
   idb_builder->saveDef("<local_path>/iPL_lg.def");
 }
 
+TEST_F(APITestInterface, run_lg_band)
+{
+  std::string pl_json_file = "<local_path>/pl_default_config.json";
+  auto* idb_builder = dmInst->get_idb_builder();
+
+  iPLAPIInst.initAPI(pl_json_file, idb_builder);
+
+  // legalize the same placement with all rows and with row bands, the banded result should be
+  // legal and should not depend on the thread number
+  auto inst_list = PlacerDBInst.get_design()->get_instance_list();
+  std::vector<Point<int32_t>> origin_coordi_list;
+  std::vector<Orient> origin_orient_list;
+  for (auto* inst : inst_list) {
+    origin_coordi_list.push_back(inst->get_coordi());
+    origin_orient_list.push_back(inst->get_orient());
+  }
+
+  auto run_lg = [&](int32_t band_row_num, int32_t thread_num) {
+    for (size_t i = 0; i < inst_list.size(); i++) {
+      inst_list[i]->set_orient(origin_orient_list[i]);
+      inst_list[i]->update_coordi(origin_coordi_list[i]);
+    }
+    auto& lg_config = PlacerDBInst.get_placer_config()->get_lg_config();
+    lg_config.set_band_row_num(band_row_num);
+    lg_config.set_thread_num(thread_num);
+
+    EXPECT_TRUE(iPLAPIInst.runLG());
+    EXPECT_TRUE(iPLAPIInst.checkLegality());
+    AbacusLegalizer::destoryInst();
+
+    std::vector<Point<int32_t>> coordi_list;
+    int64_t movement = 0;
+    for (size_t i = 0; i < inst_list.size(); i++) {
+      coordi_list.push_back(inst_list[i]->get_coordi());
+      movement += std::abs(coordi_list[i].get_x() - origin_coordi_list[i].get_x());
+      movement += std::abs(coordi_list[i].get_y() - origin_coordi_list[i].get_y());
+    }
+    return std::make_pair(coordi_list, movement);
+  };
+
+  auto [serial_coordi_list, serial_movement] = run_lg(0, 1);
+  auto [band_coordi_list, band_movement] = run_lg(32, 1);
+  auto [parallel_coordi_list, parallel_movement] = run_lg(32, 8);
+
+  EXPECT_EQ(band_coordi_list, parallel_coordi_list);
+  EXPECT_EQ(band_movement, parallel_movement);
+  EXPECT_LE(band_movement, serial_movement * 1.05);
+  LOG_INFO << "LG movement of all rows: " << serial_movement << ", of row bands: " << band_movement;
+
+  iPLAPIInst.destoryInst();
+}
+
 TEST_F(APITestInterface, run_dp)
 {
   std::string pl_json_file = "<local_path>/pl_default_config.json";
@@ -0,0 +1,104 @@
+/*
+ * @Description: Compare the density field solvers on the bin grids from 256x256 to 4096x4096.
+ * usage: DensitySolverBench [max_bin_cnt] [thread_num] [repeat]
+ * @FilePath: /iEDA/src/iPL/test/DensitySolverBench.cc
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "fft/density_solver.h"
+
+using namespace ipl;
+
+struct SolverResult
+{
+  double time = 0.0;  // ms per solve.
+  std::vector<float> phi;
+  std::vector<float> force_x;
+  std::vector<float> force_y;
+};
+
+SolverResult runSolver(DENSITY_SOLVER_TYPE type, int bin_cnt, const std::vector<float>& density, int thread_num, int repeat)
+{
+  SolverResult result;
+  DensityFieldSolver* solver = createDensityFieldSolver(type, bin_cnt, bin_cnt, 100, 100);
+  solver->set_thread_num(thread_num);
+
+  for (int r = 0; r < repeat; r++) {
+    for (int x = 0; x < bin_cnt; x++) {
+      for (int y = 0; y < bin_cnt; y++) {
+        solver->updateDensity(x, y, density[static_cast<size_t>(x) * bin_cnt + y]);
+      }
+    }
+    auto start = std::chrono::steady_clock::now();
+    solver->doFFT();
+    auto end = std::chrono::steady_clock::now();
+    result.time += std::chrono::duration<double, std::milli>(end - start).count();
+  }
+  result.time /= repeat;
+
+  size_t bin_num = static_cast<size_t>(bin_cnt) * bin_cnt;
+  result.phi.resize(bin_num);
+  result.force_x.resize(bin_num);
+  result.force_y.resize(bin_num);
+  for (int x = 0; x < bin_cnt; x++) {
+    for (int y = 0; y < bin_cnt; y++) {
+      size_t idx = static_cast<size_t>(x) * bin_cnt + y;
+      result.phi[idx] = solver->get_electro_phi(x, y);
+      std::pair<float, float> force = solver->get_electro_force(x, y);
+      result.force_x[idx] = force.first;
+      result.force_y[idx] = force.second;
+    }
+  }
+
+  delete solver;
+  return result;
+}
+
+// the max difference relative to the max magnitude of the reference.
+double relativeError(const std::vector<float>& ref, const std::vector<float>& value)
+{
+  double max_ref = 0.0;
+  double max_diff = 0.0;
+  for (size_t i = 0; i < ref.size(); i++) {
+    max_ref = std::max(max_ref, std::fabs(static_cast<double>(ref[i])));
+    max_diff = std::max(max_diff, std::fabs(static_cast<double>(ref[i]) - value[i]));
+  }
+  return max_ref > 0.0 ? max_diff / max_ref : max_diff;
+}
+
+int main(int argc, char* argv[])
+{
+  int max_bin_cnt = argc > 1 ? std::atoi(argv[1]) : 4096;
+  int thread_num = argc > 2 ? std::atoi(argv[2]) : 8;
+  int repeat = argc > 3 ? std::atoi(argv[3]) : 3;
+
+  std::printf("%10s %14s %14s %14s %10s %12s %12s\n", "bins", "ooura(ms)", "float(ms)", "double(ms)", "speedup", "float err", "double err");
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> dist(0.0F, 1.5F);
+  for (int bin_cnt = 256; bin_cnt <= max_bin_cnt; bin_cnt <<= 1) {
+    std::vector<float> density(static_cast<size_t>(bin_cnt) * bin_cnt);
+    std::generate(density.begin(), density.end(), [&]() { return dist(gen); });
+
+    SolverResult ooura = runSolver(DENSITY_SOLVER_TYPE::kOoura, bin_cnt, density, thread_num, repeat);
+    SolverResult single = runSolver(DENSITY_SOLVER_TYPE::kSpectralFloat, bin_cnt, density, thread_num, repeat);
+    SolverResult dual = runSolver(DENSITY_SOLVER_TYPE::kSpectralDouble, bin_cnt, density, thread_num, repeat);
+
+    double float_err = std::max({relativeError(ooura.phi, single.phi), relativeError(ooura.force_x, single.force_x),
+                                 relativeError(ooura.force_y, single.force_y)});
+    double double_err = std::max({relativeError(ooura.phi, dual.phi), relativeError(ooura.force_x, dual.force_x),
+                                  relativeError(ooura.force_y, dual.force_y)});
+
+    std::printf("%5dx%-5d %14.2f %14.2f %14.2f %9.2fx %12.2e %12.2e\n", bin_cnt, bin_cnt, ooura.time, single.time, dual.time,
+                ooura.time / single.time, float_err, double_err);
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * @Description: Check the WA wirelength gradient against the finite difference of the WA wirelength.
+ * @FilePath: /iEDA/src/iPL/test/WAWirelengthGradientTest.cc
+ */
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "module/evaluator/wirelength/WAWirelengthGradient.hh"
+#include "module/logger/Log.hh"
+#include "module/topology_manager/TopologyManager.hh"
+
+namespace ipl {
+
+class WAWirelengthGradientTest : public testing::Test
+{
+  void SetUp()
+  {
+    char config[] = "wa wirelength gradient test";
+    char* argv[] = {config};
+    Log::init(argv);
+  }
+  void TearDown() { Log::end(); }
+};
+
+// the WA wirelength of one dimension with the exact exp.
+double waWirelength(const std::vector<int32_t>& coordi_list, double coeff)
+{
+  double exp_min_sum = 0, coordi_exp_min_sum = 0;
+  double exp_max_sum = 0, coordi_exp_max_sum = 0;
+  for (int32_t coordi : coordi_list) {
+    double exp_min = std::exp(-coordi * coeff);
+    double exp_max = std::exp(coordi * coeff);
+    exp_min_sum += exp_min;
+    coordi_exp_min_sum += coordi * exp_min;
+    exp_max_sum += exp_max;
+    coordi_exp_max_sum += coordi * exp_max;
+  }
+  return coordi_exp_max_sum / exp_max_sum - coordi_exp_min_sum / exp_min_sum;
+}
+
+double totalWAWirelength(TopologyManager* topo_manager, double coeff)
+{
+  double total_wirelength = 0;
+  for (auto* network : topo_manager->get_network_list()) {
+    std::vector<int32_t> x_list;
+    std::vector<int32_t> y_list;
+    for (auto* node : network->get_node_list()) {
+      x_list.push_back(node->get_location().get_x());
+      y_list.push_back(node->get_location().get_y());
+    }
+    total_wirelength += network->get_net_weight() * (waWirelength(x_list, coeff) + waWirelength(y_list, coeff));
+  }
+  return total_wirelength;
+}
+
+void moveGroup(Group* group, int32_t delta_x, int32_t delta_y)
+{
+  for (auto* node : group->get_node_list()) {
+    Point<int32_t> loc = node->get_location();
+    node->set_location(Point<int32_t>(loc.get_x() + delta_x, loc.get_y() + delta_y));
+  }
+}
+
+TEST_F(WAWirelengthGradientTest, finite_difference)
+{
+  TopologyManager* topo_manager = new TopologyManager();
+
+  // group i has the pin list group_pins[i], pin 6 is not connected to any net.
+  std::vector<std::vector<int>> group_pins = {{0, 1}, {2}, {3, 4}, {5, 7}, {6, 8}};
+  // the first pin is the driver, the net with zero weight is ignored.
+  std::vector<std::vector<int>> net_pins = {{0, 2, 3}, {1, 4, 5}, {7, 8}};
+  std::vector<float> net_weights = {1.0F, 2.0F, 0.0F};
+
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int32_t> dist(0, 200);
+  std::vector<Node*> node_list;
+  for (int i = 0; i < 9; ++i) {
+    Node* node = new Node("pin_" + std::to_string(i));
+    node->set_location(Point<int32_t>(dist(gen), dist(gen)));
+    topo_manager->add_node(node->get_name(), node);
+    node_list.push_back(node);
+  }
+
+  for (size_t i = 0; i < net_pins.size(); ++i) {
+    NetWork* network = new NetWork("net_" + std::to_string(i));
+    network->set_net_weight(net_weights[i]);
+    network->set_transmitter(node_list[net_pins[i][0]]);
+    node_list[net_pins[i][0]]->set_network(network);
+    for (size_t j = 1; j < net_pins[i].size(); ++j) {
+      network->add_receiver(node_list[net_pins[i][j]]);
+      node_list[net_pins[i][j]]->set_network(network);
+    }
+    topo_manager->add_network(network->get_name(), network);
+  }
+
+  for (size_t i = 0; i < group_pins.size(); ++i) {
+    Group* group = new Group("inst_" + std::to_string(i));
+    for (int pin : group_pins[i]) {
+      node_list[pin]->set_group(group);
+      group->add_node(node_list[pin]);
+    }
+    topo_manager->add_group(group->get_name(), group);
+  }
+
+  // gamma is 100, far larger than the step.
+  float coeff = 0.01F;
+  WAWirelengthGradient wa_gradient(topo_manager);
+  wa_gradient.updateWirelengthForce(coeff, coeff, -300.0F, 2);
+
+  const auto& group_list = topo_manager->get_group_list();
+  for (size_t i = 0; i < group_list.size(); ++i) {
+    Point<float> gradient = wa_gradient.obtainWirelengthGradient(i);
+
+    moveGroup(group_list[i], 1, 0);
+    double wirelength_inc_x = totalWAWirelength(topo_manager, coeff);
+    moveGroup(group_list[i], -2, 0);
+    double wirelength_dec_x = totalWAWirelength(topo_manager, coeff);
+    moveGroup(group_list[i], 1, 1);
+    double wirelength_inc_y = totalWAWirelength(topo_manager, coeff);
+    moveGroup(group_list[i], 0, -2);
+    double wirelength_dec_y = totalWAWirelength(topo_manager, coeff);
+    moveGroup(group_list[i], 0, 1);
+
+    // the gradient is the force which decrease the wirelength.
+    EXPECT_NEAR(gradient.get_x(), -(wirelength_inc_x - wirelength_dec_x) / 2, 1e-2);
+    EXPECT_NEAR(gradient.get_y(), -(wirelength_inc_y - wirelength_dec_y) / 2, 1e-2);
+  }
+
+  // the filler is not in the topology.
+  Point<float> filler_gradient = wa_gradient.obtainWirelengthGradient(-1);
+  EXPECT_EQ(filler_gradient.get_x(), 0.0F);
+  EXPECT_EQ(filler_gradient.get_y(), 0.0F);
+
+  delete topo_manager;
+}
+
+}  // namespace ipl
@@ -164,7 +164,30 @@ eval::TileGrid* RTAPI::getCongestonMap(std::map<std::string, std::any> config_ma
 
   EarlyGlobalRouter::initInst(config_map, dmInst->get_idb_builder());
   EGR_INST.route();
+  eval::TileGrid* eval_tile_grid = buildTileGrid();
+  EarlyGlobalRouter::destroyInst();
+  return eval_tile_grid;
+}
 
+void RTAPI::initCongestionSession(std::map<std::string, std::any> config_map)
+{
+  EarlyGlobalRouter::initInst(config_map, dmInst->get_idb_builder());
+  EGR_INST.route();
+}
+
+eval::TileGrid* RTAPI::updateCongestionSession(std::map<std::string, std::pair<int, int>>& pin_coord_map, int move_threshold)
+{
+  EGR_INST.updatePinCoordMap(pin_coord_map, move_threshold);
+  return buildTileGrid();
+}
+
+void RTAPI::destroyCongestionSession()
+{
+  EarlyGlobalRouter::destroyInst();
+}
+
+eval::TileGrid* RTAPI::buildTileGrid()
+{
   eval::TileGrid* eval_tile_grid = new eval::TileGrid();
   irt_int cell_width = EGR_INST.getDataManager().getConfig().cell_width;
   irt_int cell_height = EGR_INST.getDataManager().getConfig().cell_height;
@@ -210,7 +233,6 @@ eval::TileGrid* RTAPI::getCongestonMap(std::map<std::string, std::any> config_ma
       }
     }
   }
-  EarlyGlobalRouter::destroyInst();
   return eval_tile_grid;
 }
 
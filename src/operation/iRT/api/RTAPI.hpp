@@ -42,6 +42,10 @@ class RTAPI
 
   // EVAL
   eval::TileGrid* getCongestonMap(std::map<std::string, std::any> config_map);
+  // 常驻的EGR会话,pin移动后只重布受影响的线网
+  void initCongestionSession(std::map<std::string, std::any> config_map);
+  eval::TileGrid* updateCongestionSession(std::map<std::string, std::pair<int, int>>& pin_coord_map, int move_threshold);
+  void destroyCongestionSession();
   std::vector<double> getWireLengthAndViaNum(std::map<std::string, std::any> config_map);
 
   // DRC
@@ -60,6 +64,7 @@ class RTAPI
   RTAPI& operator=(const RTAPI& other) = delete;
   RTAPI& operator=(RTAPI&& other) = delete;
   // function
+  eval::TileGrid* buildTileGrid();
 };
 
 }  // namespace irt
@@ -366,34 +366,111 @@ void DetailedRouter::routeDRModel(DRModel& dr_model)
   irt_int box_x_size = dr_box_map.get_x_size();
   irt_int box_y_size = dr_box_map.get_y_size();
   irt_int box_size = box_x_size * box_y_size;
-  irt_int range = std::max(2, static_cast<irt_int>(std::sqrt(box_size / RTUtil::getBatchSize(box_size))));
-
-  for (irt_int start_x = 0; start_x < range; start_x++) {
-    for (irt_int start_y = 0; start_y < range; start_y++) {
-      Monitor stage_monitor;
-#pragma omp parallel for collapse(2)
-      for (irt_int x = start_x; x < box_x_size; x += range) {
-        for (irt_int y = start_y; y < box_y_size; y += range) {
-          DRBox& dr_box = dr_box_map[x][y];
-          if (dr_box.skipRouting()) {
-            continue;
-          }
-          buildDRBox(dr_box);
-          checkDRBox(dr_box);
-          sortDRBox(dr_box);
-          routeDRBox(dr_box);
-          countDRBox(dr_box);
-          dr_box.freeNodeGraph();
+
+  std::vector<PlanarCoord> box_coord_list = getBoxRoutingOrder(dr_model);
+  // 3x3邻域内的box不能同时布线，box依赖其邻域内布线顺序靠前的box，依赖的box全部完成后才能开始布线
+  GridMap<irt_int> box_order_map(box_x_size, box_y_size, -1);
+  for (size_t i = 0; i < box_coord_list.size(); i++) {
+    box_order_map[box_coord_list[i].get_x()][box_coord_list[i].get_y()] = static_cast<irt_int>(i);
+  }
+  auto getNeighborOrderList = [&](irt_int box_order) {
+    const PlanarCoord& box_coord = box_coord_list[box_order];
+    std::vector<irt_int> neighbor_order_list;
+    for (irt_int x = std::max(box_coord.get_x() - 1, 0); x <= std::min(box_coord.get_x() + 1, box_x_size - 1); x++) {
+      for (irt_int y = std::max(box_coord.get_y() - 1, 0); y <= std::min(box_coord.get_y() + 1, box_y_size - 1); y++) {
+        if (box_order_map[x][y] != -1 && box_order_map[x][y] != box_order) {
+          neighbor_order_list.push_back(box_order_map[x][y]);
         }
       }
-      irt_int stage_box_x = static_cast<irt_int>(std::ceil((box_x_size - start_x) / 1.0 / range));
-      irt_int stage_box_y = static_cast<irt_int>(std::ceil((box_y_size - start_y) / 1.0 / range));
-      LOG_INST.info(Loc::current(), "Processed ", stage_box_x * stage_box_y, " boxs", stage_monitor.getStatsInfo());
+    }
+    return neighbor_order_list;
+  };
+  std::vector<irt_int> box_dep_num_list(box_coord_list.size(), 0);
+  std::vector<irt_int> ready_order_list;
+  for (irt_int i = 0; i < static_cast<irt_int>(box_coord_list.size()); i++) {
+    for (irt_int neighbor_order : getNeighborOrderList(i)) {
+      if (neighbor_order < i) {
+        box_dep_num_list[i]++;
+      }
+    }
+    if (box_dep_num_list[i] == 0) {
+      ready_order_list.push_back(i);
+    }
+  }
+  size_t processed_box_num = box_size - box_coord_list.size();
+  irt_int batch_size = RTUtil::getBatchSize(box_size);
+
+  Monitor stage_monitor;
+  std::function<void(irt_int)> routeBox = [&](irt_int box_order) {
+    const PlanarCoord& box_coord = box_coord_list[box_order];
+    DRBox& dr_box = dr_box_map[box_coord.get_x()][box_coord.get_y()];
+    buildDRBox(dr_box);
+    checkDRBox(dr_box);
+    sortDRBox(dr_box);
+    routeDRBox(dr_box);
+    countDRBox(dr_box);
+    dr_box.freeNodeGraph();
+    // 完成后释放依赖它的box，依赖数归零的box作为新任务开始布线
+    for (irt_int next_order : getNeighborOrderList(box_order)) {
+      if (next_order < box_order) {
+        continue;
+      }
+      irt_int dep_num;
+#pragma omp atomic capture
+      dep_num = --box_dep_num_list[next_order];
+      if (dep_num == 0) {
+#pragma omp task firstprivate(next_order)
+        routeBox(next_order);
+      }
+    }
+    size_t curr_processed_box_num;
+#pragma omp atomic capture
+    curr_processed_box_num = ++processed_box_num;
+    if (curr_processed_box_num % batch_size == 0) {
+      LOG_INST.info(Loc::current(), "Processed ", curr_processed_box_num, " boxs", stage_monitor.getStatsInfo());
+    }
+  };
+#pragma omp parallel
+  {
+#pragma omp single
+    {
+      for (irt_int ready_order : ready_order_list) {
+#pragma omp task firstprivate(ready_order)
+        routeBox(ready_order);
+      }
     }
   }
   LOG_INST.info(Loc::current(), "Processed ", box_size, " boxs", monitor.getStatsInfo());
 }
 
+/**
+ * 布线顺序: 按坐标奇偶分为四组，同组的box互不相邻，后组的box只依赖前组的相邻box，依赖链最长为4
+ * 组内按task数量降序，task多的box先开始以减少最后的长尾，数量相同按坐标顺序
+ * 各box只读写自身的数据，布线结果与调度顺序无关
+ */
+std::vector<PlanarCoord> DetailedRouter::getBoxRoutingOrder(DRModel& dr_model)
+{
+  GridMap<DRBox>& dr_box_map = dr_model.get_dr_box_map();
+
+  std::vector<PlanarCoord> box_coord_list;
+  for (irt_int x = 0; x < dr_box_map.get_x_size(); x++) {
+    for (irt_int y = 0; y < dr_box_map.get_y_size(); y++) {
+      if (dr_box_map[x][y].skipRouting()) {
+        continue;
+      }
+      box_coord_list.emplace_back(x, y);
+    }
+  }
+  auto getGroupIdx = [](const PlanarCoord& coord) { return (coord.get_x() % 2) * 2 + (coord.get_y() % 2); };
+  std::stable_sort(box_coord_list.begin(), box_coord_list.end(), [&](const PlanarCoord& a, const PlanarCoord& b) {
+    if (getGroupIdx(a) != getGroupIdx(b)) {
+      return getGroupIdx(a) < getGroupIdx(b);
+    }
+    return dr_box_map[a.get_x()][a.get_y()].get_dr_task_list().size() > dr_box_map[b.get_x()][b.get_y()].get_dr_task_list().size();
+  });
+  return box_coord_list;
+}
+
 #endif
 
 #if 1  // build dr_box
@@ -773,6 +850,7 @@ void DetailedRouter::buildLayerNodeList(DRBox& dr_box)
       }
     }
   }
+  dr_box.initMazeSearcher();
 }
 
 void DetailedRouter::buildOBSTaskMap(DRBox& dr_box)
@@ -1165,78 +1243,25 @@ bool DetailedRouter::isConnectedAllEnd(DRBox& dr_box)
 
 void DetailedRouter::routeSinglePath(DRBox& dr_box)
 {
-  initPathHead(dr_box);
-  while (!searchEnded(dr_box)) {
-    expandSearching(dr_box);
-    resetPathHead(dr_box);
+  std::vector<DRNode*> source_node_list;
+  for (std::vector<DRNode*>& start_node_comb : dr_box.get_start_node_comb_list()) {
+    source_node_list.insert(source_node_list.end(), start_node_comb.begin(), start_node_comb.end());
   }
-}
-
-void DetailedRouter::initPathHead(DRBox& dr_box)
-{
-  std::vector<std::vector<DRNode*>>& start_node_comb_list = dr_box.get_start_node_comb_list();
   std::vector<DRNode*>& path_node_comb = dr_box.get_path_node_comb();
-
-  for (std::vector<DRNode*>& start_node_comb : start_node_comb_list) {
-    for (DRNode* start_node : start_node_comb) {
-      start_node->set_estimated_cost(getEstimateCostToEnd(dr_box, start_node));
-      pushToOpenList(dr_box, start_node);
-    }
-  }
-  for (DRNode* path_node : path_node_comb) {
-    path_node->set_estimated_cost(getEstimateCostToEnd(dr_box, path_node));
-    pushToOpenList(dr_box, path_node);
-  }
-  dr_box.set_path_head_node(popFromOpenList(dr_box));
-}
-
-bool DetailedRouter::searchEnded(DRBox& dr_box)
-{
-  std::vector<std::vector<DRNode*>>& end_node_comb_list = dr_box.get_end_node_comb_list();
-  DRNode* path_head_node = dr_box.get_path_head_node();
-
-  if (path_head_node == nullptr) {
-    dr_box.set_end_node_comb_idx(-1);
-    return true;
-  }
-  for (size_t i = 0; i < end_node_comb_list.size(); i++) {
-    for (DRNode* end_node : end_node_comb_list[i]) {
-      if (path_head_node == end_node) {
-        dr_box.set_end_node_comb_idx(static_cast<irt_int>(i));
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
-void DetailedRouter::expandSearching(DRBox& dr_box)
-{
-  DRNode* path_head_node = dr_box.get_path_head_node();
-
-  for (auto& [orientation, neighbor_node] : path_head_node->get_neighbor_ptr_map()) {
-    if (neighbor_node == nullptr) {
-      continue;
-    }
-    if (!RTUtil::isInside(dr_box.get_routing_region(), *neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isClose()) {
-      continue;
-    }
-    if (!passCheckingSegment(dr_box, path_head_node, neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isOpen() && replaceParentNode(dr_box, path_head_node, neighbor_node)) {
-      neighbor_node->set_known_cost(getKnowCost(dr_box, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-    } else if (neighbor_node->isNone()) {
-      neighbor_node->set_known_cost(getKnowCost(dr_box, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-      neighbor_node->set_estimated_cost(getEstimateCostToEnd(dr_box, neighbor_node));
-      pushToOpenList(dr_box, neighbor_node);
-    }
-  }
+  source_node_list.insert(source_node_list.end(), path_node_comb.begin(), path_node_comb.end());
+
+  MazeGraph maze_graph{[&](DRNode* dr_node) { return dr_box.getNodeIdx(dr_node); },
+                       [&](DRNode* dr_node, auto visit) {
+                         for (auto& [orientation, neighbor_node] : dr_node->get_neighbor_ptr_map()) {
+                           if (neighbor_node != nullptr && RTUtil::isInside(dr_box.get_routing_region(), *neighbor_node)) {
+                             visit(neighbor_node);
+                           }
+                         }
+                       },
+                       [&](DRNode* start_node, DRNode* end_node) { return passCheckingSegment(dr_box, start_node, end_node); },
+                       [&](DRNode* start_node, DRNode* end_node) { return getKnowCost(dr_box, start_node, end_node); },
+                       [&](DRNode* start_node, DRNode* end_node) { return getEstimateCost(dr_box, start_node, end_node); }};
+  dr_box.get_maze_searcher().search(maze_graph, source_node_list, dr_box.get_end_node_comb_list());
 }
 
 bool DetailedRouter::passCheckingSegment(DRBox& dr_box, DRNode* start_node, DRNode* end_node)
@@ -1267,16 +1292,6 @@ bool DetailedRouter::passCheckingSegment(DRBox& dr_box, DRNode* start_node, DRNo
   return true;
 }
 
-bool DetailedRouter::replaceParentNode(DRBox& dr_box, DRNode* parent_node, DRNode* child_node)
-{
-  return getKnowCost(dr_box, parent_node, child_node) < child_node->get_known_cost();
-}
-
-void DetailedRouter::resetPathHead(DRBox& dr_box)
-{
-  dr_box.set_path_head_node(popFromOpenList(dr_box));
-}
-
 void DetailedRouter::rerouteByEnlarging(DRBox& dr_box)
 {
   GCellAxis& gcell_axis = _dr_data_manager.getDatabase().get_gcell_axis();
@@ -1304,20 +1319,7 @@ void DetailedRouter::resetSinglePath(DRBox& dr_box)
 {
   dr_box.set_forced_routing(false);
 
-  std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost> empty_queue;
-  dr_box.set_open_queue(empty_queue);
-
-  std::vector<DRNode*>& visited_node_list = dr_box.get_visited_node_list();
-  for (DRNode* visited_node : visited_node_list) {
-    visited_node->set_state(DRNodeState::kNone);
-    visited_node->set_parent_node(nullptr);
-    visited_node->set_known_cost(0);
-    visited_node->set_estimated_cost(0);
-  }
-  visited_node_list.clear();
-
-  dr_box.set_path_head_node(nullptr);
-  dr_box.set_end_node_comb_idx(-1);
+  dr_box.get_maze_searcher().reset();
 }
 
 void DetailedRouter::rerouteByforcing(DRBox& dr_box)
@@ -1341,20 +1343,20 @@ void DetailedRouter::updatePathResult(DRBox& dr_box)
   DRNode* path_head_node = dr_box.get_path_head_node();
 
   DRNode* curr_node = path_head_node;
-  DRNode* pre_node = curr_node->get_parent_node();
+  DRNode* pre_node = dr_box.getParentNode(curr_node);
 
   if (pre_node == nullptr) {
     return;
   }
   Orientation curr_orientation = getOrientation(curr_node, pre_node);
-  while (pre_node->get_parent_node() != nullptr) {
-    Orientation pre_orientation = getOrientation(pre_node, pre_node->get_parent_node());
+  while (dr_box.getParentNode(pre_node) != nullptr) {
+    Orientation pre_orientation = getOrientation(pre_node, dr_box.getParentNode(pre_node));
     if (curr_orientation != pre_orientation) {
       node_segment_list.emplace_back(curr_node, pre_node);
       curr_orientation = pre_orientation;
       curr_node = pre_node;
     }
-    pre_node = pre_node->get_parent_node();
+    pre_node = dr_box.getParentNode(pre_node);
   }
   node_segment_list.emplace_back(curr_node, pre_node);
 }
@@ -1370,15 +1372,15 @@ void DetailedRouter::resetStartAndEnd(DRBox& dr_box)
   end_node_comb_list[end_node_comb_idx].clear();
   end_node_comb_list[end_node_comb_idx].push_back(path_head_node);
 
-  DRNode* path_node = path_head_node->get_parent_node();
+  DRNode* path_node = dr_box.getParentNode(path_head_node);
   if (path_node == nullptr) {
     // 起点和终点重合
     path_node = path_head_node;
   } else {
     // 起点和终点不重合
-    while (path_node->get_parent_node() != nullptr) {
+    while (dr_box.getParentNode(path_node) != nullptr) {
       path_node_comb.push_back(path_node);
-      path_node = path_node->get_parent_node();
+      path_node = dr_box.getParentNode(path_node);
     }
   }
   if (start_node_comb_list.size() == 1) {
@@ -1427,37 +1429,12 @@ void DetailedRouter::resetSingleNet(DRBox& dr_box)
   dr_box.get_node_segment_list().clear();
 }
 
-// manager open list
-
-void DetailedRouter::pushToOpenList(DRBox& dr_box, DRNode* curr_node)
-{
-  std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost>& open_queue = dr_box.get_open_queue();
-  std::vector<DRNode*>& visited_node_list = dr_box.get_visited_node_list();
-
-  open_queue.push(curr_node);
-  curr_node->set_state(DRNodeState::kOpen);
-  visited_node_list.push_back(curr_node);
-}
-
-DRNode* DetailedRouter::popFromOpenList(DRBox& dr_box)
-{
-  std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost>& open_queue = dr_box.get_open_queue();
-
-  DRNode* node = nullptr;
-  if (!open_queue.empty()) {
-    node = open_queue.top();
-    open_queue.pop();
-    node->set_state(DRNodeState::kClose);
-  }
-  return node;
-}
-
 // calculate known cost
 
 double DetailedRouter::getKnowCost(DRBox& dr_box, DRNode* start_node, DRNode* end_node)
 {
   double cost = 0;
-  cost += start_node->get_known_cost();
+  cost += dr_box.getKnownCost(start_node);
   cost += getJointCost(dr_box, end_node, getOrientation(end_node, start_node));
   cost += getWireCost(dr_box, start_node, end_node);
   cost += getViaCost(dr_box, start_node, end_node);
@@ -1484,22 +1461,6 @@ double DetailedRouter::getJointCost(DRBox& dr_box, DRNode* curr_node, Orientatio
 
 // calculate estimate cost
 
-double DetailedRouter::getEstimateCostToEnd(DRBox& dr_box, DRNode* curr_node)
-{
-  std::vector<std::vector<DRNode*>>& end_node_comb_list = dr_box.get_end_node_comb_list();
-
-  double estimate_cost = DBL_MAX;
-  for (std::vector<DRNode*>& end_node_comb : end_node_comb_list) {
-    for (DRNode* end_node : end_node_comb) {
-      if (end_node->isClose()) {
-        continue;
-      }
-      estimate_cost = std::min(estimate_cost, getEstimateCost(dr_box, curr_node, end_node));
-    }
-  }
-  return estimate_cost;
-}
-
 double DetailedRouter::getEstimateCost(DRBox& dr_box, DRNode* start_node, DRNode* end_node)
 {
   double estimate_cost = 0;
@@ -1567,14 +1528,14 @@ void DetailedRouter::plotDRBox(DRBox& dr_box, irt_int curr_task_idx)
       irt_int y = real_rect.get_rt_y();
 
       GPBoundary gp_boundary;
-      switch (dr_node.get_state()) {
-        case DRNodeState::kNone:
+      switch (dr_box.getState(&dr_node)) {
+        case MazeNodeState::kNone:
           gp_boundary.set_data_type(none_data_type);
           break;
-        case DRNodeState::kOpen:
+        case MazeNodeState::kOpen:
           gp_boundary.set_data_type(open_data_type);
           break;
-        case DRNodeState::kClose:
+        case MazeNodeState::kClose:
           gp_boundary.set_data_type(close_data_type);
           break;
         default:
@@ -53,6 +53,7 @@ class DetailedRouter
 
 #if 1  // route dr_model
   void routeDRModel(DRModel& dr_model);
+  std::vector<PlanarCoord> getBoxRoutingOrder(DRModel& dr_model);
 #endif
 
 #if 1  // build dr_box
@@ -91,12 +92,7 @@ class DetailedRouter
   void initRoutingInfo(DRBox& dr_box, DRTask& dr_task);
   bool isConnectedAllEnd(DRBox& dr_box);
   void routeSinglePath(DRBox& dr_box);
-  void initPathHead(DRBox& dr_box);
-  bool searchEnded(DRBox& dr_box);
-  void expandSearching(DRBox& dr_box);
   bool passCheckingSegment(DRBox& dr_box, DRNode* start_node, DRNode* end_node);
-  bool replaceParentNode(DRBox& dr_box, DRNode* parent_node, DRNode* child_node);
-  void resetPathHead(DRBox& dr_box);
   void rerouteByEnlarging(DRBox& dr_box);
   bool isRoutingFailed(DRBox& dr_box);
   void resetSinglePath(DRBox& dr_box);
@@ -105,11 +101,8 @@ class DetailedRouter
   void resetStartAndEnd(DRBox& dr_box);
   void updateNetResult(DRBox& dr_box, DRTask& dr_task);
   void resetSingleNet(DRBox& dr_box);
-  void pushToOpenList(DRBox& dr_box, DRNode* curr_node);
-  DRNode* popFromOpenList(DRBox& dr_box);
   double getKnowCost(DRBox& dr_box, DRNode* start_node, DRNode* end_node);
   double getJointCost(DRBox& dr_box, DRNode* curr_node, Orientation orientation);
-  double getEstimateCostToEnd(DRBox& dr_box, DRNode* curr_node);
   double getEstimateCost(DRBox& dr_box, DRNode* start_node, DRNode* end_node);
   Orientation getOrientation(DRNode* start_node, DRNode* end_node);
   double getWireCost(DRBox& dr_box, DRNode* start_node, DRNode* end_node);
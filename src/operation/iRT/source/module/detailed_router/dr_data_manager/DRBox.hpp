@@ -6,6 +6,7 @@
 #include "DRTask.hpp"
 #include "LayerCoord.hpp"
 #include "LayerRect.hpp"
+#include "MazeSearcher.hpp"
 
 namespace irt {
 
@@ -34,6 +35,23 @@ class DRBox
     for (DRNodeGraph& node_graph : _layer_graph_list) {
       node_graph.free();
     }
+    _layer_node_offset_list.clear();
+    _maze_searcher.free();
+  }
+  void initMazeSearcher()
+  {
+    _layer_node_offset_list.clear();
+    size_t node_num = 0;
+    for (DRNodeGraph& node_graph : _layer_graph_list) {
+      _layer_node_offset_list.push_back(node_num);
+      node_num += node_graph.get_dr_node_list().size();
+    }
+    _maze_searcher.init(node_num);
+  }
+  size_t getNodeIdx(DRNode* dr_node)
+  {
+    irt_int layer_idx = dr_node->get_layer_idx();
+    return _layer_node_offset_list[layer_idx] + static_cast<size_t>(dr_node - _layer_graph_list[layer_idx].get_dr_node_list().data());
   }
   DRNode* getNodeRef(const LayerCoord& coord)
   {
@@ -63,10 +81,9 @@ class DRBox
   std::vector<std::vector<DRNode*>>& get_end_node_comb_list() { return _end_node_comb_list; }
   std::vector<DRNode*>& get_path_node_comb() { return _path_node_comb; }
   std::vector<Segment<DRNode*>>& get_node_segment_list() { return _node_segment_list; }
-  std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost>& get_open_queue() { return _open_queue; }
-  std::vector<DRNode*>& get_visited_node_list() { return _visited_node_list; }
-  DRNode* get_path_head_node() { return _path_head_node; }
-  irt_int get_end_node_comb_idx() const { return _end_node_comb_idx; }
+  MazeSearcher<DRNode>& get_maze_searcher() { return _maze_searcher; }
+  DRNode* get_path_head_node() { return _maze_searcher.get_path_head_node(); }
+  irt_int get_end_node_comb_idx() const { return _maze_searcher.get_end_node_comb_idx(); }
   void set_wire_unit(const double wire_unit) { _wire_unit = wire_unit; }
   void set_via_unit(const double via_unit) { _via_unit = via_unit; }
   void set_dr_task_ref(DRTask* dr_task_ref) { _dr_task_ref = dr_task_ref; }
@@ -79,11 +96,11 @@ class DRBox
   void set_path_node_comb(const std::vector<DRNode*>& path_node_comb) { _path_node_comb = path_node_comb; }
   void set_node_segment_list(const std::vector<Segment<DRNode*>>& node_segment_list) { _node_segment_list = node_segment_list; }
   void set_forced_routing(const bool forced_routing) { _forced_routing = forced_routing; }
-  void set_open_queue(const std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost>& open_queue) { _open_queue = open_queue; }
-  void set_visited_node_list(const std::vector<DRNode*>& visited_node_list) { _visited_node_list = visited_node_list; }
-  void set_path_head_node(DRNode* path_head_node) { _path_head_node = path_head_node; }
-  void set_end_node_comb_idx(const irt_int end_node_comb_idx) { _end_node_comb_idx = end_node_comb_idx; }
   bool isForcedRouting() { return _forced_routing; }
+  // node state
+  MazeNodeState getState(DRNode* dr_node) { return _maze_searcher.getState(getNodeIdx(dr_node)); }
+  DRNode* getParentNode(DRNode* dr_node) { return _maze_searcher.getParentNode(getNodeIdx(dr_node)); }
+  double getKnownCost(DRNode* dr_node) { return _maze_searcher.getKnownCost(getNodeIdx(dr_node)); }
 #endif
 
  private:
@@ -93,6 +110,7 @@ class DRBox
   std::vector<DRTask> _dr_task_list;
   std::vector<DRNodeGraph> _layer_graph_list;
   DRBoxStat _dr_box_stat;
+  std::vector<size_t> _layer_node_offset_list;
 #if 1  // astar
   // config
   double _wire_unit = 1;
@@ -106,10 +124,7 @@ class DRBox
   std::vector<Segment<DRNode*>> _node_segment_list;
   // single path
   bool _forced_routing = false;
-  std::priority_queue<DRNode*, std::vector<DRNode*>, CmpDRNodeCost> _open_queue;
-  std::vector<DRNode*> _visited_node_list;
-  DRNode* _path_head_node = nullptr;
-  irt_int _end_node_comb_idx = -1;
+  MazeSearcher<DRNode> _maze_searcher;
 #endif
 };
 
@@ -7,15 +7,6 @@
 
 namespace irt {
 
-#if 1  // astar
-enum class DRNodeState
-{
-  kNone = 0,
-  kOpen = 1,
-  kClose = 2
-};
-#endif
-
 class DRNode : public LayerCoord
 {
  public:
@@ -41,6 +32,7 @@ class DRNode : public LayerCoord
     }
     return neighbor_node;
   }
+  irt_int getNeighborNum() { return static_cast<irt_int>(_neighbor_ptr_map.size()); }
   bool isOBS(irt_int task_idx, Orientation orientation)
   {
     bool is_obs = false;
@@ -63,50 +55,12 @@ class DRNode : public LayerCoord
     return cost;
   }
   void addDemand(irt_int task_idx) { _task_queue.push(task_idx); }
-#if 1  // astar
-  DRNodeState& get_state() { return _state; }
-  DRNode* get_parent_node() const { return _parent_node; }
-  double get_known_cost() const { return _known_cost; }
-  double get_estimated_cost() const { return _estimated_cost; }
-  void set_state(DRNodeState state) { _state = state; }
-  void set_parent_node(DRNode* parent_node) { _parent_node = parent_node; }
-  void set_known_cost(const double known_cost) { _known_cost = known_cost; }
-  void set_estimated_cost(const double estimated_cost) { _estimated_cost = estimated_cost; }
-  bool isNone() { return _state == DRNodeState::kNone; }
-  bool isOpen() { return _state == DRNodeState::kOpen; }
-  bool isClose() { return _state == DRNodeState::kClose; }
-  double getTotalCost() { return (_known_cost + _estimated_cost); }
-#endif
 
  private:
   std::map<Orientation, DRNode*> _neighbor_ptr_map;
   std::map<Orientation, std::set<irt_int>> _obs_task_map;
   std::map<Orientation, std::set<irt_int>> _cost_task_map;
   std::queue<irt_int> _task_queue;
-#if 1  // astar
-  DRNodeState _state = DRNodeState::kNone;
-  DRNode* _parent_node = nullptr;
-  double _known_cost = 0.0;  // include curr
-  double _estimated_cost = 0.0;
-#endif
-};
-
-#if 1  // astar
-struct CmpDRNodeCost
-{
-  bool operator()(DRNode* a, DRNode* b)
-  {
-    if (RTUtil::equalDoubleByError(a->getTotalCost(), b->getTotalCost(), DBL_ERROR)) {
-      if (RTUtil::equalDoubleByError(a->get_estimated_cost(), b->get_estimated_cost(), DBL_ERROR)) {
-        return a->get_neighbor_ptr_map().size() < b->get_neighbor_ptr_map().size();
-      } else {
-        return a->get_estimated_cost() > b->get_estimated_cost();
-      }
-    } else {
-      return a->getTotalCost() > b->getTotalCost();
-    }
-  }
 };
-#endif
 
 }  // namespace irt
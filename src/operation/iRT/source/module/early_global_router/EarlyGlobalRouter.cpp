@@ -40,6 +40,62 @@ void EarlyGlobalRouter::route()
   // recordLog(_egr_data_manager.getConfig().temp_directory_path + "egr_record.log");
 }
 
+/**
+ * 增量更新pin坐标,只重布pin移动超过move_threshold且所在gcell发生变化的线网
+ * 第一次调用时记录每个pin的基准坐标,pin_coord_map中的坐标与初始化时的pin形状对应
+ * pin形状总是由初始形状加上相对基准坐标的累计偏移得到,避免多次移动后形状漂移
+ */
+void EarlyGlobalRouter::updatePinCoordMap(std::map<std::string, std::pair<irt_int, irt_int>>& pin_coord_map, irt_int move_threshold)
+{
+  Monitor monitor;
+
+  if (_pin_name_idx_map.empty()) {
+    initPinNameIdxMap();
+  }
+  std::vector<EGRNet>& egr_net_list = _egr_data_manager.getDatabase().get_egr_net_list();
+
+  std::vector<bool> dirty_net_list(egr_net_list.size(), false);
+  for (auto& [pin_name, coord] : pin_coord_map) {
+    if (!RTUtil::exist(_pin_name_idx_map, pin_name)) {
+      continue;
+    }
+    PlanarCoord curr_coord(coord.first, coord.second);
+    if (!RTUtil::exist(_pin_coord_map, pin_name)) {
+      _pin_origin_coord_map[pin_name] = curr_coord;
+      _pin_coord_map[pin_name] = curr_coord;
+      continue;
+    }
+    PlanarCoord& pre_coord = _pin_coord_map[pin_name];
+    if (std::abs(curr_coord.get_x() - pre_coord.get_x()) + std::abs(curr_coord.get_y() - pre_coord.get_y()) <= move_threshold) {
+      continue;
+    }
+    PlanarCoord& origin_coord = _pin_origin_coord_map[pin_name];
+    irt_int offset_x = curr_coord.get_x() - origin_coord.get_x();
+    irt_int offset_y = curr_coord.get_y() - origin_coord.get_y();
+    for (auto& [net_idx, pin_idx] : _pin_name_idx_map[pin_name]) {
+      std::vector<EXTLayerRect>& origin_shape_list = _pin_origin_shape_map[std::make_pair(net_idx, pin_idx)];
+      if (movePin(egr_net_list[net_idx].get_pin_list()[pin_idx], origin_shape_list, offset_x, offset_y)) {
+        dirty_net_list[net_idx] = true;
+      }
+    }
+    pre_coord = curr_coord;
+  }
+
+  irt_int reroute_net_num = 0;
+  for (size_t i = 0; i < egr_net_list.size(); i++) {
+    EGRNet& egr_net = egr_net_list[i];
+    if (!dirty_net_list[i] || skipRouting(egr_net)) {
+      continue;
+    }
+    // 先用旧的布线结果拆除demand,再按新的pin位置重布
+    updateLayerResourceMap(egr_net, -1);
+    updateDrivingPin(egr_net);
+    routeEGRNet(egr_net);
+    reroute_net_num++;
+  }
+  LOG_INST.info(Loc::current(), "Rerouted ", reroute_net_num, " / ", egr_net_list.size(), " nets", monitor.getStatsInfo());
+}
+
 void EarlyGlobalRouter::recordLog(std::string record_file_path)
 {
   std::ofstream record_file_stream = std::ofstream(record_file_path, std::ios_base::app);
@@ -320,7 +376,7 @@ void EarlyGlobalRouter::routeEGRNet(EGRNet& egr_net)
   EGRRoutingPackage egr_routing_package = initEGRRoutingPackage(egr_net);
   routeEGRRoutingPackage(egr_routing_package);
   updateRoutingSegmentList(egr_net, egr_routing_package);
-  updateLayerResourceMap(egr_net);
+  updateLayerResourceMap(egr_net, 1);
 }
 
 bool EarlyGlobalRouter::skipRouting(EGRNet& egr_net)
@@ -1074,7 +1130,7 @@ void EarlyGlobalRouter::updateRoutingSegmentList(EGRNet& egr_net, EGRRoutingPack
   egr_net.set_coord_tree(RTUtil::getTreeByFullFlow(candidate_root_coord_list, routing_segment_list, key_coord_pin_map));
 }
 
-void EarlyGlobalRouter::updateLayerResourceMap(EGRNet& egr_net)
+void EarlyGlobalRouter::updateLayerResourceMap(EGRNet& egr_net, double demand_scale)
 {
   MTree<LayerCoord>& coord_tree = egr_net.get_coord_tree();
   std::vector<Segment<TNode<LayerCoord>*>> routing_segment_list = RTUtil::getSegListByTree(coord_tree);
@@ -1085,19 +1141,20 @@ void EarlyGlobalRouter::updateLayerResourceMap(EGRNet& egr_net)
     irt_int layer_idx = driving_pin_grid_coord.get_layer_idx();
     irt_int x = driving_pin_grid_coord.get_x();
     irt_int y = driving_pin_grid_coord.get_y();
-    layer_resource_map[layer_idx][x][y].addDemand(EGRResourceType::kTrack, 1);
+    layer_resource_map[layer_idx][x][y].addDemand(EGRResourceType::kTrack, demand_scale);
     return;
   }
-  addDemandBySegmentList(routing_segment_list);
+  addDemandBySegmentList(routing_segment_list, demand_scale);
 }
 
-void EarlyGlobalRouter::addDemandBySegmentList(std::vector<Segment<TNode<LayerCoord>*>>& segment_list)
+void EarlyGlobalRouter::addDemandBySegmentList(std::vector<Segment<TNode<LayerCoord>*>>& segment_list, double demand_scale)
 {
   std::vector<GridMap<EGRNode>>& layer_resource_map = _egr_data_manager.getDatabase().get_layer_resource_map();
 
-  double wire_demand = 1;
-  double half_wire_demand = 0.5;
-  double via_demand = 0.2;
+  // demand_scale为-1时拆除已有的demand
+  double wire_demand = 1 * demand_scale;
+  double half_wire_demand = 0.5 * demand_scale;
+  double via_demand = 0.2 * demand_scale;
 
   std::set<LayerCoord, CmpLayerCoordByXASC> via_coord_set;
   for (Segment<TNode<LayerCoord>*>& segment : segment_list) {
@@ -1150,6 +1207,80 @@ void EarlyGlobalRouter::addDemandBySegmentList(std::vector<Segment<TNode<LayerCo
   }
 }
 
+void EarlyGlobalRouter::initPinNameIdxMap()
+{
+  std::vector<EGRNet>& egr_net_list = _egr_data_manager.getDatabase().get_egr_net_list();
+  for (size_t net_idx = 0; net_idx < egr_net_list.size(); net_idx++) {
+    std::vector<EGRPin>& pin_list = egr_net_list[net_idx].get_pin_list();
+    for (size_t pin_idx = 0; pin_idx < pin_list.size(); pin_idx++) {
+      // 与placer中的实例名保持一致,去除实例名中的转义符
+      std::string pin_name = pin_list[pin_idx].get_pin_name();
+      pin_name.erase(std::remove(pin_name.begin(), pin_name.end(), '\\'), pin_name.end());
+      _pin_name_idx_map[pin_name].emplace_back(static_cast<irt_int>(net_idx), static_cast<irt_int>(pin_idx));
+      _pin_origin_shape_map[std::make_pair(static_cast<irt_int>(net_idx), static_cast<irt_int>(pin_idx))]
+          = pin_list[pin_idx].get_routing_shape_list();
+    }
+  }
+}
+
+/**
+ * 将pin的初始形状整体平移offset并更新grid坐标
+ * 偏移量按所有形状的外包框限制在die内,pin的形状整体平移而不会被单独裁剪
+ * 返回pin的grid坐标是否发生变化
+ */
+bool EarlyGlobalRouter::movePin(EGRPin& egr_pin, std::vector<EXTLayerRect>& origin_shape_list, irt_int offset_x, irt_int offset_y)
+{
+  Die& die = _egr_data_manager.getDatabase().get_die();
+
+  std::vector<LayerCoord> pre_grid_coord_list = egr_pin.getGridCoordList();
+
+  std::vector<EXTLayerRect>& routing_shape_list = egr_pin.get_routing_shape_list();
+  if (origin_shape_list.empty() || origin_shape_list.size() != routing_shape_list.size()) {
+    return false;
+  }
+  irt_int bbox_lb_x = INT32_MAX;
+  irt_int bbox_lb_y = INT32_MAX;
+  irt_int bbox_rt_x = INT32_MIN;
+  irt_int bbox_rt_y = INT32_MIN;
+  for (EXTLayerRect& origin_shape : origin_shape_list) {
+    PlanarRect& real_rect = origin_shape.get_real_rect();
+    bbox_lb_x = std::min(bbox_lb_x, real_rect.get_lb_x());
+    bbox_lb_y = std::min(bbox_lb_y, real_rect.get_lb_y());
+    bbox_rt_x = std::max(bbox_rt_x, real_rect.get_rt_x());
+    bbox_rt_y = std::max(bbox_rt_y, real_rect.get_rt_y());
+  }
+  // 外包框超出die时以die的左下角为准
+  offset_x = std::max(std::min(offset_x, die.get_real_rt_x() - bbox_rt_x), die.get_real_lb_x() - bbox_lb_x);
+  offset_y = std::max(std::min(offset_y, die.get_real_rt_y() - bbox_rt_y), die.get_real_lb_y() - bbox_lb_y);
+
+  std::vector<AccessPoint>& access_point_list = egr_pin.get_access_point_list();
+  access_point_list.clear();
+  for (size_t i = 0; i < routing_shape_list.size(); i++) {
+    EXTLayerRect& routing_shape = routing_shape_list[i];
+    PlanarRect& origin_rect = origin_shape_list[i].get_real_rect();
+    routing_shape.set_real_lb(origin_rect.get_lb_x() + offset_x, origin_rect.get_lb_y() + offset_y);
+    routing_shape.set_real_rt(origin_rect.get_rt_x() + offset_x, origin_rect.get_rt_y() + offset_y);
+    routing_shape.set_grid_rect(_egr_data_manager.getGridRect(routing_shape.get_real_rect()));
+
+    AccessPoint access_point;
+    access_point.set_grid_coord(routing_shape.get_grid_rect().getMidPoint());
+    access_point.set_layer_idx(routing_shape.get_layer_idx());
+    access_point_list.push_back(access_point);
+  }
+  return pre_grid_coord_list != egr_pin.getGridCoordList();
+}
+
+void EarlyGlobalRouter::updateDrivingPin(EGRNet& egr_net)
+{
+  for (EGRPin& egr_pin : egr_net.get_pin_list()) {
+    if (egr_net.get_driving_pin().get_pin_name() != egr_pin.get_pin_name()) {
+      continue;
+    }
+    egr_net.set_driving_pin(egr_pin);
+    return;
+  }
+}
+
 void EarlyGlobalRouter::reportEGRNetList()
 {
   reportCongestion();
@@ -23,6 +23,8 @@ class EarlyGlobalRouter
   void plot();
   void plotCongstLoc();
   EGRDataManager& getDataManager() { return _egr_data_manager; }
+  // incremental
+  void updatePinCoordMap(std::map<std::string, std::pair<irt_int, irt_int>>& pin_coord_map, irt_int move_threshold);
 
  private:
   // self
@@ -30,6 +32,11 @@ class EarlyGlobalRouter
   // config & database
   EGRDataManager _egr_data_manager;
   idb::IdbBuilder* _idb_builder;
+  // incremental
+  std::map<std::string, std::vector<std::pair<irt_int, irt_int>>> _pin_name_idx_map;  // pin_name -> (net_idx, pin_idx)
+  std::map<std::string, PlanarCoord> _pin_origin_coord_map;                           // pin_name -> 初始pin坐标
+  std::map<std::string, PlanarCoord> _pin_coord_map;                                  // pin_name -> 上次布线时的pin坐标
+  std::map<std::pair<irt_int, irt_int>, std::vector<EXTLayerRect>> _pin_origin_shape_map;  // (net_idx, pin_idx) -> 初始pin形状
 
   EarlyGlobalRouter(std::map<std::string, std::any>& config_map, idb::IdbBuilder* idb_builder) { init(config_map, idb_builder); }
   EarlyGlobalRouter(const EarlyGlobalRouter& other) = delete;
@@ -70,8 +77,11 @@ class EarlyGlobalRouter
   void routeByOuter3BendsPattern(std::vector<std::vector<Segment<LayerCoord>>>& routing_segment_comb_list,
                                  std::pair<LayerCoord, LayerCoord>& coord_pair);
   void updateRoutingSegmentList(EGRNet& egr_net, EGRRoutingPackage& egr_routing_package);
-  void updateLayerResourceMap(EGRNet& egr_net);
-  void addDemandBySegmentList(std::vector<Segment<TNode<LayerCoord>*>>& segment_list);
+  void updateLayerResourceMap(EGRNet& egr_net, double demand_scale);
+  void addDemandBySegmentList(std::vector<Segment<TNode<LayerCoord>*>>& segment_list, double demand_scale);
+  void initPinNameIdxMap();
+  bool movePin(EGRPin& egr_pin, std::vector<EXTLayerRect>& origin_shape_list, irt_int offset_x, irt_int offset_y);
+  void updateDrivingPin(EGRNet& egr_net);
   void reportEGRNetList();
   void reportCongestion();
   void compressMap(std::map<irt_int, irt_int>& origin_map, irt_int lower_remain_num, irt_int upper_remain_num);
@@ -23,6 +23,7 @@ class EGRDataManager
   void input(std::map<std::string, std::any>& config_map, idb::IdbBuilder* idb_builder);
   EGRConfig& getConfig() { return _egr_config; }
   EGRDatabase& getDatabase() { return _egr_database; }
+  PlanarRect getGridRect(PlanarRect& real_rect);
 
  private:
   EGRConfig _egr_config;
@@ -68,7 +69,6 @@ class EGRDataManager
   void buildHVLayerIdxList();
   Direction getRTDirectionByDB(idb::IdbLayerDirection idb_direction);
   irt_int getEGRLayerIndexByDB(irt_int db_layer_idx);
-  PlanarRect getGridRect(PlanarRect& real_rect);
   void printConfig();
   void printDatabase();
 };
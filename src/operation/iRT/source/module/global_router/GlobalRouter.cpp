@@ -81,6 +81,8 @@ GRModel GlobalRouter::initGRModel(std::vector<GRNet>& gr_net_list)
       }
     }
   }
+  gr_model.set_x_size(die.getXSize());
+  gr_model.set_y_size(die.getYSize());
   gr_model.set_gr_net_list(gr_net_list);
 
   return gr_model;
@@ -110,28 +112,28 @@ void GlobalRouter::buildNeighborMap(GRModel& gr_model)
     GridMap<GRNode>& node_map = layer_node_map[layer_idx];
     for (irt_int x = 0; x < node_map.get_x_size(); x++) {
       for (irt_int y = 0; y < node_map.get_y_size(); y++) {
-        std::map<Orientation, GRNode*>& neighbor_ptr_map = node_map[x][y].get_neighbor_ptr_map();
+        GRNode& gr_node = node_map[x][y];
         if (routing_h) {
           if (x != 0) {
-            neighbor_ptr_map[Orientation::kWest] = &node_map[x - 1][y];
+            gr_node.addNeighbor(Orientation::kWest);
           }
           if (x != (node_map.get_x_size() - 1)) {
-            neighbor_ptr_map[Orientation::kEast] = &node_map[x + 1][y];
+            gr_node.addNeighbor(Orientation::kEast);
           }
         }
         if (routing_v) {
           if (y != 0) {
-            neighbor_ptr_map[Orientation::kSouth] = &node_map[x][y - 1];
+            gr_node.addNeighbor(Orientation::kSouth);
           }
           if (y != (node_map.get_y_size() - 1)) {
-            neighbor_ptr_map[Orientation::kNorth] = &node_map[x][y + 1];
+            gr_node.addNeighbor(Orientation::kNorth);
           }
         }
         if (layer_idx != 0) {
-          neighbor_ptr_map[Orientation::kDown] = &layer_node_map[layer_idx - 1][x][y];
+          gr_node.addNeighbor(Orientation::kDown);
         }
         if (layer_idx != static_cast<irt_int>(layer_node_map.size()) - 1) {
-          neighbor_ptr_map[Orientation::kUp] = &layer_node_map[layer_idx + 1][x][y];
+          gr_node.addNeighbor(Orientation::kUp);
         }
       }
     }
@@ -140,29 +142,12 @@ void GlobalRouter::buildNeighborMap(GRModel& gr_model)
 
 void GlobalRouter::buildNodeSupply(GRModel& gr_model)
 {
-  initNodeRealRect(gr_model);
   addBlockageList(gr_model);
   addNetRegionList(gr_model);
   calcAreaSupply(gr_model);
   buildAccessMap(gr_model);
 }
 
-void GlobalRouter::initNodeRealRect(GRModel& gr_model)
-{
-  GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
-
-  std::vector<GridMap<GRNode>>& layer_node_map = gr_model.get_layer_node_map();
-  for (size_t layer_idx = 0; layer_idx < layer_node_map.size(); layer_idx++) {
-    GridMap<GRNode>& node_map = layer_node_map[layer_idx];
-    for (irt_int x = 0; x < node_map.get_x_size(); x++) {
-      for (irt_int y = 0; y < node_map.get_y_size(); y++) {
-        GRNode& gr_node = node_map[x][y];
-        gr_node.set_real_rect(RTUtil::getRealRect(x, y, gcell_axis));
-      }
-    }
-  }
-}
-
 void GlobalRouter::addBlockageList(GRModel& gr_model)
 {
   GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
@@ -179,7 +164,7 @@ void GlobalRouter::addBlockageList(GRModel& gr_model)
     PlanarRect enlarged_grid_rect = RTUtil::getClosedGridRect(enlarged_real_rect, gcell_axis);
     for (irt_int x = enlarged_grid_rect.get_lb_x(); x <= enlarged_grid_rect.get_rt_x(); x++) {
       for (irt_int y = enlarged_grid_rect.get_lb_y(); y <= enlarged_grid_rect.get_rt_y(); y++) {
-        layer_node_map[layer_idx][x][y].get_net_blockage_map()[-1].push_back(enlarged_real_rect);
+        gr_model.getNetBlockageMap(layer_node_map[layer_idx][x][y])[-1].push_back(enlarged_real_rect);
       }
     }
   }
@@ -192,7 +177,7 @@ void GlobalRouter::addBlockageList(GRModel& gr_model)
         PlanarRect enlarged_grid_rect = RTUtil::getClosedGridRect(enlarged_real_rect, gcell_axis);
         for (irt_int x = enlarged_grid_rect.get_lb_x(); x <= enlarged_grid_rect.get_rt_x(); x++) {
           for (irt_int y = enlarged_grid_rect.get_lb_y(); y <= enlarged_grid_rect.get_rt_y(); y++) {
-            layer_node_map[layer_idx][x][y].get_net_blockage_map()[gr_net.get_net_idx()].push_back(enlarged_real_rect);
+            gr_model.getNetBlockageMap(layer_node_map[layer_idx][x][y])[gr_net.get_net_idx()].push_back(enlarged_real_rect);
           }
         }
       }
@@ -240,7 +225,7 @@ void GlobalRouter::addNetRegionList(GRModel& gr_model)
       PlanarRect enlarged_grid_rect = RTUtil::getClosedGridRect(enlarged_real_rect, gcell_axis);
       for (irt_int x = enlarged_grid_rect.get_lb_x(); x <= enlarged_grid_rect.get_rt_x(); x++) {
         for (irt_int y = enlarged_grid_rect.get_lb_y(); y <= enlarged_grid_rect.get_rt_y(); y++) {
-          layer_node_map[layer_idx][x][y].get_net_region_map()[gr_net.get_net_idx()].push_back(enlarged_real_rect);
+          gr_model.getNetRegionMap(layer_node_map[layer_idx][x][y])[gr_net.get_net_idx()].push_back(enlarged_real_rect);
         }
       }
     }
@@ -259,7 +244,7 @@ void GlobalRouter::calcAreaSupply(GRModel& gr_model)
     for (irt_int x = 0; x < node_map.get_x_size(); x++) {
       for (irt_int y = 0; y < node_map.get_y_size(); y++) {
         initSingleResource(node_map[x][y], routing_layer_list[layer_idx]);
-        initResourceSupply(node_map[x][y], routing_layer_list[layer_idx]);
+        initResourceSupply(gr_model, node_map[x][y], routing_layer_list[layer_idx]);
       }
     }
   }
@@ -267,13 +252,16 @@ void GlobalRouter::calcAreaSupply(GRModel& gr_model)
 
 void GlobalRouter::initSingleResource(GRNode& gr_node, RoutingLayer& routing_layer)
 {
+  GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
+
   irt_int min_width = routing_layer.get_min_width();
+  PlanarRect real_rect = RTUtil::getRealRect(gr_node.get_planar_coord(), gcell_axis);
 
   double single_wire_area = 0;
   if (routing_layer.isPreferH()) {
-    single_wire_area = (gr_node.get_real_rect().getXSpan() * min_width);
+    single_wire_area = (real_rect.getXSpan() * min_width);
   } else {
-    single_wire_area = (gr_node.get_real_rect().getYSpan() * min_width);
+    single_wire_area = (real_rect.getYSpan() * min_width);
   }
   gr_node.set_single_wire_area(single_wire_area);
 
@@ -283,7 +271,7 @@ void GlobalRouter::initSingleResource(GRNode& gr_node, RoutingLayer& routing_lay
   gr_node.set_single_via_area(via_rect.getArea());
 }
 
-void GlobalRouter::initResourceSupply(GRNode& gr_node, RoutingLayer& routing_layer)
+void GlobalRouter::initResourceSupply(GRModel& gr_model, GRNode& gr_node, RoutingLayer& routing_layer)
 {
   std::map<irt_int, double>& layer_idx_utilization_ratio = _gr_data_manager.getConfig().layer_idx_utilization_ratio;
 
@@ -300,8 +288,8 @@ void GlobalRouter::initResourceSupply(GRNode& gr_node, RoutingLayer& routing_lay
     }
   }
 
-  for (auto& [net_idx, blockage_list] : gr_node.get_net_blockage_map()) {
-    for (PlanarRect& blockage : blockage_list) {
+  for (const auto& [net_idx, blockage_list] : gr_model.findNetBlockageMap(gr_node)) {
+    for (const PlanarRect& blockage : blockage_list) {
       std::vector<PlanarRect> new_wire_list;
       for (PlanarRect& wire : wire_list) {
         if (RTUtil::isOpenOverlap(blockage, wire)) {
@@ -355,10 +343,13 @@ void GlobalRouter::initResourceSupply(GRNode& gr_node, RoutingLayer& routing_lay
 
 std::vector<PlanarRect> GlobalRouter::getWireList(GRNode& gr_node, RoutingLayer& routing_layer)
 {
-  irt_int real_lb_x = gr_node.get_real_rect().get_lb_x();
-  irt_int real_lb_y = gr_node.get_real_rect().get_lb_y();
-  irt_int real_rt_x = gr_node.get_real_rect().get_rt_x();
-  irt_int real_rt_y = gr_node.get_real_rect().get_rt_y();
+  GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
+
+  PlanarRect real_rect = RTUtil::getRealRect(gr_node.get_planar_coord(), gcell_axis);
+  irt_int real_lb_x = real_rect.get_lb_x();
+  irt_int real_lb_y = real_rect.get_lb_y();
+  irt_int real_rt_x = real_rect.get_rt_x();
+  irt_int real_rt_y = real_rect.get_rt_y();
   std::vector<irt_int> x_list = RTUtil::getOpenScaleList(real_lb_x, real_rt_x, routing_layer.getXTrackGrid());
   std::vector<irt_int> y_list = RTUtil::getOpenScaleList(real_lb_y, real_rt_y, routing_layer.getYTrackGrid());
   irt_int half_width = routing_layer.get_min_width() / 2;
@@ -392,18 +383,18 @@ void GlobalRouter::buildAccessMap(GRModel& gr_model)
       // 本层打通孔
       {
         GRNode& gr_node = layer_node_map[grid.get_layer_idx()][grid.get_x()][grid.get_y()];
-        gr_node.get_net_access_map()[gr_net.get_net_idx()].insert({Orientation::kUp, Orientation::kDown});
+        gr_model.getNetAccessMap(gr_node)[gr_net.get_net_idx()].insert({Orientation::kUp, Orientation::kDown});
       }
       // 上层打通孔
       if (grid.get_layer_idx() + 1 < static_cast<irt_int>(layer_node_map.size())) {
         GRNode& gr_node = layer_node_map[grid.get_layer_idx() + 1][grid.get_x()][grid.get_y()];
-        gr_node.get_net_access_map()[gr_net.get_net_idx()].insert(
+        gr_model.getNetAccessMap(gr_node)[gr_net.get_net_idx()].insert(
             {Orientation::kUp, Orientation::kDown, Orientation::kEast, Orientation::kWest, Orientation::kSouth, Orientation::kNorth});
       }
       // 下层打通孔
       if (0 <= grid.get_layer_idx() - 1) {
         GRNode& gr_node = layer_node_map[grid.get_layer_idx() - 1][grid.get_x()][grid.get_y()];
-        gr_node.get_net_access_map()[gr_net.get_net_idx()].insert(
+        gr_model.getNetAccessMap(gr_node)[gr_net.get_net_idx()].insert(
             {Orientation::kUp, Orientation::kDown, Orientation::kEast, Orientation::kWest, Orientation::kSouth, Orientation::kNorth});
       }
     }
@@ -439,6 +430,7 @@ void GlobalRouter::buildGRNetPriority(GRModel& gr_model)
 
 void GlobalRouter::checkGRModel(GRModel& gr_model)
 {
+  GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
   std::vector<RoutingLayer>& routing_layer_list = _gr_data_manager.getDatabase().get_routing_layer_list();
   irt_int bottom_routing_layer_idx = _gr_data_manager.getConfig().bottom_routing_layer_idx;
   irt_int top_routing_layer_idx = _gr_data_manager.getConfig().top_routing_layer_idx;
@@ -455,23 +447,24 @@ void GlobalRouter::checkGRModel(GRModel& gr_model)
     for (irt_int x = 0; x < node_map.get_x_size(); x++) {
       for (irt_int y = 0; y < node_map.get_y_size(); y++) {
         GRNode& gr_node = node_map[x][y];
-        std::map<Orientation, GRNode*>& neighbor_ptr_map = gr_node.get_neighbor_ptr_map();
+        PlanarRect real_rect = RTUtil::getRealRect(gr_node.get_planar_coord(), gcell_axis);
         if (routing_h) {
-          if (RTUtil::exist(neighbor_ptr_map, Orientation::kNorth) || RTUtil::exist(neighbor_ptr_map, Orientation::kSouth)) {
+          if (gr_node.hasNeighbor(Orientation::kNorth) || gr_node.hasNeighbor(Orientation::kSouth)) {
             LOG_INST.error(Loc::current(), "There is illegal vertical neighbor relations!");
           }
         }
         if (routing_v) {
-          if (RTUtil::exist(neighbor_ptr_map, Orientation::kEast) || RTUtil::exist(neighbor_ptr_map, Orientation::kWest)) {
+          if (gr_node.hasNeighbor(Orientation::kEast) || gr_node.hasNeighbor(Orientation::kWest)) {
             LOG_INST.error(Loc::current(), "There is illegal horizontal neighbor relations!");
           }
         }
-        for (auto& [orien, neighbor] : neighbor_ptr_map) {
-          Orientation opposite_orien = RTUtil::getOppositeOrientation(orien);
-          if (!RTUtil::exist(neighbor->get_neighbor_ptr_map(), opposite_orien)) {
-            LOG_INST.error(Loc::current(), "The gr_node neighbor is not bidirection!");
+        for (Orientation orien : GRModel::kNeighborOrientationList) {
+          GRNode* neighbor = gr_model.getNeighborNode(&gr_node, orien);
+          if (neighbor == nullptr) {
+            continue;
           }
-          if (neighbor->get_neighbor_ptr_map()[opposite_orien] != &gr_node) {
+          Orientation opposite_orien = RTUtil::getOppositeOrientation(orien);
+          if (gr_model.getNeighborNode(neighbor, opposite_orien) != &gr_node) {
             LOG_INST.error(Loc::current(), "The gr_node neighbor is not bidirection!");
           }
           LayerCoord node_coord(gr_node.get_planar_coord(), gr_node.get_layer_idx());
@@ -480,17 +473,17 @@ void GlobalRouter::checkGRModel(GRModel& gr_model)
             LOG_INST.error(Loc::current(), "The neighbor orien is different with real region!");
           }
         }
-        for (auto& [net_idx, blockage_list] : gr_node.get_net_blockage_map()) {
-          for (PlanarRect& blockage : blockage_list) {
-            if (RTUtil::isClosedOverlap(gr_node.get_real_rect(), blockage)) {
+        for (const auto& [net_idx, blockage_list] : gr_model.findNetBlockageMap(gr_node)) {
+          for (const PlanarRect& blockage : blockage_list) {
+            if (RTUtil::isClosedOverlap(real_rect, blockage)) {
               continue;
             }
             LOG_INST.error(Loc::current(), "The blockage is outside the node region!");
           }
         }
-        for (auto& [net_idx, region_list] : gr_node.get_net_region_map()) {
-          for (PlanarRect& region : region_list) {
-            if (RTUtil::isClosedOverlap(gr_node.get_real_rect(), region)) {
+        for (const auto& [net_idx, region_list] : gr_model.findNetRegionMap(gr_node)) {
+          for (const PlanarRect& region : region_list) {
+            if (RTUtil::isClosedOverlap(real_rect, region)) {
               continue;
             }
             LOG_INST.error(Loc::current(), "The region is outside the node region!");
@@ -628,45 +621,147 @@ void GlobalRouter::routeGRModel(GRModel& gr_model)
   Monitor monitor;
 
   std::vector<GRNet>& gr_net_list = gr_model.get_gr_net_list();
+  std::vector<GridMap<GRNode>>& layer_node_map = gr_model.get_layer_node_map();
+  if (gr_net_list.empty() || layer_node_map.empty()) {
+    return;
+  }
+  irt_int thread_number = std::max(_gr_data_manager.getConfig().thread_number, 1);
+
+  std::vector<GRSearchState> gr_search_state_list(thread_number);
+  for (GRSearchState& gr_search_state : gr_search_state_list) {
+    gr_search_state.set_gr_model_ref(&gr_model);
+  }
+  std::vector<std::vector<irt_int>> net_batch_list = getNetBatchList(gr_model);
+  LOG_INST.info(Loc::current(), "Divide ", gr_net_list.size(), " nets into ", net_batch_list.size(), " batches");
 
   irt_int batch_size = RTUtil::getBatchSize(gr_net_list.size());
 
   Monitor stage_monitor;
-  for (size_t i = 0; i < gr_net_list.size(); i++) {
-    routeGRNet(gr_model, gr_net_list[i]);
-    if ((i + 1) % batch_size == 0) {
-      LOG_INST.info(Loc::current(), "Processed ", (i + 1), " nets", stage_monitor.getStatsInfo());
+  size_t routed_net_num = 0;
+  for (std::vector<irt_int>& net_batch : net_batch_list) {
+    // the nets in one batch have no overlapped bounding box, so the demand is committed after the batch
+    // the nets failed in the bounding box are delayed, the enlarged region may overlap the other nets of the batch
+#pragma omp parallel for num_threads(thread_number) schedule(dynamic)
+    for (size_t i = 0; i < net_batch.size(); i++) {
+      routeGRNet(gr_model, gr_search_state_list[omp_get_thread_num()], gr_net_list[net_batch[i]], false);
+    }
+    for (irt_int net_idx : net_batch) {
+      updateNetDemand(gr_model, gr_net_list[net_idx]);
+    }
+    rerouteDelayedNets(gr_model, gr_search_state_list);
+    reportRerouting(gr_search_state_list);
+    size_t pre_routed_net_num = routed_net_num;
+    routed_net_num += net_batch.size();
+    if (routed_net_num / batch_size != pre_routed_net_num / batch_size) {
+      LOG_INST.info(Loc::current(), "Processed ", routed_net_num, " nets", stage_monitor.getStatsInfo());
     }
   }
 
   LOG_INST.info(Loc::current(), "Processed ", gr_net_list.size(), " nets", monitor.getStatsInfo());
 }
 
-void GlobalRouter::routeGRNet(GRModel& gr_model, GRNet& gr_net)
+std::vector<std::vector<irt_int>> GlobalRouter::getNetBatchList(GRModel& gr_model)
 {
-  initRoutingInfo(gr_model, gr_net);
-  while (!isConnectedAllEnd(gr_model)) {
-    routeSinglePath(gr_model);
-    rerouteByEnlarging(gr_model);
-    rerouteByforcing(gr_model);
-    updatePathResult(gr_model);
-    resetStartAndEnd(gr_model);
-    resetSinglePath(gr_model);
-  }
-  updateNetResult(gr_model, gr_net);
-  resetSingleNet(gr_model);
+  Die& die = _gr_data_manager.getDatabase().get_die();
+  std::vector<GRNet>& gr_net_list = gr_model.get_gr_net_list();
+
+  std::vector<std::vector<irt_int>> net_batch_list;
+  if (_gr_data_manager.getConfig().thread_number <= 1) {
+    // route the nets one by one in the sorted order
+    for (size_t i = 0; i < gr_net_list.size(); i++) {
+      net_batch_list.push_back({static_cast<irt_int>(i)});
+    }
+    return net_batch_list;
+  }
+  // the nets are binned by a coarse grid, a net is put behind all the earlier nets whose bounding box overlapped with it,
+  // so the overlapped nets keep the sorted order and the batches are deterministic.
+  irt_int bin_size = std::max(1, std::max(die.getXSize(), die.getYSize()) / 64);
+  irt_int bin_x_size = (die.getXSize() + bin_size - 1) / bin_size;
+  irt_int bin_y_size = (die.getYSize() + bin_size - 1) / bin_size;
+  GridMap<std::vector<std::pair<PlanarRect, irt_int>>> bin_rect_map(bin_x_size, bin_y_size);
+  for (size_t i = 0; i < gr_net_list.size(); i++) {
+    PlanarRect& grid_rect = gr_net_list[i].get_bounding_box().get_grid_rect();
+    irt_int lb_x = std::max(grid_rect.get_lb_x(), 0) / bin_size;
+    irt_int lb_y = std::max(grid_rect.get_lb_y(), 0) / bin_size;
+    irt_int rt_x = std::min(grid_rect.get_rt_x(), die.getXSize() - 1) / bin_size;
+    irt_int rt_y = std::min(grid_rect.get_rt_y(), die.getYSize() - 1) / bin_size;
+
+    irt_int batch_idx = 0;
+    for (irt_int x = lb_x; x <= rt_x; x++) {
+      for (irt_int y = lb_y; y <= rt_y; y++) {
+        for (auto& [bin_rect, bin_batch_idx] : bin_rect_map[x][y]) {
+          if (bin_batch_idx >= batch_idx && RTUtil::isOverlap(grid_rect, bin_rect)) {
+            batch_idx = bin_batch_idx + 1;
+          }
+        }
+      }
+    }
+    for (irt_int x = lb_x; x <= rt_x; x++) {
+      for (irt_int y = lb_y; y <= rt_y; y++) {
+        bin_rect_map[x][y].emplace_back(grid_rect, batch_idx);
+      }
+    }
+    if (static_cast<irt_int>(net_batch_list.size()) <= batch_idx) {
+      net_batch_list.resize(batch_idx + 1);
+    }
+    net_batch_list[batch_idx].push_back(static_cast<irt_int>(i));
+  }
+  return net_batch_list;
+}
+
+void GlobalRouter::rerouteDelayedNets(GRModel& gr_model, std::vector<GRSearchState>& gr_search_state_list)
+{
+  std::vector<GRNet*> delayed_net_list;
+  for (GRSearchState& gr_search_state : gr_search_state_list) {
+    std::vector<GRNet*>& delayed_list = gr_search_state.get_delayed_net_list();
+    delayed_net_list.insert(delayed_net_list.end(), delayed_list.begin(), delayed_list.end());
+    delayed_list.clear();
+  }
+  // the delayed nets are rerouted one by one in the sorted order, each one sees the demand of the whole batch
+  std::sort(delayed_net_list.begin(), delayed_net_list.end());
+  for (GRNet* gr_net : delayed_net_list) {
+    routeGRNet(gr_model, gr_search_state_list.front(), *gr_net, true);
+    updateNetDemand(gr_model, *gr_net);
+  }
 }
 
-void GlobalRouter::initRoutingInfo(GRModel& gr_model, GRNet& gr_net)
+void GlobalRouter::routeGRNet(GRModel& gr_model, GRSearchState& gr_search_state, GRNet& gr_net, bool enlarging)
+{
+  initRoutingInfo(gr_model, gr_search_state, gr_net);
+  while (!isConnectedAllEnd(gr_search_state)) {
+    routeSinglePath(gr_search_state);
+    if (!enlarging && isRoutingFailed(gr_search_state)) {
+      // drop the partial result, the net is rerouted by enlarging after the demand of the batch is updated
+      gr_search_state.get_delayed_net_list().push_back(&gr_net);
+      resetSinglePath(gr_search_state);
+      resetSingleNet(gr_search_state);
+      return;
+    }
+    rerouteByEnlarging(gr_search_state);
+    rerouteByforcing(gr_search_state);
+    if (isRoutingFailed(gr_search_state)) {
+      // the failure is reported after the batch
+      resetSinglePath(gr_search_state);
+      break;
+    }
+    updatePathResult(gr_search_state);
+    resetStartAndEnd(gr_search_state);
+    resetSinglePath(gr_search_state);
+  }
+  updateNetResult(gr_search_state, gr_net);
+  resetSingleNet(gr_search_state);
+}
+
+void GlobalRouter::initRoutingInfo(GRModel& gr_model, GRSearchState& gr_search_state, GRNet& gr_net)
 {
   std::vector<GridMap<GRNode>>& layer_node_map = gr_model.get_layer_node_map();
-  std::vector<std::vector<GRNode*>>& start_node_comb_list = gr_model.get_start_node_comb_list();
-  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_model.get_end_node_comb_list();
+  std::vector<std::vector<GRNode*>>& start_node_comb_list = gr_search_state.get_start_node_comb_list();
+  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_search_state.get_end_node_comb_list();
 
-  gr_model.set_wire_unit(1);
-  gr_model.set_via_unit(1);
-  gr_model.set_gr_net_ref(&gr_net);
-  gr_model.set_routing_region(gr_model.get_curr_bounding_box());
+  gr_search_state.set_wire_unit(1);
+  gr_search_state.set_via_unit(1);
+  gr_search_state.set_gr_net_ref(&gr_net);
+  gr_search_state.set_routing_region(gr_search_state.get_curr_bounding_box());
 
   GRPin& gr_driving_pin = gr_net.get_gr_driving_pin();
   std::vector<GRNode*> start_node_comb;
@@ -689,90 +784,40 @@ void GlobalRouter::initRoutingInfo(GRModel& gr_model, GRNet& gr_net)
   }
 }
 
-bool GlobalRouter::isConnectedAllEnd(GRModel& gr_model)
-{
-  return gr_model.get_end_node_comb_list().empty();
-}
-
-void GlobalRouter::routeSinglePath(GRModel& gr_model)
-{
-  initPathHead(gr_model);
-  while (!searchEnded(gr_model)) {
-    expandSearching(gr_model);
-    resetPathHead(gr_model);
-  }
-}
-
-void GlobalRouter::initPathHead(GRModel& gr_model)
+bool GlobalRouter::isConnectedAllEnd(GRSearchState& gr_search_state)
 {
-  std::vector<std::vector<GRNode*>>& start_node_comb_list = gr_model.get_start_node_comb_list();
-  std::vector<GRNode*>& path_node_comb = gr_model.get_path_node_comb();
-
-  for (std::vector<GRNode*>& start_node_comb : start_node_comb_list) {
-    for (GRNode* start_node : start_node_comb) {
-      start_node->set_estimated_cost(getEstimateCostToEnd(gr_model, start_node));
-      pushToOpenList(gr_model, start_node);
-    }
-  }
-  for (GRNode* path_node : path_node_comb) {
-    path_node->set_estimated_cost(getEstimateCostToEnd(gr_model, path_node));
-    pushToOpenList(gr_model, path_node);
-  }
-  gr_model.set_path_head_node(popFromOpenList(gr_model));
+  return gr_search_state.get_end_node_comb_list().empty();
 }
 
-bool GlobalRouter::searchEnded(GRModel& gr_model)
+void GlobalRouter::routeSinglePath(GRSearchState& gr_search_state)
 {
-  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_model.get_end_node_comb_list();
-  GRNode* path_head_node = gr_model.get_path_head_node();
+  GRModel& gr_model = gr_search_state.get_gr_model();
 
-  if (path_head_node == nullptr) {
-    gr_model.set_end_node_comb_idx(-1);
-    return true;
+  std::vector<GRNode*> source_node_list;
+  for (std::vector<GRNode*>& start_node_comb : gr_search_state.get_start_node_comb_list()) {
+    source_node_list.insert(source_node_list.end(), start_node_comb.begin(), start_node_comb.end());
   }
-  for (size_t i = 0; i < end_node_comb_list.size(); i++) {
-    for (GRNode* end_node : end_node_comb_list[i]) {
-      if (path_head_node == end_node) {
-        gr_model.set_end_node_comb_idx(static_cast<irt_int>(i));
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
-void GlobalRouter::expandSearching(GRModel& gr_model)
-{
-  GRNode* path_head_node = gr_model.get_path_head_node();
+  std::vector<GRNode*>& path_node_comb = gr_search_state.get_path_node_comb();
+  source_node_list.insert(source_node_list.end(), path_node_comb.begin(), path_node_comb.end());
 
-  for (auto& [orientation, neighbor_node] : path_head_node->get_neighbor_ptr_map()) {
-    if (neighbor_node == nullptr) {
-      continue;
-    }
-    if (!RTUtil::isInside(gr_model.get_routing_region(), *neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isClose()) {
-      continue;
-    }
-    if (!passCheckingSegment(gr_model, path_head_node, neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isOpen() && replaceParentNode(gr_model, path_head_node, neighbor_node)) {
-      neighbor_node->set_known_cost(getKnowCost(gr_model, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-    } else if (neighbor_node->isNone()) {
-      neighbor_node->set_known_cost(getKnowCost(gr_model, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-      neighbor_node->set_estimated_cost(getEstimateCostToEnd(gr_model, neighbor_node));
-      pushToOpenList(gr_model, neighbor_node);
-    }
-  }
+  MazeGraph maze_graph{[&](GRNode* gr_node) { return gr_search_state.getNodeIdx(gr_node); },
+                       [&](GRNode* gr_node, auto visit) {
+                         for (Orientation orientation : GRModel::kNeighborOrientationList) {
+                           GRNode* neighbor_node = gr_model.getNeighborNode(gr_node, orientation);
+                           if (neighbor_node != nullptr && RTUtil::isInside(gr_search_state.get_routing_region(), *neighbor_node)) {
+                             visit(neighbor_node);
+                           }
+                         }
+                       },
+                       [&](GRNode* start_node, GRNode* end_node) { return passCheckingSegment(gr_search_state, start_node, end_node); },
+                       [&](GRNode* start_node, GRNode* end_node) { return getKnowCost(gr_search_state, start_node, end_node); },
+                       [&](GRNode* start_node, GRNode* end_node) { return getEstimateCost(gr_search_state, start_node, end_node); }};
+  gr_search_state.get_maze_searcher().search(maze_graph, source_node_list, gr_search_state.get_end_node_comb_list());
 }
 
-bool GlobalRouter::passCheckingSegment(GRModel& gr_model, GRNode* start_node, GRNode* end_node)
+bool GlobalRouter::passCheckingSegment(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node)
 {
-  if (gr_model.isForcedRouting()) {
+  if (gr_search_state.isForcedRouting()) {
     return true;
   }
   Orientation orientation = getOrientation(start_node, end_node);
@@ -781,129 +826,141 @@ bool GlobalRouter::passCheckingSegment(GRModel& gr_model, GRNode* start_node, GR
   }
   Orientation opposite_orientation = RTUtil::getOppositeOrientation(orientation);
 
+  GRModel& gr_model = gr_search_state.get_gr_model();
+  irt_int curr_net_idx = gr_search_state.get_curr_net_idx();
+
   GRNode* pre_node = nullptr;
   GRNode* curr_node = start_node;
 
   while (curr_node != end_node) {
     pre_node = curr_node;
-    curr_node = pre_node->getNeighborNode(orientation);
+    curr_node = gr_model.getNeighborNode(pre_node, orientation);
 
     if (curr_node == nullptr) {
       return false;
     }
-    if (pre_node->isOBS(gr_model.get_curr_net_idx(), orientation) || curr_node->isOBS(gr_model.get_curr_net_idx(), opposite_orientation)) {
+    if (gr_model.isOBS(*pre_node, curr_net_idx, orientation) || gr_model.isOBS(*curr_node, curr_net_idx, opposite_orientation)) {
       return false;
     }
   }
   return true;
 }
 
-bool GlobalRouter::replaceParentNode(GRModel& gr_model, GRNode* parent_node, GRNode* child_node)
-{
-  return getKnowCost(gr_model, parent_node, child_node) < child_node->get_known_cost();
-}
-
-void GlobalRouter::resetPathHead(GRModel& gr_model)
-{
-  gr_model.set_path_head_node(popFromOpenList(gr_model));
-}
-
-void GlobalRouter::rerouteByEnlarging(GRModel& gr_model)
+void GlobalRouter::rerouteByEnlarging(GRSearchState& gr_search_state)
 {
   Die& die = _gr_data_manager.getDatabase().get_die();
-  if (isRoutingFailed(gr_model)) {
-    resetSinglePath(gr_model);
-    gr_model.set_routing_region(die.get_grid_rect());
-    routeSinglePath(gr_model);
-    gr_model.set_routing_region(gr_model.get_curr_bounding_box());
-    if (!isRoutingFailed(gr_model)) {
-      LOG_INST.info(Loc::current(), "The net ", gr_model.get_curr_net_idx(), " enlarged routing successfully!");
+  if (isRoutingFailed(gr_search_state)) {
+    resetSinglePath(gr_search_state);
+    gr_search_state.set_routing_region(die.get_grid_rect());
+    routeSinglePath(gr_search_state);
+    if (!isRoutingFailed(gr_search_state)) {
+      gr_search_state.get_enlarged_net_idx_list().push_back(gr_search_state.get_curr_net_idx());
     }
   }
 }
 
-bool GlobalRouter::isRoutingFailed(GRModel& gr_model)
+bool GlobalRouter::isRoutingFailed(GRSearchState& gr_search_state)
 {
-  return gr_model.get_end_node_comb_idx() == -1;
+  return gr_search_state.get_end_node_comb_idx() == -1;
 }
 
-void GlobalRouter::resetSinglePath(GRModel& gr_model)
+void GlobalRouter::resetSinglePath(GRSearchState& gr_search_state)
 {
-  gr_model.set_forced_routing(false);
+  gr_search_state.set_forced_routing(false);
 
-  std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost> empty_queue;
-  gr_model.set_open_queue(empty_queue);
+  gr_search_state.get_maze_searcher().reset();
+  // the path is traced back before the reset, so the region is restored after the state is cleared
+  gr_search_state.set_routing_region(gr_search_state.get_curr_bounding_box());
+}
 
-  std::vector<GRNode*>& visited_node_list = gr_model.get_visited_node_list();
-  for (GRNode* visited_node : visited_node_list) {
-    visited_node->set_state(GRNodeState::kNone);
-    visited_node->set_parent_node(nullptr);
-    visited_node->set_known_cost(0);
-    visited_node->set_estimated_cost(0);
+void GlobalRouter::rerouteByforcing(GRSearchState& gr_search_state)
+{
+  if (isRoutingFailed(gr_search_state)) {
+    gr_search_state.get_forced_net_idx_list().push_back(gr_search_state.get_curr_net_idx());
+    resetSinglePath(gr_search_state);
+    gr_search_state.set_forced_routing(true);
+    routeSinglePath(gr_search_state);
+    if (isRoutingFailed(gr_search_state)) {
+      gr_search_state.get_failed_net_idx_list().push_back(gr_search_state.get_curr_net_idx());
+    }
   }
-  visited_node_list.clear();
-
-  gr_model.set_path_head_node(nullptr);
-  gr_model.set_end_node_comb_idx(-1);
 }
 
-void GlobalRouter::rerouteByforcing(GRModel& gr_model)
+void GlobalRouter::reportRerouting(std::vector<GRSearchState>& gr_search_state_list)
 {
-  if (isRoutingFailed(gr_model)) {
-    LOG_INST.warning(Loc::current(), "The net ", gr_model.get_curr_net_idx(), " forced routing!");
-    resetSinglePath(gr_model);
-    gr_model.set_forced_routing(true);
-    routeSinglePath(gr_model);
-    if (isRoutingFailed(gr_model)) {
-      LOG_INST.error(Loc::current(), "The net ", gr_model.get_curr_net_idx(), " forced routing failed!");
-    }
+  // the rerouting is recorded by the routing threads and reported here out of the parallel region
+  std::vector<irt_int> enlarged_net_idx_list;
+  std::vector<irt_int> forced_net_idx_list;
+  std::vector<irt_int> failed_net_idx_list;
+  for (GRSearchState& gr_search_state : gr_search_state_list) {
+    std::vector<irt_int>& enlarged_list = gr_search_state.get_enlarged_net_idx_list();
+    std::vector<irt_int>& forced_list = gr_search_state.get_forced_net_idx_list();
+    std::vector<irt_int>& failed_list = gr_search_state.get_failed_net_idx_list();
+    enlarged_net_idx_list.insert(enlarged_net_idx_list.end(), enlarged_list.begin(), enlarged_list.end());
+    forced_net_idx_list.insert(forced_net_idx_list.end(), forced_list.begin(), forced_list.end());
+    failed_net_idx_list.insert(failed_net_idx_list.end(), failed_list.begin(), failed_list.end());
+    enlarged_list.clear();
+    forced_list.clear();
+    failed_list.clear();
+  }
+  std::sort(enlarged_net_idx_list.begin(), enlarged_net_idx_list.end());
+  std::sort(forced_net_idx_list.begin(), forced_net_idx_list.end());
+  std::sort(failed_net_idx_list.begin(), failed_net_idx_list.end());
+  for (irt_int net_idx : enlarged_net_idx_list) {
+    LOG_INST.info(Loc::current(), "The net ", net_idx, " enlarged routing successfully!");
+  }
+  for (irt_int net_idx : forced_net_idx_list) {
+    LOG_INST.warning(Loc::current(), "The net ", net_idx, " forced routing!");
+  }
+  for (irt_int net_idx : failed_net_idx_list) {
+    LOG_INST.error(Loc::current(), "The net ", net_idx, " forced routing failed!");
   }
 }
 
-void GlobalRouter::updatePathResult(GRModel& gr_model)
+void GlobalRouter::updatePathResult(GRSearchState& gr_search_state)
 {
-  std::vector<Segment<GRNode*>>& node_segment_list = gr_model.get_node_segment_list();
-  GRNode* path_head_node = gr_model.get_path_head_node();
+  std::vector<Segment<GRNode*>>& node_segment_list = gr_search_state.get_node_segment_list();
+  GRNode* path_head_node = gr_search_state.get_path_head_node();
 
   GRNode* curr_node = path_head_node;
-  GRNode* pre_node = curr_node->get_parent_node();
+  GRNode* pre_node = gr_search_state.getParentNode(curr_node);
 
   if (pre_node == nullptr) {
     return;
   }
   Orientation curr_orientation = getOrientation(curr_node, pre_node);
-  while (pre_node->get_parent_node() != nullptr) {
-    Orientation pre_orientation = getOrientation(pre_node, pre_node->get_parent_node());
+  while (gr_search_state.getParentNode(pre_node) != nullptr) {
+    Orientation pre_orientation = getOrientation(pre_node, gr_search_state.getParentNode(pre_node));
     if (curr_orientation != pre_orientation) {
       node_segment_list.emplace_back(curr_node, pre_node);
       curr_orientation = pre_orientation;
       curr_node = pre_node;
     }
-    pre_node = pre_node->get_parent_node();
+    pre_node = gr_search_state.getParentNode(pre_node);
   }
   node_segment_list.emplace_back(curr_node, pre_node);
 }
 
-void GlobalRouter::resetStartAndEnd(GRModel& gr_model)
+void GlobalRouter::resetStartAndEnd(GRSearchState& gr_search_state)
 {
-  std::vector<std::vector<GRNode*>>& start_node_comb_list = gr_model.get_start_node_comb_list();
-  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_model.get_end_node_comb_list();
-  std::vector<GRNode*>& path_node_comb = gr_model.get_path_node_comb();
-  GRNode* path_head_node = gr_model.get_path_head_node();
-  irt_int end_node_comb_idx = gr_model.get_end_node_comb_idx();
+  std::vector<std::vector<GRNode*>>& start_node_comb_list = gr_search_state.get_start_node_comb_list();
+  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_search_state.get_end_node_comb_list();
+  std::vector<GRNode*>& path_node_comb = gr_search_state.get_path_node_comb();
+  GRNode* path_head_node = gr_search_state.get_path_head_node();
+  irt_int end_node_comb_idx = gr_search_state.get_end_node_comb_idx();
 
   end_node_comb_list[end_node_comb_idx].clear();
   end_node_comb_list[end_node_comb_idx].push_back(path_head_node);
 
-  GRNode* path_node = path_head_node->get_parent_node();
+  GRNode* path_node = gr_search_state.getParentNode(path_head_node);
   if (path_node == nullptr) {
     // 起点和终点重合
     path_node = path_head_node;
   } else {
     // 起点和终点不重合
-    while (path_node->get_parent_node() != nullptr) {
+    while (gr_search_state.getParentNode(path_node) != nullptr) {
       path_node_comb.push_back(path_node);
-      path_node = path_node->get_parent_node();
+      path_node = gr_search_state.getParentNode(path_node);
     }
   }
   if (start_node_comb_list.size() == 1) {
@@ -914,16 +971,28 @@ void GlobalRouter::resetStartAndEnd(GRModel& gr_model)
   end_node_comb_list.erase(end_node_comb_list.begin() + end_node_comb_idx);
 }
 
-void GlobalRouter::updateNetResult(GRModel& gr_model, GRNet& gr_net)
+void GlobalRouter::updateNetResult(GRSearchState& gr_search_state, GRNet& gr_net)
 {
-  std::vector<Segment<GRNode*>>& node_segment_list = gr_model.get_node_segment_list();
+  std::vector<Segment<GRNode*>>& node_segment_list = gr_search_state.get_node_segment_list();
+
+  std::vector<Segment<LayerCoord>>& routing_segment_list = gr_net.get_routing_segment_list();
+  for (Segment<GRNode*>& node_segment : node_segment_list) {
+    routing_segment_list.emplace_back(*node_segment.get_first(), *node_segment.get_second());
+  }
+}
+
+void GlobalRouter::updateNetDemand(GRModel& gr_model, GRNet& gr_net)
+{
+  std::vector<GridMap<GRNode>>& layer_node_map = gr_model.get_layer_node_map();
 
   std::set<GRNode*> wire_set;
   std::set<GRNode*> via_set;
 
-  for (Segment<GRNode*>& node_segment : node_segment_list) {
-    GRNode* first_node = node_segment.get_first();
-    GRNode* second_node = node_segment.get_second();
+  for (Segment<LayerCoord>& routing_segment : gr_net.get_routing_segment_list()) {
+    LayerCoord& first_coord = routing_segment.get_first();
+    LayerCoord& second_coord = routing_segment.get_second();
+    GRNode* first_node = &layer_node_map[first_coord.get_layer_idx()][first_coord.get_x()][first_coord.get_y()];
+    GRNode* second_node = &layer_node_map[second_coord.get_layer_idx()][second_coord.get_x()][second_coord.get_y()];
     Orientation orientation = getOrientation(first_node, second_node);
     if (orientation == Orientation::kNone || orientation == Orientation::kOblique) {
       LOG_INST.error(Loc::current(), "The orientation is error!");
@@ -938,81 +1007,51 @@ void GlobalRouter::updateNetResult(GRModel& gr_model, GRNet& gr_net)
       if (node_i == second_node) {
         break;
       }
-      node_i = node_i->getNeighborNode(orientation);
+      node_i = gr_model.getNeighborNode(node_i, orientation);
     }
   }
   for (GRNode* wire_node : wire_set) {
-    wire_node->addWireDemand(gr_model.get_curr_net_idx());
+    gr_model.addWireDemand(*wire_node, gr_net.get_net_idx());
   }
   for (GRNode* via_node : via_set) {
     if (RTUtil::exist(wire_set, via_node)) {
       continue;
     }
-    via_node->addViaDemand(gr_model.get_curr_net_idx());
-  }
-
-  std::vector<Segment<LayerCoord>>& routing_segment_list = gr_net.get_routing_segment_list();
-  for (Segment<GRNode*>& node_segment : node_segment_list) {
-    routing_segment_list.emplace_back(*node_segment.get_first(), *node_segment.get_second());
+    gr_model.addViaDemand(*via_node, gr_net.get_net_idx());
   }
 }
 
-void GlobalRouter::resetSingleNet(GRModel& gr_model)
+void GlobalRouter::resetSingleNet(GRSearchState& gr_search_state)
 {
-  gr_model.set_gr_net_ref(nullptr);
-  gr_model.get_start_node_comb_list().clear();
-  gr_model.get_end_node_comb_list().clear();
-  gr_model.get_path_node_comb().clear();
-  gr_model.get_node_segment_list().clear();
-}
-
-// manager open list
-
-void GlobalRouter::pushToOpenList(GRModel& gr_model, GRNode* curr_node)
-{
-  std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost>& open_queue = gr_model.get_open_queue();
-  std::vector<GRNode*>& visited_node_list = gr_model.get_visited_node_list();
-
-  open_queue.push(curr_node);
-  curr_node->set_state(GRNodeState::kOpen);
-  visited_node_list.push_back(curr_node);
-}
-
-GRNode* GlobalRouter::popFromOpenList(GRModel& gr_model)
-{
-  std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost>& open_queue = gr_model.get_open_queue();
-
-  GRNode* gr_node = nullptr;
-  if (!open_queue.empty()) {
-    gr_node = open_queue.top();
-    open_queue.pop();
-    gr_node->set_state(GRNodeState::kClose);
-  }
-  return gr_node;
+  gr_search_state.set_gr_net_ref(nullptr);
+  gr_search_state.get_start_node_comb_list().clear();
+  gr_search_state.get_end_node_comb_list().clear();
+  gr_search_state.get_path_node_comb().clear();
+  gr_search_state.get_node_segment_list().clear();
 }
 
 // calculate known cost
 
-double GlobalRouter::getKnowCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node)
+double GlobalRouter::getKnowCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node)
 {
   double cost = 0;
-  cost += start_node->get_known_cost();
-  cost += getJointCost(gr_model, end_node, getOrientation(end_node, start_node));
-  cost += getWireCost(gr_model, start_node, end_node);
-  cost += getViaCost(gr_model, start_node, end_node);
+  cost += gr_search_state.getKnownCost(start_node);
+  cost += getJointCost(gr_search_state, end_node, getOrientation(end_node, start_node));
+  cost += getWireCost(gr_search_state, start_node, end_node);
+  cost += getViaCost(gr_search_state, start_node, end_node);
   return cost;
 }
 
-double GlobalRouter::getJointCost(GRModel& gr_model, GRNode* curr_node, Orientation orientation)
+double GlobalRouter::getJointCost(GRSearchState& gr_search_state, GRNode* curr_node, Orientation orientation)
 {
-  const PlanarRect& curr_bounding_box = gr_model.get_curr_bounding_box();
-  const GridMap<double>& curr_cost_map = gr_model.get_curr_cost_map();
+  const PlanarRect& curr_bounding_box = gr_search_state.get_curr_bounding_box();
+  const GridMap<double>& curr_cost_map = gr_search_state.get_curr_cost_map();
 
   irt_int local_x = curr_node->get_x() - curr_bounding_box.get_lb_x();
   irt_int local_y = curr_node->get_y() - curr_bounding_box.get_lb_y();
   double net_cost = (curr_cost_map.isInside(local_x, local_y) ? curr_cost_map[local_x][local_y] : 1);
 
-  double env_cost = curr_node->getCost(gr_model.get_curr_net_idx(), orientation);
+  double env_cost = gr_search_state.get_gr_model().getCost(*curr_node, gr_search_state.get_curr_net_idx(), orientation);
 
   double env_weight = 1;
   double net_weight = 1;
@@ -1023,27 +1062,11 @@ double GlobalRouter::getJointCost(GRModel& gr_model, GRNode* curr_node, Orientat
 
 // calculate estimate cost
 
-double GlobalRouter::getEstimateCostToEnd(GRModel& gr_model, GRNode* curr_node)
-{
-  std::vector<std::vector<GRNode*>>& end_node_comb_list = gr_model.get_end_node_comb_list();
-
-  double estimate_cost = DBL_MAX;
-  for (std::vector<GRNode*>& end_node_comb : end_node_comb_list) {
-    for (GRNode* end_node : end_node_comb) {
-      if (end_node->isClose()) {
-        continue;
-      }
-      estimate_cost = std::min(estimate_cost, getEstimateCost(gr_model, curr_node, end_node));
-    }
-  }
-  return estimate_cost;
-}
-
-double GlobalRouter::getEstimateCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node)
+double GlobalRouter::getEstimateCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node)
 {
   double estimate_cost = 0;
-  estimate_cost += getWireCost(gr_model, start_node, end_node);
-  estimate_cost += getViaCost(gr_model, start_node, end_node);
+  estimate_cost += getWireCost(gr_search_state, start_node, end_node);
+  estimate_cost += getViaCost(gr_search_state, start_node, end_node);
   return estimate_cost;
 }
 
@@ -1059,21 +1082,21 @@ Orientation GlobalRouter::getOrientation(GRNode* start_node, GRNode* end_node)
   return orientation;
 }
 
-double GlobalRouter::getWireCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node)
+double GlobalRouter::getWireCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node)
 {
-  return gr_model.get_wire_unit() * RTUtil::getManhattanDistance(*start_node, *end_node);
+  return gr_search_state.get_wire_unit() * RTUtil::getManhattanDistance(*start_node, *end_node);
 }
 
-double GlobalRouter::getViaCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node)
+double GlobalRouter::getViaCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node)
 {
-  return gr_model.get_via_unit() * std::abs(start_node->get_layer_idx() - end_node->get_layer_idx());
+  return gr_search_state.get_via_unit() * std::abs(start_node->get_layer_idx() - end_node->get_layer_idx());
 }
 
 #endif
 
 #if 1  // plot
 
-void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
+void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx, GRSearchState* gr_search_state)
 {
   GCellAxis& gcell_axis = _gr_data_manager.getDatabase().get_gcell_axis();
 
@@ -1098,14 +1121,15 @@ void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
         irt_int y = real_rect.get_rt_y();
 
         GPBoundary gp_boundary;
-        switch (gr_node.get_state()) {
-          case GRNodeState::kNone:
+        MazeNodeState node_state = (gr_search_state == nullptr ? MazeNodeState::kNone : gr_search_state->getState(&gr_node));
+        switch (node_state) {
+          case MazeNodeState::kNone:
             gp_boundary.set_data_type(none_data_type);
             break;
-          case GRNodeState::kOpen:
+          case MazeNodeState::kOpen:
             gp_boundary.set_data_type(open_data_type);
             break;
-          case GRNodeState::kClose:
+          case MazeNodeState::kClose:
             gp_boundary.set_data_type(close_data_type);
             break;
           default:
@@ -1134,13 +1158,14 @@ void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
         gp_text_net_blockage_map.set_presentation(GPTextPresentation::kLeftMiddle);
         node_graph_struct.push(gp_text_net_blockage_map);
 
-        if (!gr_node.get_net_blockage_map().empty()) {
+        const std::map<irt_int, std::vector<PlanarRect>>& net_blockage_map = gr_model.findNetBlockageMap(gr_node);
+        if (!net_blockage_map.empty()) {
           y -= y_reduced_span;
           GPText gp_text_net_blockage_map_info;
           gp_text_net_blockage_map_info.set_coord(real_rect.get_lb_x(), y);
           gp_text_net_blockage_map_info.set_text_type(info_data_type);
           std::string net_blockage_map_message = "--";
-          for (auto& [net_idx, blockage_list] : gr_node.get_net_blockage_map()) {
+          for (const auto& [net_idx, blockage_list] : net_blockage_map) {
             net_blockage_map_message += RTUtil::getString("(", net_idx, ")");
           }
           gp_text_net_blockage_map_info.set_message(net_blockage_map_message);
@@ -1158,13 +1183,14 @@ void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
         gp_text_net_region_map.set_presentation(GPTextPresentation::kLeftMiddle);
         node_graph_struct.push(gp_text_net_region_map);
 
-        if (!gr_node.get_net_region_map().empty()) {
+        const std::map<irt_int, std::vector<PlanarRect>>& net_region_map = gr_model.findNetRegionMap(gr_node);
+        if (!net_region_map.empty()) {
           y -= y_reduced_span;
           GPText gp_text_net_region_map_info;
           gp_text_net_region_map_info.set_coord(real_rect.get_lb_x(), y);
           gp_text_net_region_map_info.set_text_type(info_data_type);
           std::string net_region_map_message = "--";
-          for (auto& [net_idx, blockage_list] : gr_node.get_net_region_map()) {
+          for (const auto& [net_idx, blockage_list] : net_region_map) {
             net_region_map_message += RTUtil::getString("(", net_idx, ")");
           }
           gp_text_net_region_map_info.set_message(net_region_map_message);
@@ -1236,13 +1262,14 @@ void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
         gp_text_net_queue.set_presentation(GPTextPresentation::kLeftMiddle);
         node_graph_struct.push(gp_text_net_queue);
 
-        if (!gr_node.get_net_queue().empty()) {
+        std::vector<irt_int> net_queue = gr_model.getNetQueue(gr_node);
+        if (!net_queue.empty()) {
           y -= y_reduced_span;
           GPText gp_text_net_queue_info;
           gp_text_net_queue_info.set_coord(real_rect.get_lb_x(), y);
           gp_text_net_queue_info.set_text_type(info_data_type);
           std::string net_queue_info_message = "--";
-          for (irt_int net_idx : RTUtil::getListByQueue(gr_node.get_net_queue())) {
+          for (irt_int net_idx : net_queue) {
             net_queue_info_message += RTUtil::getString("(", net_idx, ")");
           }
           gp_text_net_queue_info.set_message(net_queue_info_message);
@@ -1272,7 +1299,10 @@ void GlobalRouter::plotGRModel(GRModel& gr_model, irt_int curr_net_idx)
         irt_int y_reduced_span = (rt_y - lb_y) / 4;
         irt_int width = std::min(x_reduced_span, y_reduced_span) / 2;
 
-        for (auto& [orientation, neighbor_node] : gr_node.get_neighbor_ptr_map()) {
+        for (Orientation orientation : GRModel::kNeighborOrientationList) {
+          if (!gr_node.hasNeighbor(orientation)) {
+            continue;
+          }
           GPPath gp_path;
           switch (orientation) {
             case Orientation::kEast:
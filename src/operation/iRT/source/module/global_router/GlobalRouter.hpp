@@ -5,6 +5,7 @@
 #include "GRConfig.hpp"
 #include "GRDataManager.hpp"
 #include "GRModel.hpp"
+#include "GRSearchState.hpp"
 #include "RTU.hpp"
 #include "SortStatus.hpp"
 #include "SortType.hpp"
@@ -43,12 +44,11 @@ class GlobalRouter
   void buildGRModel(GRModel& gr_model);
   void buildNeighborMap(GRModel& gr_model);
   void buildNodeSupply(GRModel& gr_model);
-  void initNodeRealRect(GRModel& gr_model);
   void addBlockageList(GRModel& gr_model);
   void addNetRegionList(GRModel& gr_model);
   void calcAreaSupply(GRModel& gr_model);
   void initSingleResource(GRNode& gr_node, RoutingLayer& routing_layer);
-  void initResourceSupply(GRNode& gr_node, RoutingLayer& routing_layer);
+  void initResourceSupply(GRModel& gr_model, GRNode& gr_node, RoutingLayer& routing_layer);
   std::vector<PlanarRect> getWireList(GRNode& gr_node, RoutingLayer& routing_layer);
   void buildAccessMap(GRModel& gr_model);
   void buildGRNetPriority(GRModel& gr_model);
@@ -69,37 +69,33 @@ class GlobalRouter
 
 #if 1  // route gr_model
   void routeGRModel(GRModel& gr_model);
-  void routeGRNet(GRModel& gr_model, GRNet& gr_net);
-  void initRoutingInfo(GRModel& gr_model, GRNet& gr_net);
-  bool isConnectedAllEnd(GRModel& gr_model);
-  void routeSinglePath(GRModel& gr_model);
-  void initPathHead(GRModel& gr_model);
-  bool searchEnded(GRModel& gr_model);
-  void expandSearching(GRModel& gr_model);
-  bool passCheckingSegment(GRModel& gr_model, GRNode* start_node, GRNode* end_node);
-  bool replaceParentNode(GRModel& gr_model, GRNode* parent_node, GRNode* child_node);
-  void resetPathHead(GRModel& gr_model);
-  void rerouteByEnlarging(GRModel& gr_model);
-  bool isRoutingFailed(GRModel& gr_model);
-  void resetSinglePath(GRModel& gr_model);
-  void rerouteByforcing(GRModel& gr_model);
-  void updatePathResult(GRModel& gr_model);
-  void resetStartAndEnd(GRModel& gr_model);
-  void updateNetResult(GRModel& gr_model, GRNet& gr_net);
-  void resetSingleNet(GRModel& gr_model);
-  void pushToOpenList(GRModel& gr_model, GRNode* curr_node);
-  GRNode* popFromOpenList(GRModel& gr_model);
-  double getKnowCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node);
-  double getJointCost(GRModel& gr_model, GRNode* curr_node, Orientation orientation);
-  double getEstimateCostToEnd(GRModel& gr_model, GRNode* curr_node);
-  double getEstimateCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node);
+  std::vector<std::vector<irt_int>> getNetBatchList(GRModel& gr_model);
+  void routeGRNet(GRModel& gr_model, GRSearchState& gr_search_state, GRNet& gr_net, bool enlarging);
+  void rerouteDelayedNets(GRModel& gr_model, std::vector<GRSearchState>& gr_search_state_list);
+  void initRoutingInfo(GRModel& gr_model, GRSearchState& gr_search_state, GRNet& gr_net);
+  bool isConnectedAllEnd(GRSearchState& gr_search_state);
+  void routeSinglePath(GRSearchState& gr_search_state);
+  bool passCheckingSegment(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node);
+  void rerouteByEnlarging(GRSearchState& gr_search_state);
+  bool isRoutingFailed(GRSearchState& gr_search_state);
+  void resetSinglePath(GRSearchState& gr_search_state);
+  void rerouteByforcing(GRSearchState& gr_search_state);
+  void reportRerouting(std::vector<GRSearchState>& gr_search_state_list);
+  void updatePathResult(GRSearchState& gr_search_state);
+  void resetStartAndEnd(GRSearchState& gr_search_state);
+  void updateNetResult(GRSearchState& gr_search_state, GRNet& gr_net);
+  void updateNetDemand(GRModel& gr_model, GRNet& gr_net);
+  void resetSingleNet(GRSearchState& gr_search_state);
+  double getKnowCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node);
+  double getJointCost(GRSearchState& gr_search_state, GRNode* curr_node, Orientation orientation);
+  double getEstimateCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node);
   Orientation getOrientation(GRNode* start_node, GRNode* end_node);
-  double getWireCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node);
-  double getViaCost(GRModel& gr_model, GRNode* start_node, GRNode* end_node);
+  double getWireCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node);
+  double getViaCost(GRSearchState& gr_search_state, GRNode* start_node, GRNode* end_node);
 #endif
 
 #if 1  // plot gr_model
-  void plotGRModel(GRModel& gr_model, irt_int curr_net_idx = -1);
+  void plotGRModel(GRModel& gr_model, irt_int curr_net_idx = -1, GRSearchState* gr_search_state = nullptr);
 #endif
 
 #if 1  // update gr_model
@@ -44,6 +44,7 @@ GRNet GRDataManager::convertToGRNet(Net& net)
 void GRDataManager::wrapConfig(Config& config)
 {
   _gr_config.temp_directory_path = config.gr_temp_directory_path;
+  _gr_config.thread_number = config.thread_number;
   _gr_config.bottom_routing_layer_idx = config.bottom_routing_layer_idx;
   _gr_config.top_routing_layer_idx = config.top_routing_layer_idx;
   _gr_config.layer_idx_utilization_ratio = config.layer_idx_utilization_ratio;
@@ -16,65 +16,144 @@ class GRModel
   std::vector<GridMap<GRNode>>& get_layer_node_map() { return _layer_node_map; }
   std::vector<GRNet>& get_gr_net_list() { return _gr_net_list; }
   GRModelStat& get_gr_model_stat() { return _gr_model_stat; }
+  irt_int get_x_size() const { return _x_size; }
+  irt_int get_y_size() const { return _y_size; }
   // setter
   void set_layer_node_map(const std::vector<GridMap<GRNode>>& layer_node_map) { _layer_node_map = layer_node_map; }
   void set_gr_net_list(const std::vector<GRNet>& gr_net_list) { _gr_net_list = gr_net_list; }
-#if 1  // astar
-  double get_wire_unit() const { return _wire_unit; }
-  double get_via_unit() const { return _via_unit; }
-  const irt_int get_curr_net_idx() const { return _gr_net_ref->get_net_idx(); }
-  const PlanarRect& get_curr_bounding_box() const { return _gr_net_ref->get_bounding_box().get_grid_rect(); }
-  const GridMap<double>& get_curr_cost_map() const { return _gr_net_ref->get_ra_cost_map(); }
-  PlanarRect& get_routing_region() { return _routing_region; }
-  std::vector<std::vector<GRNode*>>& get_start_node_comb_list() { return _start_node_comb_list; }
-  std::vector<std::vector<GRNode*>>& get_end_node_comb_list() { return _end_node_comb_list; }
-  std::vector<GRNode*>& get_path_node_comb() { return _path_node_comb; }
-  std::vector<Segment<GRNode*>>& get_node_segment_list() { return _node_segment_list; }
-  std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost>& get_open_queue() { return _open_queue; }
-  std::vector<GRNode*>& get_visited_node_list() { return _visited_node_list; }
-  GRNode* get_path_head_node() { return _path_head_node; }
-  irt_int get_end_node_comb_idx() const { return _end_node_comb_idx; }
-  void set_wire_unit(const double wire_unit) { _wire_unit = wire_unit; }
-  void set_via_unit(const double via_unit) { _via_unit = via_unit; }
-  void set_gr_net_ref(GRNet* gr_net_ref) { _gr_net_ref = gr_net_ref; }
-  void set_routing_region(const PlanarRect& routing_region) { _routing_region = routing_region; }
-  void set_start_node_comb_list(const std::vector<std::vector<GRNode*>>& start_node_comb_list)
+  void set_x_size(const irt_int x_size) { _x_size = x_size; }
+  void set_y_size(const irt_int y_size) { _y_size = y_size; }
+  // function
+  static constexpr std::array<Orientation, 6> kNeighborOrientationList
+      = {Orientation::kEast, Orientation::kWest, Orientation::kSouth, Orientation::kNorth, Orientation::kUp, Orientation::kDown};
+  size_t getNodeIdx(const GRNode& gr_node) const
   {
-    _start_node_comb_list = start_node_comb_list;
+    return (static_cast<size_t>(gr_node.get_layer_idx()) * _x_size + gr_node.get_x()) * _y_size + gr_node.get_y();
+  }
+  /**
+   * 同层邻居在GridMap中是连续的(x为行，y为列)，所以平面邻居直接由指针偏移得到
+   */
+  GRNode* getNeighborNode(GRNode* gr_node, Orientation orientation)
+  {
+    if (!gr_node->hasNeighbor(orientation)) {
+      return nullptr;
+    }
+    switch (orientation) {
+      case Orientation::kEast:
+        return gr_node + _y_size;
+      case Orientation::kWest:
+        return gr_node - _y_size;
+      case Orientation::kNorth:
+        return gr_node + 1;
+      case Orientation::kSouth:
+        return gr_node - 1;
+      case Orientation::kUp:
+        return &_layer_node_map[gr_node->get_layer_idx() + 1][gr_node->get_x()][gr_node->get_y()];
+      case Orientation::kDown:
+        return &_layer_node_map[gr_node->get_layer_idx() - 1][gr_node->get_x()][gr_node->get_y()];
+      default:
+        return nullptr;
+    }
+  }
+  // net info, 只在建模时写入
+  std::map<irt_int, std::vector<PlanarRect>>& getNetBlockageMap(GRNode& gr_node)
+  {
+    gr_node.markNetBlockage();
+    return _net_blockage_map[getNodeIdx(gr_node)];
+  }
+  std::map<irt_int, std::vector<PlanarRect>>& getNetRegionMap(GRNode& gr_node)
+  {
+    gr_node.markNetRegion();
+    return _net_region_map[getNodeIdx(gr_node)];
+  }
+  std::map<irt_int, std::set<Orientation>>& getNetAccessMap(GRNode& gr_node)
+  {
+    gr_node.markNetAccess();
+    return _net_access_map[getNodeIdx(gr_node)];
+  }
+  // net info, 只读查询，不存在时返回空
+  const std::map<irt_int, std::vector<PlanarRect>>& findNetBlockageMap(const GRNode& gr_node) const
+  {
+    return gr_node.hasNetBlockage() ? _net_blockage_map.at(getNodeIdx(gr_node)) : _empty_rect_map;
+  }
+  const std::map<irt_int, std::vector<PlanarRect>>& findNetRegionMap(const GRNode& gr_node) const
+  {
+    return gr_node.hasNetRegion() ? _net_region_map.at(getNodeIdx(gr_node)) : _empty_rect_map;
+  }
+  const std::map<irt_int, std::set<Orientation>>& findNetAccessMap(const GRNode& gr_node) const
+  {
+    return gr_node.hasNetAccess() ? _net_access_map.at(getNodeIdx(gr_node)) : _empty_access_map;
+  }
+  std::vector<irt_int> getNetQueue(const GRNode& gr_node) const
+  {
+    auto iter = _net_queue_map.find(getNodeIdx(gr_node));
+    return iter == _net_queue_map.end() ? std::vector<irt_int>() : iter->second;
+  }
+  bool isAccess(const GRNode& gr_node, irt_int net_idx, Orientation orientation) const
+  {
+    if (!gr_node.hasNetAccess()) {
+      return false;
+    }
+    const std::map<irt_int, std::set<Orientation>>& net_access_map = findNetAccessMap(gr_node);
+    auto iter = net_access_map.find(net_idx);
+    return iter != net_access_map.end() && RTUtil::exist(iter->second, orientation);
+  }
+  bool isOBS(const GRNode& gr_node, irt_int net_idx, Orientation orientation) const
+  {
+    if (isAccess(gr_node, net_idx, orientation)) {
+      // 存在绿通
+      return false;
+    }
+    return gr_node.isOBS(orientation);
+  }
+  double getCost(const GRNode& gr_node, irt_int net_idx, Orientation orientation) const
+  {
+    double cost = 0;
+    if (isAccess(gr_node, net_idx, orientation)) {
+      // 存在绿通
+      cost += 0;
+    } else {
+      cost += gr_node.getCost(orientation);
+    }
+    if (gr_node.hasNetRegion()) {
+      const std::map<irt_int, std::vector<PlanarRect>>& net_region_map = findNetRegionMap(gr_node);
+      if (!RTUtil::exist(net_region_map, net_idx)) {
+        cost += static_cast<double>(net_region_map.size());
+      }
+    }
+    return cost;
+  }
+  void addWireDemand(GRNode& gr_node, irt_int net_idx)
+  {
+    // 使用绿通时，不消耗资源
+    if (RTUtil::exist(findNetAccessMap(gr_node), net_idx)) {
+      return;
+    }
+    gr_node.addWireDemand();
+    _net_queue_map[getNodeIdx(gr_node)].push_back(net_idx);
+  }
+  void addViaDemand(GRNode& gr_node, irt_int net_idx)
+  {
+    if (RTUtil::exist(findNetAccessMap(gr_node), net_idx)) {
+      return;
+    }
+    gr_node.addViaDemand();
+    _net_queue_map[getNodeIdx(gr_node)].push_back(net_idx);
   }
-  void set_end_node_comb_list(const std::vector<std::vector<GRNode*>>& end_node_comb_list) { _end_node_comb_list = end_node_comb_list; }
-  void set_path_node_comb(const std::vector<GRNode*>& path_node_comb) { _path_node_comb = path_node_comb; }
-  void set_node_segment_list(const std::vector<Segment<GRNode*>>& node_segment_list) { _node_segment_list = node_segment_list; }
-  void set_forced_routing(const bool forced_routing) { _forced_routing = forced_routing; }
-  void set_open_queue(const std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost>& open_queue) { _open_queue = open_queue; }
-  void set_visited_node_list(const std::vector<GRNode*>& visited_node_list) { _visited_node_list = visited_node_list; }
-  void set_path_head_node(GRNode* path_head_node) { _path_head_node = path_head_node; }
-  void set_end_node_comb_idx(const irt_int end_node_comb_idx) { _end_node_comb_idx = end_node_comb_idx; }
-  bool isForcedRouting() { return _forced_routing; }
-#endif
 
  private:
   std::vector<GridMap<GRNode>> _layer_node_map;
   std::vector<GRNet> _gr_net_list;
   GRModelStat _gr_model_stat;
-#if 1  // astar
-  // config
-  double _wire_unit = 1;
-  double _via_unit = 2;
-  // single net
-  GRNet* _gr_net_ref = nullptr;
-  PlanarRect _routing_region;
-  std::vector<std::vector<GRNode*>> _start_node_comb_list;
-  std::vector<std::vector<GRNode*>> _end_node_comb_list;
-  std::vector<GRNode*> _path_node_comb;
-  std::vector<Segment<GRNode*>> _node_segment_list;
-  // single path
-  bool _forced_routing = false;
-  std::priority_queue<GRNode*, std::vector<GRNode*>, CmpGRNodeCost> _open_queue;
-  std::vector<GRNode*> _visited_node_list;
-  GRNode* _path_head_node = nullptr;
-  irt_int _end_node_comb_idx = -1;
-#endif
+  irt_int _x_size = 0;
+  irt_int _y_size = 0;
+  // 稀疏的net info，以node idx为key，只有少量node存在
+  std::unordered_map<size_t, std::map<irt_int, std::vector<PlanarRect>>> _net_blockage_map;
+  std::unordered_map<size_t, std::map<irt_int, std::vector<PlanarRect>>> _net_region_map;
+  std::unordered_map<size_t, std::map<irt_int, std::set<Orientation>>> _net_access_map;
+  std::unordered_map<size_t, std::vector<irt_int>> _net_queue_map;
+  std::map<irt_int, std::vector<PlanarRect>> _empty_rect_map;
+  std::map<irt_int, std::set<Orientation>> _empty_access_map;
 };
 
 }  // namespace irt
@@ -4,15 +4,6 @@
 
 namespace irt {
 
-#if 1  // astar
-enum class GRNodeState
-{
-  kNone = 0,
-  kOpen = 1,
-  kClose = 2
-};
-#endif
-
 class GRNode : public LayerCoord
 {
  public:
@@ -20,47 +11,35 @@ class GRNode : public LayerCoord
   ~GRNode() = default;
 
   // getter
-  PlanarRect& get_real_rect() { return _real_rect; }
-  std::map<Orientation, GRNode*>& get_neighbor_ptr_map() { return _neighbor_ptr_map; }
-  std::map<irt_int, std::vector<PlanarRect>>& get_net_blockage_map() { return _net_blockage_map; }
-  std::map<irt_int, std::vector<PlanarRect>>& get_net_region_map() { return _net_region_map; }
   irt_int get_single_wire_area() const { return _single_wire_area; }
   irt_int get_single_via_area() const { return _single_via_area; }
   irt_int get_wire_area_supply() const { return _wire_area_supply; }
   irt_int get_via_area_supply() const { return _via_area_supply; }
   irt_int get_wire_area_demand() const { return _wire_area_demand; }
   irt_int get_via_area_demand() const { return _via_area_demand; }
-  std::map<irt_int, std::set<Orientation>>& get_net_access_map() { return _net_access_map; }
-  std::queue<irt_int>& get_net_queue() { return _net_queue; }
   // setter
-  void set_real_rect(const PlanarRect& real_rect) { _real_rect = real_rect; }
-  void set_neighbor_ptr_map(const std::map<Orientation, GRNode*>& neighbor_ptr_map) { _neighbor_ptr_map = neighbor_ptr_map; }
-  void set_net_blockage_map(const std::map<irt_int, std::vector<PlanarRect>>& net_blockage_map) { _net_blockage_map = net_blockage_map; }
-  void set_net_region_map(const std::map<irt_int, std::vector<PlanarRect>>& net_region_map) { _net_region_map = net_region_map; }
   void set_single_wire_area(const irt_int single_wire_area) { _single_wire_area = single_wire_area; }
   void set_single_via_area(const irt_int single_via_area) { _single_via_area = single_via_area; }
   void set_wire_area_supply(const irt_int wire_area_supply) { _wire_area_supply = wire_area_supply; }
   void set_via_area_supply(const irt_int via_area_supply) { _via_area_supply = via_area_supply; }
   void set_wire_area_demand(const irt_int wire_area_demand) { _wire_area_demand = wire_area_demand; }
   void set_via_area_demand(const irt_int via_area_demand) { _via_area_demand = via_area_demand; }
-  void set_net_access_map(const std::map<irt_int, std::set<Orientation>>& net_access_map) { _net_access_map = net_access_map; }
-  void set_net_queue(const std::queue<irt_int>& net_queue) { _net_queue = net_queue; }
   // function
-  GRNode* getNeighborNode(Orientation orientation)
-  {
-    GRNode* neighbor_node = nullptr;
-    if (RTUtil::exist(_neighbor_ptr_map, orientation)) {
-      neighbor_node = _neighbor_ptr_map[orientation];
-    }
-    return neighbor_node;
-  }
-  bool isOBS(irt_int net_idx, Orientation orientation)
+  // 邻居由网格下标计算，只记录存在的方向
+  bool hasNeighbor(Orientation orientation) const { return (_neighbor_mask >> static_cast<irt_int>(orientation)) & 1U; }
+  void addNeighbor(Orientation orientation) { _neighbor_mask |= static_cast<uint8_t>(1U << static_cast<irt_int>(orientation)); }
+  irt_int getNeighborNum() const { return __builtin_popcount(_neighbor_mask); }
+  // net info存在GRModel的稀疏表中，这里只记录是否存在
+  bool hasNetBlockage() const { return _net_info_mask & kNetBlockage; }
+  bool hasNetRegion() const { return _net_info_mask & kNetRegion; }
+  bool hasNetAccess() const { return _net_info_mask & kNetAccess; }
+  void markNetBlockage() { _net_info_mask |= kNetBlockage; }
+  void markNetRegion() { _net_info_mask |= kNetRegion; }
+  void markNetAccess() { _net_info_mask |= kNetAccess; }
+  bool isOBS(Orientation orientation) const
   {
     bool is_obs = true;
-    if (RTUtil::exist(_net_access_map, net_idx) && RTUtil::exist(_net_access_map[net_idx], orientation)) {
-      // 存在绿通
-      is_obs = false;
-    } else if (orientation == Orientation::kUp || orientation == Orientation::kDown) {
+    if (orientation == Orientation::kUp || orientation == Orientation::kDown) {
       // wire剩余可以给via
       is_obs = ((_wire_area_supply - _wire_area_demand + _via_area_supply - _via_area_demand) < _single_via_area);
     } else {
@@ -69,91 +48,32 @@ class GRNode : public LayerCoord
     }
     return is_obs;
   }
-  double getCost(irt_int net_idx, Orientation orientation)
+  double getCost(Orientation orientation) const
   {
     double cost = 0;
-    if (RTUtil::exist(_net_access_map, net_idx) && RTUtil::exist(_net_access_map[net_idx], orientation)) {
-      // 存在绿通
-      cost += 0;
-    } else if (orientation == Orientation::kUp || orientation == Orientation::kDown) {
+    if (orientation == Orientation::kUp || orientation == Orientation::kDown) {
       cost += RTUtil::sigmoid(_via_area_demand, _wire_area_supply - _wire_area_demand + _via_area_supply);
     } else {
       cost += RTUtil::sigmoid(_wire_area_demand, _wire_area_supply + std::min(_via_area_supply - _via_area_demand, 0));
     }
-    if (!RTUtil::exist(_net_region_map, net_idx)) {
-      cost += static_cast<double>(_net_region_map.size());
-    }
     return cost;
   }
-  void addWireDemand(irt_int net_idx)
-  {
-    if (RTUtil::exist(_net_access_map, net_idx)) {
-      return;
-    }
-    _wire_area_demand += _single_wire_area;
-    _net_queue.push(net_idx);
-  }
-  void addViaDemand(irt_int net_idx)
-  {
-    if (RTUtil::exist(_net_access_map, net_idx)) {
-      return;
-    }
-    _via_area_demand += _single_via_area;
-    _net_queue.push(net_idx);
-  }
-#if 1  // astar
-  GRNodeState& get_state() { return _state; }
-  GRNode* get_parent_node() const { return _parent_node; }
-  double get_known_cost() const { return _known_cost; }
-  double get_estimated_cost() const { return _estimated_cost; }
-  void set_state(GRNodeState state) { _state = state; }
-  void set_parent_node(GRNode* parent_node) { _parent_node = parent_node; }
-  void set_known_cost(const double known_cost) { _known_cost = known_cost; }
-  void set_estimated_cost(const double estimated_cost) { _estimated_cost = estimated_cost; }
-  bool isNone() { return _state == GRNodeState::kNone; }
-  bool isOpen() { return _state == GRNodeState::kOpen; }
-  bool isClose() { return _state == GRNodeState::kClose; }
-  double getTotalCost() { return (_known_cost + _estimated_cost); }
-#endif
+  void addWireDemand() { _wire_area_demand += _single_wire_area; }
+  void addViaDemand() { _via_area_demand += _single_via_area; }
 
  private:
-  PlanarRect _real_rect;
-  std::map<Orientation, GRNode*> _neighbor_ptr_map;
-  std::map<irt_int, std::vector<PlanarRect>> _net_blockage_map;
-  std::map<irt_int, std::vector<PlanarRect>> _net_region_map;
+  static constexpr uint8_t kNetBlockage = 1U << 0;
+  static constexpr uint8_t kNetRegion = 1U << 1;
+  static constexpr uint8_t kNetAccess = 1U << 2;
+
   irt_int _single_wire_area = 0;
   irt_int _single_via_area = 0;
   irt_int _wire_area_supply = 0;
   irt_int _via_area_supply = 0;
   irt_int _wire_area_demand = 0;
   irt_int _via_area_demand = 0;
-  // 使用绿通时，不消耗资源
-  std::map<irt_int, std::set<Orientation>> _net_access_map;
-  std::queue<irt_int> _net_queue;
-#if 1  // astar
-  GRNodeState _state = GRNodeState::kNone;
-  GRNode* _parent_node = nullptr;
-  double _known_cost = 0.0;  // include curr
-  double _estimated_cost = 0.0;
-#endif
-};
-
-#if 1  // astar
-struct CmpGRNodeCost
-{
-  bool operator()(GRNode* a, GRNode* b)
-  {
-    if (RTUtil::equalDoubleByError(a->getTotalCost(), b->getTotalCost(), DBL_ERROR)) {
-      if (RTUtil::equalDoubleByError(a->get_estimated_cost(), b->get_estimated_cost(), DBL_ERROR)) {
-        return a->get_neighbor_ptr_map().size() < b->get_neighbor_ptr_map().size();
-      } else {
-        return a->get_estimated_cost() > b->get_estimated_cost();
-      }
-    } else {
-      return a->getTotalCost() > b->getTotalCost();
-    }
-  }
+  uint8_t _neighbor_mask = 0;
+  uint8_t _net_info_mask = 0;
 };
-#endif
 
 }  // namespace irt
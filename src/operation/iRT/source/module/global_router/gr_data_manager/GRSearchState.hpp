@@ -0,0 +1,91 @@
+#pragma once
+
+#include "GRModel.hpp"
+#include "MazeSearcher.hpp"
+
+namespace irt {
+
+/**
+ * The astar state of one routing thread, the state of GRNode is kept in the maze searcher indexed by the node idx
+ * local to the routing region, so the threads can search on the same GRModel at the same time and each thread only
+ * holds the state of the largest region it has searched instead of the whole die.
+ */
+class GRSearchState
+{
+ public:
+  GRSearchState() = default;
+  ~GRSearchState() = default;
+  // function
+  void set_gr_model_ref(GRModel* gr_model_ref) { _gr_model_ref = gr_model_ref; }
+  GRModel& get_gr_model() { return *_gr_model_ref; }
+#if 1  // astar
+  double get_wire_unit() const { return _wire_unit; }
+  double get_via_unit() const { return _via_unit; }
+  const irt_int get_curr_net_idx() const { return _gr_net_ref->get_net_idx(); }
+  const PlanarRect& get_curr_bounding_box() const { return _gr_net_ref->get_bounding_box().get_grid_rect(); }
+  const GridMap<double>& get_curr_cost_map() const { return _gr_net_ref->get_ra_cost_map(); }
+  PlanarRect& get_routing_region() { return _routing_region; }
+  std::vector<std::vector<GRNode*>>& get_start_node_comb_list() { return _start_node_comb_list; }
+  std::vector<std::vector<GRNode*>>& get_end_node_comb_list() { return _end_node_comb_list; }
+  std::vector<GRNode*>& get_path_node_comb() { return _path_node_comb; }
+  std::vector<Segment<GRNode*>>& get_node_segment_list() { return _node_segment_list; }
+  MazeSearcher<GRNode>& get_maze_searcher() { return _maze_searcher; }
+  GRNode* get_path_head_node() { return _maze_searcher.get_path_head_node(); }
+  irt_int get_end_node_comb_idx() const { return _maze_searcher.get_end_node_comb_idx(); }
+  std::vector<GRNet*>& get_delayed_net_list() { return _delayed_net_list; }
+  std::vector<irt_int>& get_enlarged_net_idx_list() { return _enlarged_net_idx_list; }
+  std::vector<irt_int>& get_forced_net_idx_list() { return _forced_net_idx_list; }
+  std::vector<irt_int>& get_failed_net_idx_list() { return _failed_net_idx_list; }
+  void set_wire_unit(const double wire_unit) { _wire_unit = wire_unit; }
+  void set_via_unit(const double via_unit) { _via_unit = via_unit; }
+  void set_gr_net_ref(GRNet* gr_net_ref) { _gr_net_ref = gr_net_ref; }
+  void set_routing_region(const PlanarRect& routing_region)
+  {
+    _routing_region = routing_region;
+    _region_x_size = routing_region.get_rt_x() - routing_region.get_lb_x() + 1;
+    _region_y_size = routing_region.get_rt_y() - routing_region.get_lb_y() + 1;
+    size_t node_num = _gr_model_ref->get_layer_node_map().size() * _region_x_size * _region_y_size;
+    _maze_searcher.extend(node_num);
+  }
+  void set_forced_routing(const bool forced_routing) { _forced_routing = forced_routing; }
+  bool isForcedRouting() { return _forced_routing; }
+  // node state
+  size_t getNodeIdx(GRNode* gr_node)
+  {
+    size_t local_x = static_cast<size_t>(gr_node->get_x() - _routing_region.get_lb_x());
+    size_t local_y = static_cast<size_t>(gr_node->get_y() - _routing_region.get_lb_y());
+    return (static_cast<size_t>(gr_node->get_layer_idx()) * _region_x_size + local_x) * _region_y_size + local_y;
+  }
+  MazeNodeState getState(GRNode* gr_node) { return _maze_searcher.getState(getNodeIdx(gr_node)); }
+  GRNode* getParentNode(GRNode* gr_node) { return _maze_searcher.getParentNode(getNodeIdx(gr_node)); }
+  double getKnownCost(GRNode* gr_node) { return _maze_searcher.getKnownCost(getNodeIdx(gr_node)); }
+#endif
+
+ private:
+  GRModel* _gr_model_ref = nullptr;
+#if 1  // astar
+  // config
+  double _wire_unit = 1;
+  double _via_unit = 2;
+  // single net
+  GRNet* _gr_net_ref = nullptr;
+  PlanarRect _routing_region;
+  size_t _region_x_size = 0;
+  size_t _region_y_size = 0;
+  std::vector<std::vector<GRNode*>> _start_node_comb_list;
+  std::vector<std::vector<GRNode*>> _end_node_comb_list;
+  std::vector<GRNode*> _path_node_comb;
+  std::vector<Segment<GRNode*>> _node_segment_list;
+  // single path
+  bool _forced_routing = false;
+  MazeSearcher<GRNode> _maze_searcher;
+  // the nets failed in the bounding box, rerouted by enlarging after the batch
+  std::vector<GRNet*> _delayed_net_list;
+  // rerouting record, reported out of the parallel region
+  std::vector<irt_int> _enlarged_net_idx_list;
+  std::vector<irt_int> _forced_net_idx_list;
+  std::vector<irt_int> _failed_net_idx_list;
+#endif
+};
+
+}  // namespace irt
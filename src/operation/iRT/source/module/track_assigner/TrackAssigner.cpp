@@ -562,6 +562,7 @@ void TrackAssigner::initTANodeMap(TAPanel& ta_panel)
       ta_node.set_layer_idx(layer_idx);
     }
   }
+  ta_panel.initMazeSearcher();
 }
 
 void TrackAssigner::buildNeighborMap(TAPanel& ta_panel)
@@ -930,78 +931,25 @@ bool TrackAssigner::isConnectedAllEnd(TAPanel& ta_panel)
 
 void TrackAssigner::routeSinglePath(TAPanel& ta_panel)
 {
-  initPathHead(ta_panel);
-  while (!searchEnded(ta_panel)) {
-    expandSearching(ta_panel);
-    resetPathHead(ta_panel);
+  std::vector<TANode*> source_node_list;
+  for (std::vector<TANode*>& start_node_comb : ta_panel.get_start_node_comb_list()) {
+    source_node_list.insert(source_node_list.end(), start_node_comb.begin(), start_node_comb.end());
   }
-}
-
-void TrackAssigner::initPathHead(TAPanel& ta_panel)
-{
-  std::vector<std::vector<TANode*>>& start_node_comb_list = ta_panel.get_start_node_comb_list();
   std::vector<TANode*>& path_node_comb = ta_panel.get_path_node_comb();
-
-  for (std::vector<TANode*>& start_node_comb : start_node_comb_list) {
-    for (TANode* start_node : start_node_comb) {
-      start_node->set_estimated_cost(getEstimateCostToEnd(ta_panel, start_node));
-      pushToOpenList(ta_panel, start_node);
-    }
-  }
-  for (TANode* path_node : path_node_comb) {
-    path_node->set_estimated_cost(getEstimateCostToEnd(ta_panel, path_node));
-    pushToOpenList(ta_panel, path_node);
-  }
-  ta_panel.set_path_head_node(popFromOpenList(ta_panel));
-}
-
-bool TrackAssigner::searchEnded(TAPanel& ta_panel)
-{
-  std::vector<std::vector<TANode*>>& end_node_comb_list = ta_panel.get_end_node_comb_list();
-  TANode* path_head_node = ta_panel.get_path_head_node();
-
-  if (path_head_node == nullptr) {
-    ta_panel.set_end_node_comb_idx(-1);
-    return true;
-  }
-  for (size_t i = 0; i < end_node_comb_list.size(); i++) {
-    for (TANode* end_node : end_node_comb_list[i]) {
-      if (path_head_node == end_node) {
-        ta_panel.set_end_node_comb_idx(static_cast<irt_int>(i));
-        return true;
-      }
-    }
-  }
-  return false;
-}
-
-void TrackAssigner::expandSearching(TAPanel& ta_panel)
-{
-  TANode* path_head_node = ta_panel.get_path_head_node();
-
-  for (auto& [orientation, neighbor_node] : path_head_node->get_neighbor_ptr_map()) {
-    if (neighbor_node == nullptr) {
-      continue;
-    }
-    if (!RTUtil::isInside(ta_panel.get_routing_region(), *neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isClose()) {
-      continue;
-    }
-    if (!passCheckingSegment(ta_panel, path_head_node, neighbor_node)) {
-      continue;
-    }
-    if (neighbor_node->isOpen() && replaceParentNode(ta_panel, path_head_node, neighbor_node)) {
-      neighbor_node->set_known_cost(getKnowCost(ta_panel, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-    } else if (neighbor_node->isNone()) {
-      neighbor_node->set_known_cost(getKnowCost(ta_panel, path_head_node, neighbor_node));
-      neighbor_node->set_parent_node(path_head_node);
-      neighbor_node->set_estimated_cost(getEstimateCostToEnd(ta_panel, neighbor_node));
-      pushToOpenList(ta_panel, neighbor_node);
-    }
-  }
+  source_node_list.insert(source_node_list.end(), path_node_comb.begin(), path_node_comb.end());
+
+  MazeGraph maze_graph{[&](TANode* ta_node) { return ta_panel.getNodeIdx(ta_node); },
+                       [&](TANode* ta_node, auto visit) {
+                         for (auto& [orientation, neighbor_node] : ta_node->get_neighbor_ptr_map()) {
+                           if (neighbor_node != nullptr && RTUtil::isInside(ta_panel.get_routing_region(), *neighbor_node)) {
+                             visit(neighbor_node);
+                           }
+                         }
+                       },
+                       [&](TANode* start_node, TANode* end_node) { return passCheckingSegment(ta_panel, start_node, end_node); },
+                       [&](TANode* start_node, TANode* end_node) { return getKnowCost(ta_panel, start_node, end_node); },
+                       [&](TANode* start_node, TANode* end_node) { return getEstimateCost(ta_panel, start_node, end_node); }};
+  ta_panel.get_maze_searcher().search(maze_graph, source_node_list, ta_panel.get_end_node_comb_list());
 }
 
 bool TrackAssigner::passCheckingSegment(TAPanel& ta_panel, TANode* start_node, TANode* end_node)
@@ -1033,16 +981,6 @@ bool TrackAssigner::passCheckingSegment(TAPanel& ta_panel, TANode* start_node, T
   return true;
 }
 
-bool TrackAssigner::replaceParentNode(TAPanel& ta_panel, TANode* parent_node, TANode* child_node)
-{
-  return getKnowCost(ta_panel, parent_node, child_node) < child_node->get_known_cost();
-}
-
-void TrackAssigner::resetPathHead(TAPanel& ta_panel)
-{
-  ta_panel.set_path_head_node(popFromOpenList(ta_panel));
-}
-
 bool TrackAssigner::isRoutingFailed(TAPanel& ta_panel)
 {
   return ta_panel.get_end_node_comb_idx() == -1;
@@ -1052,20 +990,7 @@ void TrackAssigner::resetSinglePath(TAPanel& ta_panel)
 {
   ta_panel.set_forced_routing(false);
 
-  std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost> empty_queue;
-  ta_panel.set_open_queue(empty_queue);
-
-  std::vector<TANode*>& visited_node_list = ta_panel.get_visited_node_list();
-  for (TANode* visited_node : visited_node_list) {
-    visited_node->set_state(TANodeState::kNone);
-    visited_node->set_parent_node(nullptr);
-    visited_node->set_known_cost(0);
-    visited_node->set_estimated_cost(0);
-  }
-  visited_node_list.clear();
-
-  ta_panel.set_path_head_node(nullptr);
-  ta_panel.set_end_node_comb_idx(-1);
+  ta_panel.get_maze_searcher().reset();
 }
 
 void TrackAssigner::rerouteByforcing(TAPanel& ta_panel)
@@ -1089,20 +1014,20 @@ void TrackAssigner::updatePathResult(TAPanel& ta_panel)
   TANode* path_head_node = ta_panel.get_path_head_node();
 
   TANode* curr_node = path_head_node;
-  TANode* pre_node = curr_node->get_parent_node();
+  TANode* pre_node = ta_panel.getParentNode(curr_node);
 
   if (pre_node == nullptr) {
     return;
   }
   Orientation curr_orientation = getOrientation(curr_node, pre_node);
-  while (pre_node->get_parent_node() != nullptr) {
-    Orientation pre_orientation = getOrientation(pre_node, pre_node->get_parent_node());
+  while (ta_panel.getParentNode(pre_node) != nullptr) {
+    Orientation pre_orientation = getOrientation(pre_node, ta_panel.getParentNode(pre_node));
     if (curr_orientation != pre_orientation) {
       node_segment_list.emplace_back(curr_node, pre_node);
       curr_orientation = pre_orientation;
       curr_node = pre_node;
     }
-    pre_node = pre_node->get_parent_node();
+    pre_node = ta_panel.getParentNode(pre_node);
   }
   node_segment_list.emplace_back(curr_node, pre_node);
 }
@@ -1118,15 +1043,15 @@ void TrackAssigner::resetStartAndEnd(TAPanel& ta_panel)
   end_node_comb_list[end_node_comb_idx].clear();
   end_node_comb_list[end_node_comb_idx].push_back(path_head_node);
 
-  TANode* path_node = path_head_node->get_parent_node();
+  TANode* path_node = ta_panel.getParentNode(path_head_node);
   if (path_node == nullptr) {
     // 起点和终点重合
     path_node = path_head_node;
   } else {
     // 起点和终点不重合
-    while (path_node->get_parent_node() != nullptr) {
+    while (ta_panel.getParentNode(path_node) != nullptr) {
       path_node_comb.push_back(path_node);
-      path_node = path_node->get_parent_node();
+      path_node = ta_panel.getParentNode(path_node);
     }
   }
   if (start_node_comb_list.size() == 1) {
@@ -1175,37 +1100,12 @@ void TrackAssigner::resetSingleNet(TAPanel& ta_panel)
   ta_panel.get_node_segment_list().clear();
 }
 
-// manager open list
-
-void TrackAssigner::pushToOpenList(TAPanel& ta_panel, TANode* curr_node)
-{
-  std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost>& open_queue = ta_panel.get_open_queue();
-  std::vector<TANode*>& visited_node_list = ta_panel.get_visited_node_list();
-
-  open_queue.push(curr_node);
-  curr_node->set_state(TANodeState::kOpen);
-  visited_node_list.push_back(curr_node);
-}
-
-TANode* TrackAssigner::popFromOpenList(TAPanel& ta_panel)
-{
-  std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost>& open_queue = ta_panel.get_open_queue();
-
-  TANode* node = nullptr;
-  if (!open_queue.empty()) {
-    node = open_queue.top();
-    open_queue.pop();
-    node->set_state(TANodeState::kClose);
-  }
-  return node;
-}
-
 // calculate known cost
 
 double TrackAssigner::getKnowCost(TAPanel& ta_panel, TANode* start_node, TANode* end_node)
 {
   double cost = 0;
-  cost += start_node->get_known_cost();
+  cost += ta_panel.getKnownCost(start_node);
   cost += getJointCost(ta_panel, end_node, getOrientation(end_node, start_node));
   cost += getWireCost(ta_panel, start_node, end_node);
   cost += getViaCost(ta_panel, start_node, end_node);
@@ -1232,22 +1132,6 @@ double TrackAssigner::getJointCost(TAPanel& ta_panel, TANode* curr_node, Orienta
 
 // calculate estimate cost
 
-double TrackAssigner::getEstimateCostToEnd(TAPanel& ta_panel, TANode* curr_node)
-{
-  std::vector<std::vector<TANode*>>& end_node_comb_list = ta_panel.get_end_node_comb_list();
-
-  double estimate_cost = DBL_MAX;
-  for (std::vector<TANode*>& end_node_comb : end_node_comb_list) {
-    for (TANode* end_node : end_node_comb) {
-      if (end_node->isClose()) {
-        continue;
-      }
-      estimate_cost = std::min(estimate_cost, getEstimateCost(ta_panel, curr_node, end_node));
-    }
-  }
-  return estimate_cost;
-}
-
 double TrackAssigner::getEstimateCost(TAPanel& ta_panel, TANode* start_node, TANode* end_node)
 {
   double estimate_cost = 0;
@@ -1314,14 +1198,14 @@ void TrackAssigner::plotTAPanel(TAPanel& ta_panel, irt_int curr_task_idx)
       irt_int y = real_rect.get_rt_y();
 
       GPBoundary gp_boundary;
-      switch (ta_node.get_state()) {
-        case TANodeState::kNone:
+      switch (ta_panel.getState(&ta_node)) {
+        case MazeNodeState::kNone:
           gp_boundary.set_data_type(none_data_type);
           break;
-        case TANodeState::kOpen:
+        case MazeNodeState::kOpen:
           gp_boundary.set_data_type(open_data_type);
           break;
-        case TANodeState::kClose:
+        case MazeNodeState::kClose:
           gp_boundary.set_data_type(close_data_type);
           break;
         default:
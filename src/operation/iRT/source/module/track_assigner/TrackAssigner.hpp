@@ -82,12 +82,7 @@ class TrackAssigner
   void initRoutingInfo(TAPanel& ta_panel, TATask& ta_task);
   bool isConnectedAllEnd(TAPanel& ta_panel);
   void routeSinglePath(TAPanel& ta_panel);
-  void initPathHead(TAPanel& ta_panel);
-  bool searchEnded(TAPanel& ta_panel);
-  void expandSearching(TAPanel& ta_panel);
   bool passCheckingSegment(TAPanel& ta_panel, TANode* start_node, TANode* end_node);
-  bool replaceParentNode(TAPanel& ta_panel, TANode* parent_node, TANode* child_node);
-  void resetPathHead(TAPanel& ta_panel);
   bool isRoutingFailed(TAPanel& ta_panel);
   void resetSinglePath(TAPanel& ta_panel);
   void rerouteByforcing(TAPanel& ta_panel);
@@ -95,11 +90,8 @@ class TrackAssigner
   void resetStartAndEnd(TAPanel& ta_panel);
   void updateNetResult(TAPanel& ta_panel, TATask& ta_task);
   void resetSingleNet(TAPanel& ta_panel);
-  void pushToOpenList(TAPanel& ta_panel, TANode* curr_node);
-  TANode* popFromOpenList(TAPanel& ta_panel);
   double getKnowCost(TAPanel& ta_panel, TANode* start_node, TANode* end_node);
   double getJointCost(TAPanel& ta_panel, TANode* curr_node, Orientation orientation);
-  double getEstimateCostToEnd(TAPanel& ta_panel, TANode* curr_node);
   double getEstimateCost(TAPanel& ta_panel, TANode* start_node, TANode* end_node);
   Orientation getOrientation(TANode* start_node, TANode* end_node);
   double getWireCost(TAPanel& ta_panel, TANode* start_node, TANode* end_node);
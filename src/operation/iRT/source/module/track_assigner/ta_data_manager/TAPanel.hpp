@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EXTLayerRect.hpp"
+#include "MazeSearcher.hpp"
 #include "ScaleAxis.hpp"
 #include "TANode.hpp"
 #include "TAPanelStat.hpp"
@@ -28,7 +29,13 @@ class TAPanel : public EXTLayerRect
   void set_ta_node_map(const GridMap<TANode>& ta_node_map) { _ta_node_map = ta_node_map; }
   // function
   bool skipAssigning() { return _ta_task_list.empty(); }
-  void freeNodeMap() { _ta_node_map.free(); }
+  void freeNodeMap()
+  {
+    _ta_node_map.free();
+    _maze_searcher.free();
+  }
+  void initMazeSearcher() { _maze_searcher.init(static_cast<size_t>(_ta_node_map.get_x_size()) * _ta_node_map.get_y_size()); }
+  size_t getNodeIdx(TANode* ta_node) { return static_cast<size_t>(ta_node - &_ta_node_map[0][0]); }
 
 #if 1  // astar
   double get_wire_unit() const { return _wire_unit; }
@@ -41,10 +48,9 @@ class TAPanel : public EXTLayerRect
   std::vector<std::vector<TANode*>>& get_end_node_comb_list() { return _end_node_comb_list; }
   std::vector<TANode*>& get_path_node_comb() { return _path_node_comb; }
   std::vector<Segment<TANode*>>& get_node_segment_list() { return _node_segment_list; }
-  std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost>& get_open_queue() { return _open_queue; }
-  std::vector<TANode*>& get_visited_node_list() { return _visited_node_list; }
-  TANode* get_path_head_node() { return _path_head_node; }
-  irt_int get_end_node_comb_idx() const { return _end_node_comb_idx; }
+  MazeSearcher<TANode>& get_maze_searcher() { return _maze_searcher; }
+  TANode* get_path_head_node() { return _maze_searcher.get_path_head_node(); }
+  irt_int get_end_node_comb_idx() const { return _maze_searcher.get_end_node_comb_idx(); }
   void set_wire_unit(const double wire_unit) { _wire_unit = wire_unit; }
   void set_via_unit(const double via_unit) { _via_unit = via_unit; }
   void set_ta_task_ref(TATask* ta_task_ref) { _ta_task_ref = ta_task_ref; }
@@ -57,11 +63,11 @@ class TAPanel : public EXTLayerRect
   void set_path_node_comb(const std::vector<TANode*>& path_node_comb) { _path_node_comb = path_node_comb; }
   void set_node_segment_list(const std::vector<Segment<TANode*>>& node_segment_list) { _node_segment_list = node_segment_list; }
   void set_forced_routing(const bool forced_routing) { _forced_routing = forced_routing; }
-  void set_open_queue(const std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost>& open_queue) { _open_queue = open_queue; }
-  void set_visited_node_list(const std::vector<TANode*>& visited_node_list) { _visited_node_list = visited_node_list; }
-  void set_path_head_node(TANode* path_head_node) { _path_head_node = path_head_node; }
-  void set_end_node_comb_idx(const irt_int end_node_comb_idx) { _end_node_comb_idx = end_node_comb_idx; }
   bool isForcedRouting() { return _forced_routing; }
+  // node state
+  MazeNodeState getState(TANode* ta_node) { return _maze_searcher.getState(getNodeIdx(ta_node)); }
+  TANode* getParentNode(TANode* ta_node) { return _maze_searcher.getParentNode(getNodeIdx(ta_node)); }
+  double getKnownCost(TANode* ta_node) { return _maze_searcher.getKnownCost(getNodeIdx(ta_node)); }
 #endif
 
  private:
@@ -84,10 +90,7 @@ class TAPanel : public EXTLayerRect
   std::vector<Segment<TANode*>> _node_segment_list;
   // single path
   bool _forced_routing = false;
-  std::priority_queue<TANode*, std::vector<TANode*>, CmpTANodeCost> _open_queue;
-  std::vector<TANode*> _visited_node_list;
-  TANode* _path_head_node = nullptr;
-  irt_int _end_node_comb_idx = -1;
+  MazeSearcher<TANode> _maze_searcher;
 #endif
 };
 
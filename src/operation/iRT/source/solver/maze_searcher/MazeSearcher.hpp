@@ -0,0 +1,297 @@
+#pragma once
+
+#include "RTU.hpp"
+#include "RTUtil.hpp"
+
+namespace irt {
+
+enum class MazeNodeState
+{
+  kNone = 0,
+  kOpen = 1,
+  kClose = 2
+};
+
+/**
+ * 各阶段搜索图的适配，由各阶段用lambda组装
+ *  getNodeIdx(Node* node) -> size_t : node在[0, node_num)中的下标
+ *  forEachNeighbor(Node* node, visit) : 对每个存在且在routing region内的邻居调用visit(Node* neighbor_node)
+ *  passChecking(Node* start_node, Node* end_node) -> bool : start到end的线段是否可走
+ *  getKnownCost(Node* start_node, Node* end_node) -> double : 经过start到达end的已知代价(包含start的已知代价)
+ *  getEstimateCost(Node* start_node, Node* end_node) -> double : start到end的估计代价
+ */
+template <typename NodeIdxFunc, typename NeighborFunc, typename PassFunc, typename KnownCostFunc, typename EstimateCostFunc>
+struct MazeGraph
+{
+  NodeIdxFunc getNodeIdx;
+  NeighborFunc forEachNeighbor;
+  PassFunc passChecking;
+  KnownCostFunc getKnownCost;
+  EstimateCostFunc getEstimateCost;
+};
+
+/**
+ * GR/TA/DR共用的A*搜索内核
+ *  - 搜索状态保存在以node idx为下标的连续数组中，node本身只读，同一张图可由多个searcher同时搜索
+ *  - open list为带位置索引的二叉堆，找到更优父节点时原位上浮
+ *  - 多源多汇，弹出任意终点即结束，终点判断为O(1)
+ */
+template <typename Node>
+class MazeSearcher
+{
+ public:
+  MazeSearcher() = default;
+  ~MazeSearcher() = default;
+  // getter
+  Node* get_path_head_node() const { return _path_head_node; }
+  irt_int get_end_node_comb_idx() const { return _end_node_comb_idx; }
+  // function
+  void init(size_t node_num)
+  {
+    _state_list.assign(node_num, MazeNodeState::kNone);
+    _parent_node_list.assign(node_num, nullptr);
+    _known_cost_list.assign(node_num, 0.0);
+    _estimated_cost_list.assign(node_num, 0.0);
+    _heap_pos_list.assign(node_num, -1);
+    _end_comb_idx_list.assign(node_num, -1);
+    _open_heap.clear();
+    _visited_node_idx_list.clear();
+    _path_head_node = nullptr;
+    _end_node_comb_idx = -1;
+  }
+  // 扩大到至少node_num，已有的状态在reset后都是初始值，所以只补齐新增的部分
+  void extend(size_t node_num)
+  {
+    if (node_num <= _state_list.size()) {
+      return;
+    }
+    _state_list.resize(node_num, MazeNodeState::kNone);
+    _parent_node_list.resize(node_num, nullptr);
+    _known_cost_list.resize(node_num, 0.0);
+    _estimated_cost_list.resize(node_num, 0.0);
+    _heap_pos_list.resize(node_num, -1);
+    _end_comb_idx_list.resize(node_num, -1);
+  }
+  void free()
+  {
+    std::vector<MazeNodeState>().swap(_state_list);
+    std::vector<Node*>().swap(_parent_node_list);
+    std::vector<double>().swap(_known_cost_list);
+    std::vector<double>().swap(_estimated_cost_list);
+    std::vector<irt_int>().swap(_heap_pos_list);
+    std::vector<irt_int>().swap(_end_comb_idx_list);
+    std::vector<HeapItem>().swap(_open_heap);
+    std::vector<size_t>().swap(_visited_node_idx_list);
+    _path_head_node = nullptr;
+    _end_node_comb_idx = -1;
+  }
+  // 清除上一次搜索的状态，只遍历访问过的node
+  void reset()
+  {
+    for (size_t node_idx : _visited_node_idx_list) {
+      _state_list[node_idx] = MazeNodeState::kNone;
+      _parent_node_list[node_idx] = nullptr;
+      _known_cost_list[node_idx] = 0.0;
+      _estimated_cost_list[node_idx] = 0.0;
+      _heap_pos_list[node_idx] = -1;
+    }
+    _visited_node_idx_list.clear();
+    _open_heap.clear();
+    _path_head_node = nullptr;
+    _end_node_comb_idx = -1;
+  }
+  MazeNodeState getState(size_t node_idx) const { return _state_list[node_idx]; }
+  Node* getParentNode(size_t node_idx) const { return _parent_node_list[node_idx]; }
+  double getKnownCost(size_t node_idx) const { return _known_cost_list[node_idx]; }
+  double getEstimatedCost(size_t node_idx) const { return _estimated_cost_list[node_idx]; }
+  bool isNone(size_t node_idx) const { return _state_list[node_idx] == MazeNodeState::kNone; }
+  bool isOpen(size_t node_idx) const { return _state_list[node_idx] == MazeNodeState::kOpen; }
+  bool isClose(size_t node_idx) const { return _state_list[node_idx] == MazeNodeState::kClose; }
+  /**
+   * 从source_list出发，搜索到end_node_comb_list中任意一个node
+   * 结果: path_head_node为到达的终点(失败为nullptr)，end_node_comb_idx为终点所在comb(失败为-1)
+   * 搜索状态保留到reset，用于回溯路径
+   */
+  template <typename Graph>
+  void search(Graph& graph, const std::vector<Node*>& source_list, const std::vector<std::vector<Node*>>& end_node_comb_list)
+  {
+    _path_head_node = nullptr;
+    _end_node_comb_idx = -1;
+
+    std::vector<size_t> end_node_idx_list;
+    for (size_t i = 0; i < end_node_comb_list.size(); i++) {
+      for (Node* end_node : end_node_comb_list[i]) {
+        size_t end_node_idx = graph.getNodeIdx(end_node);
+        if (_end_comb_idx_list[end_node_idx] == -1) {
+          _end_comb_idx_list[end_node_idx] = static_cast<irt_int>(i);
+          end_node_idx_list.push_back(end_node_idx);
+        }
+      }
+    }
+    for (Node* source_node : source_list) {
+      size_t source_node_idx = graph.getNodeIdx(source_node);
+      if (!isNone(source_node_idx)) {
+        continue;
+      }
+      _estimated_cost_list[source_node_idx] = getEstimateCostToEnd(graph, source_node, end_node_comb_list);
+      pushToOpenList(source_node, source_node_idx);
+    }
+    while (!_open_heap.empty()) {
+      Node* head_node = popFromOpenList();
+      irt_int end_comb_idx = _end_comb_idx_list[graph.getNodeIdx(head_node)];
+      if (end_comb_idx != -1) {
+        _path_head_node = head_node;
+        _end_node_comb_idx = end_comb_idx;
+        break;
+      }
+      expandSearching(graph, head_node, end_node_comb_list);
+    }
+    for (size_t end_node_idx : end_node_idx_list) {
+      _end_comb_idx_list[end_node_idx] = -1;
+    }
+  }
+
+ private:
+  struct HeapItem
+  {
+    Node* node = nullptr;
+    size_t node_idx = 0;
+    double total_cost = 0.0;
+    double estimated_cost = 0.0;
+    irt_int neighbor_num = 0;
+  };
+  // node state, indexed by node idx
+  std::vector<MazeNodeState> _state_list;
+  std::vector<Node*> _parent_node_list;
+  std::vector<double> _known_cost_list;  // include curr
+  std::vector<double> _estimated_cost_list;
+  std::vector<irt_int> _heap_pos_list;
+  std::vector<irt_int> _end_comb_idx_list;
+  // single path
+  std::vector<HeapItem> _open_heap;
+  std::vector<size_t> _visited_node_idx_list;
+  Node* _path_head_node = nullptr;
+  irt_int _end_node_comb_idx = -1;
+
+  template <typename Graph>
+  void expandSearching(Graph& graph, Node* path_head_node, const std::vector<std::vector<Node*>>& end_node_comb_list)
+  {
+    graph.forEachNeighbor(path_head_node, [&](Node* neighbor_node) {
+      size_t neighbor_node_idx = graph.getNodeIdx(neighbor_node);
+      if (isClose(neighbor_node_idx)) {
+        return;
+      }
+      if (!graph.passChecking(path_head_node, neighbor_node)) {
+        return;
+      }
+      if (isOpen(neighbor_node_idx)) {
+        double known_cost = graph.getKnownCost(path_head_node, neighbor_node);
+        if (known_cost < _known_cost_list[neighbor_node_idx]) {
+          _known_cost_list[neighbor_node_idx] = known_cost;
+          _parent_node_list[neighbor_node_idx] = path_head_node;
+          irt_int heap_pos = _heap_pos_list[neighbor_node_idx];
+          _open_heap[heap_pos].total_cost = known_cost + _estimated_cost_list[neighbor_node_idx];
+          siftUp(heap_pos);
+        }
+      } else if (isNone(neighbor_node_idx)) {
+        _known_cost_list[neighbor_node_idx] = graph.getKnownCost(path_head_node, neighbor_node);
+        _parent_node_list[neighbor_node_idx] = path_head_node;
+        _estimated_cost_list[neighbor_node_idx] = getEstimateCostToEnd(graph, neighbor_node, end_node_comb_list);
+        pushToOpenList(neighbor_node, neighbor_node_idx);
+      }
+    });
+  }
+  template <typename Graph>
+  double getEstimateCostToEnd(Graph& graph, Node* curr_node, const std::vector<std::vector<Node*>>& end_node_comb_list)
+  {
+    double estimate_cost = DBL_MAX;
+    for (const std::vector<Node*>& end_node_comb : end_node_comb_list) {
+      for (Node* end_node : end_node_comb) {
+        if (isClose(graph.getNodeIdx(end_node))) {
+          continue;
+        }
+        estimate_cost = std::min(estimate_cost, graph.getEstimateCost(curr_node, end_node));
+      }
+    }
+    return estimate_cost;
+  }
+  void pushToOpenList(Node* curr_node, size_t curr_node_idx)
+  {
+    HeapItem heap_item;
+    heap_item.node = curr_node;
+    heap_item.node_idx = curr_node_idx;
+    heap_item.total_cost = _known_cost_list[curr_node_idx] + _estimated_cost_list[curr_node_idx];
+    heap_item.estimated_cost = _estimated_cost_list[curr_node_idx];
+    heap_item.neighbor_num = curr_node->getNeighborNum();
+    _open_heap.push_back(heap_item);
+    _heap_pos_list[curr_node_idx] = static_cast<irt_int>(_open_heap.size()) - 1;
+    _state_list[curr_node_idx] = MazeNodeState::kOpen;
+    _visited_node_idx_list.push_back(curr_node_idx);
+    siftUp(static_cast<irt_int>(_open_heap.size()) - 1);
+  }
+  Node* popFromOpenList()
+  {
+    HeapItem top_item = _open_heap.front();
+    _open_heap.front() = _open_heap.back();
+    _heap_pos_list[_open_heap.front().node_idx] = 0;
+    _open_heap.pop_back();
+    if (!_open_heap.empty()) {
+      siftDown(0);
+    }
+    _heap_pos_list[top_item.node_idx] = -1;
+    _state_list[top_item.node_idx] = MazeNodeState::kClose;
+    return top_item.node;
+  }
+  // 与原先CmpNodeCost一致: 总代价小优先，其次估计代价小优先，最后邻居多优先
+  static bool isBetter(const HeapItem& a, const HeapItem& b)
+  {
+    if (RTUtil::equalDoubleByError(a.total_cost, b.total_cost, DBL_ERROR)) {
+      if (RTUtil::equalDoubleByError(a.estimated_cost, b.estimated_cost, DBL_ERROR)) {
+        return a.neighbor_num > b.neighbor_num;
+      } else {
+        return a.estimated_cost < b.estimated_cost;
+      }
+    } else {
+      return a.total_cost < b.total_cost;
+    }
+  }
+  void siftUp(irt_int pos)
+  {
+    HeapItem heap_item = _open_heap[pos];
+    while (pos > 0) {
+      irt_int parent_pos = (pos - 1) / 2;
+      if (!isBetter(heap_item, _open_heap[parent_pos])) {
+        break;
+      }
+      _open_heap[pos] = _open_heap[parent_pos];
+      _heap_pos_list[_open_heap[pos].node_idx] = pos;
+      pos = parent_pos;
+    }
+    _open_heap[pos] = heap_item;
+    _heap_pos_list[heap_item.node_idx] = pos;
+  }
+  void siftDown(irt_int pos)
+  {
+    irt_int heap_size = static_cast<irt_int>(_open_heap.size());
+    HeapItem heap_item = _open_heap[pos];
+    while (true) {
+      irt_int child_pos = 2 * pos + 1;
+      if (child_pos >= heap_size) {
+        break;
+      }
+      if (child_pos + 1 < heap_size && isBetter(_open_heap[child_pos + 1], _open_heap[child_pos])) {
+        child_pos++;
+      }
+      if (!isBetter(_open_heap[child_pos], heap_item)) {
+        break;
+      }
+      _open_heap[pos] = _open_heap[child_pos];
+      _heap_pos_list[_open_heap[pos].node_idx] = pos;
+      pos = child_pos;
+    }
+    _open_heap[pos] = heap_item;
+    _heap_pos_list[heap_item.node_idx] = pos;
+  }
+};
+
+}  // namespace irt
@@ -10,8 +10,10 @@
 
 #include <iostream>
 #include <optional>
+#include <queue>
 
 #include "HashSet.hh"
+#include "delay/ArnoldiDelayCal.hh"
 #include "delay/ElmoreDelayCalc.hh"
 #include "liberty/Liberty.hh"
 #include "log/Log.hh"
@@ -83,6 +85,18 @@ TimingEngine& TimingEngine::set_num_threads(unsigned num_thread) {
   return *this;
 }
 
+/**
+ * @brief Set the slew, delay, AT and RT propagation level by level, the
+ * vertexes of one level are propagated in parallel.
+ *
+ * @param is_level_prop
+ * @return TimingEngine&
+ */
+TimingEngine& TimingEngine::set_is_level_propagation(bool is_level_prop) {
+  _ista->set_is_level_propagation(is_level_prop);
+  return *this;
+}
+
 void TimingEngine::set_db_adapter(std::unique_ptr<TimingDBAdapter> db_adapter) {
   _db_adapter = std::move(db_adapter);
 }
@@ -369,32 +383,128 @@ void TimingEngine::updateRCTreeInfo(Net* net) {
   auto* rc_net = _timing_engine->get_ista()->getRcNet(net);
   if (rc_net) {
     rc_net->updateRcTreeInfo();
+    // the rc equation of the changed net is built again.
+    if (auto* arnoldi_net = dynamic_cast<ArnoldiNet*>(rc_net); arnoldi_net) {
+      arnoldi_net->resetRcEquation();
+    }
     auto* rct = rc_net->rct();
     if (rct) {
       rct->updateRcTiming();
     }
+    markNetDirty(net);
+  }
+}
+
+/**
+ * @brief record the net driver vertex dirty, the net load or delay is
+ * changed, the fanout cone is reset at the next incremental update.
+ *
+ * @param net
+ */
+void TimingEngine::markNetDirty(Net* net) {
+  if (!_ista->isBuildGraph()) {
+    return;
+  }
+
+  auto* driver = net->getDriver();
+  if (!driver) {
+    return;
+  }
+
+  auto& the_graph = _ista->get_graph();
+  if (auto driver_vertex = the_graph.findVertex(driver); driver_vertex) {
+    _incr_func.addDirtyVertex(*driver_vertex);
+  }
+}
+
+/**
+ * @brief record the driver of the instance connected nets dirty, which
+ * include the instance output and the instance input driver.
+ *
+ * @param instance
+ */
+void TimingEngine::markInstanceDirty(Instance* instance) {
+  Pin* pin;
+  FOREACH_INSTANCE_PIN(instance, pin) {
+    if (auto* net = pin->get_net(); net) {
+      markNetDirty(net);
+    }
+  }
+}
+
+/**
+ * @brief levelize the vertexes of the new instance, and raise the level of
+ * its fanout cone, so that the incremental queue keep the topological order.
+ *
+ * @param instance
+ */
+void TimingEngine::levelizeInstance(Instance* instance) {
+  auto& the_graph = _ista->get_graph();
+
+  std::queue<StaVertex*> bfs_queue;
+  StaLevelization levelization;
+  Pin* pin;
+  FOREACH_INSTANCE_PIN(instance, pin) {
+    if (auto the_vertex = the_graph.findVertex(pin); the_vertex) {
+      (*the_vertex)->exec(levelization);
+      bfs_queue.push(*the_vertex);
+    }
+  }
+
+  while (!bfs_queue.empty()) {
+    auto* the_vertex = bfs_queue.front();
+    bfs_queue.pop();
+
+    StaArc* src_arc;
+    FOREACH_SRC_ARC(the_vertex, src_arc) {
+      if (!src_arc->isDelayArc()) {
+        continue;
+      }
+      auto* snk_vertex = src_arc->get_snk();
+      if (snk_vertex->is_start() ||
+          snk_vertex->get_level() > the_vertex->get_level()) {
+        continue;
+      }
+      snk_vertex->set_level(the_vertex->get_level() + 1);
+      bfs_queue.push(snk_vertex);
+    }
   }
 }
 
 /**
- * @brief incremental propagation to update timing data.
+ * @brief incremental propagation to update timing data, only the fwd cone of
+ * the dirty vertexes and the bwd cone of the fwd cone are propagated, and only
+ * the end vertexes in the fwd cone are analyzed again.
  *
  * @return TimingEngine&
  */
 TimingEngine& TimingEngine::incrUpdateTiming() {
-  resetPathData();
+  _ista->resetReportTbl();
 
+  StaGraph& the_graph = _ista->get_graph();
+
+  _incr_func.resetDirtyFwdCone();
+  // only the nets driven by the fwd cone are calculated again, which include
+  // the rc changed nets.
+  _ista->prepareRcNets(_incr_func.getFwdConeDriverNets());
   _incr_func.applyFwdQueue();
 
-  StaGraph& the_graph = _ista->get_graph();
+  auto end_vertexes = _incr_func.getFwdConeEndVertexes(&the_graph);
+  for (auto* end_vertex : end_vertexes) {
+    _ista->removePathData(end_vertex);
+  }
 
-  the_graph.exec([](StaGraph* the_graph) -> unsigned {
-    StaAnalyze analyze_path;
-    return analyze_path(the_graph);
-  });
+  the_graph.exec(
+      [&end_vertexes](StaGraph* the_graph) -> unsigned {
+        StaAnalyze analyze_path(std::move(end_vertexes));
+        return analyze_path(the_graph);
+      });
 
+  _incr_func.resetBwdConeOfFwdCone();
   _incr_func.applyBwdQueue();
 
+  _incr_func.resetIncrData();
+
   return *this;
 }
 
@@ -642,6 +752,10 @@ void TimingEngine::insertBuffer(const char* instance_name) {
   for (auto* net : buffer_nets) {
     build_graph.buildNet(&the_graph, net);
   }
+  levelizeInstance(instance);
+  ista->resetLevelPropagation();
+
+  markInstanceDirty(instance);
 }
 
 /**
@@ -696,6 +810,7 @@ void TimingEngine::removeBuffer(const char* instance_name) {
       initRcTree(net);
     }
 
+    _incr_func.removeDirtyVertex(*the_vertex);
     the_graph.removePinVertex(pin, *the_vertex);
   }
 
@@ -705,6 +820,12 @@ void TimingEngine::removeBuffer(const char* instance_name) {
     buffer_driver_vertex->addSrcArc(to_be_changed_arc);
     dynamic_cast<StaNetArc*>(to_be_changed_arc)->set_net(buffer_driver_net);
   }
+
+  if (buffer_driver_vertex) {
+    _incr_func.addDirtyVertex(buffer_driver_vertex);
+  }
+
+  ista->resetLevelPropagation();
 }
 
 /**
@@ -751,6 +872,8 @@ void TimingEngine::repowerInstance(const char* instance_name,
   }
 
   instance->set_inst_cell(inst_liberty_cell);
+
+  markInstanceDirty(instance);
 }
 
 /**
@@ -775,32 +898,25 @@ void TimingEngine::moveInstance(const char* instance_name,
       if (prop_type == PropType::kFwd || prop_type == PropType::kFwdAndBwd) {
         FOREACH_SNK_ARC((*the_vertex), the_arc) {
           auto* src_vertex = the_arc->get_src();
-          _incr_func.insertFwdQueue(src_vertex);
 
-          StaResetPropagation reset_fwd_prop;
-          reset_fwd_prop.set_incr_func(&_incr_func);
+          std::optional<unsigned> max_level;
           if (update_level) {
-            reset_fwd_prop.set_max_min_level((*the_vertex)->get_level() +
-                                             ((*update_level) << 1));
+            max_level = (*the_vertex)->get_level() + ((*update_level) << 1);
           }
-          src_vertex->exec(reset_fwd_prop);
+          _incr_func.resetFwdCone(src_vertex, max_level);
         }
       }
     } else {
       if (prop_type == PropType::kBwd || prop_type == PropType::kFwdAndBwd) {
         FOREACH_SRC_ARC((*the_vertex), the_arc) {
           auto* snk_vertex = the_arc->get_snk();
-          _incr_func.insertBwdQueue(snk_vertex);
 
-          StaResetPropagation reset_bwd_prop;
-          reset_bwd_prop.set_is_bwd();
-          reset_bwd_prop.set_incr_func(&_incr_func);
+          std::optional<unsigned> min_level;
           if (update_level &&
               ((*the_vertex)->get_level() > ((*update_level) << 1))) {
-            reset_bwd_prop.set_max_min_level((*the_vertex)->get_level() -
-                                             ((*update_level) << 1));
+            min_level = (*the_vertex)->get_level() - ((*update_level) << 1);
           }
-          snk_vertex->exec(reset_bwd_prop);
+          _incr_func.resetBwdCone(snk_vertex, min_level);
         }
       }
     }
@@ -52,6 +52,7 @@ class TimingEngine {
 
   // Builder
   TimingEngine &set_num_threads(unsigned num_thread);
+  TimingEngine &set_is_level_propagation(bool is_level_prop);
 
   void set_design_work_space(const char *design_work_space) {
     _ista->set_design_work_space(design_work_space);
@@ -195,6 +196,7 @@ class TimingEngine {
   TimingEngine &incrUpdateTiming();
 
   TimingEngine &updateTiming() {
+    _incr_func.resetIncrData();
     _ista->updateTiming();
     return *this;
   }
@@ -335,6 +337,10 @@ class TimingEngine {
   TimingEngine();
   ~TimingEngine();
 
+  void markNetDirty(Net *net);
+  void markInstanceDirty(Instance *instance);
+  void levelizeInstance(Instance *instance);
+
   Sta *_ista;
 
   std::unique_ptr<TimingDBAdapter> _db_adapter;
@@ -204,16 +204,17 @@ void ArnoldiNet::assignRcNodeID() {
  * @param parser
  */
 void ArnoldiNet::updateRcTiming(const spef::Net& spef_net) {
+  resetRcEquation();
   makeRct(spef_net);
   updateRcTreeInfo();
   makeRcTreeReduce();
 
   if (_rct.index() != 0) {
     auto& rct = std::get<RcTree>(_rct);
-    rct.initData();
     if (rct._root) {
-      rct.updateLoad(nullptr, rct.get_root());
-      rct.updateDelay(nullptr, rct.get_root());
+      rct.updateRcTiming();
+    } else {
+      rct.initData();
     }
 
     assignRcNodeID();
@@ -222,13 +223,17 @@ void ArnoldiNet::updateRcTiming(const spef::Net& spef_net) {
 
 /**
  * @brief Store the resistances of each segment and the capacitance of each
- * nodal in vector container.
+ * nodal in the matrix of the workspace.
  *
  * @param analysis_mode
  * @param trans_type
+ * @param workspace the thread workspace the matrix allocated.
+ * @return the conductance matrix G, cap matrix C and input vector.
  */
-void ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
-                                                 TransType trans_type) {
+std::tuple<Eigen::Map<MatrixXd>, Eigen::Map<MatrixXd>, Eigen::Map<VectorXd>>
+ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
+                                            TransType trans_type,
+                                            ArnoldiWorkspace& workspace) {
   constexpr unsigned use_reduce_node_num = 10;
 
   auto& rct = std::get<RcTree>(_rct);
@@ -239,9 +244,14 @@ void ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
     // set_is_reduce(true);
   }
 
+  // G, C and input vec.
+  workspace.reset(2 * node_num * node_num + node_num);
+  auto conductances = workspace.allocMatrix(node_num, node_num);
+  auto cap_matrix = workspace.allocMatrix(node_num, node_num);
+  auto input_vec = workspace.allocVector(node_num);
+
   // construct the matrix C and diagonal G.
   std::vector<double> nodal_caps(node_num);
-  MatrixXd conductances(node_num, node_num);
   conductances.setZero();
 
   FOREACH_RCTREE_NODE(rct, name, rc_node) {
@@ -272,27 +282,22 @@ void ArnoldiNet::constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
     }
   }
 
-  _conductances_matrix = conductances;
-
   // consturct nodal cap matrix.
+  cap_matrix.setZero();
   auto cap_size = _nodal_caps.size();
-  VectorXd nodal_vec(cap_size);
   for (decltype(cap_size) i = 0; i < cap_size; ++i) {
-    nodal_vec(i) = _nodal_caps[i];
+    cap_matrix(i, i) = _nodal_caps[i];
   }
 
-  _cap_matrix = nodal_vec.asDiagonal();
-
   // construct input vec.
-  VectorXd input_vec(_nodal_caps.size());
   input_vec.setZero();
   input_vec(0) = 1.0;
 
-  _input_vec = input_vec;
+  DVERBOSE_VLOG(1) << "conductances\n" << conductances;
+  DVERBOSE_VLOG(1) << "cap_matrix\n" << cap_matrix;
+  DVERBOSE_VLOG(1) << "input_vec\n" << input_vec;
 
-  DVERBOSE_VLOG(1) << "conductances\n" << _conductances_matrix;
-  DVERBOSE_VLOG(1) << "cap_matrix\n" << _cap_matrix;
-  DVERBOSE_VLOG(1) << "input_vec\n" << _input_vec;
+  return {conductances, cap_matrix, input_vec};
 }
 
 /**
@@ -340,16 +345,17 @@ void ArnoldiNet::reduceRCEquation() {
  * Calculation Using Current Source Models>> but dont agree with the paper, we
  * use inv cap , not use inv G.
  */
-auto ArnoldiNet::constructRCEquation(const MatrixXd& cap_matrix,
-                                     const MatrixXd& conductances_matrix,
-                                     const VectorXd& input_vec) {
-  auto cap_inv = cap_matrix.inverse();
+auto ArnoldiNet::constructRCEquation(
+    const Eigen::Ref<const MatrixXd>& cap_matrix,
+    const Eigen::Ref<const MatrixXd>& conductances_matrix,
+    const Eigen::Ref<const VectorXd>& input_vec) {
+  MatrixXd cap_inv = cap_matrix.inverse();
 
   // LOG_INFO << "cap matrix:\n" << cap_matrix;
   // LOG_INFO << "cap inv:\n" << cap_inv;
   // LOG_INFO << "conductances:\n" << (*_conductances);
 
-  auto cap_inv_dot_conductances = cap_inv * conductances_matrix;
+  MatrixXd cap_inv_dot_conductances = cap_inv * conductances_matrix;
   // LOG_INFO << cap_inv_dot_conductances;
 
   EigenSolver<MatrixXd> es(cap_inv_dot_conductances);
@@ -450,7 +456,7 @@ std::vector<VectorXd> ArnoldiNet::solveRCEquation(
  * @return VectorXd
  */
 VectorXd ArnoldiNet::getOutputVector(unsigned id) {
-  VectorXd output_vec(_input_vec.rows());
+  VectorXd output_vec(std::get<RcTree>(_rct).get_node_num());
   output_vec.setZero();
   output_vec(id) = 1.0;
 
@@ -462,6 +468,82 @@ VectorXd ArnoldiNet::getOutputVector(unsigned id) {
   return output_vec;
 }
 
+/**
+ * @brief Build the RC equation of the net, which is independent of the input
+ * current, so it could be prepared for all nets in parallel before the
+ * propagation. The equation is built only once for each mode and trans.
+ *
+ * @param analysis_mode
+ * @param trans_type
+ * @return unsigned return 1 if success, else return 0.
+ */
+unsigned ArnoldiNet::prepareRcEquation(AnalysisMode analysis_mode,
+                                       TransType trans_type) {
+  std::lock_guard<std::mutex> lk(_calc_mutex);
+  ModeTransPair mode_trans(analysis_mode, trans_type);
+  if (_diag_B_W.contains(mode_trans)) {
+    return 1;
+  }
+
+  auto& workspace = ArnoldiWorkspace::getThreadWorkspace();
+  auto [conductances, cap_matrix, input_vec] =
+      constructResistanceAndCapMatrix(analysis_mode, trans_type, workspace);
+
+  if (isReduce()) {
+    _conductances_matrix = conductances;
+    _cap_matrix = cap_matrix;
+    _input_vec = input_vec;
+
+    if (constructArnoldiOrthogonalBasis()) {
+      reduceRCEquation();
+      _diag_B_W.emplace(
+          mode_trans,
+          constructRCEquation(_reduce_cap_matrix, _reduce_conductances_matrix,
+                              _reduce_input_vec));
+      return 1;
+    }
+    set_is_reduce(false);
+  }
+
+  _diag_B_W.emplace(mode_trans,
+                    constructRCEquation(cap_matrix, conductances, input_vec));
+
+  return 1;
+}
+
+/**
+ * @brief Get the RC equation of the mode and trans, which should be prepared.
+ *
+ * @param analysis_mode
+ * @param trans_type
+ * @return std::tuple<MatrixXd, MatrixXd, MatrixXd>& the diag, B and W.
+ */
+std::tuple<MatrixXd, MatrixXd, MatrixXd>& ArnoldiNet::getRcEquation(
+    AnalysisMode analysis_mode, TransType trans_type) {
+  std::lock_guard<std::mutex> lk(_calc_mutex);
+  return _diag_B_W.at(ModeTransPair(analysis_mode, trans_type));
+}
+
+/**
+ * @brief Reset the RC equation and the node voltage, the rc tree is changed.
+ *
+ */
+void ArnoldiNet::resetRcEquation() {
+  std::scoped_lock lk(_calc_mutex, _cache_mutex);
+  _diag_B_W.clear();
+  _node_voltage_cache.clear();
+}
+
+/**
+ * @brief Reset the node voltage, the driver current of the last update is
+ * freed, so the cache is cleared before each update.
+ *
+ */
+void ArnoldiNet::resetNodeVoltageCache() {
+  std::lock_guard<std::mutex> lk(_cache_mutex);
+  _node_voltage_cache.clear();
+}
+
 /**
  * @brief Use trapezoidal method to calculate the net delay and slew. if the
 delay and slew has been calculated,do not need to calculate again.
@@ -470,60 +552,49 @@ delay and slew has been calculated,do not need to calculate again.
  * @param sim_total_time
  * @param num_sim_point
  * @param trans_type
+ * @param output_current the driver current, the loads driven by the same
+ * current and slew share the node voltage.
+ * @param from_slew_ps the driver slew.
  */
 MatrixXd ArnoldiNet::calcDelayAndSlew(
     std::function<std::vector<double>(double, double, int)>&& get_current,
     double start_time, double end_time, int num_sim_point,
-    AnalysisMode analysis_mode, TransType trans_type) {
-  // HeapLeakChecker heap_checker("test_foo");
+    AnalysisMode analysis_mode, TransType trans_type,
+    LibetyCurrentData* output_current, double from_slew_ps) {
+  NodeVoltageKey cache_key(analysis_mode, trans_type, output_current,
+                           from_slew_ps);
   {
-    if (!_diag_B_W) {
-      std::lock_guard<std::mutex> lk(_calc_mutex);
-
-      if (!_diag_B_W) {
-        constructResistanceAndCapMatrix(analysis_mode, trans_type);
-        if (!isReduce()) {
-          _diag_B_W = constructRCEquation(_cap_matrix, _conductances_matrix,
-                                          _input_vec);
-        } else {
-          if (constructArnoldiOrthogonalBasis()) {
-            reduceRCEquation();
-            _diag_B_W = constructRCEquation(_reduce_cap_matrix,
-                                            _reduce_conductances_matrix,
-                                            _reduce_input_vec);
-          } else {
-            set_is_reduce(false);
-            _diag_B_W = constructRCEquation(_cap_matrix, _conductances_matrix,
-                                            _input_vec);
-          }
-        }
-      }
+    std::lock_guard<std::mutex> lk(_cache_mutex);
+    if (auto it = _node_voltage_cache.find(cache_key);
+        it != _node_voltage_cache.end()) {
+      return it->second;
     }
+  }
 
-    auto [diag, B, W] = *_diag_B_W;
-
-    DVERBOSE_VLOG(1) << "diag\n" << diag;
-    DVERBOSE_VLOG(1) << "W\n" << W;
-    DVERBOSE_VLOG(1) << "B\n" << B;
-
-    // Get back Euler integration
-    auto V_waveform = solveRCEquation(std::move(get_current), start_time,
-                                      end_time, num_sim_point, diag, B);
-    MatrixXd V_matrix(V_waveform[0].size(), V_waveform.size());
-    int i = 0;
-    for (auto& V : V_waveform) {
-      // LOG_INFO << "V raw\n" << V;
-      // LOG_INFO << "V\n" << W * V;
-      V_matrix.col(i++) =
-          W * V;  // get the origin V, V is W_inv * origin V.
-                  // every column is one time voltage of every point.
-    }
-    DVERBOSE_VLOG(1) << "V Matrix \n" << V_matrix;
+  prepareRcEquation(analysis_mode, trans_type);
+
+  auto& [diag, B, W] = getRcEquation(analysis_mode, trans_type);
 
-    return V_matrix;
+  DVERBOSE_VLOG(1) << "diag\n" << diag;
+  DVERBOSE_VLOG(1) << "W\n" << W;
+  DVERBOSE_VLOG(1) << "B\n" << B;
+
+  // Get back Euler integration
+  auto V_waveform = solveRCEquation(std::move(get_current), start_time,
+                                    end_time, num_sim_point, diag, B);
+  MatrixXd V_matrix(V_waveform[0].size(), V_waveform.size());
+  int i = 0;
+  for (auto& V : V_waveform) {
+    V_matrix.col(i++) = W * V;  // get the origin V, V is W_inv * origin V.
+                                // every column is one time voltage of every
+                                // point.
   }
+  DVERBOSE_VLOG(1) << "V Matrix \n" << V_matrix;
+
+  std::lock_guard<std::mutex> lk(_cache_mutex);
+  _node_voltage_cache.emplace(cache_key, V_matrix);
 
-  // if (!heap_checker.NoLeaks()) assert(NULL == "heap memory leak");
+  return V_matrix;
 }
 
 /**
@@ -651,11 +722,12 @@ std::optional<double> ArnoldiNet::delay(Waveform& driver_waveform,
 std::optional<std::pair<double, MatrixXd>> ArnoldiNet::getDelay(
     std::function<std::vector<double>(double, double, int)>&& get_current,
     double start_time, double end_time, int num_sim_point,
-    AnalysisMode analysis_mode, TransType trans_type, DesignObject* pin) {
+    AnalysisMode analysis_mode, TransType trans_type,
+    LibetyCurrentData* output_current, double from_slew_ps, DesignObject* pin) {
   // std::lock_guard<std::mutex> lk(_calc_mutex);
-  MatrixXd V_matrix =
-      calcDelayAndSlew(std::move(get_current), start_time, end_time,
-                       num_sim_point, analysis_mode, trans_type);
+  MatrixXd V_matrix = calcDelayAndSlew(
+      std::move(get_current), start_time, end_time, num_sim_point,
+      analysis_mode, trans_type, output_current, from_slew_ps);
 
   double step_time_ns = (end_time - start_time) / (num_sim_point - 1);
 
@@ -747,16 +819,17 @@ std::optional<double> ArnoldiNet::slew(Waveform& node_waveform,
 std::optional<double> ArnoldiNet::getSlew(
     std::function<std::vector<double>(double, double, int)>&& get_current,
     double start_time, double end_time, int num_sim_point,
-    AnalysisMode analysis_mode, TransType trans_type, Pin* pin) {
+    AnalysisMode analysis_mode, TransType trans_type,
+    LibetyCurrentData* output_current, double from_slew_ps, Pin* pin) {
   std::optional<double> slew;
 
   {
     // std::lock_guard<std::mutex> lk(_calc_mutex);
     DVERBOSE_VLOG(1) << "calculate net: " << get_net()->getFullName();
 
-    MatrixXd V_matrix =
-        calcDelayAndSlew(std::move(get_current), start_time, end_time,
-                         num_sim_point, analysis_mode, trans_type);
+    MatrixXd V_matrix = calcDelayAndSlew(
+        std::move(get_current), start_time, end_time, num_sim_point,
+        analysis_mode, trans_type, output_current, from_slew_ps);
 
     double step_time_ns = (end_time - start_time) / (num_sim_point - 1);
 
@@ -800,8 +873,9 @@ std::optional<std::pair<double, MatrixXd>> ArnoldiNet::delay(
       return (*output_current)->getOutputCurrent(simu_info);
     };
 
+    // the delay from slew is ns, but the slew from slew is ps.
     return getDelay(std::move(get_current), 0, total_time, num_points, mode,
-                    trans_type, &to);
+                    trans_type, *output_current, NS_TO_PS(from_slew), &to);
   }
 
   return std::nullopt;
@@ -839,7 +913,7 @@ std::optional<double> ArnoldiNet::slew(
     };
 
     return getSlew(std::move(get_current), 0, total_time, num_points, mode,
-                   trans_type, &to);
+                   trans_type, *output_current, from_slew, &to);
   }
   // prof_count++;
   // if (prof_count > 400000) {
@@ -10,16 +10,19 @@
 
 #include <Eigen/Core>
 #include <algorithm>
+#include <map>
 #include <mutex>
 #include <optional>
 #include <stack>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include "ElmoreDelayCalc.hh"
 #include "Type.hh"
 #include "WaveformInfo.hh"
+#include "log/Log.hh"
 #include "spef/parser-spef.hpp"
 
 using namespace Eigen;
@@ -58,6 +61,46 @@ class ReducedPath {
       _all_reduced_edges;  //!< record the all reserverd reduced edge.
 };
 
+/**
+ * @brief The per thread arena of the rc equation matrix, the buffer only
+ * grow, the matrix of the following net reuse the memory, avoid malloc the
+ * eigen matrix for each net.
+ *
+ */
+class ArnoldiWorkspace {
+ public:
+  void reset(std::size_t total_size) {
+    if (_buffer.size() < total_size) {
+      _buffer.resize(total_size);
+    }
+    _used_size = 0;
+  }
+
+  Eigen::Map<MatrixXd> allocMatrix(Index rows, Index cols) {
+    return Eigen::Map<MatrixXd>(alloc(rows * cols), rows, cols);
+  }
+  Eigen::Map<VectorXd> allocVector(Index size) {
+    return Eigen::Map<VectorXd>(alloc(size), size);
+  }
+
+  static ArnoldiWorkspace& getThreadWorkspace() {
+    static thread_local ArnoldiWorkspace workspace;
+    return workspace;
+  }
+
+ private:
+  double* alloc(std::size_t size) {
+    LOG_FATAL_IF(_used_size + size > _buffer.size())
+        << "workspace is not reset enough.";
+    double* data = _buffer.data() + _used_size;
+    _used_size += size;
+    return data;
+  }
+
+  std::vector<double> _buffer;
+  std::size_t _used_size = 0;
+};
+
 /**
  * @brief Net for arnoldi calc.
  *
@@ -82,6 +125,10 @@ class ArnoldiNet : public RcNet {
 
   void updateRcTiming(const spef::Net& spef_net) override;
 
+  unsigned prepareRcEquation(AnalysisMode analysis_mode, TransType trans_type);
+  void resetRcEquation();
+  void resetNodeVoltageCache();
+
   void set_nodal_caps(std::vector<double>&& nodal_caps) {
     _nodal_caps = std::move(nodal_caps);
   }
@@ -104,12 +151,15 @@ class ArnoldiNet : public RcNet {
   std::optional<std::pair<double, MatrixXd>> getDelay(
       std::function<std::vector<double>(double, double, int)>&& get_current,
       double start_time, double end_time, int num_sim_point,
-      AnalysisMode analysis_mode, TransType trans_type, DesignObject* pin);
+      AnalysisMode analysis_mode, TransType trans_type,
+      LibetyCurrentData* output_current, double from_slew_ps,
+      DesignObject* pin);
 
   std::optional<double> getSlew(
       std::function<std::vector<double>(double, double, int)>&& get_current,
       double start_time, double end_time, int num_sim_point,
-      AnalysisMode analysis_mode, TransType trans_type, Pin* pin);
+      AnalysisMode analysis_mode, TransType trans_type,
+      LibetyCurrentData* output_current, double from_slew_ps, Pin* pin);
 
   std::optional<std::pair<double, MatrixXd>> delay(
       DesignObject& to, double from_slew,
@@ -129,16 +179,23 @@ class ArnoldiNet : public RcNet {
   MatrixXd calcDelayAndSlew(
       std::function<std::vector<double>(double, double, int)>&& get_current,
       double start_time, double end_time, int num_sim_point,
-      AnalysisMode analysis_mode, TransType trans_type);
+      AnalysisMode analysis_mode, TransType trans_type,
+      LibetyCurrentData* output_current, double from_slew_ps);
 
-  void constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
-                                       TransType trans_type);
+  std::tuple<Eigen::Map<MatrixXd>, Eigen::Map<MatrixXd>, Eigen::Map<VectorXd>>
+  constructResistanceAndCapMatrix(AnalysisMode analysis_mode,
+                                  TransType trans_type,
+                                  ArnoldiWorkspace& workspace);
   unsigned constructArnoldiOrthogonalBasis();
   void reduceRCEquation();
 
-  auto constructRCEquation(const MatrixXd& cap_matrix,
-                           const MatrixXd& conductances_matrix,
-                           const VectorXd& input_vec);
+  auto constructRCEquation(
+      const Eigen::Ref<const MatrixXd>& cap_matrix,
+      const Eigen::Ref<const MatrixXd>& conductances_matrix,
+      const Eigen::Ref<const VectorXd>& input_vec);
+
+  std::tuple<MatrixXd, MatrixXd, MatrixXd>& getRcEquation(
+      AnalysisMode analysis_mode, TransType trans_type);
   std::vector<VectorXd> solveRCEquation(
       std::function<std::vector<double>(double, double, int)>&& get_current,
       double start_time, double end_time, int num_sim_point, MatrixXd& diag,
@@ -172,10 +229,17 @@ class ArnoldiNet : public RcNet {
   MatrixXd _reduce_cap_matrix;           //!< The reduce cap matrix.
   MatrixXd _reduce_input_vec;            //!< The reduce input select vector.
 
-  std::optional<std::tuple<MatrixXd, MatrixXd, MatrixXd>>
-      _diag_B_W;  // The RC equation matrix.
+  std::map<ModeTransPair, std::tuple<MatrixXd, MatrixXd, MatrixXd>>
+      _diag_B_W;  // The RC equation matrix of each mode and trans.
+
+  // the node voltage of the same input current is reused by all the load
+  // delay and slew, key is (mode, trans, driver current, driver slew).
+  using NodeVoltageKey =
+      std::tuple<AnalysisMode, TransType, LibetyCurrentData*, double>;
+  std::map<NodeVoltageKey, MatrixXd> _node_voltage_cache;
 
   std::mutex _calc_mutex;
+  std::mutex _cache_mutex;
 
   unsigned _is_debug : 1 = 0;
   unsigned _is_reduce : 1 = 0;  // default reduce.
@@ -29,35 +29,35 @@ RctNode::RctNode(std::string&& name)
       _is_visited(0) {}
 
 double RctNode::nodeLoad(AnalysisMode mode, TransType trans_type) {
-  return _nload[ModeTransPair(mode, trans_type)];
+  return _nload[ModeTransToIndex(mode, trans_type)];
 }
 
 double RctNode::cap(AnalysisMode mode, TransType trans_type) {
   return _obj ? _obj->cap(mode, trans_type) +
-                    _ncap[ModeTransPair(mode, trans_type)]
-              : _ncap[ModeTransPair(mode, trans_type)];
+                    _ncap[ModeTransToIndex(mode, trans_type)]
+              : _ncap[ModeTransToIndex(mode, trans_type)];
 }
 
 void RctNode::setCap(double cap) {
   _cap = cap;
-  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransPair(mode, trans)] = cap; }
+  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransToIndex(mode, trans)] = cap; }
 }
 
 void RctNode::incrCap(double cap) {
   _cap += cap;
-  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransPair(mode, trans)] += cap; }
+  FOREACH_MODE_TRANS(mode, trans) { _ncap[ModeTransToIndex(mode, trans)] += cap; }
 }
 
 double RctNode::delay(AnalysisMode mode, TransType trans_type) {
-  return _ndelay[ModeTransPair(mode, trans_type)];
+  return _ndelay[ModeTransToIndex(mode, trans_type)];
 }
 
 double RctNode::slew(AnalysisMode mode, TransType trans_type,
                      double input_slew) {
   auto si = input_slew;
   return si < 0.0
-             ? -std::sqrt(si * si + _impulse[ModeTransPair(mode, trans_type)])
-             : std::sqrt(si * si + _impulse[ModeTransPair(mode, trans_type)]);
+             ? -std::sqrt(si * si + _impulse[ModeTransToIndex(mode, trans_type)])
+             : std::sqrt(si * si + _impulse[ModeTransToIndex(mode, trans_type)]);
 }
 
 RctEdge::RctEdge(RctNode& from, RctNode& to, double res)
@@ -98,7 +98,7 @@ RctNode* RcTree::insertNode(const std::string& name, double cap) {
   node._cap = cap;
 
   FOREACH_MODE_TRANS(mode, trans) {
-    node._ncap[ModeTransPair(mode, trans)] = cap;
+    node._ncap[ModeTransToIndex(mode, trans)] = cap;
   }
 
   return &node;
@@ -171,12 +171,6 @@ void RcTree::insertSegment(const std::string& name1, const std::string& name2,
  *
  */
 void RcTree::initData() {
-  auto init_zero_value = [](auto& the_map) {
-    for (auto it = the_map.begin(); it != the_map.end(); it++) {
-      it->second = 0.0;
-    }
-  };
-
   for (auto& kvp : _str2nodes) {
     kvp.second._load = 0.0;
     kvp.second._delay = 0.0;
@@ -186,12 +180,12 @@ void RcTree::initData() {
     kvp.second._is_update_ldelay = 0;
     kvp.second._is_update_response = 0;
 
-    init_zero_value(kvp.second._ures);
-    init_zero_value(kvp.second._nload);
-    init_zero_value(kvp.second._beta);
-    init_zero_value(kvp.second._ndelay);
-    init_zero_value(kvp.second._ldelay);
-    init_zero_value(kvp.second._impulse);
+    kvp.second._ures.fill(0.0);
+    kvp.second._nload.fill(0.0);
+    kvp.second._beta.fill(0.0);
+    kvp.second._ndelay.fill(0.0);
+    kvp.second._ldelay.fill(0.0);
+    kvp.second._impulse.fill(0.0);
   }
 }
 /**
@@ -206,129 +200,200 @@ void RcTree::updateRcTiming() {
 
   initData();
 
-  updateLoad(nullptr, _root);
-  updateDelay(nullptr, _root);
-  updateLDelay(nullptr, _root);
-  updateResponse(nullptr, _root);
+  // the flat tree is the scratch of the thread, reuse the memory among nets.
+  static thread_local RctFlatTree flat_tree;
+  flat_tree.build(_root);
+  flat_tree.updateMoments();
+  flat_tree.writeBack();
 
   // printGraphViz();
 }
+
 /**
- * @brief calculate and update the each node's load of a rctree
- *
- * @param parent
- * @param from
+ * @brief clear the flat tree, keep the capacity for reuse.
  *
  */
-void RcTree::updateLoad(RctNode* parent, RctNode* from) {
-  if (from->isUpdateLoad()) {
-    LOG_ERROR << "found loop in rc tree " << from->get_name();
-    // printGraphViz();
-    return;
-  }
+void RctFlatTree::clear() {
+  _nodes.clear();
+  _parent.clear();
+  _res.clear();
+  _cap.clear();
+  _load.clear();
+  _delay.clear();
 
-  from->set_is_update_load(true);
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    _ncap[i].clear();
+    _nload[i].clear();
+    _ndelay[i].clear();
+    _ures[i].clear();
+    _ldelay[i].clear();
+    _beta[i].clear();
+    _impulse[i].clear();
+  }
+}
 
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      updateLoad(from, &to);
+/**
+ * @brief flatten the rc tree from the root by dfs pre-order, the node is
+ * visited once, the edge to the visited node is loop and ignored.
+ *
+ * @param root
+ */
+void RctFlatTree::build(RctNode* root) {
+  clear();
+
+  auto add_node = [this](RctNode* node, int parent_id, double res) {
+    node->set_is_visited(true);
+    _nodes.push_back(node);
+    _parent.push_back(parent_id);
+    _res.push_back(res);
+    _cap.push_back(node->cap());
+
+    FOREACH_MODE_TRANS(mode, trans) {
+      _ncap[ModeTransToIndex(mode, trans)].push_back(node->cap(mode, trans));
+    }
+  };
 
-      from->_load += to._load;
+  add_node(root, -1, 0.0);
+  _dfs_stack.clear();
+  _dfs_stack.emplace_back(root, 0);
+
+  while (!_dfs_stack.empty()) {
+    auto [from, from_id] = _dfs_stack.back();
+    _dfs_stack.pop_back();
+
+    RctNode* parent = _parent[from_id] < 0 ? nullptr : _nodes[_parent[from_id]];
+    // push in reverse order, so the fanout is visited in the list order.
+    for (auto it = from->_fanout.rbegin(); it != from->_fanout.rend(); ++it) {
+      auto* e = *it;
+      auto& to = e->get_to();
+      if (&to == parent) {
+        continue;
+      }
 
-      FOREACH_MODE_TRANS(mode, trans) {
-        from->_nload[ModeTransPair(mode, trans)] +=
-            to._nload[ModeTransPair(mode, trans)];
+      if (to.isVisited()) {
+        LOG_ERROR << "found loop in rc tree " << to.get_name();
+        continue;
       }
+
+      int to_id = static_cast<int>(_nodes.size());
+      add_node(&to, from_id, e->get_res());
+      _dfs_stack.emplace_back(&to, to_id);
     }
   }
-  from->_load += from->cap();
 
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_nload[ModeTransPair(mode, trans)] += from->cap(mode, trans);
+  for (auto* node : _nodes) {
+    node->set_is_visited(false);
+  }
+
+  std::size_t num_nodes = _nodes.size();
+  _load.assign(num_nodes, 0.0);
+  _delay.assign(num_nodes, 0.0);
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    _nload[i].assign(num_nodes, 0.0);
+    _ndelay[i].assign(num_nodes, 0.0);
+    _ures[i].assign(num_nodes, 0.0);
+    _ldelay[i].assign(num_nodes, 0.0);
+    _beta[i].assign(num_nodes, 0.0);
+    _impulse[i].assign(num_nodes, 0.0);
   }
 }
+
 /**
- * @brief upadate the delay from net root to each node
+ * @brief calc the load, elmore delay, load delay and second moment response.
+ * The child id is bigger than the parent id, so the upstream accumulation
+ * sweep from the leaf to root, the downstream sweep from root to leaf.
  *
- * @param parent
- * @param from
  */
-void RcTree::updateDelay(RctNode* parent, RctNode* from) {
-  if (from->isUpdateDelay()) {
-    return;
+void RctFlatTree::updateMoments() {
+  int num_nodes = static_cast<int>(_nodes.size());
+
+  // update load, from leaf to root.
+  for (int id = num_nodes - 1; id >= 0; --id) {
+    _load[id] += _cap[id];
+    if (int parent_id = _parent[id]; parent_id >= 0) {
+      _load[parent_id] += _load[id];
+    }
   }
 
-  from->set_is_update_delay(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      to._delay = from->_delay + e->_res * to._load;
-
-      FOREACH_MODE_TRANS(mode, trans) {
-        to._ndelay[ModeTransPair(mode, trans)] =
-            from->_ndelay[ModeTransPair(mode, trans)] +
-            e->_res * to._nload[ModeTransPair(mode, trans)];
-
-        // Update the upstream resistance.
-        to._ures[ModeTransPair(mode, trans)] =
-            from->_ures[ModeTransPair(mode, trans)] + e->_res;
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    auto& ncap = _ncap[i];
+    auto& nload = _nload[i];
+    for (int id = num_nodes - 1; id >= 0; --id) {
+      nload[id] += ncap[id];
+      if (int parent_id = _parent[id]; parent_id >= 0) {
+        nload[parent_id] += nload[id];
       }
-      updateDelay(from, &to);
     }
   }
-}
 
-// Procedure: _update_ldelay
-// Compute the load delay of each rctree node along the downstream traversal of
-// the rctree.
-void RcTree::updateLDelay(RctNode* parent, RctNode* from) {
-  if (from->isUpdateLdelay()) {
-    return;
+  // update delay and upstream resistance, from root to leaf.
+  for (int id = 1; id < num_nodes; ++id) {
+    _delay[id] = _delay[_parent[id]] + _res[id] * _load[id];
   }
 
-  from->set_is_update_Ldelay(true);
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    auto& nload = _nload[i];
+    auto& ndelay = _ndelay[i];
+    auto& ures = _ures[i];
+    for (int id = 1; id < num_nodes; ++id) {
+      int parent_id = _parent[id];
+      ndelay[id] = ndelay[parent_id] + _res[id] * nload[id];
+      ures[id] = ures[parent_id] + _res[id];
+    }
+  }
 
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      updateLDelay(from, &to);
-      FOREACH_MODE_TRANS(mode, trans) {
-        from->_ldelay[ModeTransPair(mode, trans)] +=
-            to._ldelay[ModeTransPair(mode, trans)];
+  // update load delay, from leaf to root.
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    auto& ncap = _ncap[i];
+    auto& ndelay = _ndelay[i];
+    auto& ldelay = _ldelay[i];
+    for (int id = num_nodes - 1; id >= 0; --id) {
+      ldelay[id] += ncap[id] * ndelay[id];
+      if (int parent_id = _parent[id]; parent_id >= 0) {
+        ldelay[parent_id] += ldelay[id];
       }
     }
   }
 
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_ldelay[ModeTransPair(mode, trans)] +=
-        from->cap(mode, trans) * from->_ndelay[ModeTransPair(mode, trans)];
+  // update the impulse and second moment of the input response, from root to
+  // leaf.
+  for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+    auto& ndelay = _ndelay[i];
+    auto& ldelay = _ldelay[i];
+    auto& beta = _beta[i];
+    auto& impulse = _impulse[i];
+    for (int id = 0; id < num_nodes; ++id) {
+      if (int parent_id = _parent[id]; parent_id >= 0) {
+        beta[id] = beta[parent_id] + _res[id] * ldelay[id];
+      }
+      impulse[id] = 2.0 * beta[id] - std::pow(ndelay[id], 2);
+    }
   }
 }
 
-// Procedure: _update_response
-// Compute the impulse and second moment of the input response for each rctree
-// node.
-void RcTree::updateResponse(RctNode* parent, RctNode* from) {
-  if (from->isUpdateResponse()) {
-    return;
-  }
-
-  from->set_is_update_response(true);
-
-  for (auto* e : from->_fanout) {
-    if (auto& to = e->_to; &to != parent) {
-      FOREACH_MODE_TRANS(mode, trans) {
-        to._beta[ModeTransPair(mode, trans)] =
-            from->_beta[ModeTransPair(mode, trans)] +
-            e->_res * to._ldelay[ModeTransPair(mode, trans)];
-      }
-      updateResponse(from, &to);
+/**
+ * @brief write the moments back to the rc node.
+ *
+ */
+void RctFlatTree::writeBack() {
+  int num_nodes = static_cast<int>(_nodes.size());
+  for (int id = 0; id < num_nodes; ++id) {
+    auto* node = _nodes[id];
+    node->_load = _load[id];
+    node->_delay = _delay[id];
+    for (int i = 0; i < MODE_TRANS_SPLIT; ++i) {
+      node->_nload[i] = _nload[i][id];
+      node->_ndelay[i] = _ndelay[i][id];
+      node->_ures[i] = _ures[i][id];
+      node->_ldelay[i] = _ldelay[i][id];
+      node->_beta[i] = _beta[i][id];
+      node->_impulse[i] = _impulse[i][id];
     }
-  }
 
-  FOREACH_MODE_TRANS(mode, trans) {
-    from->_impulse[ModeTransPair(mode, trans)] =
-        2.0 * from->_beta[ModeTransPair(mode, trans)] -
-        std::pow(from->_ndelay[ModeTransPair(mode, trans)], 2);
+    node->_is_update_load = 1;
+    node->_is_update_delay = 1;
+    node->_is_update_ldelay = 1;
+    node->_is_update_response = 1;
   }
 }
 
@@ -346,7 +411,7 @@ double RcTree::delay(const std::string& name, AnalysisMode mode,
   if (itr == _str2nodes.end()) {
     LOG_FATAL << "RCTree node " << name << " can not found." << std::endl;
   }
-  return itr->second._ndelay[ModeTransPair(mode, trans_type)];
+  return itr->second._ndelay[ModeTransToIndex(mode, trans_type)];
 }
 
 double RcTree::slew(const std::string& name, AnalysisMode mode,
@@ -666,7 +731,7 @@ double RcNet::load(AnalysisMode mode, TransType trans_type) {
   } else {
     if (std::get<RcTree>(_rct)._root) {
       return std::get<RcTree>(_rct)
-          ._root->_nload[ModeTransPair(mode, trans_type)];
+          ._root->_nload[ModeTransToIndex(mode, trans_type)];
     } else {
       return 0.0;
     }
@@ -10,6 +10,7 @@
 
 #include <Eigen/Core>
 #include <algorithm>
+#include <array>
 #include <list>
 #include <map>
 #include <optional>
@@ -53,6 +54,7 @@ class RctNode {
   friend class RcTree;
   friend class RcNet;
   friend class ArnoldiNet;
+  friend class RctFlatTree;
 
  public:
   RctNode() = default;
@@ -66,13 +68,13 @@ class RctNode {
   double get_cap() const { return _cap; }
   double cap(AnalysisMode mode, TransType trans_type);
   double get_cap(AnalysisMode mode, TransType trans_type) {
-    return _ncap[ModeTransPair(mode, trans_type)];
+    return _ncap[ModeTransToIndex(mode, trans_type)];
   }
   void setCap(double cap);
   void incrCap(double cap);
 
   double get_ures(AnalysisMode mode, TransType trans_type) {
-    return _ures[ModeTransPair(mode, trans_type)];
+    return _ures[ModeTransToIndex(mode, trans_type)];
   }
 
   double delay() const { return _delay; }
@@ -141,13 +143,13 @@ class RctNode {
   unsigned _is_visited : 1;
   unsigned _reserved : 26;
 
-  std::map<ModeTransPair, double> _ures;
-  std::map<ModeTransPair, double> _nload;
-  std::map<ModeTransPair, double> _beta;
-  std::map<ModeTransPair, double> _ncap;
-  std::map<ModeTransPair, double> _ndelay;
-  std::map<ModeTransPair, double> _ldelay;
-  std::map<ModeTransPair, double> _impulse;
+  ModeTransArray _ures{};
+  ModeTransArray _nload{};
+  ModeTransArray _beta{};
+  ModeTransArray _ncap{};
+  ModeTransArray _ndelay{};
+  ModeTransArray _ldelay{};
+  ModeTransArray _impulse{};
 
   std::list<RctEdge*> _fanin;
   std::list<RctEdge*> _fanout;
@@ -251,6 +253,48 @@ class RctEdge {
   DISALLOW_COPY_AND_ASSIGN(RctEdge);
 };
 
+/**
+ * @brief The flattened rc tree for elmore moment computation, the nodes are
+ * stored in dfs pre-order with integer id, so the parent id is always less than
+ * the child id, the load and delay moments can be computed by two linear
+ * sweeps without recursion. The per mode trans value is stored in struct of
+ * arrays.
+ *
+ */
+class RctFlatTree {
+ public:
+  RctFlatTree() = default;
+  ~RctFlatTree() = default;
+
+  void build(RctNode* root);
+  void updateMoments();
+  void writeBack();
+
+  [[nodiscard]] std::size_t numNodes() const { return _nodes.size(); }
+
+ private:
+  void clear();
+
+  std::vector<RctNode*> _nodes;  //!< The rc node of the node id.
+  std::vector<int> _parent;      //!< The parent node id, -1 for root.
+  std::vector<double> _res;      //!< The res of the edge from parent.
+  std::vector<double> _cap;      //!< The node cap include pin cap.
+  std::vector<double> _load;
+  std::vector<double> _delay;
+
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _ncap;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _nload;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _ndelay;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _ures;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _ldelay;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _beta;
+  std::array<std::vector<double>, MODE_TRANS_SPLIT> _impulse;
+
+  std::vector<std::pair<RctNode*, int>> _dfs_stack;  //!< The dfs scratch.
+
+  DISALLOW_COPY_AND_ASSIGN(RctFlatTree);
+};
+
 /**
  * @brief The RC tree, consist of resistance, ground capacitance.
  *
@@ -312,39 +356,34 @@ class RcTree {
       fanout_edge->get_to().removeFanin(fanout_edge);
     }
 
-    auto it =
-        std::find_if(_str2nodes.begin(), _str2nodes.end(),
-                     [the_node](auto& it) { return &(it.second) == the_node; });
-    LOG_FATAL_IF(it == _str2nodes.end());
-    _str2nodes.erase(it);
-
     auto it1 =
         std::find_if(_edges.begin(), _edges.end(), [the_node](auto& edge) {
           return &(edge.get_from()) == the_node || &(edge.get_to()) == the_node;
         });
     LOG_FATAL_IF(it1 == _edges.end());
     _edges.erase(it1);
+
+    auto it = _str2nodes.find(the_node->get_name());
+    LOG_FATAL_IF(it == _str2nodes.end() || &(it->second) != the_node);
+    _str2nodes.erase(it);
   }
 
   std::optional<RctEdge*> findEdge(RctNode& from, RctNode& to) {
-    auto it = std::find_if(_edges.begin(), _edges.end(), [&](RctEdge& edge) {
-      return &from == &edge.get_from() && &to == &edge.get_to();
-    });
-    if (it != _edges.end()) {
-      return &(*it);
+    for (auto* edge : from.get_fanout()) {
+      if (&to == &edge->get_to()) {
+        return edge;
+      }
     }
     return std::nullopt;
   }
 
   std::optional<RctEdge*> findEdge(std::string from_name, std::string to_name) {
-    auto it = std::find_if(_edges.begin(), _edges.end(), [&](RctEdge& edge) {
-      return from_name == edge.get_from().get_name() &&
-             to_name == edge.get_to().get_name();
-    });
-    if (it != _edges.end()) {
-      return &(*it);
+    auto* from = node(from_name);
+    auto* to = node(to_name);
+    if (!from || !to) {
+      return std::nullopt;
     }
-    return std::nullopt;
+    return findEdge(*from, *to);
   }
 
   RctNode* node(const std::string&);
@@ -368,10 +407,6 @@ class RcTree {
   std::vector<CoupledRcNode> _coupled_nodes;
 
   void initData();
-  void updateLoad(RctNode*, RctNode*);
-  void updateDelay(RctNode*, RctNode*);
-  void updateLDelay(RctNode* parent, RctNode* from);
-  void updateResponse(RctNode* parent, RctNode* from);
 
   RctNode* rcNode(const std::string&);
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <cmath>
 #include <utility>
 
@@ -50,6 +51,21 @@ enum class ModeTransIndex : int {
 
 using ModeTransPair = std::pair<AnalysisMode, TransType>;
 
+/**
+ * @brief The fixed slot array of mode trans value, index by ModeTransIndex.
+ *
+ */
+using ModeTransArray = std::array<double, MODE_TRANS_SPLIT>;
+
+constexpr int ModeTransToIndex(AnalysisMode mode, TransType trans_type) {
+  return static_cast<int>(
+      (mode == AnalysisMode::kMax)
+          ? ((trans_type == TransType::kRise) ? ModeTransIndex::kMaxRise
+                                              : ModeTransIndex::kMaxFall)
+          : ((trans_type == TransType::kRise) ? ModeTransIndex::kMinRise
+                                              : ModeTransIndex::kMinFall));
+}
+
 #define FOREACH_MODE_TRANS(mode, trans) for (auto [mode, trans] : g_split_trans)
 
 #define NS_TO_FS(delay) ((delay) * static_cast<int64_t>(g_ns2fs))
@@ -29,11 +29,13 @@
 #include "StaDelayPropagation.hh"
 #include "StaDump.hh"
 #include "StaGraph.hh"
+#include "StaLevelPropagation.hh"
 #include "StaLevelization.hh"
 #include "StaPathData.hh"
 #include "StaReport.hh"
 #include "StaSlewPropagation.hh"
 #include "ThreadPool/ThreadPool.h"
+#include "delay/ArnoldiDelayCal.hh"
 #include "liberty/Liberty.hh"
 #include "log/Log.hh"
 #include "netlist/NetlistWriter.hh"
@@ -1114,9 +1116,42 @@ unsigned Sta::buildGraph() {
     the_graph.exec(func);
   }
 
+  resetLevelPropagation();
+
   return 1;
 }
 
+/**
+ * @brief Get the level propagation, the graph is levelized at the first
+ * propagation after the graph changed.
+ *
+ * @return StaLevelPropagation*
+ */
+StaLevelPropagation *Sta::getLevelPropagation() {
+  unsigned num_threads = std::max(_num_threads, 1U);
+  if (!_level_propagation ||
+      (_level_propagation->get_num_threads() != num_threads)) {
+    _level_propagation = std::make_unique<StaLevelPropagation>(num_threads);
+  }
+
+  if (!_level_propagation->isLevelized()) {
+    _level_propagation->levelize(&get_graph());
+  }
+
+  return _level_propagation.get();
+}
+
+/**
+ * @brief Clear the level buckets, which should be called when the graph
+ * changed.
+ *
+ */
+void Sta::resetLevelPropagation() {
+  if (_level_propagation) {
+    _level_propagation->reset();
+  }
+}
+
 /**
  * @brief Insert the seq path data.
  *
@@ -1145,6 +1180,26 @@ unsigned Sta::insertPathData(StaVertex *end_vertex,
   return 1;
 }
 
+/**
+ * @brief Remove the path data of the end vertex in all path groups, which is
+ * used by incremental analysis before the end vertex analyzed again.
+ *
+ * @param end_vertex
+ * @return unsigned return 1 if removed, else return 0.
+ */
+unsigned Sta::removePathData(StaVertex *end_vertex) {
+  unsigned is_removed = 0;
+  for (auto &[capture_clock, seq_path_group] : _clock_groups) {
+    is_removed |= seq_path_group->removePathEndData(end_vertex);
+  }
+
+  if (_clock_gate_group) {
+    is_removed |= _clock_gate_group->removePathEndData(end_vertex);
+  }
+
+  return is_removed;
+}
+
 /**
  * @brief set the report froms tos build tag.
  *
@@ -1925,6 +1980,103 @@ unsigned Sta::resetPathData() {
   return 1;
 }
 
+/**
+ * @brief Prepare the rc net reduce model of the analysis modes and trans
+ * types before the propagation, the model is independent of the driver slew,
+ * so the net delay calc in the propagation only need solve the model. The
+ * node voltage of the last update is cleared, for the driver current it keyed
+ * is freed.
+ *
+ * @param arnoldi_nets
+ * @return unsigned
+ */
+unsigned Sta::prepareRcNets(std::vector<ArnoldiNet*>& arnoldi_nets) {
+  if (arnoldi_nets.empty()) {
+    return 1;
+  }
+
+  std::vector<ModeTransPair> mode_trans_list;
+  FOREACH_MODE_TRANS(mode, trans) {
+    if ((mode == AnalysisMode::kMax && isMaxAnalysis()) ||
+        (mode == AnalysisMode::kMin && isMinAnalysis())) {
+      mode_trans_list.emplace_back(mode, trans);
+    }
+  }
+
+  auto prepare_nets = [&arnoldi_nets, &mode_trans_list](std::size_t begin,
+                                                        std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      arnoldi_nets[i]->resetNodeVoltageCache();
+      for (auto [mode, trans] : mode_trans_list) {
+        arnoldi_nets[i]->prepareRcEquation(mode, trans);
+      }
+    }
+  };
+
+  // the few nets of the incremental update is not worth to dispatch threads.
+  const std::size_t min_chunk_size = 64;
+  unsigned num_threads = get_num_threads() ? get_num_threads() : 1;
+  if ((num_threads == 1) || (arnoldi_nets.size() <= min_chunk_size)) {
+    prepare_nets(0, arnoldi_nets.size());
+    return 1;
+  }
+
+  {
+    std::size_t chunk_size =
+        std::max(min_chunk_size, arnoldi_nets.size() / (num_threads * 4) + 1);
+
+    ThreadPool pool(num_threads);
+    for (std::size_t begin = 0; begin < arnoldi_nets.size();
+         begin += chunk_size) {
+      std::size_t end = std::min(begin + chunk_size, arnoldi_nets.size());
+      pool.enqueue(prepare_nets, begin, end);
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Prepare the rc nets of the given nets, the net without arnoldi rc
+ * tree is skipped.
+ *
+ * @param nets
+ * @return unsigned
+ */
+unsigned Sta::prepareRcNets(const std::vector<Net*>& nets) {
+  std::vector<ArnoldiNet*> arnoldi_nets;
+  for (auto* net : nets) {
+    auto* arnoldi_net = dynamic_cast<ArnoldiNet*>(getRcNet(net));
+    if (arnoldi_net && arnoldi_net->rct() && arnoldi_net->rct()->get_root()) {
+      arnoldi_nets.push_back(arnoldi_net);
+    }
+  }
+
+  return prepareRcNets(arnoldi_nets);
+}
+
+/**
+ * @brief Prepare the rc nets of all nets.
+ *
+ * @return unsigned
+ */
+unsigned Sta::prepareRcNets() {
+  LOG_INFO << "prepare rc net start";
+
+  std::vector<ArnoldiNet*> arnoldi_nets;
+  for (auto& [net, rc_net] : _net_to_rc_net) {
+    auto* arnoldi_net = dynamic_cast<ArnoldiNet*>(rc_net.get());
+    if (arnoldi_net && arnoldi_net->rct() && arnoldi_net->rct()->get_root()) {
+      arnoldi_nets.push_back(arnoldi_net);
+    }
+  }
+  unsigned is_ok = prepareRcNets(arnoldi_nets);
+
+  LOG_INFO << "prepare rc net end";
+
+  return is_ok;
+}
+
 /**
  * @brief update the timing data.
  *
@@ -1936,6 +2088,7 @@ unsigned Sta::updateTiming() {
   resetSdcConstrain();
   resetGraphData();
   resetPathData();
+  prepareRcNets();
 
   StaGraph &the_graph = get_graph();
 
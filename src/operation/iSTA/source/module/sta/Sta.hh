@@ -34,6 +34,8 @@
 namespace ista {
 
 class SdcConstrain;
+class StaLevelPropagation;
+class ArnoldiNet;
 
 constexpr int g_global_derate_num = 8;
 
@@ -147,6 +149,13 @@ class Sta {
   void set_num_threads(unsigned num_thread) { _num_threads = num_thread; }
   [[nodiscard]] unsigned get_num_threads() const { return _num_threads; }
 
+  void set_is_level_propagation(bool is_level_prop) {
+    _is_level_propagation = is_level_prop;
+  }
+  [[nodiscard]] bool isLevelPropagation() const {
+    return _is_level_propagation;
+  }
+
   void set_n_worst_path_per_clock(unsigned n_worst) {
     _n_worst_path_per_clock = n_worst;
   }
@@ -326,10 +335,16 @@ class Sta {
   auto& getMaxFanout() { return _max_fanout; }
 
   unsigned buildGraph();
-  void resetGraph() { _graph.reset(); }
+  void resetGraph() {
+    _graph.reset();
+    resetLevelPropagation();
+  }
   StaGraph& get_graph() { return _graph; }
   bool isBuildGraph() { return !_graph.get_vertexes().empty(); }
 
+  StaLevelPropagation* getLevelPropagation();
+  void resetLevelPropagation();
+
   StaVertex* findVertex(const char* pin_name);
   StaVertex* findVertex(DesignObject* obj) {
     auto the_vertex = _graph.findVertex(obj);
@@ -349,6 +364,7 @@ class Sta {
                           StaSeqPathData* seq_data);
   unsigned insertPathData(StaVertex* end_vertex,
                           StaClockGatePathData* seq_data);
+  unsigned removePathData(StaVertex* end_vertex);
 
   std::unique_ptr<StaReportTable>& get_report_tbl_summary() {
     return _report_tbl_summary;
@@ -431,6 +447,8 @@ class Sta {
 
   unsigned resetGraphData();
   unsigned resetPathData();
+  unsigned prepareRcNets(const std::vector<Net*>& nets);
+  unsigned prepareRcNets();
   unsigned updateTiming();
   unsigned reportTiming(std::set<std::string>&& exclude_cell_names = {},
                         bool is_derate = true, bool is_clock_cap = false);
@@ -446,9 +464,15 @@ class Sta {
   Sta();
   ~Sta();
 
+  unsigned prepareRcNets(std::vector<ArnoldiNet*>& arnoldi_nets);
+
   std::string _design_work_space;
 
   unsigned _num_threads = 48;  //!< The num of thread for propagation.
+  bool _is_level_propagation =
+      false;  //!< Whether propagate level by level instead of dfs.
+  std::unique_ptr<StaLevelPropagation>
+      _level_propagation;  //!< The level buckets, rebuilt when graph changed.
   unsigned _n_worst_path_per_clock =
       3;  //!< The top n worst path config for each clock.
   unsigned _n_worst_path_per_endpoint = 1;    //!< The top n worst path
@@ -489,6 +489,27 @@ unsigned StaAnalyze::analyzeClockGateCheck(StaVertex* end_vertex,
   return is_ok;
 }
 
+/**
+ * @brief Analyze the end vertex accord the end type.
+ *
+ * @param end_vertex
+ * @param analysis_mode
+ * @return unsigned
+ */
+unsigned StaAnalyze::analyzeEndVertex(StaVertex* end_vertex,
+                                      AnalysisMode analysis_mode) {
+  if (end_vertex->is_port()) {
+    return analyzePortSetupHold(end_vertex, analysis_mode);
+  }
+
+  StaArc* check_arc = end_vertex->getCheckArc(analysis_mode);
+  if (end_vertex->is_end() && end_vertex->is_clock_gate_end()) {
+    return analyzeClockGateCheck(end_vertex, check_arc, analysis_mode);
+  }
+
+  return analyzeSetupHold(end_vertex, check_arc, analysis_mode);
+}
+
 /**
  * @brief Analyze the end vertex to do timing constrain check.
  *
@@ -499,33 +520,27 @@ unsigned StaAnalyze::operator()(StaGraph* the_graph) {
   LOG_INFO << "analyze timing path start";
 
   AnalysisMode analysis_mode = get_analysis_mode();
-  StaVertex* end_vertex;
   unsigned is_ok = 1;
-  FOREACH_END_VERTEX(the_graph, end_vertex) {
+  auto analyze_end_vertex = [this, analysis_mode,
+                             &is_ok](StaVertex* end_vertex) {
     if (IS_MAX(analysis_mode)) {
-      if (end_vertex->is_port()) {
-        is_ok &= analyzePortSetupHold(end_vertex, AnalysisMode::kMax);
-      } else if (end_vertex->is_end() && end_vertex->is_clock_gate_end()) {
-        StaArc* check_arc = end_vertex->getCheckArc(AnalysisMode::kMax);
-        is_ok &=
-            analyzeClockGateCheck(end_vertex, check_arc, AnalysisMode::kMax);
-      } else {
-        StaArc* check_arc = end_vertex->getCheckArc(AnalysisMode::kMax);
-        is_ok &= analyzeSetupHold(end_vertex, check_arc, AnalysisMode::kMax);
-      }
+      is_ok &= analyzeEndVertex(end_vertex, AnalysisMode::kMax);
     }
 
     if (IS_MIN(analysis_mode)) {
-      if (end_vertex->is_port()) {
-        is_ok &= analyzePortSetupHold(end_vertex, AnalysisMode::kMin);
-      } else if (end_vertex->is_end() && end_vertex->is_clock_gate_end()) {
-        StaArc* check_arc = end_vertex->getCheckArc(AnalysisMode::kMin);
-        is_ok &=
-            analyzeClockGateCheck(end_vertex, check_arc, AnalysisMode::kMin);
-      } else {
-        StaArc* check_arc = end_vertex->getCheckArc(AnalysisMode::kMin);
-        is_ok &= analyzeSetupHold(end_vertex, check_arc, AnalysisMode::kMin);
-      }
+      is_ok &= analyzeEndVertex(end_vertex, AnalysisMode::kMin);
+    }
+  };
+
+  if (_is_analyze_part_end) {
+    // incremental analysis only the end vertex of the changed cone.
+    for (auto* end_vertex : _end_vertexes) {
+      analyze_end_vertex(end_vertex);
+    }
+  } else {
+    StaVertex* end_vertex;
+    FOREACH_END_VERTEX(the_graph, end_vertex) {
+      analyze_end_vertex(end_vertex);
     }
   }
 
@@ -23,9 +23,16 @@ namespace ista {
  */
 class StaAnalyze : public StaFunc {
  public:
+  StaAnalyze() = default;
+  explicit StaAnalyze(std::vector<StaVertex*>&& end_vertexes)
+      : _end_vertexes(std::move(end_vertexes)),
+        _is_analyze_part_end(true) {}
+  ~StaAnalyze() override = default;
+
   unsigned operator()(StaGraph* the_graph) override;
 
  private:
+  unsigned analyzeEndVertex(StaVertex* end_vertex, AnalysisMode analysis_mode);
   StaClockPair analyzeClockRelation(StaClockData* launch_clock_data,
                                     StaClockData* capture_clock_data);
   unsigned analyzeSetupHold(StaVertex* end_vertex, StaArc* check_arc,
@@ -34,6 +41,10 @@ class StaAnalyze : public StaFunc {
                                 AnalysisMode analysis_mode);
   unsigned analyzeClockGateCheck(StaVertex* end_vertex, StaArc* check_arc,
                                  AnalysisMode analysis_mode);
+
+  std::vector<StaVertex*>
+      _end_vertexes;  //!< The end vertexes to be analyzed for incremental.
+  bool _is_analyze_part_end = false;  //!< Whether only analyze _end_vertexes.
 };
 
 }  // namespace ista
@@ -12,7 +12,6 @@
 #include <string>
 #include <utility>
 
-#include "ThreadPool/ThreadPool.h"
 #include "delay/ArnoldiDelayCal.hh"
 #include "delay/ElmoreDelayCalc.hh"
 #include "log/Log.hh"
@@ -55,19 +54,15 @@ unsigned StaBuildRCTree::operator()(StaGraph* the_graph) {
   Netlist* design_nl = the_graph->get_nl();
 
   LOG_INFO << "read spef " << _spef_file_name << " start";
+  // The spef is read by streaming, the net is parsed by chunk in parallel,
+  // and the rc tree is built directly when the net parsed, so the whole spef
+  // nets need not be kept in memory.
   spef::Spef parser;
-  if (!parser.read(_spef_file_name)) {
-    LOG_FATAL << "Parse the spef file error.";
+  if (!parser.read_header(_spef_file_name)) {
+    LOG_FATAL << "Parse the spef file header error.";
     return 0;
   }
 
-  LOG_INFO << "read spef " << _spef_file_name << " end";
-
-  LOG_INFO << "expand spef name start";
-  unsigned num_threads = getNumThreads();
-  parser.expand_name(num_threads);
-  LOG_INFO << "expand spef name end";
-
   auto rc_net_common_info = std::make_unique<RCNetCommonInfo>();
   rc_net_common_info->set_spef_cap_unit(parser.capacitance_unit);
   rc_net_common_info->set_spef_resistance_unit(parser.resistance_unit);
@@ -86,47 +81,23 @@ unsigned StaBuildRCTree::operator()(StaGraph* the_graph) {
   }
 
   // rc net update timing information.
-  auto& spef_nets = parser.getNets();
-
-#if 1
-  {
-    ThreadPool pool(num_threads);
-
-    for (const auto& spef_net : spef_nets) {
-      // enqueue and store future
-      pool.enqueue(
-          [design_nl, this](const auto& spef_net) {
-            auto spef_name = spef_net.name;
-            auto* design_net = design_nl->findNet(spef_name.c_str());
-            if (design_net) {
-              auto* rc_net = getSta()->getRcNet(design_net);
-              // DLOG_INFO << "Update Rc tree timing " << spef_name;
-              rc_net->updateRcTiming(spef_net);
-            } else {
-              LOG_FATAL << "build rc tree not found design net " << spef_name;
-            }
-          },
-          spef_net);
-    }
-  }
-#else
-
-  std::for_each(std::begin(spef_nets), std::end(spef_nets),
-                [design_nl, this](const auto& spef_net) {
-                  auto spef_name = spef_net.name;
-                  auto* design_net = design_nl->findNet(spef_name.c_str());
-                  if (design_net) {
-                    auto* rc_net = getSta()->getRcNet(design_net);
-                    // DLOG_INFO << "Update Rc tree timing " << spef_name;
-                    rc_net->updateRcTiming(spef_net);
-                    // printYaml(spef_net);
-                  } else {
-                    LOG_FATAL << "build rc tree not found design net "
-                              << spef_name;
-                  }
-                });
-
-#endif
+  unsigned num_threads = getNumThreads();
+  is_ok = parser.read_nets(
+      num_threads, [design_nl, this](const spef::Net& spef_net) {
+        auto& spef_name = spef_net.name;
+        auto* design_net = design_nl->findNet(spef_name.c_str());
+        if (design_net) {
+          auto* rc_net = getSta()->getRcNet(design_net);
+          // DLOG_INFO << "Update Rc tree timing " << spef_name;
+          rc_net->updateRcTiming(spef_net);
+        } else {
+          LOG_FATAL << "build rc tree not found design net " << spef_name;
+        }
+      });
+
+  LOG_FATAL_IF(!is_ok) << "Parse the spef file error.";
+
+  LOG_INFO << "read spef " << _spef_file_name << " end";
 
   // ProfilerStop();
 
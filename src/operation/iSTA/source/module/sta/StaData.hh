@@ -69,6 +69,7 @@ class StaData {
     return 0;
   }
   virtual void set_req_time(int req_time) { LOG_FATAL << "not implemented"; }
+  virtual void reset_req_time() { LOG_FATAL << "not implemented"; }
 
   virtual void incrArriveTime(int delta) { LOG_FATAL << "not implemented"; }
   AnalysisMode get_delay_type() const { return _delay_type; }
@@ -263,6 +264,7 @@ class StaPathDelayData : public StaData {
   unsigned isPathDelayData() const override { return 1; }
   std::optional<int> get_req_time() const override { return _req_time; }
   void set_req_time(int req_time) override { _req_time = req_time; }
+  void reset_req_time() override { _req_time = std::nullopt; }
 
   StaClockData* get_launch_clock_data() const { return _launch_clock_data; }
 
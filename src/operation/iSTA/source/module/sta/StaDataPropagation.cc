@@ -10,6 +10,7 @@
 #include "StaDataPropagation.hh"
 
 #include "StaData.hh"
+#include "StaLevelPropagation.hh"
 #include "StaVertex.hh"
 #include "ThreadPool/ThreadPool.h"
 #include "log/Log.hh"
@@ -420,7 +421,9 @@ unsigned StaFwdPropagation::operator()(StaArc* the_arc) {
       if (the_arc->isNegativeArc()) {
         trans_type = FLIP_TRANS(trans_type);
       }
-      next_data1 = src_vertex->getPathDelayData(delay_data->get_delay_type(),
+      // the data of the snk vertex is found by the launch data, which keep
+      // the same launch clock.
+      next_data1 = snk_vertex->getPathDelayData(delay_data->get_delay_type(),
                                                 trans_type, delay_data);
     }
 
@@ -453,7 +456,7 @@ unsigned StaFwdPropagation::operator()(StaArc* the_arc) {
       if (isIncremental()) {
         auto trans_type = delay_data->get_trans_type();
         trans_type = FLIP_TRANS(trans_type);
-        next_data2 = src_vertex->getPathDelayData(delay_data->get_delay_type(),
+        next_data2 = snk_vertex->getPathDelayData(delay_data->get_delay_type(),
                                                   trans_type, delay_data);
       }
 
@@ -553,6 +556,40 @@ unsigned StaDataPropagation::operator()(StaGraph* the_graph) {
   auto* ista = getSta();
 
   unsigned num_threads = getNumThreads();
+  if (isLevelPropagation()) {
+    auto* level_propagation = ista->getLevelPropagation();
+
+    if ((_prop_type == PropType::kFwdProp) ||
+        (_prop_type == PropType::kIncrFwdProp)) {
+      LOG_INFO << "data fwd level propagation start";
+      StaFwdPropagation fwd_propagation;
+      if (_prop_type == PropType::kIncrFwdProp) {
+        fwd_propagation.set_is_incremental();
+      }
+
+      is_ok = level_propagation->propagateFwd(
+          fwd_propagation, [](StaVertex* the_vertex) -> bool {
+            return the_vertex->get_prop_tag().is_prop();
+          });
+      LOG_INFO << "data fwd level propagation end";
+    } else {
+      LOG_INFO << "data bwd level propagation start";
+      StaBwdPropagation bwd_propagation;
+      is_ok = level_propagation->propagateBwd(
+          bwd_propagation, [ista](StaVertex* the_vertex) -> bool {
+            // not constrained port not propagation.
+            if (the_vertex->is_start()) {
+              return !(the_vertex->is_port() &&
+                       ista->getIODelayConstrain(the_vertex).empty());
+            }
+            return the_vertex->get_prop_tag().is_prop();
+          });
+      LOG_INFO << "data bwd level propagation end";
+    }
+
+    return is_ok;
+  }
+
   if ((_prop_type == PropType::kFwdProp) ||
       (_prop_type == PropType::kIncrFwdProp)) {
     LOG_INFO << "data fwd propagation start";
@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "StaArc.hh"
+#include "StaLevelPropagation.hh"
 #include "ThreadPool/ThreadPool.h"
 #include "Type.hh"
 #include "delay/ArnoldiDelayCal.hh"
@@ -246,6 +247,19 @@ unsigned StaDelayPropagation::operator()(StaVertex* the_vertex) {
 unsigned StaDelayPropagation::operator()(StaGraph* the_graph) {
   LOG_INFO << "delay propagation start";
   unsigned is_ok = 1;
+
+  if (isLevelPropagation()) {
+    // the vertex without snk arcs is propagated by the fanout vertex.
+    auto* level_propagation = getSta()->getLevelPropagation();
+    is_ok = level_propagation->propagateFwd(
+        *this, [](StaVertex* the_vertex) -> bool {
+          return !the_vertex->get_snk_arcs().empty();
+        });
+
+    LOG_INFO << "delay propagation end";
+    return is_ok;
+  }
+
   
   {
 #if 1
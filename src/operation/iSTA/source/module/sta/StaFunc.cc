@@ -42,6 +42,7 @@ unsigned StaFunc::operator()(StaClock* /* the_clock */) {
 
 AnalysisMode StaFunc::get_analysis_mode() { return _ista->get_analysis_mode(); }
 unsigned StaFunc::getNumThreads() { return _ista->get_num_threads(); }
+bool StaFunc::isLevelPropagation() { return _ista->isLevelPropagation(); }
 
 /**
  * @brief Print the timing path record for debug.
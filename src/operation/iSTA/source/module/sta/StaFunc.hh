@@ -36,6 +36,7 @@ class StaFunc {
 
   virtual AnalysisMode get_analysis_mode();
   unsigned getNumThreads();
+  bool isLevelPropagation();
   Sta* getSta() { return _ista; }
 
   void set_is_trace_path() { _is_trace_path = true; }
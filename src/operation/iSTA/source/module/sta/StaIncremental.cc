@@ -18,7 +18,8 @@
 
 namespace ista {
 
-StaIncremental::StaIncremental() : _fwd_queue(cmp), _bwd_queue(cmp) {}
+StaIncremental::StaIncremental()
+    : _fwd_queue(fwd_cmp), _bwd_queue(bwd_cmp) {}
 
 /**
  * @brief propagate the slew from the vertex to its fanout.
@@ -76,18 +77,126 @@ unsigned StaIncremental::propagateRT(StaVertex* the_vertex) {
  * @brief insert the vertex to fwd propagation queue.
  *
  * @param the_vertex
+ * @return true if the vertex is inserted first time.
  */
-void StaIncremental::insertFwdQueue(StaVertex* the_vertex) {
+bool StaIncremental::insertFwdQueue(StaVertex* the_vertex) {
+  if (!_fwd_cone_vertexes.insert(the_vertex).second) {
+    return false;
+  }
   _fwd_queue.push(the_vertex);
+  return true;
 }
 
 /**
  * @brief insert the vertex to bwd propagation queue.
  *
  * @param the_vertex
+ * @return true if the vertex is inserted first time.
  */
-void StaIncremental::insertBwdQueue(StaVertex* the_vertex) {
+bool StaIncremental::insertBwdQueue(StaVertex* the_vertex) {
+  if (!_bwd_cone_vertexes.insert(the_vertex).second) {
+    return false;
+  }
   _bwd_queue.push(the_vertex);
+  return true;
+}
+
+/**
+ * @brief reset the fwd cone of the vertex, the vertex of the cone is inserted
+ * to the fwd queue.
+ *
+ * @param the_vertex
+ * @param max_level the level beyond which not reset, nullopt for all.
+ * @return unsigned
+ */
+unsigned StaIncremental::resetFwdCone(StaVertex* the_vertex,
+                                      std::optional<unsigned> max_level) {
+  StaResetPropagation reset_fwd_prop;
+  reset_fwd_prop.set_incr_func(this);
+  reset_fwd_prop.set_max_min_level(max_level);
+  return the_vertex->exec(reset_fwd_prop);
+}
+
+/**
+ * @brief reset the bwd cone of the vertex, the vertex of the cone is inserted
+ * to the bwd queue.
+ *
+ * @param the_vertex
+ * @param min_level the level below which not reset, nullopt for all.
+ * @return unsigned
+ */
+unsigned StaIncremental::resetBwdCone(StaVertex* the_vertex,
+                                      std::optional<unsigned> min_level) {
+  StaResetPropagation reset_bwd_prop;
+  reset_bwd_prop.set_is_bwd();
+  reset_bwd_prop.set_incr_func(this);
+  reset_bwd_prop.set_max_min_level(min_level);
+  return the_vertex->exec(reset_bwd_prop);
+}
+
+/**
+ * @brief reset the fwd cone of the recorded dirty vertexes.
+ *
+ * @return unsigned
+ */
+unsigned StaIncremental::resetDirtyFwdCone() {
+  unsigned is_ok = 1;
+  for (auto* dirty_vertex : _dirty_vertexes) {
+    is_ok &= resetFwdCone(dirty_vertex);
+  }
+  _dirty_vertexes.clear();
+  return is_ok;
+}
+
+/**
+ * @brief the require time of the fwd cone and its fanin cone need be updated,
+ * reset the bwd cone of the fwd cone vertexes.
+ *
+ * @return unsigned
+ */
+unsigned StaIncremental::resetBwdConeOfFwdCone() {
+  unsigned is_ok = 1;
+  for (auto* fwd_vertex : _fwd_cone_vertexes) {
+    is_ok &= resetBwdCone(fwd_vertex);
+  }
+  return is_ok;
+}
+
+/**
+ * @brief get the nets driven by the fwd cone vertexes, whose driver slew and
+ * current are propagated again.
+ *
+ * @return std::vector<Net*>
+ */
+std::vector<Net*> StaIncremental::getFwdConeDriverNets() {
+  std::vector<Net*> driver_nets;
+  for (auto* fwd_vertex : _fwd_cone_vertexes) {
+    auto* obj = fwd_vertex->get_design_obj();
+    auto* net = obj->get_net();
+    if (net && (net->getDriver() == obj)) {
+      driver_nets.push_back(net);
+    }
+  }
+  return driver_nets;
+}
+
+/**
+ * @brief get the end vertexes of the fwd cone, whose path data need be
+ * analyzed again.
+ *
+ * @param the_graph
+ * @return std::vector<StaVertex*>
+ */
+std::vector<StaVertex*> StaIncremental::getFwdConeEndVertexes(
+    StaGraph* the_graph) {
+  auto& graph_end_vertexes = the_graph->get_end_vertexes();
+  std::vector<StaVertex*> end_vertexes;
+  for (auto* fwd_vertex : _fwd_cone_vertexes) {
+    if (graph_end_vertexes.count(fwd_vertex)) {
+      end_vertexes.push_back(fwd_vertex);
+    }
+  }
+  return end_vertexes;
 }
 
 /**
@@ -125,8 +234,8 @@ unsigned StaIncremental::applyFwdQueue() {
 unsigned StaIncremental::applyBwdQueue() {
   unsigned is_ok = 1;
 
-  while (!_fwd_queue.empty()) {
-    auto* the_vertex = _fwd_queue.top();
+  while (!_bwd_queue.empty()) {
+    auto* the_vertex = _bwd_queue.top();
 
     // need to parallel execute the follow task.
     is_ok &= propagateRT(the_vertex);
@@ -135,12 +244,28 @@ unsigned StaIncremental::applyBwdQueue() {
       break;
     }
 
-    _fwd_queue.pop();
+    _bwd_queue.pop();
   }
 
   return is_ok;
 }
 
+/**
+ * @brief clear the dirty vertexes and the cone of last incremental update.
+ *
+ */
+void StaIncremental::resetIncrData() {
+  while (!_fwd_queue.empty()) {
+    _fwd_queue.pop();
+  }
+  while (!_bwd_queue.empty()) {
+    _bwd_queue.pop();
+  }
+  _dirty_vertexes.clear();
+  _fwd_cone_vertexes.clear();
+  _bwd_cone_vertexes.clear();
+}
+
 /**
  * @brief reset the vertex propgagation.
  *
@@ -148,23 +273,59 @@ unsigned StaIncremental::applyBwdQueue() {
  * @return unsigned
  */
 unsigned StaResetPropagation::operator()(StaVertex* the_vertex) {
-  std::lock_guard<std::mutex> lk(the_vertex->get_fwd_mutex());
   if (beyondLevel(the_vertex->get_level())) {
     return 1;
   }
 
   LOG_FATAL_IF(!_incr_func) << "incr_func is nullptr";
   if (_is_fwd) {
+    // the vertex has been reset, so has its fanout cone, the check is before
+    // lock for the loop.
+    if (!_incr_func->insertFwdQueue(the_vertex)) {
+      return 1;
+    }
+
+    std::lock_guard<std::mutex> lk(the_vertex->get_fwd_mutex());
+
     the_vertex->reset_is_slew_prop();
     the_vertex->reset_is_delay_prop();
     the_vertex->reset_is_fwd();
 
-    _incr_func->insertFwdQueue(the_vertex);
+    // the arrive time is recalculated from the fanin, the whole fanout cone is
+    // reset too, so the stale data is removed and created again. The level
+    // limited reset keep the data, which is updated in place, for the fanout
+    // beyond the level still refer to it.
+    if (!_max_min_level && !the_vertex->is_start()) {
+      StaData* delay_data;
+      FOREACH_DELAY_DATA(the_vertex, delay_data) {
+        if (auto* bwd_data = delay_data->get_bwd(); bwd_data) {
+          bwd_data->erase_fwd(delay_data);
+        }
+        for (auto* fwd_data : delay_data->get_fwd_set()) {
+          fwd_data->set_bwd(nullptr);
+        }
+      }
+      the_vertex->resetPathDelayBucket();
+    }
 
     FOREACH_SRC_ARC(the_vertex, src_arc) { src_arc->exec(*this); }
   } else {
+    if (!_incr_func->insertBwdQueue(the_vertex)) {
+      return 1;
+    }
+
+    std::lock_guard<std::mutex> lk(the_vertex->get_bwd_mutex());
     the_vertex->reset_is_bwd();
-    _incr_func->insertBwdQueue(the_vertex);
+
+    // the require time is the min(max) of the fanout, recalculate from none.
+    StaData* delay_data;
+    FOREACH_DELAY_DATA(the_vertex, delay_data) { delay_data->reset_req_time(); }
+
+    // the start vertex require time is not propagated to the clock path.
+    if (the_vertex->is_start()) {
+      return 1;
+    }
+
     FOREACH_SNK_ARC(the_vertex, snk_arc) { snk_arc->exec(*this); }
   }
 
@@ -11,9 +11,13 @@
 
 #pragma once
 
+#include <optional>
 #include <queue>
+#include <unordered_set>
+#include <vector>
 
 #include "StaFunc.hh"
+#include "StaGraph.hh"
 #include "StaVertex.hh"
 
 namespace ista {
@@ -21,13 +25,25 @@ namespace ista {
 /**
  * @brief The top class for incremental static timing analysis.
  *
+ * The netlist or parasitic change only record the dirty vertex, the fwd cone
+ * and bwd cone of the dirty vertexes are reset and repropagated when
+ * incremental update timing, the vertex out of the cone keep the timing data.
  */
 class StaIncremental {
  public:
   StaIncremental();
   ~StaIncremental() = default;
 
-  const std::function<bool(StaVertex*, StaVertex*)> cmp =
+  // the fwd queue pop the low level first, fanin is updated before fanout.
+  const std::function<bool(StaVertex*, StaVertex*)> fwd_cmp =
+      [](StaVertex* left, StaVertex* right) -> bool {
+    unsigned left_level = left->get_level();
+    unsigned right_level = right->get_level();
+    return left_level > right_level;
+  };
+
+  // the bwd queue pop the high level first, fanout is updated before fanin.
+  const std::function<bool(StaVertex*, StaVertex*)> bwd_cmp =
       [](StaVertex* left, StaVertex* right) -> bool {
     unsigned left_level = left->get_level();
     unsigned right_level = right->get_level();
@@ -39,17 +55,43 @@ class StaIncremental {
   unsigned propagateAT(StaVertex* the_vertex);
   unsigned propagateRT(StaVertex* the_vertex);
 
-  void insertFwdQueue(StaVertex* the_vertex);
-  void insertBwdQueue(StaVertex* the_vertex);
+  bool insertFwdQueue(StaVertex* the_vertex);
+  bool insertBwdQueue(StaVertex* the_vertex);
+
+  void addDirtyVertex(StaVertex* the_vertex) {
+    _dirty_vertexes.insert(the_vertex);
+  }
+  void removeDirtyVertex(StaVertex* the_vertex) {
+    _dirty_vertexes.erase(the_vertex);
+  }
+
+  unsigned resetFwdCone(StaVertex* the_vertex,
+                        std::optional<unsigned> max_level = std::nullopt);
+  unsigned resetBwdCone(StaVertex* the_vertex,
+                        std::optional<unsigned> min_level = std::nullopt);
+  unsigned resetDirtyFwdCone();
+  unsigned resetBwdConeOfFwdCone();
+
+  std::vector<StaVertex*> getFwdConeEndVertexes(StaGraph* the_graph);
+  std::vector<Net*> getFwdConeDriverNets();
 
   unsigned applyFwdQueue();
   unsigned applyBwdQueue();
 
+  void resetIncrData();
+
  private:
-  std::priority_queue<StaVertex*, std::vector<StaVertex*>, decltype(cmp)>
+  std::priority_queue<StaVertex*, std::vector<StaVertex*>, decltype(fwd_cmp)>
       _fwd_queue;
-  std::priority_queue<StaVertex*, std::vector<StaVertex*>, decltype(cmp)>
+  std::priority_queue<StaVertex*, std::vector<StaVertex*>, decltype(bwd_cmp)>
       _bwd_queue;
+
+  std::unordered_set<StaVertex*>
+      _dirty_vertexes;  //!< The changed vertexes not reset yet.
+  std::unordered_set<StaVertex*>
+      _fwd_cone_vertexes;  //!< The vertexes reset in fwd cone.
+  std::unordered_set<StaVertex*>
+      _bwd_cone_vertexes;  //!< The vertexes reset in bwd cone.
 };
 
 /**
@@ -65,7 +107,7 @@ class StaResetPropagation : public StaFunc {
   void set_is_bwd() { _is_fwd = false; }
 
   void set_incr_func(StaIncremental* incr_func) { _incr_func = incr_func; }
-  void set_max_min_level(unsigned max_min_level) {
+  void set_max_min_level(std::optional<unsigned> max_min_level) {
     _max_min_level = max_min_level;
   }
   bool beyondLevel(unsigned level) {
@@ -0,0 +1,156 @@
+/**
+ * @file StaLevelPropagation.cc
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The implemention of level synchronous propagation.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+
+#include "StaLevelPropagation.hh"
+
+#include <future>
+
+#include "StaLevelization.hh"
+#include "ThreadPool/ThreadPool.h"
+#include "log/Log.hh"
+
+namespace ista {
+
+StaLevelPropagation::StaLevelPropagation(unsigned num_threads)
+    : _num_threads(num_threads ? num_threads : 1) {
+  if (_num_threads > 1) {
+    _pool = std::make_unique<ThreadPool>(_num_threads);
+  }
+}
+
+StaLevelPropagation::~StaLevelPropagation() = default;
+
+/**
+ * @brief Bucket the vertexes by the level of StaLevelization, the level of
+ * the vertex is larger than all its fanin vertexes. The vertex not in the
+ * fanin cone of the end vertexes has no level, which is not propagated by the
+ * dfs propagation either.
+ *
+ * @param the_graph
+ * @return unsigned return 1 if success, else return 0.
+ */
+unsigned StaLevelPropagation::levelize(StaGraph* the_graph) {
+  _level_vertexes.clear();
+
+  StaLevelization levelization;
+  levelization(the_graph);
+
+  auto add_vertex = [this](StaVertex* vertex) {
+    unsigned level = vertex->get_level();
+    if (level == 0) {
+      return;
+    }
+    if (_level_vertexes.size() < level) {
+      _level_vertexes.resize(level);
+    }
+    _level_vertexes[level - 1].push_back(vertex);
+  };
+
+  StaVertex* the_vertex;
+  FOREACH_VERTEX(the_graph, the_vertex) { add_vertex(the_vertex); }
+  FOREACH_ASSISTANT_VERTEX(the_graph, assistant) {
+    add_vertex(assistant.get());
+  }
+
+  _is_levelized = true;
+  LOG_INFO << "levelize graph " << numLevel() << " levels";
+
+  return 1;
+}
+
+/**
+ * @brief Propagate the vertexes of one level in parallel, the vertexes are
+ * splitted to chunks, one chunk for one task.
+ *
+ * @param func
+ * @param vertexes
+ * @param is_need_prop
+ * @return unsigned return 1 if success, else return 0.
+ */
+unsigned StaLevelPropagation::propagateLevel(
+    StaFunc& func, std::vector<StaVertex*>& vertexes,
+    std::function<bool(StaVertex*)>& is_need_prop) {
+  // small level is not worth to dispatch threads.
+  const std::size_t min_chunk_size = 64;
+  if (!_pool || (vertexes.size() <= min_chunk_size)) {
+    unsigned is_ok = 1;
+    for (auto* vertex : vertexes) {
+      if (is_need_prop(vertex)) {
+        is_ok &= vertex->exec(func);
+      }
+    }
+    return is_ok;
+  }
+
+  std::size_t chunk_size =
+      std::max(min_chunk_size, vertexes.size() / (_num_threads * 4) + 1);
+
+  auto prop_chunk = [&func, &vertexes, &is_need_prop](
+                        std::size_t begin, std::size_t end) -> unsigned {
+    unsigned is_ok = 1;
+    for (std::size_t i = begin; i < end; ++i) {
+      auto* vertex = vertexes[i];
+      if (is_need_prop(vertex)) {
+        is_ok &= vertex->exec(func);
+      }
+    }
+    return is_ok;
+  };
+
+  std::vector<std::future<unsigned>> results;
+  for (std::size_t begin = 0; begin < vertexes.size(); begin += chunk_size) {
+    std::size_t end = std::min(begin + chunk_size, vertexes.size());
+    results.emplace_back(_pool->enqueue(prop_chunk, begin, end));
+  }
+
+  // the barrier of the level.
+  unsigned is_ok = 1;
+  for (auto& result : results) {
+    is_ok &= result.get();
+  }
+
+  return is_ok;
+}
+
+/**
+ * @brief Propagate from the low level to high level, such as slew, delay and
+ * arrive time.
+ *
+ * @param func
+ * @param is_need_prop judge whether the vertex need propagation.
+ * @return unsigned return 1 if success, else return 0.
+ */
+unsigned StaLevelPropagation::propagateFwd(
+    StaFunc& func, std::function<bool(StaVertex*)> is_need_prop) {
+  unsigned is_ok = 1;
+  for (auto& vertexes : _level_vertexes) {
+    is_ok &= propagateLevel(func, vertexes, is_need_prop);
+  }
+
+  return is_ok;
+}
+
+/**
+ * @brief Propagate from the high level to low level, such as require time.
+ *
+ * @param func
+ * @param is_need_prop judge whether the vertex need propagation.
+ * @return unsigned return 1 if success, else return 0.
+ */
+unsigned StaLevelPropagation::propagateBwd(
+    StaFunc& func, std::function<bool(StaVertex*)> is_need_prop) {
+  unsigned is_ok = 1;
+  for (auto it = _level_vertexes.rbegin(); it != _level_vertexes.rend();
+       ++it) {
+    is_ok &= propagateLevel(func, *it, is_need_prop);
+  }
+
+  return is_ok;
+}
+
+}  // namespace ista
@@ -0,0 +1,63 @@
+/**
+ * @file StaLevelPropagation.hh
+ * @author simin tao (taosm@pcl.ac.cn)
+ * @brief The level synchronous(wavefront) propagation of the sta graph.
+ * @version 0.1
+ * @date 2026-10-17
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "StaFunc.hh"
+#include "StaGraph.hh"
+
+class ThreadPool;
+
+namespace ista {
+
+/**
+ * @brief The level-by-level propagation engine.
+ *
+ * The vertexes are bucketed by the level of StaLevelization, and then the
+ * vertexes of the same level are processed in parallel, a barrier is applied
+ * between levels. Since all the fanin(fwd) or fanout(bwd) vertexes are
+ * finished before a level start, the vertex functor need not recurse into the
+ * cone any more, the threads do not collide on the shared cone.
+ *
+ * The buckets are kept by the sta until the graph is changed, so all the
+ * propagations of one update timing share one levelization.
+ */
+class StaLevelPropagation {
+ public:
+  explicit StaLevelPropagation(unsigned num_threads);
+  ~StaLevelPropagation();
+
+  unsigned levelize(StaGraph* the_graph);
+  void reset() {
+    _level_vertexes.clear();
+    _is_levelized = false;
+  }
+  [[nodiscard]] bool isLevelized() const { return _is_levelized; }
+  [[nodiscard]] unsigned get_num_threads() const { return _num_threads; }
+
+  unsigned propagateFwd(StaFunc& func,
+                        std::function<bool(StaVertex*)> is_need_prop);
+  unsigned propagateBwd(StaFunc& func,
+                        std::function<bool(StaVertex*)> is_need_prop);
+
+  [[nodiscard]] std::size_t numLevel() const { return _level_vertexes.size(); }
+
+ private:
+  unsigned propagateLevel(StaFunc& func, std::vector<StaVertex*>& vertexes,
+                          std::function<bool(StaVertex*)>& is_need_prop);
+
+  unsigned _num_threads;
+  std::unique_ptr<ThreadPool> _pool;  //!< The pool shared by all levels.
+  std::vector<std::vector<StaVertex*>>
+      _level_vertexes;  //!< The vertexes of each level, level 1 is the start.
+  bool _is_levelized = false;
+};
+
+}  // namespace ista
@@ -230,6 +230,9 @@ class StaPathGroup {
   StaPathGroup& operator=(StaPathGroup&& rhs) noexcept;
 
   unsigned insertPathData(StaVertex* end_vertex, StaPathData* seq_data);
+  unsigned removePathEndData(StaVertex* end_vertex) {
+    return _end_data.erase(end_vertex);
+  }
   StaPathEnd* findPathEndData(StaVertex* end_vertex) {
     if (auto it = _end_data.find(end_vertex); it != _end_data.end()) {
       return it->second.get();
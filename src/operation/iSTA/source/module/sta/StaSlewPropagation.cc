@@ -9,6 +9,7 @@
 
 #include <optional>
 
+#include "StaLevelPropagation.hh"
 #include "ThreadPool/ThreadPool.h"
 #include "delay/ArnoldiDelayCal.hh"
 #include "netlist/Pin.hh"
@@ -248,6 +249,19 @@ unsigned StaSlewPropagation::operator()(StaVertex* the_vertex) {
 unsigned StaSlewPropagation::operator()(StaGraph* the_graph) {
   LOG_INFO << "slew propagation start";
   unsigned is_ok = 1;
+
+  if (isLevelPropagation()) {
+    // the vertex without snk arcs is propagated by the fanout vertex.
+    auto* level_propagation = getSta()->getLevelPropagation();
+    is_ok = level_propagation->propagateFwd(
+        *this, [](StaVertex* the_vertex) -> bool {
+          return !the_vertex->get_snk_arcs().empty();
+        });
+
+    LOG_INFO << "slew propagation end";
+    return is_ok;
+  }
+
   {
 #if 1
     // create thread pool
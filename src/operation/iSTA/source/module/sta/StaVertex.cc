@@ -108,12 +108,12 @@ StaVertex::StaVertex(DesignObject* obj)
       _is_bwd(0),
       _is_fwd(0),
       _is_crosstalk_prop(0),
-      _level(0),
       _is_sdc_clock_pin(0),
       _is_ideal_clock_latency(0),
       _is_bidirection(0),
       _is_assistant(0),
       _reserverd(0),
+      _level(0),
       _slew_bucket(c_vertex_slew_data_bucket_size),
       _path_delay_bucket(c_vertex_path_delay_data_bucket_size) {
   if (!obj) {
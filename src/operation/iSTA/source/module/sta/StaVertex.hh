@@ -353,7 +353,6 @@ class StaVertex {
   unsigned _is_fwd : 1 = 0;  //!< The vertex is arrive time forward propagated.
   unsigned _is_crosstalk_prop : 1 = 0;  // The vertex is crosstalk propagated.
 
-  unsigned _level : 10 = 0;            //!< The vertex level, start from 1;
   unsigned _is_sdc_clock_pin : 1 = 0;  //!< The create_clock or
                                        //!< create_generate_clock constrain pin.
   unsigned _is_ideal_clock_latency : 1 = 0;  //!< The ideal clock latency set.
@@ -363,6 +362,9 @@ class StaVertex {
 
   unsigned _reserverd : 4 = 0;
 
+  unsigned _level = 0;  //!< The vertex level, start from 1, not a bit field
+                        //!< for the deep graph.
+
   std::vector<StaArc*> _src_arcs;  //!< The timing arc sourced from the vertex.
   std::vector<StaArc*> _snk_arcs;  //!< The timing arc sinked to the vertex.
   StaDataBucket _slew_bucket;      //!< The slew data bucket.
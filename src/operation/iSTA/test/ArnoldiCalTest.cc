@@ -212,10 +212,12 @@ TEST_F(ArnoldiCal, total_test) {
         arnoldi_net->updateRcTiming(*spef_net);
         auto arnoldi_delay = arnoldi_net->getDelay(
             get_current, start_time, end_time, num_sim_point,
-            ista::AnalysisMode::kMax, ista::TransType::kRise, &pin);
+            ista::AnalysisMode::kMax, ista::TransType::kRise, nullptr, 0.0,
+            &pin);
         auto arnoldi_slew = arnoldi_net->getSlew(
             get_current, start_time, end_time, num_sim_point,
-            ista::AnalysisMode::kMax, ista::TransType::kRise, &pin);
+            ista::AnalysisMode::kMax, ista::TransType::kRise, nullptr, 0.0,
+            &pin);
         std::cout << driver->getFullName() << " ----> " << load_name
                   << " delay is " << arnoldi_delay->first << std::endl;
         std::cout << driver->getFullName() << " ----> " << load_name
@@ -303,10 +305,12 @@ TEST_F(ArnoldiCal, arnoldi) {
         arnoldi_net->updateRcTiming(*spef_net);
         auto arnoldi_delay = arnoldi_net->getDelay(
             get_current, start_time, end_time, num_sim_point,
-            ista::AnalysisMode::kMax, ista::TransType::kRise, &pin);
+            ista::AnalysisMode::kMax, ista::TransType::kRise, nullptr, 0.0,
+            &pin);
         auto arnoldi_slew = arnoldi_net->getSlew(
             get_current, start_time, end_time, num_sim_point,
-            ista::AnalysisMode::kMax, ista::TransType::kRise, &pin);
+            ista::AnalysisMode::kMax, ista::TransType::kRise, nullptr, 0.0,
+            &pin);
         std::cout << driver->getFullName() << " ----> " << load_name
                   << " delay is " << arnoldi_delay->first << std::endl;
         std::cout << driver->getFullName() << " ----> " << load_name
@@ -225,6 +225,30 @@ TEST_F(DelayTest, updateTiming1) {
   std::cout << "test" << std::endl;
 }
 
+TEST_F(DelayTest, flat_rc_tree) {
+  ista::RcTree rct;
+  rct.insertNode("root", 0.0);
+  rct.insertNode("a", 1.0);
+  rct.insertNode("b", 2.0);
+  rct.insertNode("c", 3.0);
+  rct.insertSegment("root", "a", 1.0);
+  rct.insertSegment("a", "b", 2.0);
+  rct.insertSegment("a", "c", 0.5);
+  rct.set_root(rct.node("root"));
+
+  rct.updateRcTiming();
+
+  EXPECT_DOUBLE_EQ(rct.node("root")->nodeLoad(), 6.0);
+  EXPECT_DOUBLE_EQ(rct.delay("a"), 6.0);
+  EXPECT_DOUBLE_EQ(rct.delay("b"), 10.0);
+  EXPECT_DOUBLE_EQ(rct.delay("c"), 7.5);
+  EXPECT_DOUBLE_EQ(
+      rct.delay("b", ista::AnalysisMode::kMin, ista::TransType::kFall), 10.0);
+  EXPECT_DOUBLE_EQ(rct.node("b")->get_ures(ista::AnalysisMode::kMax,
+                                           ista::TransType::kRise),
+                   3.0);
+}
+
 TEST_F(DelayTest, nutshell) {
   spef::Spef parser;
   if (!parser.read("/home/smtao/nutshell/soc_asic_top.cmax.125c.spef")) {
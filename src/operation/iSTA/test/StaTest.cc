@@ -17,6 +17,7 @@
 #include "sta/StaDelayPropagation.hh"
 #include "sta/StaDump.hh"
 #include "sta/StaGraph.hh"
+#include "sta/StaLevelPropagation.hh"
 #include "sta/StaSlewPropagation.hh"
 #include "tcl/ScriptEngine.hh"
 #include "usage/usage.hh"
@@ -88,4 +89,38 @@ TEST_F(StaTest, simple_design) {
   }
 }
 
+TEST_F(StaTest, levelize_deep_chain) {
+  // the chain is deeper than the old 10 bit level field.
+  const unsigned chain_length = 2048;
+
+  Netlist design_nl;
+  StaGraph the_graph(&design_nl);
+  std::vector<StaVertex*> chain;
+  for (unsigned i = 0; i < chain_length; ++i) {
+    auto vertex = std::make_unique<StaVertex>(nullptr);
+    chain.push_back(vertex.get());
+    the_graph.addVertex(std::move(vertex));
+  }
+
+  for (unsigned i = 0; i + 1 < chain_length; ++i) {
+    auto arc = std::make_unique<StaNetArc>(chain[i], chain[i + 1], nullptr);
+    chain[i]->addSrcArc(arc.get());
+    chain[i + 1]->addSnkArc(arc.get());
+    the_graph.addArc(std::move(arc));
+  }
+
+  chain.front()->set_is_start();
+  the_graph.addStartVertex(chain.front());
+  chain.back()->set_is_end();
+  the_graph.addEndVertex(chain.back());
+
+  StaLevelPropagation level_propagation(1);
+  level_propagation.levelize(&the_graph);
+
+  EXPECT_EQ(level_propagation.numLevel(), chain_length);
+  for (unsigned i = 0; i < chain_length; ++i) {
+    EXPECT_EQ(chain[i]->get_level(), i + 1);
+  }
+}
+
 }  // namespace
\ No newline at end of file
@@ -1,3 +1,7 @@
+#include <map>
+#include <optional>
+#include <tuple>
+
 #include "api/TimingEngine.hh"
 #include "gtest/gtest.h"
 
@@ -14,6 +18,28 @@ class TimingEngineTest : public testing::Test {
   void TearDown() { Log::end(); }
 };
 
+// the slew, arrive time and require time of all the pins.
+using PinTiming =
+    std::tuple<double, std::optional<double>, std::optional<double>>;
+std::map<std::string, std::vector<PinTiming>> getPinTiming(
+    TimingEngine* timing_engine) {
+  std::map<std::string, std::vector<PinTiming>> pin_timing;
+  auto& the_graph = timing_engine->get_ista()->get_graph();
+  StaVertex* the_vertex;
+  FOREACH_VERTEX(&the_graph, the_vertex) {
+    auto pin_name = the_vertex->getName();
+    for (auto mode : {AnalysisMode::kMax, AnalysisMode::kMin}) {
+      for (auto trans_type : {TransType::kRise, TransType::kFall}) {
+        pin_timing[pin_name].emplace_back(
+            timing_engine->reportSlew(pin_name.c_str(), mode, trans_type),
+            timing_engine->reportAT(pin_name.c_str(), mode, trans_type),
+            timing_engine->reportRT(pin_name.c_str(), mode, trans_type));
+      }
+    }
+  }
+  return pin_timing;
+}
+
 TEST_F(TimingEngineTest, resizer) {
   TimingEngine* timing_engine = TimingEngine::getOrCreateTimingEngine();
   if (timing_engine) {
@@ -239,4 +265,93 @@ TEST_F(TimingEngineTest, move_Instance) {
   timing_engine->reportTiming();
 }
 
+TEST_F(TimingEngineTest, level_propagation) {
+  TimingEngine* timing_engine = TimingEngine::getOrCreateTimingEngine();
+  timing_engine->set_num_threads(1);
+
+  const char* design_work_space =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/";
+  timing_engine->set_design_work_space(design_work_space);
+
+  std::vector<const char*> lib_files = {
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/"
+      "NangateOpenCellLibrary_fast.lib"};
+
+  const char* verilog_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.v";
+  const char* sdc_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.sdc";
+  const char* spef_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.spef";
+
+  timing_engine->readLiberty(lib_files);
+  timing_engine->readDesign(verilog_file);
+  timing_engine->readSdc(sdc_file);
+
+  timing_engine->buildGraph();
+  timing_engine->buildRCTree(spef_file, DelayCalcMethod::kElmore);
+
+  // the dfs propagation.
+  timing_engine->set_is_level_propagation(false);
+  timing_engine->updateTiming();
+  auto dfs_timing = getPinTiming(timing_engine);
+
+  // the level propagation with multi threads.
+  timing_engine->set_num_threads(4);
+  timing_engine->set_is_level_propagation(true);
+  timing_engine->updateTiming();
+  auto level_timing = getPinTiming(timing_engine);
+
+  EXPECT_FALSE(dfs_timing.empty());
+  EXPECT_EQ(dfs_timing, level_timing);
+
+  timing_engine->set_is_level_propagation(false);
+}
+
+TEST_F(TimingEngineTest, incr_update_timing) {
+  TimingEngine* timing_engine = TimingEngine::getOrCreateTimingEngine();
+  timing_engine->set_num_threads(1);
+
+  const char* design_work_space =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/";
+  timing_engine->set_design_work_space(design_work_space);
+
+  std::vector<const char*> lib_files = {
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/"
+      "NangateOpenCellLibrary_fast.lib"};
+
+  const char* verilog_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.v";
+  const char* sdc_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.sdc";
+  const char* spef_file =
+      "/home/taosimin/iEDA-main/iEDA/src/iSTA/example/sizer/sizer.spef";
+
+  timing_engine->readLiberty(lib_files);
+  timing_engine->readDesign(verilog_file);
+  timing_engine->readSdc(sdc_file);
+
+  timing_engine->buildGraph();
+  timing_engine->buildRCTree(spef_file, DelayCalcMethod::kElmore);
+  timing_engine->updateTiming();
+
+  // change the load of one net arc.
+  Netlist* design_netlist = timing_engine->get_netlist();
+  Net* net_1 = design_netlist->findNet("net_1");
+  auto* pin = design_netlist->findPin("inst_2:A2", false, false).front();
+  auto* node1 = timing_engine->makeOrFindRCTreeNode(pin);
+  timing_engine->incrCap(node1, 0.003);
+  timing_engine->updateRCTreeInfo(net_1);
+
+  timing_engine->incrUpdateTiming();
+  auto incr_timing = getPinTiming(timing_engine);
+
+  // the full update for comparing result.
+  timing_engine->updateTiming();
+  auto full_timing = getPinTiming(timing_engine);
+
+  EXPECT_FALSE(full_timing.empty());
+  EXPECT_EQ(incr_timing, full_timing);
+}
+
 }  // namespace
@@ -48,6 +48,7 @@ class ToConfig {
   }
   void set_rebuffer_max_fanout(int num) { _rebuffer_max_fanout = num; }
   void set_split_load_min_fanout(int num) { _split_load_min_fanout = num; }
+  void set_setup_batch_path_number(int num) { _setup_batch_path_number = num; }
 
   // getter
   const vector<string> &get_lef_files() const { return _lef_files_path; }
@@ -78,6 +79,7 @@ class ToConfig {
   }
   int get_rebuffer_max_fanout() { return _rebuffer_max_fanout; }
   int get_split_load_min_fanout() { return _split_load_min_fanout; }
+  int get_setup_batch_path_number() { return _setup_batch_path_number; }
 
  private:
   // input
@@ -104,6 +106,8 @@ class ToConfig {
   int _number_passes_allowed_decreasing_slack = 50;
   int _rebuffer_max_fanout = 20;
   int _split_load_min_fanout = 8; // Don't split loads on low fanout nets.
+  // the number of violated paths fixed before one timing update when fix setup
+  int _setup_batch_path_number = 1;
 
   // output
   string _out_def_path;
@@ -94,6 +94,9 @@ void JsonParser::jsonToConfig(Json *json, ToConfig *config) const {
       json->at("number_passes_allowed_decreasing_slack").get<int>());
   config->set_rebuffer_max_fanout(json->at("rebuffer_max_fanout").get<int>());
   config->set_split_load_min_fanout(json->at("split_load_min_fanout").get<int>());
+  if (json->contains("setup_batch_path_number")) {
+    config->set_setup_batch_path_number(json->at("setup_batch_path_number").get<int>());
+  }
 
   cout << "[ToConfig Info] hold_slack_margin:\n\t\t" << config->get_hold_slack_margin()
        << endl;
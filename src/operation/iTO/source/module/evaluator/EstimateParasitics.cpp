@@ -1,21 +1,38 @@
 #include "EstimateParasitics.h"
+
+#include <mutex>
+
 #include "api/TimingEngine.hh"
 #include "api/TimingIDBAdapter.hh"
 
 namespace ito {
+/**
+ * @brief Flute extends its LUT to the max degree when it first meets such a net,
+ * which races when the trees are built in parallel, so extend it in advance.
+ * Other modules may read the LUT again in the same process, which shrinks it
+ * back, so it is checked before every parallel estimation.
+ *
+ */
+static std::mutex flute_lut_mutex;
+
+static void extendFluteLUT() {
+  std::lock_guard<std::mutex> lock(flute_lut_mutex);
+  Flute::extendLUT();
+}
+
 EstimateParasitics::EstimateParasitics(DbInterface *dbintreface)
     : _db_interface(dbintreface) {
   _timing_engine = _db_interface->get_timing_engine();
   _db_adapter = _timing_engine->get_db_adapter();
   _dbu = _db_interface->get_dbu();
-  Flute::readLUT();
+  extendFluteLUT();
 }
 
 EstimateParasitics::EstimateParasitics(TimingEngine *timing_engine, int dbu)
     : _timing_engine(timing_engine) {
   _db_adapter = _timing_engine->get_db_adapter();
   _dbu = dbu;
-  Flute::readLUT();
+  extendFluteLUT();
 }
 
 /**
@@ -25,15 +42,13 @@ EstimateParasitics::EstimateParasitics(TimingEngine *timing_engine, int dbu)
  */
 void EstimateParasitics::excuteParasiticsEstimate() {
   if (_have_estimated_parasitics) {
+    std::vector<Net *> invalid_nets;
     for (Net *net : _parasitics_invalid) {
-      DesignObject *driver = net->getDriver();
-      if (driver) {
-        if (_timing_engine->get_ista()->getRcNet(net)) {
-          _timing_engine->resetRcTree(net);
-        }
-        excuteWireParasitic(driver, net, _db_adapter);
+      if (net->getDriver()) {
+        invalid_nets.push_back(net);
       }
     }
+    estimateNetsParasitics(invalid_nets);
     _parasitics_invalid.clear();
   } else {
     estimateAllNetParasitics();
@@ -47,15 +62,47 @@ void EstimateParasitics::excuteParasiticsEstimate() {
 void EstimateParasitics::estimateAllNetParasitics() {
   LOG_INFO << "estimate all net parasitics start";
   Netlist *design_nl = _timing_engine->get_netlist();
-  Net *    net;
-  FOREACH_NET(design_nl, net) {
-    estimateNetParasitics(net);
-  }
+  std::vector<Net *> nets;
+  nets.reserve(design_nl->getNetNum());
+  Net *net;
+  FOREACH_NET(design_nl, net) { nets.push_back(net); }
+  estimateNetsParasitics(nets);
   _have_estimated_parasitics = true;
   _parasitics_invalid.clear();
   LOG_INFO << "estimate all net parasitics end";
 }
 
+/**
+ * @brief The steiner trees and wire rc are estimated in parallel, then
+ * committed to the timing engine serially. The nets are processed chunk by
+ * chunk to bound the memory of the uncommitted trees.
+ *
+ * @param nets
+ */
+void EstimateParasitics::estimateNetsParasitics(std::vector<Net *> &nets) {
+  extendFluteLUT();
+
+  const int chunk_size = 100000;
+  int       net_num = nets.size();
+  for (int begin = 0; begin < net_num; begin += chunk_size) {
+    int end = std::min(begin + chunk_size, net_num);
+
+    std::vector<WireParasitic> wire_parasitics(end - begin);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int i = begin; i < end; i++) {
+      wire_parasitics[i - begin] = estimateWireParasitic(nets[i], _db_adapter);
+    }
+
+    for (auto &wire_parasitic : wire_parasitics) {
+      Net *net = wire_parasitic.net;
+      if (_timing_engine->get_ista()->getRcNet(net)) {
+        _timing_engine->resetRcTree(net);
+      }
+      commitWireParasitic(wire_parasitic);
+    }
+  }
+}
+
 /**
  * @brief update rc for special net
  *
@@ -90,55 +137,91 @@ void EstimateParasitics::estimateInvalidNetParasitics(DesignObject *drvr_pin_por
 
 void EstimateParasitics::excuteWireParasitic(DesignObject *drvr_pin_port, Net *curr_net,
                                              TimingDBAdapter *db_adapter) {
-  RoutingTree *tree = makeRoutingTree(curr_net, db_adapter, RoutingType::kSteiner);
+  WireParasitic wire_parasitic = estimateWireParasitic(curr_net, db_adapter);
+  commitWireParasitic(wire_parasitic);
+}
+
+/**
+ * @brief Build the steiner tree and calculate the wire rc, only the net and
+ * the technology are read, so it is safe to call in parallel.
+ *
+ * @param curr_net
+ * @param db_adapter
+ * @return WireParasitic
+ */
+WireParasitic EstimateParasitics::estimateWireParasitic(Net             *curr_net,
+                                                        TimingDBAdapter *db_adapter) {
+  WireParasitic wire_parasitic;
+  wire_parasitic.net = curr_net;
 
-  if (tree) {
-    vector<int> segment_idx;
-    vector<int> length_wire;
-    tree->drvrToLoadLength(tree->get_root(), segment_idx, length_wire, 0);
-
-    std::vector<std::pair<int, int>> wire_segment_idx;
-    std::vector<int>                 length_per_wire;
-
-    tree->segmentIndexAndLength(tree->get_root(), wire_segment_idx, length_per_wire);
-
-    int numb = wire_segment_idx.size();
-    for (int i = 0; i != numb; ++i) {
-      int      index1 = wire_segment_idx[i].first;
-      int      index2 = wire_segment_idx[i].second;
-      RctNode *n1 = _timing_engine->makeOrFindRCTreeNode(curr_net, index1);
-      RctNode *n2 = _timing_engine->makeOrFindRCTreeNode(curr_net, index2);
-
-      int length_dbu = length_per_wire[i];
-      if (length_dbu == 0) {
-        _timing_engine->makeResistor(curr_net, n1, n2, 1.0e-3);
-      } else {
-        std::optional<double> width = std::nullopt;
-        double                cap = dynamic_cast<TimingIDBAdapter *>(db_adapter)
-                         ->getCapacitance(1, (double)length_dbu / _dbu, width);
-        double res = dynamic_cast<TimingIDBAdapter *>(db_adapter)
-                         ->getResistance(1, (double)length_dbu / _dbu, width);
-
-        if (curr_net->isClockNet()) {
-          cap /= 10.0;
-          res /= 10.0;
-        // } else {
-        //   cap /= 2.0;
-        //   res /= 2.0;
-        }
-
-        _timing_engine->incrCap(n1, cap / 2.0, true);
-        _timing_engine->makeResistor(curr_net, n1, n2, res);
-        _timing_engine->incrCap(n2, cap / 2.0, true);
+  RoutingTree *tree = makeRoutingTree(curr_net, db_adapter, RoutingType::kSteiner);
+  if (!tree) {
+    return wire_parasitic;
+  }
+  wire_parasitic.tree = tree;
+  tree->segmentIndexAndLength(tree->get_root(), wire_parasitic.wire_segment_idx,
+                              wire_parasitic.length_per_wire);
+
+  for (int length_dbu : wire_parasitic.length_per_wire) {
+    double cap = 0.0;
+    double res = 0.0;
+    if (length_dbu != 0) {
+      std::optional<double> width = std::nullopt;
+      cap = dynamic_cast<TimingIDBAdapter *>(db_adapter)
+                ->getCapacitance(1, (double)length_dbu / _dbu, width);
+      res = dynamic_cast<TimingIDBAdapter *>(db_adapter)
+                ->getResistance(1, (double)length_dbu / _dbu, width);
+
+      if (curr_net->isClockNet()) {
+        cap /= 10.0;
+        res /= 10.0;
+      // } else {
+      //   cap /= 2.0;
+      //   res /= 2.0;
       }
-      RctNodeConnectPin(curr_net, index1, n1, tree);
-      RctNodeConnectPin(curr_net, index2, n2, tree);
     }
+    wire_parasitic.wire_caps.push_back(cap);
+    wire_parasitic.wire_ress.push_back(res);
+  }
+  return wire_parasitic;
+}
 
-    _timing_engine->updateRCTreeInfo(curr_net);
+/**
+ * @brief Make the rc tree of the estimated net in the timing engine.
+ *
+ * @param wire_parasitic
+ */
+void EstimateParasitics::commitWireParasitic(WireParasitic &wire_parasitic) {
+  Net         *curr_net = wire_parasitic.net;
+  RoutingTree *tree = wire_parasitic.tree;
+  if (!tree) {
+    return;
+  }
+
+  int numb = wire_parasitic.wire_segment_idx.size();
+  for (int i = 0; i != numb; ++i) {
+    int      index1 = wire_parasitic.wire_segment_idx[i].first;
+    int      index2 = wire_parasitic.wire_segment_idx[i].second;
+    RctNode *n1 = _timing_engine->makeOrFindRCTreeNode(curr_net, index1);
+    RctNode *n2 = _timing_engine->makeOrFindRCTreeNode(curr_net, index2);
 
-    delete tree;
+    if (wire_parasitic.length_per_wire[i] == 0) {
+      _timing_engine->makeResistor(curr_net, n1, n2, 1.0e-3);
+    } else {
+      double cap = wire_parasitic.wire_caps[i];
+      double res = wire_parasitic.wire_ress[i];
+      _timing_engine->incrCap(n1, cap / 2.0, true);
+      _timing_engine->makeResistor(curr_net, n1, n2, res);
+      _timing_engine->incrCap(n2, cap / 2.0, true);
+    }
+    RctNodeConnectPin(curr_net, index1, n1, tree);
+    RctNodeConnectPin(curr_net, index2, n2, tree);
   }
+
+  _timing_engine->updateRCTreeInfo(curr_net);
+
+  delete tree;
+  wire_parasitic.tree = nullptr;
 }
 
 void EstimateParasitics::RctNodeConnectPin(Net *net, int index, RctNode *rcnode,
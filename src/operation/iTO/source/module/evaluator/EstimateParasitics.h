@@ -14,6 +14,16 @@ namespace ito {
 using ito::dbuToMeters;
 using ito::metersToDbu;
 
+// the wire rc of a net estimated by its steiner tree, not committed to the timing engine.
+struct WireParasitic {
+  Net                             *net = nullptr;
+  RoutingTree                     *tree = nullptr;
+  std::vector<std::pair<int, int>> wire_segment_idx;
+  std::vector<int>                 length_per_wire;
+  std::vector<double>              wire_caps;
+  std::vector<double>              wire_ress;
+};
+
 class EstimateParasitics {
  public:
   EstimateParasitics(DbInterface *dbintreface);
@@ -36,6 +46,12 @@ class EstimateParasitics {
                            TimingDBAdapter *db_adapter);
 
  private:
+  void estimateNetsParasitics(std::vector<Net *> &nets);
+
+  WireParasitic estimateWireParasitic(Net *curr_net, TimingDBAdapter *db_adapter);
+
+  void commitWireParasitic(WireParasitic &wire_parasitic);
+
   void RctNodeConnectPin(Net *net, int index, RctNode *rcnode, RoutingTree *tree);
 
   DbInterface     *_db_interface = nullptr;
@@ -52,7 +52,8 @@ void HoldOptimizer::optimizeHold() {
   int   insert_buf_count = 1;
   while (insert_buf_count > 0 && worst_hold_slack < _slack_margin) {
     insert_buf_count = checkAndOptimizeHold(end_points, insert_buf_cell);
-    _parasitics_estimator->estimateAllNetParasitics();
+    // only the nets changed by the hold buffers are re-estimated.
+    _parasitics_estimator->excuteParasiticsEstimate();
     _timing_engine->updateTiming();
     worst_hold_slack = getWorstSlack(AnalysisMode::kMin);
     _db_interface->report()->get_ofstream()
@@ -129,7 +130,8 @@ int HoldOptimizer::checkAndOptimizeHold(VertexSet    end_points,
       insert_buf_num.push_back(repair_count);
       if (repair_count > 0) {
         _parasitics_estimator->excuteParasiticsEstimate();
-        _timing_engine->updateTiming();
+        // only the fanout cone of the inserted buffers is dirty.
+        _timing_engine->incrUpdateTiming();
       }
 
       findEndpointsWithHoldViolation(end_points, worst_slack, end_pts_hold_violation);
@@ -59,6 +59,7 @@ void SetupOptimizer::optimizeSetup() {
   float slack_margin = _db_interface->get_setup_slack_margin();
   int   _number_passes_allowed_decreasing_slack =
       _db_interface->get_number_passes_allowed_decreasing_slack();
+  int   batch_path_num = _db_interface->get_setup_batch_path_number();
 
   StaSeqPathData *worst_path = worstRequiredPath();
   Slack worst_slack = worst_path->getSlackNs();
@@ -67,7 +68,13 @@ void SetupOptimizer::optimizeSetup() {
   // slack violation
   while (worst_slack < slack_margin) {
 
-    optimizeSetup(worst_path, worst_slack);
+    if (batch_path_num > 1) {
+      vector<StaSeqPathData *> violated_paths =
+          worstRequiredPaths(batch_path_num, slack_margin);
+      optimizeSetup(violated_paths);
+    } else {
+      optimizeSetup(worst_path, worst_slack);
+    }
 
     _parasitics_estimator->excuteParasiticsEstimate();
 
@@ -125,83 +132,191 @@ void SetupOptimizer::optimizeSetup() {
 }
 
 void SetupOptimizer::optimizeSetup(StaSeqPathData *worst_path, Slack path_slack) {
+  vector<PathDriver> drivers = getPathDrivers(worst_path);
+  for (auto &driver : drivers) {
+    if (driver.in_port) {
+      driver.upsize = upsizeCell(driver.in_port, driver.drvr_port, driver.load_cap,
+                                 driver.prev_drive);
+    }
+  }
+  fixPathDrivers(drivers, path_slack, nullptr);
+}
+
+/**
+ * @brief Fix a batch of violated paths before one timing update.
+ * The upsize cells of all path drivers are evaluated in parallel, then the
+ * fixes are applied from the worst path, a fix touching a net which has been
+ * changed in this batch is skipped, as its delay estimation is out of date.
+ *
+ * @param violated_paths sorted by slack, the worst first.
+ */
+void SetupOptimizer::optimizeSetup(vector<StaSeqPathData *> &violated_paths) {
+  // the net load is cached when it is first got, so collect the drivers serially.
+  vector<vector<PathDriver>> path_drivers;
+  vector<Slack>              path_slacks;
+  for (auto *path : violated_paths) {
+    path_drivers.push_back(getPathDrivers(path));
+    path_slacks.push_back(path->getSlackNs());
+  }
+
+  vector<PathDriver *> eval_drivers;
+  for (auto &drivers : path_drivers) {
+    for (auto &driver : drivers) {
+      if (driver.in_port) {
+        eval_drivers.push_back(&driver);
+      }
+    }
+  }
+  // only the liberty is read when evaluating the upsize cell.
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < (int)eval_drivers.size(); i++) {
+    PathDriver *driver = eval_drivers[i];
+    driver->upsize = upsizeCell(driver->in_port, driver->drvr_port, driver->load_cap,
+                                driver->prev_drive);
+  }
+
+  std::set<Net *> touched_nets;
+  for (size_t i = 0; i < path_drivers.size(); i++) {
+    fixPathDrivers(path_drivers[i], path_slacks[i], &touched_nets);
+  }
+}
+
+/**
+ * @brief The drivers with the largest delay on the path, sorted by delay.
+ *
+ * @param path
+ * @return vector<PathDriver> the upsize cell is not evaluated.
+ */
+vector<PathDriver> SetupOptimizer::getPathDrivers(StaSeqPathData *path) {
   vector<TimingEngine::PathNet> path_driver_vertexs =
-      _timing_engine->getPathDriverVertexs(worst_path);
+      _timing_engine->getPathDriverVertexs(path);
   int path_length = path_driver_vertexs.size();
 
   vector<TimingEngine::PathNet> sorted_path_driver_vertexs;
   for (int i = 0; i < path_length; i++) {
-    auto path = path_driver_vertexs[i];
-    sorted_path_driver_vertexs.push_back(path);
+    auto path_net = path_driver_vertexs[i];
+    sorted_path_driver_vertexs.push_back(path_net);
   }
   sort(sorted_path_driver_vertexs.begin(), sorted_path_driver_vertexs.end(),
        [](TimingEngine::PathNet n1, TimingEngine::PathNet n2) {
          return n1.delay > n2.delay;
        });
 
+  vector<PathDriver> drivers;
   if (path_length > 1) {
     for (int i = 0; i < (int)path_length / 5; i++) {
-      auto       path = sorted_path_driver_vertexs[i];
-      StaVertex *drvr_vertex = path.driver;
-      auto      *obj = drvr_vertex->get_design_obj();
-      Pin       *drvr_pin = dynamic_cast<Pin *>(obj);
-
-      int fanout = getFanoutNumber(drvr_pin);
-      int _rebuffer_max_fanout = _db_interface->get_rebuffer_max_fanout();
-
-      LibertyPort *drvr_port = drvr_pin->get_cell_port();
-      float load_cap = drvr_pin->get_net()->getLoad(AnalysisMode::kMax, TransType::kRise);
+      auto       path_net = sorted_path_driver_vertexs[i];
+      PathDriver driver;
+      driver.drvr_vertex = path_net.driver;
+      driver.drvr_pin = dynamic_cast<Pin *>(path_net.driver->get_design_obj());
+      driver.drvr_port = driver.drvr_pin->get_cell_port();
+      driver.load_cap =
+          driver.drvr_pin->get_net()->getLoad(AnalysisMode::kMax, TransType::kRise);
 
       vector<TimingEngine::PathNet>::iterator itr =
-          find(path_driver_vertexs.begin(), path_driver_vertexs.end(), path);
+          find(path_driver_vertexs.begin(), path_driver_vertexs.end(), path_net);
       int drvr_idx = distance(path_driver_vertexs.begin(), itr);
       if (drvr_idx >= 1) {
-        auto         in_path = path_driver_vertexs[drvr_idx - 1];
-        StaVertex   *in_vertex = in_path.load;
-        auto        *in_obj = in_vertex->get_design_obj();
-        Pin         *in_pin = dynamic_cast<Pin *>(in_obj);
-        LibertyPort *in_port = in_pin->get_cell_port();
-
-        float        prev_drive;
-        auto        *prev_drvr_vertex = in_path.driver;
-        auto        *prev_drvr_obj = prev_drvr_vertex->get_design_obj();
-        Pin         *prev_drvr_pin = dynamic_cast<Pin *>(prev_drvr_obj);
+        auto       in_path = path_driver_vertexs[drvr_idx - 1];
+        StaVertex *in_vertex = in_path.load;
+        Pin       *in_pin = dynamic_cast<Pin *>(in_vertex->get_design_obj());
+        driver.in_port = in_pin->get_cell_port();
+
+        Pin *prev_drvr_pin = dynamic_cast<Pin *>(in_path.driver->get_design_obj());
         LibertyPort *prev_drvr_port = prev_drvr_pin->get_cell_port();
-        prev_drive = prev_drvr_port->driveResistance();
-
-        LibertyCell *upsize = upsizeCell(in_port, drvr_port, load_cap, prev_drive);
-        if (upsize) {
-          Instance *drvr_inst = drvr_pin->get_own_instance();
-          if (_violation_fixer->repowerInstance(drvr_inst, upsize)) {
-            _resize_instance_count++;
-            _parasitics_estimator->estimateNetParasitics(drvr_pin->get_net());
-          }
-          break;
+        driver.prev_drive = prev_drvr_port->driveResistance();
+      }
+      drivers.push_back(driver);
+    }
+  }
+  return drivers;
+}
+
+/**
+ * @brief Upsize, rebuffer or split loads on the first fixable driver.
+ *
+ * @param drivers
+ * @param path_slack
+ * @param touched_nets the nets changed in this batch, nullptr if not batched.
+ */
+void SetupOptimizer::fixPathDrivers(vector<PathDriver> &drivers, Slack path_slack,
+                                    std::set<Net *> *touched_nets) {
+  auto is_touched = [touched_nets](const std::set<Net *> &nets) {
+    if (touched_nets) {
+      for (Net *net : nets) {
+        if (touched_nets->count(net)) {
+          return true;
         }
       }
+    }
+    return false;
+  };
+  auto touch = [touched_nets](const std::set<Net *> &nets) {
+    if (touched_nets) {
+      touched_nets->insert(nets.begin(), nets.end());
+    }
+  };
 
-      if (fanout > 1
-          // Rebuffer blows up on large fanout nets.
-          && fanout < _rebuffer_max_fanout) {
-        int count_before = _inserted_buffer_count;
-        buffering(drvr_pin); // _inserted_buffer_count++
-        int insert_count = _inserted_buffer_count - count_before;
+  int _rebuffer_max_fanout = _db_interface->get_rebuffer_max_fanout();
+  int split_load_min_fanout = _db_interface->get_split_load_min_fanout();
 
-        if (insert_count > 0) {
-          break;
-        }
+  for (auto &driver : drivers) {
+    Pin *drvr_pin = driver.drvr_pin;
+    Net *drvr_net = drvr_pin->get_net();
+    int  fanout = getFanoutNumber(drvr_pin);
+
+    if (driver.upsize) {
+      // the resized instance changes the load of all its nets.
+      Instance       *drvr_inst = drvr_pin->get_own_instance();
+      std::set<Net *> inst_nets = getInstanceNets(drvr_inst);
+      if (is_touched(inst_nets)) {
+        continue;
+      }
+      if (_violation_fixer->repowerInstance(drvr_inst, driver.upsize)) {
+        _resize_instance_count++;
+        _parasitics_estimator->estimateNetParasitics(drvr_net);
+        touch(inst_nets);
       }
+      break;
+    }
 
-      // Don't split loads on low fanout nets.
-      int split_load_min_fanout = _db_interface->get_split_load_min_fanout();
-      if (fanout > split_load_min_fanout) {
-        insertBufferSeparateLoads(drvr_vertex, path_slack);
+    if (is_touched({drvr_net})) {
+      continue;
+    }
+
+    if (fanout > 1
+        // Rebuffer blows up on large fanout nets.
+        && fanout < _rebuffer_max_fanout) {
+      int count_before = _inserted_buffer_count;
+      buffering(drvr_pin); // _inserted_buffer_count++
+      int insert_count = _inserted_buffer_count - count_before;
+
+      if (insert_count > 0) {
+        touch({drvr_net});
         break;
       }
     }
+
+    // Don't split loads on low fanout nets.
+    if (fanout > split_load_min_fanout) {
+      insertBufferSeparateLoads(driver.drvr_vertex, path_slack);
+      touch({drvr_net});
+      break;
+    }
   }
 }
 
+std::set<Net *> SetupOptimizer::getInstanceNets(Instance *inst) {
+  std::set<Net *> nets;
+  Pin            *pin;
+  FOREACH_INSTANCE_PIN(inst, pin) {
+    if (pin->get_net()) {
+      nets.insert(pin->get_net());
+    }
+  }
+  return nets;
+}
+
 void SetupOptimizer::buffering(Pin *pin) {
   Net         *net = pin->get_net();
   LibertyPort *drvr_port = pin->get_cell_port();
@@ -674,7 +789,9 @@ LibertyCell *SetupOptimizer::upsizeCell(LibertyPort *in_port, LibertyPort *drvr_
     const char *in_port_name = in_port->get_port_name();
     const char *drvr_port_name = drvr_port->get_port_name();
 
-    sort(equiv_cells->begin(), equiv_cells->end(),
+    // sort a copy, the equiv cells are shared when evaluating in parallel.
+    vector<LibertyCell *> sorted_cells(equiv_cells->begin(), equiv_cells->end());
+    sort(sorted_cells.begin(), sorted_cells.end(),
          [=](LibertyCell *cell1, LibertyCell *cell2) {
            LibertyPort *port1 = cell1->get_cell_port_or_port_bus(drvr_port_name);
            LibertyPort *port2 = cell2->get_cell_port_or_port_bus(drvr_port_name);
@@ -685,7 +802,7 @@ LibertyCell *SetupOptimizer::upsizeCell(LibertyPort *in_port, LibertyPort *drvr_
     float delay =
         calcGateDelay(drvr_port, load_cap) + prev_drive * in_port->get_port_cap();
 
-    for (LibertyCell *equiv : *equiv_cells) {
+    for (LibertyCell *equiv : sorted_cells) {
       if (strstr(equiv->get_cell_name(), "CLK") != NULL) {
         continue;
       }
@@ -724,4 +841,42 @@ StaSeqPathData *SetupOptimizer::worstRequiredPath() {
   return worst_path;
 }
 
+/**
+ * @brief The worst path of each violated endpoint.
+ *
+ * @param path_num the max number of the paths.
+ * @param slack_margin
+ * @return vector<StaSeqPathData *> sorted by slack, the worst first.
+ */
+vector<StaSeqPathData *> SetupOptimizer::worstRequiredPaths(int path_num,
+                                                            Slack slack_margin) {
+  vector<TransType>        rise_fall = {TransType::kRise, TransType::kFall};
+  vector<StaSeqPathData *> violated_paths;
+
+  auto      *ista = _timing_engine->get_ista();
+  StaGraph  *the_graph = &(ista->get_graph());
+  StaVertex *vertex;
+  FOREACH_END_VERTEX(the_graph, vertex) {
+    StaSeqPathData *worst_path = nullptr;
+    for (auto rf : rise_fall) {
+      auto path = _timing_engine->vertexWorstRequiredPath(vertex, AnalysisMode::kMax, rf);
+      if (path && (!worst_path || path->getSlackNs() < worst_path->getSlackNs())) {
+        worst_path = path;
+      }
+    }
+    if (worst_path && worst_path->getSlackNs() < slack_margin) {
+      violated_paths.push_back(worst_path);
+    }
+  }
+
+  sort(violated_paths.begin(), violated_paths.end(),
+       [](StaSeqPathData *path1, StaSeqPathData *path2) {
+         return path1->getSlackNs() < path2->getSlackNs();
+       });
+  if ((int)violated_paths.size() > path_num) {
+    violated_paths.resize(path_num);
+  }
+  return violated_paths;
+}
+
 } // namespace ito
\ No newline at end of file
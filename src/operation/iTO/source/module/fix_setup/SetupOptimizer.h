@@ -13,6 +13,18 @@ namespace ito {
 using ito::BufferedOptionSeq;
 using ito::fuzzyLess;
 using ito::fuzzyLessEqual;
+
+// a driver on the violated path and its upsize cell.
+struct PathDriver {
+  StaVertex   *drvr_vertex = nullptr;
+  Pin         *drvr_pin = nullptr;
+  LibertyPort *in_port = nullptr; // nullptr when the driver is the path start.
+  LibertyPort *drvr_port = nullptr;
+  float        load_cap = 0.0;
+  float        prev_drive = 0.0;
+  LibertyCell *upsize = nullptr;
+};
+
 class SetupOptimizer {
  public:
   SetupOptimizer(DbInterface *dbinterface);
@@ -32,6 +44,15 @@ class SetupOptimizer {
 
   void optimizeSetup(StaSeqPathData *worst_path, Slack path_slack);
 
+  void optimizeSetup(vector<StaSeqPathData *> &violated_paths);
+
+  vector<PathDriver> getPathDrivers(StaSeqPathData *path);
+
+  void fixPathDrivers(vector<PathDriver> &drivers, Slack path_slack,
+                      std::set<Net *> *touched_nets);
+
+  std::set<Net *> getInstanceNets(Instance *inst);
+
   void buffering(Pin *pin);
 
   void insertBufferSeparateLoads(StaVertex *drvr_vertex, Slack drvr_slack);
@@ -68,6 +89,8 @@ class SetupOptimizer {
 
   StaSeqPathData *worstRequiredPath();
 
+  vector<StaSeqPathData *> worstRequiredPaths(int path_num, Slack slack_margin);
+
   // data
   DbInterface     *_db_interface;
   TimingEngine    *_timing_engine;
@@ -241,6 +241,15 @@ void readLUT() {
 #endif
 }
 
+// Init the LUTs to FLUTE_D now instead of lazily in flute(),
+// so that later calls only read the LUTs.
+void extendLUT() {
+  if (LUT == nullptr) {
+    readLUT();
+  }
+  ensureLUT(FLUTE_D);
+}
+
 static void
 makeLUT(LUT_TYPE &LUT,
 	NUMSOLN_TYPE &numsoln)
@@ -61,6 +61,7 @@ typedef struct {
 
 // User-Callable Functions
 void readLUT();
+void extendLUT();  // read the LUT if needed and init it to FLUTE_D
 void deleteLUT();
 DTYPE flute_wl(int d, DTYPE x[], DTYPE y[], int acc);
 Tree flute(int d, DTYPE x[], DTYPE y[], int acc);